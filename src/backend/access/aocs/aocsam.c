@@ -418,6 +418,10 @@ open_next_scan_seg(AOCSScanDesc scan)
 												  scan->columnScanInfo.num_proj_atts,
 												  scan->blockDirectory);
 
+				if (scan->zoneMap)
+					AppendOnlyZoneMap_LoadSegmentFile(scan->zoneMap,
+													  (FileSegInfo *) curSegInfo);
+
 				return scan->cur_seg;
 			}
 		}
@@ -639,6 +643,9 @@ aocs_endscan(AOCSScanDesc scan)
 	if (scan->total_seg != 0)
 		AppendOnlyVisimap_Finish(&scan->visibilityMap, AccessShareLock);
 
+	if (scan->zoneMap)
+		AppendOnlyZoneMap_Finish(scan->zoneMap);
+
 	RelationDecrementReferenceCount(scan->rs_base.rs_rd);
 
 	pfree(scan);
@@ -812,6 +819,37 @@ ReadNext:
 			}
 		}
 
+		/*
+		 * If the zone maps show that this row and the ones after it do not
+		 * satisfy the quals, move every column to the first row that might.
+		 * The blocks in between are passed over without being read.
+		 */
+		if (scan->zoneMap && rowNum != INT64CONST(-1))
+		{
+			int64		nextRowNum;
+
+			if (AppendOnlyZoneMap_ExcludesRow(scan->zoneMap, rowNum, &nextRowNum))
+			{
+				SIMPLE_FAULT_INJECTOR("aocs_zonemap_skip_rows");
+
+				for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+				{
+					AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+					err = datumstreamread_skip_to_row(scan->columnScanInfo.ds[attno],
+													  nextRowNum);
+					if (err < 0)
+					{
+						close_cur_scan_seg(scan);
+						break;
+					}
+				}
+
+				rowNum = INT64CONST(-1);
+				goto ReadNext;
+			}
+		}
+
 		scan->cur_seg_row++;
 		if (rowNum == INT64CONST(-1))
 		{
@@ -1040,6 +1078,13 @@ aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupl
 
 			Assert(idesc->ds[i]->blockFirstRowNum == idesc->lastSequence + 1);
 
+			/*
+			 * The value belongs to the next block directory entry, whether
+			 * it goes to a new block or to a lob of its own.
+			 */
+			AppendOnlyBlockDirectory_SummarizeDatum(&idesc->blockDirectory, i,
+													datum, null[i]);
+
 
 			/* now write this new item to the new block */
 			err = datumstreamwrite_put(idesc->ds[i], datum, null[i], &toFree2);
@@ -1062,6 +1107,9 @@ aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupl
 				idesc->ds[i]->blockFirstRowNum = idesc->lastSequence + 2;
 			}
 		}
+		else
+			AppendOnlyBlockDirectory_SummarizeDatum(&idesc->blockDirectory, i,
+													datum, null[i]);
 
 		if (toFree1 != NULL)
 			pfree(toFree1);
@@ -448,6 +448,10 @@ aoco_beginscan_extractcolumns(Relation rel, Snapshot snapshot,
 							snapshot,
 							cols,
 							flags);
+	aoscan->zoneMap = AppendOnlyZoneMap_Init(rel,
+											 aoscan->appendOnlyMetaDataSnapshot,
+											 true,
+											 qual);
 
 	pfree(cols);
 
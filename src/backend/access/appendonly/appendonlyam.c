@@ -342,6 +342,10 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 												 &scan->executorReadBlock,
 												  /* blockFirstRowNum */ 1);
 
+	if (scan->zoneMap)
+		AppendOnlyZoneMap_LoadSegmentFile(scan->zoneMap,
+										  scan->aos_segfile_arr[scan->aos_segfiles_processed - 1]);
+
 	/* ready to go! */
 	scan->aos_need_new_segfile = false;
 
@@ -1323,6 +1327,23 @@ getNextBlock(AppendOnlyScanDesc scan)
 											 false);
 	}
 
+	/*
+	 * Pass over the block without reading its content if the zone maps show
+	 * that none of its rows satisfy the quals. Large content is not
+	 * summarized, so it is always read.
+	 */
+	if (scan->zoneMap && !scan->executorReadBlock.isLarge &&
+		AppendOnlyZoneMap_ExcludesBlock(scan->zoneMap,
+										scan->executorReadBlock.headerOffsetInFile))
+	{
+		SIMPLE_FAULT_INJECTOR("appendonly_zonemap_skip_block");
+
+		AppendOnlyExecutionReadBlock_FinishedScanBlock(&scan->executorReadBlock);
+		AppendOnlyStorageRead_SkipCurrentBlock(&scan->storageRead);
+
+		return false;
+	}
+
 	AppendOnlyExecutorReadBlock_GetContents(
 											&scan->executorReadBlock);
 
@@ -1867,6 +1888,9 @@ appendonly_endscan(TableScanDesc scan)
 	if (aoscan->aos_total_segfiles > 0)
 		AppendOnlyVisimap_Finish(&aoscan->visibilityMap, AccessShareLock);
 
+	if (aoscan->zoneMap)
+		AppendOnlyZoneMap_Finish(aoscan->zoneMap);
+
 	if (aoscan->aofetch)
 	{
 		appendonly_fetch_finish(aoscan->aofetch);
@@ -3039,6 +3063,10 @@ appendonly_insert(AppendOnlyInsertDesc aoInsertDesc,
 
 		if (itemLen > 0)
 			memcpy(itemPtr, tup, itemLen);
+
+		AppendOnlyBlockDirectory_SummarizeMemTuple(&aoInsertDesc->blockDirectory,
+												   tup,
+												   aoInsertDesc->mt_bind);
 	}
 	else
 	{
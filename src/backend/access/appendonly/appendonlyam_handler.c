@@ -401,6 +401,27 @@ appendonly_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
  * ------------------------------------------------------------------------
  */
 
+/*
+ * Begin a sequential scan, using the quals to skip blocks by the zone maps
+ * of the block directory.
+ */
+static TableScanDesc
+appendonly_beginscan_extractcolumns(Relation rel, Snapshot snapshot,
+									List *targetlist, List *qual,
+									uint32 flags)
+{
+	AppendOnlyScanDesc aoscan;
+
+	aoscan = (AppendOnlyScanDesc) appendonly_beginscan(rel, snapshot, 0, NULL,
+													   NULL, flags);
+	aoscan->zoneMap = AppendOnlyZoneMap_Init(rel,
+											 aoscan->appendOnlyMetaDataSnapshot,
+											 false,
+											 qual);
+
+	return (TableScanDesc) aoscan;
+}
+
 /* ------------------------------------------------------------------------
  * Index Scan Callbacks for appendonly AM
  * ------------------------------------------------------------------------
@@ -1916,6 +1937,7 @@ static const TableAmRoutine ao_row_methods = {
 	.slot_callbacks = appendonly_slot_callbacks,
 
 	.scan_begin = appendonly_beginscan,
+	.scan_begin_extractcolumns = appendonly_beginscan_extractcolumns,
 	.scan_end = appendonly_endscan,
 	.scan_rescan = appendonly_rescan,
 	.scan_getnextslot = appendonly_getnextslot,
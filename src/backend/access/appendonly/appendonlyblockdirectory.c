@@ -19,11 +19,16 @@
 #include "catalog/pg_appendonly_fn.h"
 #include "access/heapam.h"
 #include "access/genam.h"
+#include "catalog/pg_type.h"
+#include "nodes/primnodes.h"
 #include "parser/parse_oper.h"
+#include "utils/date.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/guc.h"
 #include "utils/fmgroids.h"
+#include "utils/timestamp.h"
+#include "utils/typcache.h"
 #include "cdb/cdbappendonlyam.h"
 
 int			gp_blockdirectory_entry_min_range = 0;
@@ -36,6 +41,13 @@ minipage_size(uint32 nEntry)
 		sizeof(MinipageEntry) * nEntry;
 }
 
+static inline uint32
+zonemap_size(uint32 nEntry, int nColumns)
+{
+	return offsetof(MinipageZoneMap, summaries) +
+		sizeof(ZoneMapSummary) * nEntry * nColumns;
+}
+
 static void load_last_minipage(
 				   AppendOnlyBlockDirectory *blockDirectory,
 				   int64 lastSequence,
@@ -62,6 +74,14 @@ static bool insert_new_entry(AppendOnlyBlockDirectory *blockDirectory,
 				 int64 fileOffset,
 				 int64 rowCount,
 				 bool addColAction);
+static void init_zonemap(AppendOnlyBlockDirectory *blockDirectory);
+static void zonemap_merge_pending(MinipagePerColumnGroup *minipageInfo,
+					  int entryNo);
+static Minipage *build_zonemap_minipage(MinipagePerColumnGroup *minipageInfo);
+static void read_zonemap(Minipage *minipage,
+			 int nColumns,
+			 AttrNumber *attnums,
+			 ZoneMapSummary *summaries);
 
 void
 AppendOnlyBlockDirectoryEntry_GetBeginRange(
@@ -280,6 +300,7 @@ AppendOnlyBlockDirectory_Init_forInsert(
 	blockDirectory->indinfo = CatalogOpenIndexes(blockDirectory->blkdirRel);
 
 	init_internal(blockDirectory);
+	init_zonemap(blockDirectory);
 
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
 			  (errmsg("Append-only block directory init for insert: "
@@ -749,7 +770,12 @@ insert_new_entry(
 
 		if (gp_blockdirectory_entry_min_range > 0 &&
 			fileOffset - entry->fileOffset < gp_blockdirectory_entry_min_range)
+		{
+			/* The latest entry now covers the new block, too */
+			if (minipageInfo->numZoneMapColumns > 0)
+				zonemap_merge_pending(minipageInfo, lastEntryNo);
 			return true;
+		}
 
 		/* Update the rowCount in the latest entry */
 		Assert(entry->rowCount <= firstRowNum - entry->firstRowNum);
@@ -780,6 +806,10 @@ insert_new_entry(
 		 */
 		MemSet(minipageInfo->minipage->entry, 0,
 			   minipageInfo->numMinipageEntries * sizeof(MinipageEntry));
+		if (minipageInfo->numZoneMapColumns > 0)
+			MemSet(minipageInfo->zoneMap, 0,
+				   minipageInfo->numMinipageEntries *
+				   minipageInfo->numZoneMapColumns * sizeof(ZoneMapSummary));
 		minipageInfo->numMinipageEntries = 0;
 	}
 
@@ -790,6 +820,17 @@ insert_new_entry(
 	entry->fileOffset = fileOffset;
 	entry->rowCount = rowCount;
 
+	if (minipageInfo->numZoneMapColumns > 0)
+	{
+		int			nColumns = minipageInfo->numZoneMapColumns;
+
+		memcpy(&minipageInfo->zoneMap[minipageInfo->numMinipageEntries * nColumns],
+			   minipageInfo->pendingZoneMap,
+			   nColumns * sizeof(ZoneMapSummary));
+		MemSet(minipageInfo->pendingZoneMap, 0,
+			   nColumns * sizeof(ZoneMapSummary));
+	}
+
 	minipageInfo->numMinipageEntries++;
 
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
@@ -936,15 +977,22 @@ copy_out_minipage(MinipagePerColumnGroup *minipageInfo,
 	value = (struct varlena *)
 		DatumGetPointer(minipage_value);
 	detoast_value = pg_detoast_datum(value);
-	Assert(VARSIZE(detoast_value) <= minipage_size(NUM_MINIPAGE_ENTRIES));
+	Assert(((Minipage *) detoast_value)->nEntry <= NUM_MINIPAGE_ENTRIES);
 
-	memcpy(minipageInfo->minipage, detoast_value, VARSIZE(detoast_value));
-	if (detoast_value != value)
-		pfree(detoast_value);
-
-	Assert(minipageInfo->minipage->nEntry <= NUM_MINIPAGE_ENTRIES);
+	/* Leave out the zone map, if any; it is unpacked below */
+	memcpy(minipageInfo->minipage, detoast_value,
+		   minipage_size(((Minipage *) detoast_value)->nEntry));
 
 	minipageInfo->numMinipageEntries = minipageInfo->minipage->nEntry;
+
+	if (minipageInfo->numZoneMapColumns > 0)
+		read_zonemap((Minipage *) detoast_value,
+					 minipageInfo->numZoneMapColumns,
+					 minipageInfo->zoneMapAttnums,
+					 minipageInfo->zoneMap);
+
+	if (detoast_value != value)
+		pfree(detoast_value);
 }
 
 
@@ -1156,6 +1204,7 @@ write_minipage(AppendOnlyBlockDirectory *blockDirectory,
 {
 	HeapTuple	tuple;
 	MemoryContext oldcxt;
+	Minipage   *minipage;
 	Datum	   *values = blockDirectory->values;
 	bool	   *nulls = blockDirectory->nulls;
 	Relation	blkdirRel = blockDirectory->blkdirRel;
@@ -1183,8 +1232,17 @@ write_minipage(AppendOnlyBlockDirectory *blockDirectory,
 	SET_VARSIZE(minipageInfo->minipage,
 				minipage_size(minipageInfo->numMinipageEntries));
 	minipageInfo->minipage->nEntry = minipageInfo->numMinipageEntries;
-	values[Anum_pg_aoblkdir_minipage - 1] =
-		PointerGetDatum(minipageInfo->minipage);
+
+	/*
+	 * The zone map goes after the entries, so the minipage is copied to a
+	 * buffer large enough for both.
+	 */
+	if (minipageInfo->numZoneMapColumns > 0)
+		minipage = build_zonemap_minipage(minipageInfo);
+	else
+		minipage = minipageInfo->minipage;
+
+	values[Anum_pg_aoblkdir_minipage - 1] = PointerGetDatum(minipage);
 	nulls[Anum_pg_aoblkdir_minipage - 1] = false;
 
 	tuple = heaptuple_form_to(heapTupleDesc,
@@ -1225,6 +1283,8 @@ write_minipage(AppendOnlyBlockDirectory *blockDirectory,
 	}
 
 	heap_freetuple(tuple);
+	if (minipage != minipageInfo->minipage)
+		pfree(minipage);
 
 	MemoryContextSwitchTo(oldcxt);
 }
@@ -1255,6 +1315,11 @@ AppendOnlyBlockDirectory_End_forInsert(
 		}
 
 		pfree(minipageInfo->minipage);
+		if (minipageInfo->numZoneMapColumns > 0)
+		{
+			pfree(minipageInfo->zoneMap);
+			pfree(minipageInfo->pendingZoneMap);
+		}
 	}
 
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
@@ -1368,3 +1433,853 @@ AppendOnlyBlockDirectory_End_addCol(
 
 	MemoryContextDelete(blockDirectory->memoryContext);
 }
+
+/*
+ * Zone maps
+ *
+ * Each block directory entry written by an insert also summarizes a few
+ * columns of its column group over the rows the entry covers: their smallest
+ * and largest value and their number of NULLs. A scan with quals on those
+ * columns passes over the blocks of the entries that no row could satisfy.
+ */
+
+static bool
+zonemap_type_supported(Oid typid)
+{
+	switch (typid)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case DATEOID:
+		case TIMESTAMPOID:
+		case TIMESTAMPTZOID:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Integer values compare with each other once widened to int64. Date/time
+ * values only compare with values of the same type.
+ */
+static bool
+zonemap_types_comparable(Oid typid1, Oid typid2)
+{
+	if (typid1 == typid2)
+		return true;
+
+	return (typid1 == INT2OID || typid1 == INT4OID || typid1 == INT8OID) &&
+		(typid2 == INT2OID || typid2 == INT4OID || typid2 == INT8OID);
+}
+
+static int64
+zonemap_datum_to_int64(Oid typid, Datum value)
+{
+	switch (typid)
+	{
+		case INT2OID:
+			return DatumGetInt16(value);
+		case INT4OID:
+			return DatumGetInt32(value);
+		case INT8OID:
+			return DatumGetInt64(value);
+		case DATEOID:
+			return DatumGetDateADT(value);
+		case TIMESTAMPOID:
+			return DatumGetTimestamp(value);
+		case TIMESTAMPTZOID:
+			return DatumGetTimestampTz(value);
+		default:
+			elog(ERROR, "unexpected type %u in zone map", typid);
+	}
+
+	return 0;					/* keep compiler quiet */
+}
+
+static void
+zonemap_add_value(ZoneMapSummary *summary, Oid typid, Datum value,
+				  bool isnull)
+{
+	int64		v;
+
+	summary->flags |= ZONEMAP_SUMMARIZED;
+
+	if (isnull)
+	{
+		summary->nullCount++;
+		return;
+	}
+
+	v = zonemap_datum_to_int64(typid, value);
+	if (!(summary->flags & ZONEMAP_HAS_VALUES))
+	{
+		summary->minValue = v;
+		summary->maxValue = v;
+		summary->flags |= ZONEMAP_HAS_VALUES;
+	}
+	else if (v < summary->minValue)
+		summary->minValue = v;
+	else if (v > summary->maxValue)
+		summary->maxValue = v;
+}
+
+/*
+ * Widen summary dst to cover the rows of src as well. If either side is not
+ * summarized, neither is the result: its rows could hold any value.
+ */
+static void
+zonemap_merge(ZoneMapSummary *dst, ZoneMapSummary *src)
+{
+	if (!(dst->flags & ZONEMAP_SUMMARIZED) ||
+		!(src->flags & ZONEMAP_SUMMARIZED))
+	{
+		MemSet(dst, 0, sizeof(ZoneMapSummary));
+		return;
+	}
+
+	dst->nullCount += src->nullCount;
+
+	if (!(src->flags & ZONEMAP_HAS_VALUES))
+		return;
+
+	if (!(dst->flags & ZONEMAP_HAS_VALUES))
+	{
+		dst->minValue = src->minValue;
+		dst->maxValue = src->maxValue;
+		dst->flags |= ZONEMAP_HAS_VALUES;
+	}
+	else
+	{
+		dst->minValue = Min(dst->minValue, src->minValue);
+		dst->maxValue = Max(dst->maxValue, src->maxValue);
+	}
+}
+
+/*
+ * init_zonemap
+ *
+ * Choose the columns to summarize for each column group: the column itself
+ * for a column-oriented relation, and the first few supported columns for a
+ * row-oriented one.
+ *
+ * With gp_appendonly_zone_maps off, no column is summarized, and the
+ * minipages are written without a zone map, as before.
+ */
+static void
+init_zonemap(AppendOnlyBlockDirectory *blockDirectory)
+{
+	TupleDesc	tupleDesc = RelationGetDescr(blockDirectory->aoRel);
+	MemoryContext oldcxt;
+	int			groupNo;
+
+	oldcxt = MemoryContextSwitchTo(blockDirectory->memoryContext);
+
+	for (groupNo = 0; groupNo < blockDirectory->numColumnGroups; groupNo++)
+	{
+		MinipagePerColumnGroup *minipageInfo =
+		&blockDirectory->minipages[groupNo];
+		AttrNumber	firstAttno;
+		AttrNumber	lastAttno;
+		AttrNumber	attno;
+		int			nColumns = 0;
+
+		if (!gp_appendonly_zone_maps)
+		{
+			minipageInfo->numZoneMapColumns = 0;
+			continue;
+		}
+
+		if (blockDirectory->isAOCol)
+			firstAttno = lastAttno = groupNo + 1;
+		else
+		{
+			firstAttno = 1;
+			lastAttno = tupleDesc->natts;
+		}
+
+		for (attno = firstAttno;
+			 attno <= Min(lastAttno, tupleDesc->natts) &&
+			 nColumns < MAX_ZONEMAP_COLUMNS;
+			 attno++)
+		{
+			Form_pg_attribute attr = TupleDescAttr(tupleDesc, attno - 1);
+
+			if (attr->attisdropped || !zonemap_type_supported(attr->atttypid))
+				continue;
+
+			minipageInfo->zoneMapAttnums[nColumns] = attno;
+			minipageInfo->zoneMapTypes[nColumns] = attr->atttypid;
+			nColumns++;
+		}
+
+		minipageInfo->numZoneMapColumns = nColumns;
+		if (nColumns > 0)
+		{
+			minipageInfo->zoneMap =
+				palloc0(sizeof(ZoneMapSummary) * NUM_MINIPAGE_ENTRIES * nColumns);
+			minipageInfo->pendingZoneMap =
+				palloc0(sizeof(ZoneMapSummary) * nColumns);
+		}
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+}
+
+/*
+ * zonemap_merge_pending
+ *
+ * Fold the summary of the rows added since the last entry was inserted into
+ * the given entry.
+ */
+static void
+zonemap_merge_pending(MinipagePerColumnGroup *minipageInfo, int entryNo)
+{
+	int			nColumns = minipageInfo->numZoneMapColumns;
+	int			col;
+
+	for (col = 0; col < nColumns; col++)
+		zonemap_merge(&minipageInfo->zoneMap[entryNo * nColumns + col],
+					  &minipageInfo->pendingZoneMap[col]);
+
+	MemSet(minipageInfo->pendingZoneMap, 0,
+		   nColumns * sizeof(ZoneMapSummary));
+}
+
+/*
+ * build_zonemap_minipage
+ *
+ * Return a palloc'd copy of the in-memory minipage, with its zone map
+ * stored after the entries.
+ */
+static Minipage *
+build_zonemap_minipage(MinipagePerColumnGroup *minipageInfo)
+{
+	uint32		nEntry = minipageInfo->numMinipageEntries;
+	int			nColumns = minipageInfo->numZoneMapColumns;
+	uint32		size = minipage_size(nEntry) + zonemap_size(nEntry, nColumns);
+	MinipageZoneMap header;
+	Minipage   *minipage;
+	char	   *zonemap;
+
+	minipage = palloc(size);
+	memcpy(minipage, minipageInfo->minipage, minipage_size(nEntry));
+	SET_VARSIZE(minipage, size);
+
+	MemSet(&header, 0, sizeof(header));
+	header.nColumns = nColumns;
+	memcpy(header.attnums, minipageInfo->zoneMapAttnums,
+		   nColumns * sizeof(AttrNumber));
+
+	zonemap = (char *) minipage + minipage_size(nEntry);
+	memcpy(zonemap, &header, offsetof(MinipageZoneMap, summaries));
+	memcpy(zonemap + offsetof(MinipageZoneMap, summaries),
+		   minipageInfo->zoneMap,
+		   sizeof(ZoneMapSummary) * nEntry * nColumns);
+
+	return minipage;
+}
+
+/*
+ * read_zonemap
+ *
+ * Unpack the summaries of the given columns for every entry of a minipage
+ * into summaries, nEntry * nColumns of them, entry-major. Columns that the
+ * minipage does not summarize come out unsummarized.
+ *
+ * The zone map is not aligned within the minipage, so it is copied out
+ * piecewise.
+ */
+static void
+read_zonemap(Minipage *minipage, int nColumns, AttrNumber *attnums,
+			 ZoneMapSummary *summaries)
+{
+	uint32		nEntry = minipage->nEntry;
+	uint32		size = VARSIZE(minipage);
+	MinipageZoneMap header;
+	char	   *zonemap;
+	int			col;
+
+	MemSet(summaries, 0, sizeof(ZoneMapSummary) * nEntry * nColumns);
+
+	if (size == minipage_size(nEntry))
+		return;
+
+	if (size < minipage_size(nEntry) + offsetof(MinipageZoneMap, summaries))
+		elog(ERROR, "invalid zone map in append-only block directory minipage");
+
+	zonemap = (char *) minipage + minipage_size(nEntry);
+	memcpy(&header, zonemap, offsetof(MinipageZoneMap, summaries));
+
+	if (header.nColumns < 0 || header.nColumns > MAX_ZONEMAP_COLUMNS ||
+		size != minipage_size(nEntry) + zonemap_size(nEntry, header.nColumns))
+		elog(ERROR, "invalid zone map in append-only block directory minipage");
+
+	for (col = 0; col < nColumns; col++)
+	{
+		int			stored;
+		uint32		entryNo;
+
+		for (stored = 0; stored < header.nColumns; stored++)
+		{
+			if (header.attnums[stored] == attnums[col])
+				break;
+		}
+		if (stored == header.nColumns)
+			continue;
+
+		for (entryNo = 0; entryNo < nEntry; entryNo++)
+			memcpy(&summaries[entryNo * nColumns + col],
+				   zonemap + offsetof(MinipageZoneMap, summaries) +
+				   sizeof(ZoneMapSummary) * (entryNo * header.nColumns + stored),
+				   sizeof(ZoneMapSummary));
+	}
+}
+
+/*
+ * AppendOnlyBlockDirectory_SummarizeDatum
+ *
+ * Add a value of a column-oriented relation to the summary of the entry
+ * that will cover it, i.e. the next one inserted for its column group.
+ */
+void
+AppendOnlyBlockDirectory_SummarizeDatum(AppendOnlyBlockDirectory *blockDirectory,
+										int columnGroupNo,
+										Datum value,
+										bool isnull)
+{
+	MinipagePerColumnGroup *minipageInfo;
+
+	if (blockDirectory->blkdirRel == NULL)
+		return;
+
+	minipageInfo = &blockDirectory->minipages[columnGroupNo];
+	if (minipageInfo->numZoneMapColumns == 0)
+		return;
+
+	Assert(minipageInfo->numZoneMapColumns == 1);
+	zonemap_add_value(&minipageInfo->pendingZoneMap[0],
+					  minipageInfo->zoneMapTypes[0],
+					  value, isnull);
+}
+
+/*
+ * AppendOnlyBlockDirectory_SummarizeMemTuple
+ *
+ * Add a tuple of a row-oriented relation to the summary of the entry that
+ * will cover it.
+ */
+void
+AppendOnlyBlockDirectory_SummarizeMemTuple(AppendOnlyBlockDirectory *blockDirectory,
+										   MemTuple tuple,
+										   MemTupleBinding *mt_bind)
+{
+	MinipagePerColumnGroup *minipageInfo;
+	int			col;
+
+	if (blockDirectory->blkdirRel == NULL)
+		return;
+
+	minipageInfo = &blockDirectory->minipages[0];
+	for (col = 0; col < minipageInfo->numZoneMapColumns; col++)
+	{
+		Datum		value;
+		bool		isnull;
+
+		value = memtuple_getattr(tuple, mt_bind,
+								 minipageInfo->zoneMapAttnums[col], &isnull);
+		zonemap_add_value(&minipageInfo->pendingZoneMap[col],
+						  minipageInfo->zoneMapTypes[col],
+						  value, isnull);
+	}
+}
+
+static bool
+zonemap_var_supported(Var *var, TupleDesc tupleDesc)
+{
+	Form_pg_attribute attr;
+
+	if (var->varlevelsup != 0 ||
+		var->varattno <= 0 || var->varattno > tupleDesc->natts)
+		return false;
+
+	attr = TupleDescAttr(tupleDesc, var->varattno - 1);
+
+	return !attr->attisdropped &&
+		attr->atttypid == var->vartype &&
+		zonemap_type_supported(attr->atttypid);
+}
+
+/*
+ * make_zonemap_key
+ *
+ * Turn a qual of the form "column op constant", "constant op column",
+ * "column IS NULL" or "column IS NOT NULL" into a scan key, with the
+ * constant mapped to int64. Returns false for any other qual.
+ */
+static bool
+make_zonemap_key(Expr *clause, TupleDesc tupleDesc, ScanKey key, int64 *value)
+{
+	if (IsA(clause, OpExpr))
+	{
+		OpExpr	   *op = (OpExpr *) clause;
+		Oid			opno = op->opno;
+		Node	   *leftop;
+		Node	   *rightop;
+		Var		   *var;
+		Const	   *con;
+		TypeCacheEntry *typentry;
+		int			strategy;
+
+		if (list_length(op->args) != 2)
+			return false;
+
+		leftop = (Node *) linitial(op->args);
+		rightop = (Node *) lsecond(op->args);
+		while (IsA(leftop, RelabelType))
+			leftop = (Node *) ((RelabelType *) leftop)->arg;
+		while (IsA(rightop, RelabelType))
+			rightop = (Node *) ((RelabelType *) rightop)->arg;
+
+		if (IsA(leftop, Var) && IsA(rightop, Const))
+		{
+			var = (Var *) leftop;
+			con = (Const *) rightop;
+		}
+		else if (IsA(leftop, Const) && IsA(rightop, Var))
+		{
+			var = (Var *) rightop;
+			con = (Const *) leftop;
+			opno = get_commutator(opno);
+			if (!OidIsValid(opno))
+				return false;
+		}
+		else
+			return false;
+
+		if (!zonemap_var_supported(var, tupleDesc) || con->constisnull ||
+			!zonemap_types_comparable(var->vartype, con->consttype))
+			return false;
+
+		typentry = lookup_type_cache(var->vartype, TYPECACHE_BTREE_OPFAMILY);
+		if (!OidIsValid(typentry->btree_opf))
+			return false;
+
+		strategy = get_op_opfamily_strategy(opno, typentry->btree_opf);
+		if (strategy == InvalidStrategy)
+			return false;
+
+		ScanKeyEntryInitialize(key,
+							   0,
+							   var->varattno,
+							   strategy,
+							   con->consttype,
+							   InvalidOid,
+							   get_opcode(opno),
+							   con->constvalue);
+		*value = zonemap_datum_to_int64(con->consttype, con->constvalue);
+
+		return true;
+	}
+	else if (IsA(clause, NullTest))
+	{
+		NullTest   *ntest = (NullTest *) clause;
+		Node	   *arg = (Node *) ntest->arg;
+
+		while (IsA(arg, RelabelType))
+			arg = (Node *) ((RelabelType *) arg)->arg;
+
+		if (ntest->argisrow || !IsA(arg, Var) ||
+			!zonemap_var_supported((Var *) arg, tupleDesc))
+			return false;
+
+		ScanKeyEntryInitialize(key,
+							   SK_ISNULL | (ntest->nulltesttype == IS_NULL ?
+											SK_SEARCHNULL : SK_SEARCHNOTNULL),
+							   ((Var *) arg)->varattno,
+							   InvalidStrategy,
+							   InvalidOid,
+							   InvalidOid,
+							   InvalidOid,
+							   (Datum) 0);
+		*value = 0;
+
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * zonemap_excludes
+ *
+ * Does the summary show that no row of its entry satisfies the key?
+ */
+static bool
+zonemap_excludes(ScanKey key, int64 value, ZoneMapSummary *summary)
+{
+	if (!(summary->flags & ZONEMAP_SUMMARIZED))
+		return false;
+
+	if (key->sk_flags & SK_ISNULL)
+	{
+		if (key->sk_flags & SK_SEARCHNULL)
+			return summary->nullCount == 0;
+		else
+			return !(summary->flags & ZONEMAP_HAS_VALUES);
+	}
+
+	/* btree operators are strict, they never hold for NULLs */
+	if (!(summary->flags & ZONEMAP_HAS_VALUES))
+		return true;
+
+	switch (key->sk_strategy)
+	{
+		case BTLessStrategyNumber:
+			return summary->minValue >= value;
+		case BTLessEqualStrategyNumber:
+			return summary->minValue > value;
+		case BTEqualStrategyNumber:
+			return value < summary->minValue || value > summary->maxValue;
+		case BTGreaterEqualStrategyNumber:
+			return summary->maxValue < value;
+		case BTGreaterStrategyNumber:
+			return summary->maxValue <= value;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Append a range to the column group, merging it into the previous one if
+ * both are excluded, or both are not.
+ */
+static void
+zonemap_add_range(ZoneMapColumnGroup *group, int64 firstRowNum,
+				  int64 fileOffset, bool excluded)
+{
+	ZoneMapRange *range;
+
+	if (group->numRanges > 0 &&
+		group->ranges[group->numRanges - 1].excluded == excluded)
+		return;
+
+	if (group->numRanges == group->maxRanges)
+	{
+		group->maxRanges = Max(group->maxRanges * 2, NUM_MINIPAGE_ENTRIES);
+		if (group->ranges == NULL)
+			group->ranges = palloc(sizeof(ZoneMapRange) * group->maxRanges);
+		else
+			group->ranges = repalloc(group->ranges,
+									 sizeof(ZoneMapRange) * group->maxRanges);
+	}
+
+	range = &group->ranges[group->numRanges++];
+	range->firstRowNum = firstRowNum;
+	range->fileOffset = fileOffset;
+	range->excluded = excluded;
+}
+
+/*
+ * Find the range of the column group that holds the given row, or block
+ * when byOffset is set. Returns -1 when it precedes every range.
+ */
+static int
+zonemap_find_range(ZoneMapColumnGroup *group, int64 position, bool byOffset)
+{
+	ZoneMapRange *ranges = group->ranges;
+
+#define ZONEMAP_RANGE_START(i) \
+	(byOffset ? ranges[i].fileOffset : ranges[i].firstRowNum)
+
+	if (group->numRanges == 0 || position < ZONEMAP_RANGE_START(0))
+		return -1;
+
+	if (position < ZONEMAP_RANGE_START(group->currentRange))
+		group->currentRange = 0;
+
+	while (group->currentRange + 1 < group->numRanges &&
+		   ZONEMAP_RANGE_START(group->currentRange + 1) <= position)
+		group->currentRange++;
+
+#undef ZONEMAP_RANGE_START
+
+	return group->currentRange;
+}
+
+/*
+ * AppendOnlyZoneMap_Init
+ *
+ * Set up the zone map of a sequential scan with the given quals. Returns
+ * NULL when zone maps are disabled, the relation has no block directory, or
+ * none of the quals can be checked against a zone map.
+ */
+AppendOnlyZoneMap *
+AppendOnlyZoneMap_Init(Relation aoRel,
+					   Snapshot appendOnlyMetaDataSnapshot,
+					   bool isAOCol,
+					   List *qual)
+{
+	AppendOnlyZoneMap *zoneMap;
+	MemoryContext memoryContext;
+	MemoryContext oldcxt;
+	Oid			blkdirrelid;
+	Oid			blkdiridxid;
+	ListCell   *lc;
+	int			keyNo;
+
+	if (!gp_appendonly_zone_maps || qual == NIL)
+		return NULL;
+
+	GetAppendOnlyEntryAuxOids(aoRel->rd_id, NULL, NULL,
+							  &blkdirrelid, &blkdiridxid, NULL, NULL);
+	if (!OidIsValid(blkdirrelid))
+		return NULL;
+
+	memoryContext = AllocSetContextCreate(CurrentMemoryContext,
+										  "ZoneMapContext",
+										  ALLOCSET_DEFAULT_MINSIZE,
+										  ALLOCSET_DEFAULT_INITSIZE,
+										  ALLOCSET_DEFAULT_MAXSIZE);
+	oldcxt = MemoryContextSwitchTo(memoryContext);
+
+	zoneMap = palloc0(sizeof(AppendOnlyZoneMap));
+	zoneMap->memoryContext = memoryContext;
+	zoneMap->keys = palloc0(sizeof(ScanKeyData) * list_length(qual));
+	zoneMap->keyValues = palloc0(sizeof(int64) * list_length(qual));
+
+	foreach(lc, qual)
+	{
+		if (make_zonemap_key((Expr *) lfirst(lc),
+							 RelationGetDescr(aoRel),
+							 &zoneMap->keys[zoneMap->nkeys],
+							 &zoneMap->keyValues[zoneMap->nkeys]))
+			zoneMap->nkeys++;
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+
+	if (zoneMap->nkeys == 0)
+	{
+		MemoryContextDelete(memoryContext);
+		return NULL;
+	}
+
+	/*
+	 * A row-oriented relation has a single column group. A column-oriented
+	 * one needs the column group of every column with a key.
+	 */
+	zoneMap->groups =
+		MemoryContextAllocZero(memoryContext,
+							   sizeof(ZoneMapColumnGroup) * zoneMap->nkeys);
+	if (!isAOCol)
+		zoneMap->numGroups = 1;
+	else
+	{
+		for (keyNo = 0; keyNo < zoneMap->nkeys; keyNo++)
+		{
+			int			columnGroupNo = zoneMap->keys[keyNo].sk_attno - 1;
+			int			groupNo;
+
+			for (groupNo = 0; groupNo < zoneMap->numGroups; groupNo++)
+			{
+				if (zoneMap->groups[groupNo].columnGroupNo == columnGroupNo)
+					break;
+			}
+			if (groupNo == zoneMap->numGroups)
+				zoneMap->groups[zoneMap->numGroups++].columnGroupNo = columnGroupNo;
+		}
+	}
+
+	zoneMap->aoRel = aoRel;
+	zoneMap->appendOnlyMetaDataSnapshot = appendOnlyMetaDataSnapshot;
+	zoneMap->isAOCol = isAOCol;
+	zoneMap->blkdirRel = heap_open(blkdirrelid, AccessShareLock);
+	zoneMap->blkdirIdx = index_open(blkdiridxid, AccessShareLock);
+
+	return zoneMap;
+}
+
+/*
+ * AppendOnlyZoneMap_LoadSegmentFile
+ *
+ * Read the zone maps of a segment file from the block directory, and find
+ * the ranges of it that the scan keys exclude.
+ */
+void
+AppendOnlyZoneMap_LoadSegmentFile(AppendOnlyZoneMap *zoneMap,
+								  FileSegInfo *segmentFileInfo)
+{
+	TupleDesc	heapTupleDesc = RelationGetDescr(zoneMap->blkdirRel);
+	MemoryContext oldcxt;
+	AttrNumber *attnums;
+	int			keyNo;
+	int			groupNo;
+
+	oldcxt = MemoryContextSwitchTo(zoneMap->memoryContext);
+
+	attnums = palloc(sizeof(AttrNumber) * zoneMap->nkeys);
+	for (keyNo = 0; keyNo < zoneMap->nkeys; keyNo++)
+		attnums[keyNo] = zoneMap->keys[keyNo].sk_attno;
+
+	for (groupNo = 0; groupNo < zoneMap->numGroups; groupNo++)
+	{
+		ZoneMapColumnGroup *group = &zoneMap->groups[groupNo];
+		ScanKeyData scanKeys[2];
+		SysScanDesc idxScanDesc;
+		HeapTuple	tuple;
+		int64		eof;
+		int64		endRowNum = 0;
+
+		if (!zoneMap->isAOCol)
+			eof = segmentFileInfo->eof;
+		else
+		{
+			AOCSFileSegInfo *aocsInfo = (AOCSFileSegInfo *) segmentFileInfo;
+
+			eof = aocsInfo->vpinfo.entry[group->columnGroupNo].eof;
+		}
+
+		group->numRanges = 0;
+		group->currentRange = 0;
+
+		ScanKeyInit(&scanKeys[0],
+					1,			/* segno */
+					BTEqualStrategyNumber,
+					F_INT4EQ,
+					Int32GetDatum(segmentFileInfo->segno));
+		ScanKeyInit(&scanKeys[1],
+					2,			/* columngroup_no */
+					BTEqualStrategyNumber,
+					F_INT4EQ,
+					Int32GetDatum(group->columnGroupNo));
+
+		idxScanDesc = systable_beginscan_ordered(zoneMap->blkdirRel,
+												 zoneMap->blkdirIdx,
+												 zoneMap->appendOnlyMetaDataSnapshot,
+												 2, scanKeys);
+
+		while ((tuple = systable_getnext_ordered(idxScanDesc,
+												 ForwardScanDirection)) != NULL)
+		{
+			Datum		value;
+			bool		isnull;
+			Minipage   *minipage;
+			ZoneMapSummary *summaries;
+			uint32		entryNo;
+
+			value = heap_getattr(tuple, Anum_pg_aoblkdir_minipage,
+								 heapTupleDesc, &isnull);
+			Assert(!isnull);
+
+			minipage = (Minipage *)
+				pg_detoast_datum_copy((struct varlena *) DatumGetPointer(value));
+			summaries = palloc(sizeof(ZoneMapSummary) *
+							   minipage->nEntry * zoneMap->nkeys);
+			read_zonemap(minipage, zoneMap->nkeys, attnums, summaries);
+
+			for (entryNo = 0; entryNo < minipage->nEntry; entryNo++)
+			{
+				MinipageEntry *entry = &minipage->entry[entryNo];
+				bool		excluded = false;
+
+				/* Entries past the end of file were left by aborted inserts */
+				if (entry->fileOffset >= eof)
+					break;
+
+				for (keyNo = 0; keyNo < zoneMap->nkeys; keyNo++)
+				{
+					if (zonemap_excludes(&zoneMap->keys[keyNo],
+										 zoneMap->keyValues[keyNo],
+										 &summaries[entryNo * zoneMap->nkeys + keyNo]))
+					{
+						excluded = true;
+						break;
+					}
+				}
+
+				zonemap_add_range(group, entry->firstRowNum, entry->fileOffset,
+								  excluded);
+				endRowNum = entry->firstRowNum + entry->rowCount;
+			}
+
+			pfree(summaries);
+			pfree(minipage);
+		}
+
+		systable_endscan_ordered(idxScanDesc);
+
+		/* Nothing is known about the rows after the last entry */
+		if (group->numRanges > 0)
+			zonemap_add_range(group, endRowNum, eof, false);
+	}
+
+	pfree(attnums);
+
+	MemoryContextSwitchTo(oldcxt);
+}
+
+/*
+ * AppendOnlyZoneMap_ExcludesBlock
+ *
+ * Does the zone map of a row-oriented relation show that no row of the
+ * block at the given offset of the current segment file satisfies the
+ * scan keys?
+ */
+bool
+AppendOnlyZoneMap_ExcludesBlock(AppendOnlyZoneMap *zoneMap, int64 fileOffset)
+{
+	ZoneMapColumnGroup *group = &zoneMap->groups[0];
+	int			rangeNo;
+
+	Assert(!zoneMap->isAOCol);
+
+	rangeNo = zonemap_find_range(group, fileOffset, true);
+
+	return rangeNo >= 0 && group->ranges[rangeNo].excluded;
+}
+
+/*
+ * AppendOnlyZoneMap_ExcludesRow
+ *
+ * Does the zone map of a column-oriented relation show that the given row
+ * of the current segment file does not satisfy the scan keys? If so,
+ * *nextRowNum is set to the first row after it that might.
+ */
+bool
+AppendOnlyZoneMap_ExcludesRow(AppendOnlyZoneMap *zoneMap, int64 rowNum,
+							  int64 *nextRowNum)
+{
+	bool		excluded = false;
+	int			groupNo;
+
+	for (groupNo = 0; groupNo < zoneMap->numGroups; groupNo++)
+	{
+		ZoneMapColumnGroup *group = &zoneMap->groups[groupNo];
+		int			rangeNo = zonemap_find_range(group, rowNum, false);
+		int64		endRowNum;
+
+		if (rangeNo < 0 || !group->ranges[rangeNo].excluded)
+			continue;
+
+		/* An excluded range is always followed by one that is not */
+		Assert(rangeNo + 1 < group->numRanges);
+		endRowNum = group->ranges[rangeNo + 1].firstRowNum;
+
+		if (!excluded || endRowNum > *nextRowNum)
+			*nextRowNum = endRowNum;
+		excluded = true;
+	}
+
+	return excluded;
+}
+
+void
+AppendOnlyZoneMap_Finish(AppendOnlyZoneMap *zoneMap)
+{
+	index_close(zoneMap->blkdirIdx, AccessShareLock);
+	heap_close(zoneMap->blkdirRel, AccessShareLock);
+
+	MemoryContextDelete(zoneMap->memoryContext);
+}
@@ -67,6 +67,7 @@
 #include "utils/faultinjector.h"
 #include "utils/guc.h"
 #include "utils/inval.h"
+#include "utils/mdcacheshared.h"
 #include "utils/memutils.h"
 #include "utils/relmapper.h"
 
@@ -2951,6 +2952,7 @@ CommitTransaction(void)
 	 * about the catalog change before they start using the relation).
 	 */
 	AtEOXact_Inval(true);
+	AtEOXact_MDCacheShared(true);
 
 	AtEOXact_MultiXact();
 
@@ -3298,6 +3300,7 @@ PrepareTransaction(void)
 	PostPrepare_PgStat();
 
 	PostPrepare_Inval();
+	AtEOXact_MDCacheShared(false);
 
 	PostPrepare_smgr();
 
@@ -3550,6 +3553,7 @@ AbortTransaction(void)
 		AtEOXact_Buffers(false);
 		AtEOXact_RelationCache(false);
 		AtEOXact_Inval(false);
+		AtEOXact_MDCacheShared(false);
 		AtEOXact_MultiXact();
 
 		ResourceOwnerRelease(TopTransactionResourceOwner,
@@ -19,10 +19,14 @@
 #include "cdb/cdbbufferedread.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
 #include "utils/guc.h"
 
 static void BufferedReadIo(
 			   BufferedRead *bufferedRead);
+static void BufferedReadPrefetch(
+					 BufferedRead *bufferedRead,
+					 int64 inEffectFileLen);
 static uint8 *BufferedReadUseBeforeBuffer(
 							BufferedRead *bufferedRead,
 							int32 maxReadAheadLen,
@@ -103,6 +107,7 @@ BufferedReadInit(
 	bufferedRead->fileLen = 0;
 	/* start reading from beginning of file */
 	bufferedRead->fileOff = 0;
+	bufferedRead->prefetchPosition = 0;
 
 	/*
 	 * Temporary limit support for random reading.
@@ -142,6 +147,7 @@ BufferedReadSetFile(
 	bufferedRead->haveTemporaryLimitInEffect = false;
 	bufferedRead->temporaryLimitFileLen = 0;
 	bufferedRead->fileOff =0;
+	bufferedRead->prefetchPosition = 0;
 
 	if (fileLen > 0)
 	{
@@ -153,6 +159,7 @@ BufferedReadSetFile(
 		else
 			bufferedRead->largeReadLen = (int32) fileLen;
 		BufferedReadIo(bufferedRead);
+		BufferedReadPrefetch(bufferedRead, fileLen);
 	}
 }
 
@@ -224,6 +231,48 @@ BufferedReadIo(
 		VacuumCostBalance += VacuumCostPageMiss;
 }
 
+/*
+ * Start reading the large read after the current one in the background.
+ *
+ * The kernel reads it into the page cache while the caller decompresses and
+ * evaluates the current one, so that the next BufferedReadIo finds it there
+ * instead of waiting on the device.  Only sequential reads prefetch; nothing
+ * is prefetched while a temporary range is in effect, since the caller will
+ * likely jump elsewhere once done with it.
+ */
+static void
+BufferedReadPrefetch(
+					 BufferedRead *bufferedRead,
+					 int64 inEffectFileLen)
+{
+#ifdef USE_PREFETCH
+	int64		nextPosition;
+	int64		prefetchLen;
+
+	if (effective_io_concurrency <= 0 ||
+		bufferedRead->haveTemporaryLimitInEffect)
+		return;
+
+	nextPosition = bufferedRead->largeReadPosition + bufferedRead->largeReadLen;
+
+	prefetchLen = inEffectFileLen - nextPosition;
+	if (prefetchLen > bufferedRead->maxLargeReadLen)
+		prefetchLen = bufferedRead->maxLargeReadLen;
+
+	/* Nothing left, or already prefetched */
+	if (prefetchLen <= 0 ||
+		nextPosition + prefetchLen <= bufferedRead->prefetchPosition)
+		return;
+
+	(void) FilePrefetch(bufferedRead->file,
+						nextPosition,
+						(int) prefetchLen,
+						WAIT_EVENT_DATA_FILE_PREFETCH);
+
+	bufferedRead->prefetchPosition = nextPosition + prefetchLen;
+#endif							/* USE_PREFETCH */
+}
+
 static uint8 *
 BufferedReadUseBeforeBuffer(
 							BufferedRead *bufferedRead,
@@ -304,6 +353,7 @@ BufferedReadUseBeforeBuffer(
 	}
 
 	BufferedReadIo(bufferedRead);
+	BufferedReadPrefetch(bufferedRead, inEffectFileLen);
 
 	extraLen = maxReadAheadLen - beforeLen;
 	Assert(extraLen > 0);
@@ -406,6 +456,7 @@ BufferedReadSetTemporaryRange(
 		 */
 		bufferedRead->fileOff = beginFileOffset;
 		bufferedRead->bufferOffset = 0;
+		bufferedRead->prefetchPosition = 0;
 
 		remainingFileLen = afterFileOffset - beginFileOffset;
 		if (remainingFileLen > bufferedRead->maxLargeReadLen)
@@ -520,6 +571,7 @@ BufferedReadGetNextBuffer(
 		}
 
 		BufferedReadIo(bufferedRead);
+		BufferedReadPrefetch(bufferedRead, inEffectFileLen);
 
 		if (maxReadAheadLen > bufferedRead->largeReadLen)
 			bufferedRead->bufferLen = bufferedRead->largeReadLen;
@@ -650,6 +702,8 @@ BufferedReadCompleteFile(
 
 	bufferedRead->largeReadPosition = 0;
 	bufferedRead->largeReadLen = 0;
+
+	bufferedRead->prefetchPosition = 0;
 }
 
 
@@ -138,6 +138,18 @@ int
 /* 1/4 sec in msec */
 #define RX_THREAD_POLL_TIMEOUT (250)
 
+/*
+ * On Linux, data packets are sent with sendmmsg() and received with
+ * recvmmsg(), up to UDPIC_MMSG_BATCH_SIZE packets per syscall. Elsewhere
+ * every packet takes its own sendto() or recvfrom().
+ */
+#ifdef __linux__
+#define UDPIC_USE_MMSG
+#define UDPIC_MMSG_BATCH_SIZE (32)
+#else
+#define UDPIC_MMSG_BATCH_SIZE (1)
+#endif
+
 /*
  * Flags definitions for flag-field of UDP-messages
  *
@@ -323,10 +335,10 @@ struct RxBufferPool
 /*
  * The buffer pool used for keeping data packets.
  *
- * maxCount is set to 1 to make sure there is always a buffer
- * for picking packets from OS buffer.
+ * maxCount starts at UDPIC_MMSG_BATCH_SIZE to cover the buffers the rx
+ * thread keeps for its next batch of packets from OS buffer.
  */
-static RxBufferPool rx_buffer_pool = {1, 0, NULL};
+static RxBufferPool rx_buffer_pool = {UDPIC_MMSG_BATCH_SIZE, 0, NULL};
 
 /*
  * SendBufferPool
@@ -617,6 +629,9 @@ typedef struct AckSendParam
  * duplicatedPktNum          - duplicate packet number.
  * recvAckNum                - the number of Acks received.
  * statusQueryMsgNum         - the number of status query messages sent.
+ * sndSyscallNum             - the number of syscalls used to send the sndPktNum packets.
+ * recvSyscallNum            - the number of syscalls the rx thread received packets with.
+ * recvSyscallPktNum         - the number of packets received by those syscalls.
  *
  */
 typedef struct ICStatistics
@@ -638,6 +653,9 @@ typedef struct ICStatistics
 	int32		duplicatedPktNum;
 	int32		recvAckNum;
 	int32		statusQueryMsgNum;
+	int32		sndSyscallNum;
+	int32		recvSyscallNum;
+	int32		recvSyscallPktNum;
 } ICStatistics;
 
 /* Statistics for UDP interconnect. */
@@ -737,6 +755,8 @@ static void checkQDConnectionAlive(void);
 
 
 static void *rxThreadFunc(void *arg);
+static int	receivePackets(icpkthdr **pkts, int npkts, struct sockaddr_storage *peers, socklen_t *peerlens, int *readCounts);
+static bool handleRxPacket(icpkthdr *pkt, int read_count, struct sockaddr_storage *peer, socklen_t peerlen);
 
 static bool handleMismatch(icpkthdr *pkt, struct sockaddr_storage *peer, int peer_len);
 static void handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now);
@@ -752,6 +772,7 @@ static inline void addCRC(icpkthdr *pkt);
 static inline bool checkCRC(icpkthdr *pkt);
 static void sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn);
 static void sendOnce(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer *buf, MotionConn *conn);
+static void sendBatch(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer **bufs, int nbufs, MotionConn *conn);
 static inline uint64 computeExpirationPeriod(MotionConn *conn, uint32 retry);
 
 static ICBuffer *getSndBuffer(MotionConn *conn);
@@ -1458,7 +1479,7 @@ InitMotionUDPIFC(int *listenerSocketFd, uint16 *listenerPort)
 
 	/* Initialize receive buffer pool */
 	rx_buffer_pool.count = 0;
-	rx_buffer_pool.maxCount = 1;
+	rx_buffer_pool.maxCount = UDPIC_MMSG_BATCH_SIZE;
 	rx_buffer_pool.freeList = NULL;
 
 	/* Initialize send control data */
@@ -3636,7 +3657,8 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		 " freebuf_avg %f "
 		 "mismatch_pkt_num %d disordered_pkt_num %d duplicated_pkt_num %d"
 		 " rtt/dev [" UINT64_FORMAT "/" UINT64_FORMAT ", %f/%f, " UINT64_FORMAT "/" UINT64_FORMAT "] "
-		 " cwnd %f status_query_msg_num %d",
+		 " cwnd %f status_query_msg_num %d"
+		 " snd_pkts_per_syscall %f recv_pkts_per_syscall %f",
 		 ic_control_info.isSender, isReceiver,
 		 Gp_interconnect_snd_queue_depth, Gp_interconnect_queue_depth, Gp_max_packet_size,
 		 UNACK_QUEUE_RING_SLOTS_NUM, TIMER_SPAN, DEFAULT_RTT,
@@ -3649,7 +3671,9 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		 (double) ((double) ic_statistics.totalBuffers) / ((double) ic_statistics.bufferCountingTime),
 		 ic_statistics.mismatchNum, ic_statistics.disorderedPktNum, ic_statistics.duplicatedPktNum,
 		 (minRtt == ~((uint64) 0) ? 0 : minRtt), (minDev == ~((uint64) 0) ? 0 : minDev), avgRtt, avgDev, maxRtt, maxDev,
-		 snd_control_info.cwnd, ic_statistics.statusQueryMsgNum);
+		 snd_control_info.cwnd, ic_statistics.statusQueryMsgNum,
+		 (double) ((double) ic_statistics.sndPktNum) / ((double) ic_statistics.sndSyscallNum),
+		 (double) ((double) ic_statistics.recvSyscallPktNum) / ((double) ic_statistics.recvSyscallNum));
 
 	ic_control_info.isSender = false;
 	memset(&ic_statistics, 0, sizeof(ICStatistics));
@@ -4617,6 +4641,119 @@ xmit_retry:
 	return;
 }
 
+/*
+ * sendBatch
+ * 		Send packets of a connection with as few syscalls as possible.
+ *
+ * The packets go out with sendmmsg() where it is available, and one by one
+ * with sendOnce() otherwise. Errors are handled like in sendOnce(): a full
+ * socket buffer or a packet dropped by iptables leaves the rest of the batch
+ * to the retransmit logic, as the packets are in the unack queue already.
+ */
+static void
+sendBatch(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer **bufs, int nbufs, MotionConn *conn)
+{
+#ifdef UDPIC_USE_MMSG
+	struct mmsghdr msgs[UDPIC_MMSG_BATCH_SIZE];
+	struct iovec iovs[UDPIC_MMSG_BATCH_SIZE];
+	int			nmsgs = 0;
+	int			sent = 0;
+#endif
+	int			i;
+
+	Assert(nbufs > 0 && nbufs <= UDPIC_MMSG_BATCH_SIZE);
+
+#ifdef UDPIC_USE_MMSG
+	if (nbufs > 1)
+	{
+		for (i = 0; i < nbufs; i++)
+		{
+#ifdef USE_ASSERT_CHECKING
+			if (testmode_inject_fault(gp_udpic_dropxmit_percent))
+			{
+#ifdef AMS_VERBOSE_LOGGING
+				write_log("THROW PKT with seq %d srcpid %d despid %d", bufs[i]->pkt->seq, bufs[i]->pkt->srcPid, bufs[i]->pkt->dstPid);
+#endif
+				continue;
+			}
+#endif
+			iovs[nmsgs].iov_base = bufs[i]->pkt;
+			iovs[nmsgs].iov_len = bufs[i]->pkt->len;
+
+			memset(&msgs[nmsgs], 0, sizeof(struct mmsghdr));
+			msgs[nmsgs].msg_hdr.msg_name = &conn->peer;
+			msgs[nmsgs].msg_hdr.msg_namelen = conn->peer_len;
+			msgs[nmsgs].msg_hdr.msg_iov = &iovs[nmsgs];
+			msgs[nmsgs].msg_hdr.msg_iovlen = 1;
+			nmsgs++;
+		}
+
+		/*
+		 * sendmmsg() stops at the first packet it fails to send, and reports
+		 * the error on the next call.
+		 */
+		while (sent < nmsgs)
+		{
+			int			n;
+
+			n = sendmmsg(pEntry->txfd, &msgs[sent], nmsgs - sent, 0);
+			if (n < 0)
+			{
+				int			save_errno = errno;
+
+				if (errno == EINTR)
+					continue;
+
+				if (errno == EAGAIN)	/* no space ? not an error. */
+					return;
+
+				/* See sendOnce() */
+				if (errno == EPERM)
+				{
+					ereport(LOG,
+							(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+							 errmsg("Interconnect error writing an outgoing packet: %m"),
+							 errdetail("error during sendmmsg() for Remote Connection: contentId=%d at %s",
+									   conn->remoteContentId, conn->remoteHostAndPort)));
+					return;
+				}
+
+				ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+								errmsg("Interconnect error writing an outgoing packet: %m"),
+								errdetail("error during sendmmsg() call (error:%d).\n"
+										  "For Remote Connection: contentId=%d at %s",
+										  save_errno, conn->remoteContentId,
+										  conn->remoteHostAndPort)));
+				/* not reached */
+			}
+
+			ic_statistics.sndSyscallNum++;
+
+			for (i = sent; i < sent + n; i++)
+			{
+				icpkthdr   *pkt = (icpkthdr *) iovs[i].iov_base;
+
+				if (msgs[i].msg_len != pkt->len && DEBUG1 >= log_min_messages)
+					write_log("Interconnect error writing an outgoing packet [seq %d]: short transmit (given %d sent %d) during sendmmsg() call."
+							  "For Remote Connection: contentId=%d at %s", pkt->seq, pkt->len, (int) msgs[i].msg_len,
+							  conn->remoteContentId,
+							  conn->remoteHostAndPort);
+			}
+
+			sent += n;
+		}
+
+		return;
+	}
+#endif
+
+	for (i = 0; i < nbufs; i++)
+	{
+		sendOnce(transportStates, pEntry, bufs[i], conn);
+		ic_statistics.sndSyscallNum++;
+	}
+}
+
 
 /*
  * handleStopMsgs
@@ -4726,6 +4863,9 @@ handleStopMsgs(ChunkTransportState *transportStates, ChunkTransportStateEntry *p
 static void
 sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn)
 {
+	ICBuffer   *batch[UDPIC_MMSG_BATCH_SIZE];
+	int			nbatch = 0;
+
 	while (conn->capacity > 0 && icBufferListLength(&conn->sndQueue) > 0)
 	{
 		ICBuffer   *buf = NULL;
@@ -4764,9 +4904,9 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 		}
 
 		/*
-		 * Note the place of sendOnce here. If we send before appending it to
+		 * Note the place of sendBatch here. If we send before appending it to
 		 * the unack queue and putting it into unack queue ring, and there is
-		 * a network error occurred in the sendOnce function, error message
+		 * a network error occurred in the sendBatch function, error message
 		 * will be output. In the time of error message output, interrupts is
 		 * potentially checked, if there is a pending query cancel, it will
 		 * lead to a dangled buffer (memory leak).
@@ -4775,7 +4915,7 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 		updateStats(TPE_DATA_PKT_SEND, conn, buf->pkt);
 #endif
 
-		sendOnce(transportStates, pEntry, buf, conn);
+		batch[nbatch++] = buf;
 		ic_statistics.sndPktNum++;
 
 #ifdef AMS_VERBOSE_LOGGING
@@ -4783,7 +4923,16 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 #endif
 
 		buf->conn->sentSeq = buf->pkt->seq;
+
+		if (nbatch == UDPIC_MMSG_BATCH_SIZE)
+		{
+			sendBatch(transportStates, pEntry, batch, nbatch, conn);
+			nbatch = 0;
+		}
 	}
+
+	if (nbatch > 0)
+		sendBatch(transportStates, pEntry, batch, nbatch, conn);
 }
 
 /*
@@ -6133,13 +6282,20 @@ handleDataPacket(MotionConn *conn, icpkthdr *pkt, struct sockaddr_storage *peer,
 static void *
 rxThreadFunc(void *arg)
 {
-	icpkthdr   *pkt = NULL;
+	icpkthdr   *pkts[UDPIC_MMSG_BATCH_SIZE];
+	struct sockaddr_storage peers[UDPIC_MMSG_BATCH_SIZE];
+	socklen_t	peerlens[UDPIC_MMSG_BATCH_SIZE];
+	int			readCounts[UDPIC_MMSG_BATCH_SIZE];
 	bool		skip_poll = false;
+	int			i;
+
+	memset(pkts, 0, sizeof(pkts));
 
 	for (;;)
 	{
 		struct pollfd nfd;
 		int			n;
+		int			nbufs;
 
 		/* check shutdown condition */
 		if (pg_atomic_read_u32(&ic_control_info.shutdown) == 1)
@@ -6151,18 +6307,33 @@ rxThreadFunc(void *arg)
 			break;
 		}
 
-		/* Try to get a buffer */
-		if (pkt == NULL)
+		/*
+		 * Try to get a buffer for every packet of the batch. The batch is
+		 * cut short where the pool runs out, we only need one to go on.
+		 */
+		for (nbufs = 0; nbufs < UDPIC_MMSG_BATCH_SIZE; nbufs++)
 		{
-			pthread_mutex_lock(&ic_control_info.lock);
-			pkt = getRxBuffer(&rx_buffer_pool);
-			pthread_mutex_unlock(&ic_control_info.lock);
+			if (pkts[nbufs] == NULL)
+				break;
+		}
 
-			if (pkt == NULL)
+		if (nbufs < UDPIC_MMSG_BATCH_SIZE)
+		{
+			pthread_mutex_lock(&ic_control_info.lock);
+			for (; nbufs < UDPIC_MMSG_BATCH_SIZE; nbufs++)
 			{
-				setRxThreadError(ENOMEM);
-				continue;
+				if (pkts[nbufs] == NULL)
+					pkts[nbufs] = getRxBuffer(&rx_buffer_pool);
+				if (pkts[nbufs] == NULL)
+					break;
 			}
+			pthread_mutex_unlock(&ic_control_info.lock);
+		}
+
+		if (nbufs == 0)
+		{
+			setRxThreadError(ENOMEM);
+			continue;
 		}
 
 		if (!skip_poll)
@@ -6208,15 +6379,7 @@ rxThreadFunc(void *arg)
 			/* we've got something interesting to read */
 			/* handle incoming */
 			/* ready to read on our socket */
-			MotionConn *conn = NULL;
-			int			read_count = 0;
-
-			struct sockaddr_storage peer;
-			socklen_t	peerlen;
-
-			peerlen = sizeof(peer);
-			read_count = recvfrom(UDP_listenerFd, (char *) pkt, Gp_max_packet_size, 0,
-								  (struct sockaddr *) &peer, &peerlen);
+			n = receivePackets(pkts, nbufs, peers, peerlens, readCounts);
 
 			if (pg_atomic_read_u32(&ic_control_info.shutdown) == 1)
 			{
@@ -6227,10 +6390,7 @@ rxThreadFunc(void *arg)
 				break;
 			}
 
-			if (DEBUG5 >= log_min_messages)
-				write_log("received inbound len %d", read_count);
-
-			if (read_count < 0)
+			if (n < 0)
 			{
 				skip_poll = false;
 
@@ -6251,12 +6411,8 @@ rxThreadFunc(void *arg)
 				continue;
 			}
 
-			if (read_count < sizeof(icpkthdr))
-			{
-				if (DEBUG1 >= log_min_messages)
-					write_log("Interconnect error: short conn receive (%d)", read_count);
-				continue;
-			}
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.recvSyscallNum, 1);
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.recvSyscallPktNum, n);
 
 			/*
 			 * when we get a "good" recvfrom() result, we can skip poll()
@@ -6264,113 +6420,196 @@ rxThreadFunc(void *arg)
 			 */
 			skip_poll = true;
 
-			/* length must be >= 0 */
-			if (pkt->len < 0)
+			for (i = 0; i < n; i++)
 			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound with negative length");
-				continue;
-			}
+				if (DEBUG5 >= log_min_messages)
+					write_log("received inbound len %d", readCounts[i]);
 
-			if (pkt->len != read_count)
-			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
-				continue;
+				if (handleRxPacket(pkts[i], readCounts[i], &peers[i], peerlens[i]))
+					pkts[i] = NULL;
 			}
+		}
 
-			/*
-			 * check the CRC of the payload.
-			 */
-			if (gp_interconnect_full_crc)
-			{
-				if (!checkCRC(pkt))
-				{
-					pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.crcErrors, 1);
-					if (DEBUG2 >= log_min_messages)
-						write_log("received network data error, dropping bad packet, user data unaffected.");
-					continue;
-				}
-			}
+		/* pthread_yield(); */
+	}
 
-#ifdef AMS_VERBOSE_LOGGING
-			logPkt("GOT MESSAGE", pkt);
+	/* Before return, we release the packets. */
+	pthread_mutex_lock(&ic_control_info.lock);
+	for (i = 0; i < UDPIC_MMSG_BATCH_SIZE; i++)
+	{
+		if (pkts[i])
+		{
+			freeRxBuffer(&rx_buffer_pool, pkts[i]);
+			pkts[i] = NULL;
+		}
+	}
+	pthread_mutex_unlock(&ic_control_info.lock);
+
+	/* nothing to return */
+	return NULL;
+}
+
+/*
+ * receivePackets
+ * 		Called by rx thread to receive up to npkts packets into the given
+ * 		buffers.
+ *
+ * Returns the number of packets received, or -1 with errno set. The length
+ * and the sender of every packet are returned in readCounts and peers.
+ */
+static int
+receivePackets(icpkthdr **pkts, int npkts, struct sockaddr_storage *peers, socklen_t *peerlens, int *readCounts)
+{
+#ifdef UDPIC_USE_MMSG
+	struct mmsghdr msgs[UDPIC_MMSG_BATCH_SIZE];
+	struct iovec iovs[UDPIC_MMSG_BATCH_SIZE];
+	int			i;
+	int			n;
+
+	Assert(npkts > 0 && npkts <= UDPIC_MMSG_BATCH_SIZE);
+
+	for (i = 0; i < npkts; i++)
+	{
+		iovs[i].iov_base = pkts[i];
+		iovs[i].iov_len = Gp_max_packet_size;
+
+		memset(&msgs[i], 0, sizeof(struct mmsghdr));
+		msgs[i].msg_hdr.msg_name = &peers[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* the socket is non-blocking, this returns whatever is queued */
+	n = recvmmsg(UDP_listenerFd, msgs, npkts, 0, NULL);
+
+	for (i = 0; i < n; i++)
+	{
+		peerlens[i] = msgs[i].msg_hdr.msg_namelen;
+		readCounts[i] = msgs[i].msg_len;
+	}
+
+	return n;
+#else
+	Assert(npkts > 0);
+
+	peerlens[0] = sizeof(struct sockaddr_storage);
+	readCounts[0] = recvfrom(UDP_listenerFd, (char *) pkts[0], Gp_max_packet_size, 0,
+							 (struct sockaddr *) &peers[0], &peerlens[0]);
+
+	return readCounts[0] < 0 ? -1 : 1;
 #endif
+}
 
-			bool		wakeup_mainthread = false;
-			AckSendParam param;
+/*
+ * handleRxPacket
+ * 		Called by rx thread to handle a packet read from the socket.
+ *
+ * Returns true if the packet buffer is kept by the interconnect, and the
+ * caller needs a new one.
+ */
+static bool
+handleRxPacket(icpkthdr *pkt, int read_count, struct sockaddr_storage *peer, socklen_t peerlen)
+{
+	MotionConn *conn = NULL;
+	bool		wakeup_mainthread = false;
+	bool		consumed = false;
+	AckSendParam param;
 
-			memset(&param, 0, sizeof(AckSendParam));
+	if (read_count < sizeof(icpkthdr))
+	{
+		if (DEBUG1 >= log_min_messages)
+			write_log("Interconnect error: short conn receive (%d)", read_count);
+		return false;
+	}
 
-			/*
-			 * Get the connection for the pkt.
-			 *
-			 * The connection hash table should be locked until finishing the
-			 * processing of the packet to avoid the connection
-			 * addition/removal from the hash table during the mean time.
-			 */
+	/* length must be >= 0 */
+	if (pkt->len < 0)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound with negative length");
+		return false;
+	}
 
-			pthread_mutex_lock(&ic_control_info.lock);
-			conn = findConnByHeader(&ic_control_info.connHtab, pkt);
+	if (pkt->len != read_count)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
+		return false;
+	}
 
-			if (conn != NULL)
-			{
-				/* Handling a regular packet */
-				if (handleDataPacket(conn, pkt, &peer, &peerlen, &param, &wakeup_mainthread))
-					pkt = NULL;
-				ic_statistics.recvPktNum++;
-			}
-			else
-			{
-				/*
-				 * There may have two kinds of Mismatched packets: a) Past
-				 * packets from previous command after I was torn down b)
-				 * Future packets from current command before my connections
-				 * are built.
-				 *
-				 * The handling logic is to "Ack the past and Nak the future".
-				 */
-				if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
-				{
-					if (DEBUG1 >= log_min_messages)
-						write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
+	/*
+	 * check the CRC of the payload.
+	 */
+	if (gp_interconnect_full_crc)
+	{
+		if (!checkCRC(pkt))
+		{
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.crcErrors, 1);
+			if (DEBUG2 >= log_min_messages)
+				write_log("received network data error, dropping bad packet, user data unaffected.");
+			return false;
+		}
+	}
 
 #ifdef AMS_VERBOSE_LOGGING
-					logPkt("Got a Mismatched Packet", pkt);
+	logPkt("GOT MESSAGE", pkt);
 #endif
 
-					if (handleMismatch(pkt, &peer, peerlen))
-						pkt = NULL;
-					ic_statistics.mismatchNum++;
-				}
-			}
-			pthread_mutex_unlock(&ic_control_info.lock);
+	memset(&param, 0, sizeof(AckSendParam));
 
-			if (wakeup_mainthread)
-				SetLatch(&ic_control_info.latch);
+	/*
+	 * Get the connection for the pkt.
+	 *
+	 * The connection hash table should be locked until finishing the
+	 * processing of the packet to avoid the connection addition/removal from
+	 * the hash table during the mean time.
+	 */
 
-			/*
-			 * real ack sending is after lock release to decrease the lock
-			 * holding time.
-			 */
-			if (param.msg.len != 0)
-				sendAckWithParam(&param);
-		}
+	pthread_mutex_lock(&ic_control_info.lock);
+	conn = findConnByHeader(&ic_control_info.connHtab, pkt);
 
-		/* pthread_yield(); */
+	if (conn != NULL)
+	{
+		/* Handling a regular packet */
+		consumed = handleDataPacket(conn, pkt, peer, &peerlen, &param, &wakeup_mainthread);
+		ic_statistics.recvPktNum++;
 	}
-
-	/* Before return, we release the packet. */
-	if (pkt)
+	else
 	{
-		pthread_mutex_lock(&ic_control_info.lock);
-		freeRxBuffer(&rx_buffer_pool, pkt);
-		pkt = NULL;
-		pthread_mutex_unlock(&ic_control_info.lock);
+		/*
+		 * There may have two kinds of Mismatched packets: a) Past packets
+		 * from previous command after I was torn down b) Future packets from
+		 * current command before my connections are built.
+		 *
+		 * The handling logic is to "Ack the past and Nak the future".
+		 */
+		if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
+		{
+			if (DEBUG1 >= log_min_messages)
+				write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
+
+#ifdef AMS_VERBOSE_LOGGING
+			logPkt("Got a Mismatched Packet", pkt);
+#endif
+
+			consumed = handleMismatch(pkt, peer, peerlen);
+			ic_statistics.mismatchNum++;
+		}
 	}
+	pthread_mutex_unlock(&ic_control_info.lock);
 
-	/* nothing to return */
-	return NULL;
+	if (wakeup_mainthread)
+		SetLatch(&ic_control_info.latch);
+
+	/*
+	 * real ack sending is after lock release to decrease the lock holding
+	 * time.
+	 */
+	if (param.msg.len != 0)
+		sendAckWithParam(&param);
+
+	return consumed;
 }
 
 /*
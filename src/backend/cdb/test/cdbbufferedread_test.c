@@ -84,6 +84,46 @@ test__BufferedReadUseBeforeBuffer__IsNextReadLenZero(void **state)
 	PG_END_TRY();	
 }
 
+static void
+test__BufferedReadSetFile__PrefetchesNextLargeRead(void **state)
+{
+	BufferedRead *bufferedRead = palloc(sizeof(BufferedRead));
+	int32 maxBufferLen = 128;
+	int32 maxLargeReadLen = 128;
+	int32 memoryLen = maxBufferLen + maxLargeReadLen;
+	uint8 *memory = malloc(memoryLen);
+	char *relname = "test";
+	File file = 1;
+
+	memset(bufferedRead, 0 , sizeof(BufferedRead));
+	BufferedReadInit(bufferedRead, memory, memoryLen, maxBufferLen, maxLargeReadLen, relname);
+	effective_io_concurrency = 1;
+
+	/* The first large read covers [0, 128) */
+	expect_value(FileRead, file, file);
+	expect_any(FileRead, buffer);
+	expect_value(FileRead, amount, maxLargeReadLen);
+	expect_value(FileRead, offset, 0);
+	expect_any(FileRead, wait_event_info);
+	will_return(FileRead, maxLargeReadLen);
+
+#ifdef USE_PREFETCH
+	/* and the next one, [128, 256), is prefetched right away */
+	expect_value(FilePrefetch, file, file);
+	expect_value(FilePrefetch, offset, 128);
+	expect_value(FilePrefetch, amount, maxLargeReadLen);
+	expect_value(FilePrefetch, wait_event_info, WAIT_EVENT_DATA_FILE_PREFETCH);
+	will_return(FilePrefetch, 0);
+#endif
+
+	BufferedReadSetFile(bufferedRead, file, "test_file", 300);
+
+	assert_int_equal(bufferedRead->largeReadLen, maxLargeReadLen);
+#ifdef USE_PREFETCH
+	assert_true(bufferedRead->prefetchPosition == 256);
+#endif
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -91,7 +131,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] = {
 		unit_test(test__BufferedReadUseBeforeBuffer__IsNextReadLenZero),
-		unit_test(test__BufferedReadInit__IsConsistent)
+		unit_test(test__BufferedReadInit__IsConsistent),
+		unit_test(test__BufferedReadSetFile__PrefetchesNextLargeRead)
 	};
 
 	MemoryContextInit();
@@ -81,6 +81,8 @@ static void ExplainDXL(Query *query, ExplainState *es,
 							ParamListInfo params);
 #endif
 
+static void ExplainPrintOptimizerProfile(ExplainState *es,
+										 OptimizerProfile *profile);
 static double elapsed_time(instr_time *starttime);
 static bool ExplainPreScanNode(PlanState *planstate, Bitmapset **rels_used);
 static void ExplainNode(PlanState *planstate, List *ancestors,
@@ -253,6 +255,12 @@ ExplainQuery(ParseState *pstate, ExplainStmt *stmt, const char *queryString,
 	/* if the summary was not set explicitly, set default value */
 	es->summary = (summary_set) ? es->summary : es->analyze;
 
+	/*
+	 * The optimizer profile is only printed on explicit request, not with the
+	 * summary that ANALYZE turns on by default.
+	 */
+	es->optimizer_profile = summary_set && es->summary && es->verbose;
+
 	if (explain_memory_verbosity >= EXPLAIN_MEMORY_VERBOSITY_DETAIL)
 		es->memory_detail = true;
 
@@ -675,6 +683,11 @@ ExplainOnePlan(PlannedStmt *plannedstmt, IntoClause *into, ExplainState *es,
 		ExplainPropertyFloat("Planning Time", "ms", 1000.0 * plantime, 3, es);
 	}
 
+	/* Print where GPORCA spent the planning time */
+	if (es->optimizer_profile && queryDesc->plannedstmt->optimizerProfile)
+		ExplainPrintOptimizerProfile(es,
+									 queryDesc->plannedstmt->optimizerProfile);
+
 	/* Print slice table */
 	if (es->slicetable)
 		ExplainPrintSliceTable(es, queryDesc);
@@ -1012,6 +1025,118 @@ ExplainPrintTriggers(ExplainState *es, QueryDesc *queryDesc)
 	ExplainCloseGroup("Triggers", "Triggers", false, es);
 }
 
+/*
+ * ExplainPrintOptimizerProfile -
+ *	  Append where GPORCA spent its time planning the query to es->str.
+ */
+static void
+ExplainPrintOptimizerProfile(ExplainState *es, OptimizerProfile *profile)
+{
+	int			mdLookups = profile->mdCacheHits + profile->mdCacheMisses;
+	double		mdHitRatio = 0.0;
+
+	if (mdLookups > 0)
+		mdHitRatio = (double) profile->mdCacheHits / mdLookups;
+
+	ExplainOpenGroup("Optimizer Profile", "Optimizer Profile", true, es);
+
+	/* for higher density, open code the text output format */
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfoString(es->str, "Optimizer Profile:\n");
+		es->indent += 1;
+
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str,
+						 "Phases: %s %.3f ms, %s %.3f ms, %s %.3f ms, %s %.3f ms, %s %.3f ms, %s %.3f ms, %s %.3f ms\n",
+						 "Query Translation", profile->translateTime,
+						 "Preprocessing", profile->preprocessTime,
+						 "Exploration", profile->exploreTime,
+						 "Statistics Derivation", profile->statsTime,
+						 "Implementation", profile->implementTime,
+						 "Optimization", profile->optimizeTime,
+						 "Plan Translation", profile->planTime);
+
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str,
+						 "Metadata: %s %.3f ms, %s %d, %s %d, %s %.3f\n",
+						 "Fetch", profile->mdFetchTime,
+						 "Cache Hits", profile->mdCacheHits,
+						 "Cache Misses", profile->mdCacheMisses,
+						 "Cache Hit Ratio", mdHitRatio);
+
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str, "Memo: %s %d, %s %d, %s %d\n",
+						 "Groups", profile->memoGroups,
+						 "Group Expressions", profile->memoGroupExprs,
+						 "Search Stages", profile->searchStages);
+
+		if (profile->numXforms > 0)
+		{
+			appendStringInfoSpaces(es->str, es->indent * 2);
+			appendStringInfoString(es->str, "Xforms:");
+			for (int i = 0; i < profile->numXforms; i++)
+				appendStringInfo(es->str, "%s %s %.3f ms (%d calls)",
+								 i > 0 ? "," : "",
+								 profile->xformNames[i],
+								 profile->xformTimes[i],
+								 profile->xformCalls[i]);
+			appendStringInfoChar(es->str, '\n');
+		}
+
+		es->indent -= 1;
+	}
+	else
+	{
+		ExplainOpenGroup("Phases", "Phases", true, es);
+		ExplainPropertyFloat("Query Translation", "ms",
+							 profile->translateTime, 3, es);
+		ExplainPropertyFloat("Preprocessing", "ms",
+							 profile->preprocessTime, 3, es);
+		ExplainPropertyFloat("Exploration", "ms",
+							 profile->exploreTime, 3, es);
+		ExplainPropertyFloat("Statistics Derivation", "ms",
+							 profile->statsTime, 3, es);
+		ExplainPropertyFloat("Implementation", "ms",
+							 profile->implementTime, 3, es);
+		ExplainPropertyFloat("Optimization", "ms",
+							 profile->optimizeTime, 3, es);
+		ExplainPropertyFloat("Plan Translation", "ms",
+							 profile->planTime, 3, es);
+		ExplainCloseGroup("Phases", "Phases", true, es);
+
+		ExplainOpenGroup("Metadata", "Metadata", true, es);
+		ExplainPropertyFloat("Fetch", "ms", profile->mdFetchTime, 3, es);
+		ExplainPropertyInteger("Cache Hits", NULL, profile->mdCacheHits, es);
+		ExplainPropertyInteger("Cache Misses", NULL, profile->mdCacheMisses,
+							   es);
+		ExplainPropertyFloat("Cache Hit Ratio", NULL, mdHitRatio, 3, es);
+		ExplainCloseGroup("Metadata", "Metadata", true, es);
+
+		ExplainOpenGroup("Memo", "Memo", true, es);
+		ExplainPropertyInteger("Groups", NULL, profile->memoGroups, es);
+		ExplainPropertyInteger("Group Expressions", NULL,
+							   profile->memoGroupExprs, es);
+		ExplainPropertyInteger("Search Stages", NULL, profile->searchStages,
+							   es);
+		ExplainCloseGroup("Memo", "Memo", true, es);
+
+		ExplainOpenGroup("Xforms", "Xforms", false, es);
+		for (int i = 0; i < profile->numXforms; i++)
+		{
+			ExplainOpenGroup("Xform", NULL, true, es);
+			ExplainPropertyText("Name", profile->xformNames[i], es);
+			ExplainPropertyFloat("Time", "ms", profile->xformTimes[i], 3, es);
+			ExplainPropertyInteger("Calls", NULL, profile->xformCalls[i], es);
+			ExplainCloseGroup("Xform", NULL, true, es);
+		}
+		ExplainCloseGroup("Xforms", "Xforms", false, es);
+	}
+
+	ExplainCloseGroup("Optimizer Profile", "Optimizer Profile", true, es);
+}
+
 /*
  * ExplainPrintJITSummary -
  *    Print summarized JIT instrumentation from leader and workers
@@ -2191,6 +2316,10 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (plan->qual)
 				show_instrumentation_count("Rows Removed by Filter", 1,
 										   planstate, es);
+			if (IsA(planstate, SeqScanState) &&
+				((SeqScanState *) planstate)->runtime_filter)
+				show_instrumentation_count("Rows Removed by Runtime Filter", 2,
+										   planstate, es);
 			break;
 		case T_Gather:
 			{
@@ -654,6 +654,8 @@ ExplainExecuteQuery(ExecuteStmt *execstmt, IntoClause *into, ExplainState *es,
 	EState	   *estate = NULL;
 	instr_time	planstart;
 	instr_time	planduration;
+	int			generation;
+	bool		optimizer_profile = es->optimizer_profile;
 
 	INSTR_TIME_SET_CURRENT(planstart);
 
@@ -701,11 +703,19 @@ ExplainExecuteQuery(ExecuteStmt *execstmt, IntoClause *into, ExplainState *es,
 	}
 
 	/* Replan if needed, and acquire a transient refcount */
+	generation = entry->plansource->generation;
 	cplan = GetCachedPlan(entry->plansource, paramLI, true, queryEnv, into);
 
 	INSTR_TIME_SET_CURRENT(planduration);
 	INSTR_TIME_SUBTRACT(planduration, planstart);
 
+	/*
+	 * If the plan came from the cache, its optimizer profile is about an
+	 * earlier planning, not about the planning time shown here; omit it.
+	 */
+	if (entry->plansource->generation == generation)
+		es->optimizer_profile = false;
+
 	plan_list = cplan->stmt_list;
 
 	/* Explain each query */
@@ -727,6 +737,8 @@ ExplainExecuteQuery(ExecuteStmt *execstmt, IntoClause *into, ExplainState *es,
 			ExplainSeparatePlans(es);
 	}
 
+	es->optimizer_profile = optimizer_profile;
+
 	if (estate)
 		FreeExecutorState(estate);
 
@@ -37,6 +37,7 @@
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "lib/bloomfilter.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "port/atomics.h"
@@ -75,6 +76,11 @@ static HashJoinTuple ExecParallelHashTupleAlloc(HashJoinTable hashtable,
 												size_t size,
 												dsa_pointer *shared);
 static void MultiExecPrivateHash(HashState *node);
+static void RuntimeFilterReset(HashState *node, HashJoinTable hashtable);
+static void RuntimeFilterAdd(HashState *node, ExprContext *econtext,
+							 uint32 hashvalue);
+static void RuntimeFilterFinish(RuntimeFilterState *filter);
+static int64 RuntimeFilterInt64(Datum value, Oid typid);
 static void MultiExecParallelHash(HashState *node);
 static inline HashJoinTuple ExecParallelHashFirstTuple(HashJoinTable table,
 													   int bucketno);
@@ -173,6 +179,9 @@ MultiExecPrivateHash(HashState *node)
 
 	SIMPLE_FAULT_INJECTOR("multi_exec_hash_large_vmem");
 
+	if (node->runtime_filter)
+		RuntimeFilterReset(node, hashtable);
+
 	/*
 	 * get all inner tuples and insert into the hash table (or temp files)
 	 */
@@ -206,6 +215,9 @@ MultiExecPrivateHash(HashState *node)
 				ExecHashTableInsert(node, hashtable, slot, hashvalue);
 			}
 			hashtable->totalTuples += 1;
+
+			if (node->runtime_filter)
+				RuntimeFilterAdd(node, econtext, hashvalue);
 		}
 
 		if (hashkeys_null)
@@ -219,6 +231,9 @@ MultiExecPrivateHash(HashState *node)
 		}
 	}
 
+	if (node->runtime_filter)
+		RuntimeFilterFinish(node->runtime_filter);
+
 	/* Now we have set up all the initial batches & primary overflow batches. */
 	hashtable->nbatch_outstart = hashtable->nbatch;
 
@@ -234,6 +249,211 @@ MultiExecPrivateHash(HashState *node)
 	hashtable->partialTuples = hashtable->totalTuples;
 }
 
+/*
+ * GPDB: Fraction of the bits of a Bloom filter set, above which it is
+ * too likely to let rows through to be worth probing.
+ */
+#define RUNTIME_FILTER_MAX_BITS_SET		0.5
+
+/*
+ * GPDB: Percentage of the memory of the hash table that the Bloom filter of
+ * a runtime filter may take.  bloom_create() never allocates less than 1MB.
+ */
+#define RUNTIME_FILTER_MEM_PERCENT		10
+#define RUNTIME_FILTER_MIN_BLOOM_SIZE	(1024L * 1024L)
+
+/*
+ * RuntimeFilterReset
+ *		Start building the runtime filter over a new set of inner rows, to
+ *		be inserted into the given hash table
+ *
+ * The Bloom filter is counted in the memory of the hash table, as the skew
+ * buckets are: the space it takes is no longer allowed for the inner rows,
+ * which spill to more batches if need be.  Without room for the smallest
+ * Bloom filter, only the range of the first key is tracked.
+ */
+static void
+RuntimeFilterReset(HashState *node, HashJoinTable hashtable)
+{
+	RuntimeFilterState *filter = node->runtime_filter;
+	double		ntuples = Max(node->ps.plan->plan_rows, 1.0);
+	Size		bloom_space;
+
+	if (filter->bloom)
+		bloom_free(filter->bloom);
+	filter->bloom = NULL;
+
+	bloom_space = hashtable->spaceAllowed * RUNTIME_FILTER_MEM_PERCENT / 100;
+	if (bloom_space >= RUNTIME_FILTER_MIN_BLOOM_SIZE)
+	{
+		MemoryContext oldcxt;
+		int			bloom_work_mem;
+
+		bloom_work_mem = (int) Min(bloom_space / 1024L, (Size) INT_MAX);
+
+		/* as much as bloom_create() allocates at most for that many rows */
+		bloom_space = (Size) Min((double) bloom_work_mem * 1024L, ntuples * 2);
+		bloom_space = Max(bloom_space, RUNTIME_FILTER_MIN_BLOOM_SIZE);
+		hashtable->spaceAllowed -= bloom_space;
+
+		/* the filter outlives the current tuple, as the state it belongs to */
+		oldcxt = MemoryContextSwitchTo(GetMemoryChunkContext(filter));
+		filter->bloom = bloom_create((int64) ntuples, bloom_work_mem, 0);
+		MemoryContextSwitchTo(oldcxt);
+	}
+
+	filter->has_range = false;
+	filter->built = false;
+}
+
+/*
+ * RuntimeFilterAdd
+ *		Add the inner row in econtext, with the given hash value
+ */
+static void
+RuntimeFilterAdd(HashState *node, ExprContext *econtext, uint32 hashvalue)
+{
+	RuntimeFilterState *filter = node->runtime_filter;
+
+	if (filter->bloom)
+		bloom_add_element(filter->bloom, (unsigned char *) &hashvalue,
+						  sizeof(hashvalue));
+
+	if (OidIsValid(filter->range_types[0]))
+	{
+		ExprState  *keyexpr = (ExprState *) linitial(node->hashkeys);
+		Datum		keyval;
+		bool		isnull;
+		int64		value;
+
+		keyval = ExecEvalExpr(keyexpr, econtext, &isnull);
+		if (isnull)
+			return;
+
+		value = RuntimeFilterInt64(keyval, filter->range_types[0]);
+		if (!filter->has_range)
+		{
+			filter->min = filter->max = value;
+			filter->has_range = true;
+		}
+		else if (value < filter->min)
+			filter->min = value;
+		else if (value > filter->max)
+			filter->max = value;
+	}
+}
+
+/*
+ * RuntimeFilterFinish
+ *		Make the runtime filter available to the outer scan, once all the
+ *		inner rows have been added
+ */
+static void
+RuntimeFilterFinish(RuntimeFilterState *filter)
+{
+	/*
+	 * With more inner rows than estimated, the Bloom filter may let most
+	 * outer rows through, and only cost hashing them.  The range is still
+	 * worth checking.
+	 */
+	if (filter->bloom &&
+		bloom_prop_bits_set(filter->bloom) > RUNTIME_FILTER_MAX_BITS_SET)
+	{
+		bloom_free(filter->bloom);
+		filter->bloom = NULL;
+	}
+
+	filter->built = true;
+}
+
+static int64
+RuntimeFilterInt64(Datum value, Oid typid)
+{
+	switch (typid)
+	{
+		case INT2OID:
+			return (int64) DatumGetInt16(value);
+		case INT4OID:
+			return (int64) DatumGetInt32(value);
+		case INT8OID:
+			return DatumGetInt64(value);
+		default:
+			elog(ERROR, "unexpected runtime filter key type: %u", typid);
+	}
+	return 0;					/* keep compiler quiet */
+}
+
+/*
+ * ExecRuntimeFilterRejects
+ *		Can the scanned row in slot be dropped, as it cannot find a match
+ *		among the inner rows of the hash join the filter was built from?
+ *
+ * The hash value of the row is computed as ExecHashGetHashValue() does for
+ * outer rows, so a row with a match always passes.  Before the filter is
+ * built, every row passes.  Memory is allocated in the per-tuple context of
+ * econtext.
+ */
+bool
+ExecRuntimeFilterRejects(RuntimeFilterState *filter, TupleTableSlot *slot,
+						 ExprContext *econtext)
+{
+	MemoryContext oldcxt;
+	uint32		hashkey = 0;
+	bool		rejects = false;
+	int			i;
+
+	if (!filter->built)
+		return false;
+
+	oldcxt = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	for (i = 0; i < filter->nkeys; i++)
+	{
+		Datum		keyval;
+		bool		isnull;
+
+		/* rotate hashkey left 1 bit at each step */
+		hashkey = (hashkey << 1) | ((hashkey & 0x80000000) ? 1 : 0);
+
+		keyval = slot_getattr(slot, filter->scan_attnos[i], &isnull);
+		if (isnull)
+		{
+			/* a strict join operator never matches a null */
+			if (filter->hashStrict[i])
+			{
+				rejects = true;
+				break;
+			}
+			continue;
+		}
+
+		if (i == 0 && filter->has_range)
+		{
+			int64		value = RuntimeFilterInt64(keyval,
+												   filter->range_types[1]);
+
+			if (value < filter->min || value > filter->max)
+			{
+				rejects = true;
+				break;
+			}
+		}
+
+		if (filter->bloom)
+			hashkey ^= DatumGetUInt32(FunctionCall1Coll(&filter->hashfunctions[i],
+														filter->collations[i],
+														keyval));
+	}
+
+	if (!rejects && filter->bloom)
+		rejects = bloom_lacks_element(filter->bloom, (unsigned char *) &hashkey,
+									  sizeof(hashkey));
+
+	MemoryContextSwitchTo(oldcxt);
+
+	return rejects;
+}
+
 /* ----------------------------------------------------------------
  *		MultiExecParallelHash
  *
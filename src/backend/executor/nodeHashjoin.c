@@ -110,13 +110,17 @@
 
 #include "access/htup_details.h"
 #include "access/parallel.h"
+#include "catalog/pg_type.h"
 #include "executor/executor.h"
 #include "executor/hashjoin.h"
 #include "executor/instrument.h"	/* Instrumentation */
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
 #include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "parser/parsetree.h"
 #include "pgstat.h"
+#include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/sharedtuplestore.h"
 
@@ -153,6 +157,9 @@ static TupleTableSlot *ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 												 TupleTableSlot *tupleSlot);
 static bool ExecHashJoinNewBatch(HashJoinState *hjstate);
 static bool isNotDistinctJoin(List *qualList);
+static void ExecHashJoinInitRuntimeFilter(HashJoinState *hjstate,
+										  HashJoin *node);
+static bool IsRuntimeFilterRangeType(Oid typid);
 static bool ExecParallelHashJoinNewBatch(HashJoinState *hjstate);
 static void ExecParallelHashJoinPartitionOuter(HashJoinState *node);
 
@@ -950,9 +957,108 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	hjstate->hj_MatchedOuter = false;
 	hjstate->hj_OuterNotEmpty = false;
 
+	if (gp_enable_runtime_filter)
+		ExecHashJoinInitRuntimeFilter(hjstate, node);
+
 	return hjstate;
 }
 
+/*
+ * ExecHashJoinInitRuntimeFilter
+ *		Set up a runtime filter, built by the Hash node and applied by the
+ *		Seq Scan on the outer side
+ *
+ * Only outer rows without a match are dropped, so the join must drop them
+ * too.  Every outer hash key must be a column of the scan, for the scan to
+ * compute the hash value of its rows before projecting them.
+ */
+static void
+ExecHashJoinInitRuntimeFilter(HashJoinState *hjstate, HashJoin *node)
+{
+	Plan	   *scanplan = outerPlan(node);
+	RuntimeFilterState *filter;
+	OpExpr	   *firstclause;
+	Oid			innertype;
+	Oid			outertype;
+	ListCell   *l;
+	int			i;
+
+	if (node->join.jointype != JOIN_INNER &&
+		node->join.jointype != JOIN_SEMI &&
+		node->join.jointype != JOIN_RIGHT)
+		return;
+
+	if (hjstate->hj_nonequijoin ||
+		!IsA(outerPlanState(hjstate), SeqScanState))
+		return;
+
+	filter = (RuntimeFilterState *) palloc0(sizeof(RuntimeFilterState));
+	filter->nkeys = list_length(node->hashclauses);
+	filter->scan_attnos = (AttrNumber *)
+		palloc(filter->nkeys * sizeof(AttrNumber));
+	filter->hashfunctions = (FmgrInfo *)
+		palloc(filter->nkeys * sizeof(FmgrInfo));
+	filter->collations = (Oid *) palloc(filter->nkeys * sizeof(Oid));
+	filter->hashStrict = (bool *) palloc(filter->nkeys * sizeof(bool));
+
+	i = 0;
+	foreach(l, node->hashclauses)
+	{
+		OpExpr	   *hclause = lfirst_node(OpExpr, l);
+		Expr	   *outerkey = (Expr *) linitial(hclause->args);
+		TargetEntry *tle;
+		Oid			left_hashfn;
+		Oid			right_hashfn;
+
+		while (IsA(outerkey, RelabelType))
+			outerkey = ((RelabelType *) outerkey)->arg;
+		if (!IsA(outerkey, Var) || ((Var *) outerkey)->varno != OUTER_VAR)
+			return;
+
+		tle = get_tle_by_resno(scanplan->targetlist,
+							   ((Var *) outerkey)->varattno);
+		if (tle == NULL)
+			return;
+
+		outerkey = tle->expr;
+		while (IsA(outerkey, RelabelType))
+			outerkey = ((RelabelType *) outerkey)->arg;
+		if (!IsA(outerkey, Var) ||
+			((Var *) outerkey)->varno != ((Scan *) scanplan)->scanrelid ||
+			((Var *) outerkey)->varattno <= 0)
+			return;
+
+		if (!get_op_hash_functions(hclause->opno, &left_hashfn, &right_hashfn))
+			return;
+
+		filter->scan_attnos[i] = ((Var *) outerkey)->varattno;
+		fmgr_info(left_hashfn, &filter->hashfunctions[i]);
+		filter->collations[i] = hclause->inputcollid;
+		filter->hashStrict[i] = op_strict(hclause->opno);
+		i++;
+	}
+
+	/* track the range of the first key, if both of its sides are integers */
+	firstclause = linitial_node(OpExpr, node->hashclauses);
+	outertype = exprType(linitial(firstclause->args));
+	innertype = exprType(lsecond(firstclause->args));
+	if (IsRuntimeFilterRangeType(outertype) &&
+		IsRuntimeFilterRangeType(innertype))
+	{
+		filter->range_types[0] = innertype;
+		filter->range_types[1] = outertype;
+	}
+
+	((SeqScanState *) outerPlanState(hjstate))->runtime_filter = filter;
+	((HashState *) innerPlanState(hjstate))->runtime_filter = filter;
+}
+
+static bool
+IsRuntimeFilterRangeType(Oid typid)
+{
+	return typid == INT2OID || typid == INT4OID || typid == INT8OID;
+}
+
 /* ----------------------------------------------------------------
  *		ExecEndHashJoin
  *
@@ -1668,6 +1774,18 @@ ExecReScanHashJoin(HashJoinState *node)
 		}
 	}
 
+	/*
+	 * GPDB: Until the hash table is built again, the runtime filter describes
+	 * the old inner rows, and must not be applied to the new outer ones.
+	 */
+	if (node->hj_HashTable == NULL)
+	{
+		HashState  *hashState = (HashState *) innerPlanState(node);
+
+		if (hashState->runtime_filter)
+			hashState->runtime_filter->built = false;
+	}
+
 	/* Always reset intra-tuple state */
 	node->hj_CurHashValue = 0;
 	node->hj_CurBucketNo = 0;
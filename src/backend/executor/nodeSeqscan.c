@@ -30,6 +30,8 @@
 #include "access/relscan.h"
 #include "access/tableam.h"
 #include "executor/execdebug.h"
+#include "executor/instrument.h"
+#include "executor/nodeHash.h"
 #include "executor/nodeSeqscan.h"
 #include "utils/rel.h"
 #include "nodes/nodeFuncs.h"
@@ -82,10 +84,20 @@ SeqNext(SeqScanState *node)
 	}
 
 	/*
-	 * get the next tuple from the table
+	 * get the next tuple from the table, skipping those that the runtime
+	 * filter of the hash join above knows cannot join
 	 */
-	if (table_scan_getnextslot(scandesc, direction, slot))
-		return slot;
+	while (table_scan_getnextslot(scandesc, direction, slot))
+	{
+		if (node->runtime_filter == NULL ||
+			!ExecRuntimeFilterRejects(node->runtime_filter, slot,
+									  node->ss.ps.ps_ExprContext))
+			return slot;
+
+		/* counted apart from the rows removed by the qual */
+		InstrCountFiltered2(node, 1);
+		ResetExprContext(node->ss.ps.ps_ExprContext);
+	}
 	return NULL;
 }
 
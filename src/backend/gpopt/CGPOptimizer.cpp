@@ -195,6 +195,8 @@ CGPOptimizer::InitGPOPT()
 	gpos_init(&params);
 	gpdxl_init();
 	gpopt_init();
+
+	gpdb::InitMDCacheInvalidation();
 }
 
 //---------------------------------------------------------------------------
@@ -278,7 +278,19 @@ CConfigParamMapping::SConfigMappingElem CConfigParamMapping::m_elements[] = {
 	{EopttraceAllowGeneralPredicatesforDPE,
 	 &optimizer_enable_range_predicate_dpe,
 	 false,	 // m_negate_param
-	 GPOS_WSZ_LIT("Enable range predicates for dynamic partition elimination.")}
+	 GPOS_WSZ_LIT("Enable range predicates for dynamic partition elimination.")},
+	{EopttraceEnablePlanCache, &optimizer_plan_caching,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT("Cache optimized plans and reuse them for queries "
+				  "differing in constants only.")},
+	{EopttraceEnableAdaptiveSearchStrategy,
+	 &optimizer_adaptive_search_strategy,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT("Pick the search strategy from the complexity of the "
+				  "query.")},
+	{EopttraceBinaryDXL, &optimizer_dxl_binary,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT("Write minidumps and serialized plans as binary DXL.")}
 
 };
 
@@ -29,6 +29,7 @@
 #include "naucrates/exception.h"
 
 #include "gpopt/gpdbwrappers.h"
+#include "catalog/partition.h"
 #include "catalog/pg_collation.h"
 extern "C" {
 #include "access/external.h"
@@ -38,6 +39,7 @@ extern "C" {
 #include "optimizer/plancat.h"
 #include "parser/parse_agg.h"
 #include "utils/fmgroids.h"
+#include "utils/mdcacheshared.h"
 #include "utils/memutils.h"
 }
 #define GP_WRAP_START                                            \
@@ -1926,6 +1928,18 @@ gpdb::HasSubclassSlow(Oid rel_oid)
 	return false;
 }
 
+List *
+gpdb::GetPartitionAncestors(Oid rel_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_inherits */
+		return get_partition_ancestors(rel_oid);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
 bool
 gpdb::RelIsExternalTable(Oid relid)
 {
@@ -2545,16 +2559,27 @@ gpdb::CountLeafPartTables
 #endif
 
 /*
- * To detect changes to catalog tables that require resetting the Metadata
- * Cache, we use the normal PostgreSQL catalog cache invalidation mechanism.
- * We register a callback to a cache on all the catalog tables that contain
- * information that's contained in the ORCA metadata cache.
-
- * There is no fine-grained mechanism in the metadata cache for invalidating
- * individual entries ATM, so we just blow the whole cache whenever anything
- * changes. The callback simply increments a counter. Whenever we start
- * planning a query, we check the counter to see if it has changed since the
- * last planned query, and reset the whole cache if it has.
+ * To detect changes to catalog tables that affect the Metadata Cache, we use
+ * the normal PostgreSQL catalog cache invalidation mechanism. We register a
+ * callback to a cache on all the catalog tables that contain information
+ * that's contained in the ORCA metadata cache.
+ *
+ * The callbacks record the invalidated relation, or the syscache id and hash
+ * value of the invalidated catalog tuple. Whenever we start planning a query,
+ * the recorded changes are handed to the optimizer, which drops only the
+ * cache entries built from the changed catalog tuples (see
+ * COptTasks::InvalidateMDCache()). We still blow the whole cache when a change
+ * cannot be pinned down to individual entries: on a cache-wide invalidation
+ * (sinval queue overflow), on operator family changes, which feed into many
+ * cached types and operators, or when more changes pile up between two
+ * queries than we have room to record. The plans cached by the optimizer
+ * (see CPlanCache) are all dropped on any recorded change.
+ *
+ * The same changes invalidate the entries of the metadata cache shared by
+ * all backends (see utils/cache/mdcacheshared.c). Since a backend must not
+ * miss a change that happened while it was not planning any query, the
+ * callbacks are registered at backend start when the shared cache is
+ * enabled.
  *
  * To make sure we've covered all catalog tables that contain information
  * that's stored in the metadata cache, there are "catalog tables: xxx"
@@ -2563,26 +2588,83 @@ gpdb::CountLeafPartTables
  * anything fetched via the wrapper functions in this file can end up in the
  * metadata cache and hence need to have an invalidation callback registered.
  */
-static bool mdcache_invalidation_counter_registered = false;
-static int64 mdcache_invalidation_counter = 0;
-static int64 last_mdcache_invalidation_counter = 0;
+#define MDCACHE_MAX_INVALIDATIONS 1024
+
+static bool mdcache_invalidation_callbacks_registered = false;
+static bool mdcache_needs_reset = false;
+
+/* catalog changes recorded since the last planned query */
+static gpdb::MDCacheInvalidation
+	mdcache_pending_invalidations[MDCACHE_MAX_INVALIDATIONS];
+static int mdcache_num_pending_invalidations = 0;
+
+/* catalog changes handed out to the current planned query */
+static gpdb::MDCacheInvalidation
+	mdcache_invalidations[MDCACHE_MAX_INVALIDATIONS];
+static int mdcache_num_invalidations = 0;
 
 static void
-mdsyscache_invalidation_counter_callback(Datum arg, int cacheid,
-										 uint32 hashvalue)
+record_mdcache_invalidation(Oid relid, int cacheid, uint32 hashvalue)
 {
-	mdcache_invalidation_counter++;
+	gpdb::MDCacheInvalidation *inval;
+
+	if (mdcache_needs_reset)
+		return;
+
+	if (mdcache_num_pending_invalidations >= MDCACHE_MAX_INVALIDATIONS)
+	{
+		mdcache_needs_reset = true;
+		return;
+	}
+
+	inval = &mdcache_pending_invalidations[mdcache_num_pending_invalidations++];
+	inval->relid = relid;
+	inval->cacheid = cacheid;
+	inval->hashvalue = hashvalue;
 }
 
 static void
-mdrelcache_invalidation_counter_callback(Datum arg, Oid relid)
+mdsyscache_invalidation_callback(Datum arg, int cacheid, uint32 hashvalue)
 {
-	mdcache_invalidation_counter++;
+	/*
+	 * A zero hash value means that the whole syscache was flushed. Changes
+	 * to operator families are not tracked by the individual cached objects
+	 * that depend on them.
+	 */
+	if (hashvalue == 0 || cacheid == AMOPOPID || cacheid == OPFAMILYOID)
+	{
+		mdcache_needs_reset = true;
+		MDCacheSharedInvalidateAll();
+	}
+	else
+	{
+		record_mdcache_invalidation(InvalidOid, cacheid, hashvalue);
+		MDCacheSharedInvalidate(cacheid, hashvalue);
+	}
+}
+
+static void
+mdrelcache_invalidation_callback(Datum arg, Oid relid)
+{
+	/* InvalidOid means that the whole relcache was flushed */
+	if (!OidIsValid(relid))
+	{
+		mdcache_needs_reset = true;
+		MDCacheSharedInvalidateAll();
+	}
+	else
+	{
+		record_mdcache_invalidation(relid, -1, 0);
+		MDCacheSharedInvalidate(MDCACHE_SHARED_RELCACHE, relid);
+	}
 }
 
 static void
 register_mdcache_invalidation_callbacks(void)
 {
+	if (mdcache_invalidation_callbacks_registered)
+		return;
+
 	/* These are all the catalog tables that we care about. */
 	int metadata_caches[] = {
 		AGGFNOID,		  /* pg_aggregate */
@@ -2640,39 +2722,125 @@ register_mdcache_invalidation_callbacks(void)
 	for (i = 0; i < lengthof(metadata_caches); i++)
 	{
 		CacheRegisterSyscacheCallback(metadata_caches[i],
-									  &mdsyscache_invalidation_counter_callback,
+									  &mdsyscache_invalidation_callback,
 									  (Datum) 0);
 	}
 
 	/* also register the relcache callback */
-	CacheRegisterRelcacheCallback(&mdrelcache_invalidation_counter_callback,
+	CacheRegisterRelcacheCallback(&mdrelcache_invalidation_callback,
 								  (Datum) 0);
+
+	mdcache_invalidation_callbacks_registered = true;
 }
 
-// Has there been any catalog changes since last call?
+// Has there been any catalog changes since last call that require a reset?
 bool
 gpdb::MDCacheNeedsReset(void)
 {
 	GP_WRAP_START;
 	{
-		if (!mdcache_invalidation_counter_registered)
-		{
-			register_mdcache_invalidation_callbacks();
-			mdcache_invalidation_counter_registered = true;
-		}
-		if (last_mdcache_invalidation_counter == mdcache_invalidation_counter)
-			return false;
-		else
+		bool needs_reset = mdcache_needs_reset;
+
+		register_mdcache_invalidation_callbacks();
+
+		/*
+		 * Hand the recorded changes over to the current query, so that
+		 * changes arriving while it is planned are kept for the next one.
+		 */
+		mdcache_num_invalidations = 0;
+		if (!needs_reset)
 		{
-			last_mdcache_invalidation_counter = mdcache_invalidation_counter;
-			return true;
+			memcpy(mdcache_invalidations, mdcache_pending_invalidations,
+				   mdcache_num_pending_invalidations *
+					   sizeof(MDCacheInvalidation));
+			mdcache_num_invalidations = mdcache_num_pending_invalidations;
 		}
+		mdcache_num_pending_invalidations = 0;
+		mdcache_needs_reset = false;
+
+		return needs_reset;
 	}
 	GP_WRAP_END;
 
 	return true;
 }
 
+// catalog changes collected by the last call to MDCacheNeedsReset()
+int
+gpdb::MDCacheGetInvalidations(const MDCacheInvalidation **invalidations)
+{
+	*invalidations = mdcache_invalidations;
+	return mdcache_num_invalidations;
+}
+
+uint32
+gpdb::GetSysCacheHashValue(int cacheid, Datum key1, Datum key2, Datum key3)
+{
+	GP_WRAP_START;
+	{
+		return ::GetSysCacheHashValue(cacheid, key1, key2, key3, 0);
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
+// Called at backend start, outside of any GPOS task. Backends that only use
+// the local metadata cache register the invalidation callbacks lazily, on
+// their first planned query.
+void
+gpdb::InitMDCacheInvalidation(void)
+{
+	if (::MDCacheSharedEnabled())
+		register_mdcache_invalidation_callbacks();
+}
+
+bool
+gpdb::MDCacheSharedEnabled(void)
+{
+	// No GP_WRAP_START/END needed here, it cannot throw an ereport().
+	return ::MDCacheSharedEnabled();
+}
+
+char *
+gpdb::MDCacheSharedLookup(const char *key, Size *len)
+{
+	GP_WRAP_START;
+	{
+		return ::MDCacheSharedLookup(key, len);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+uint64
+gpdb::MDCacheSharedBeginFetch(void)
+{
+	GP_WRAP_START;
+	{
+		return ::MDCacheSharedBeginFetch();
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
+uint32
+gpdb::MDCacheSharedDependency(int cacheid, uint32 hashvalue)
+{
+	// No GP_WRAP_START/END needed here, it cannot throw an ereport().
+	return ::MDCacheSharedDependency(cacheid, hashvalue);
+}
+
+void
+gpdb::MDCacheSharedInsert(const char *key, uint64 stamp, const uint32 *deps,
+						  int ndeps, const char *data, Size len)
+{
+	GP_WRAP_START;
+	{
+		::MDCacheSharedInsert(key, stamp, deps, ndeps, data, len);
+	}
+	GP_WRAP_END;
+}
+
 // returns true if a query cancel is requested in GPDB
 bool
 gpdb::IsAbortRequested(void)
@@ -0,0 +1,443 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMDCacheInvalidator.cpp
+//
+//	@doc:
+//		Implementation of targeted invalidation of metadata cache entries
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+#include "postgres.h"
+
+#include "utils/syscache.h"
+}
+#include "gpopt/relcache/CMDCacheInvalidator.h"
+#include "gpopt/mdcache/CMDCache.h"
+
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDCast.h"
+#include "naucrates/md/IMDCheckConstraint.h"
+#include "naucrates/md/IMDColumn.h"
+#include "naucrates/md/IMDRelation.h"
+#include "naucrates/md/IMDScCmp.h"
+#include "naucrates/md/IMDScalarOp.h"
+#include "naucrates/md/IMDTrigger.h"
+
+using namespace gpos;
+using namespace gpopt;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::CMDCacheInvalidator
+//
+//	@doc:
+//		Ctor; collects the invalidated relations, and the partitioned tables
+//		whose statistics are estimated from them
+//
+//---------------------------------------------------------------------------
+CMDCacheInvalidator::CMDCacheInvalidator(
+	CMemoryPool *mp, const gpdb::MDCacheInvalidation *invalidations,
+	ULONG num_invalidations)
+	: m_mp(mp),
+	  m_invalidations(invalidations),
+	  m_num_invalidations(num_invalidations),
+	  m_rel_oids(NULL),
+	  m_stats_rel_oids(NULL),
+	  m_col_stats(NULL),
+	  m_cached_rels(NULL),
+	  m_num_stats_invalidations(0),
+	  m_stats_traced(NULL),
+	  m_has_untraced_stats(false)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT_IMP(0 < num_invalidations, NULL != invalidations);
+
+	m_rel_oids = GPOS_NEW(mp) ULongPtrArray(mp);
+	m_stats_rel_oids = GPOS_NEW(mp) ULongPtrArray(mp);
+	m_col_stats = GPOS_NEW(mp) MdidHashSet(mp);
+	m_cached_rels = GPOS_NEW(mp) MdidHashSet(mp);
+
+	for (ULONG ul = 0; ul < m_num_invalidations; ul++)
+	{
+		const gpdb::MDCacheInvalidation *inval = &m_invalidations[ul];
+
+		if (STATRELATTINH == inval->cacheid)
+		{
+			m_num_stats_invalidations++;
+		}
+
+		if (!OidIsValid(inval->relid))
+		{
+			continue;
+		}
+
+		m_rel_oids->Append(GPOS_NEW(mp) ULONG(inval->relid));
+		m_stats_rel_oids->Append(GPOS_NEW(mp) ULONG(inval->relid));
+
+		List *ancestors = gpdb::GetPartitionAncestors(inval->relid);
+		ListCell *lc = NULL;
+		ForEach(lc, ancestors)
+		{
+			m_stats_rel_oids->Append(GPOS_NEW(mp) ULONG(lfirst_oid(lc)));
+		}
+		gpdb::ListFree(ancestors);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::~CMDCacheInvalidator
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMDCacheInvalidator::~CMDCacheInvalidator()
+{
+	m_rel_oids->Release();
+	m_stats_rel_oids->Release();
+	m_col_stats->Release();
+	m_cached_rels->Release();
+	GPOS_DELETE_ARRAY(m_stats_traced);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::FContainsOid
+//
+//	@doc:
+//		Does the list contain the OID of the given mdid? The lists hold the
+//		relations invalidated between two queries, which are few
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheInvalidator::FContainsOid(const ULongPtrArray *oids, const IMDId *mdid)
+{
+	if (!IMDId::IsValid(mdid) || IMDId::EmdidGPDB != mdid->MdidType())
+	{
+		return false;
+	}
+
+	OID oid = CMDIdGPDB::CastMdid(mdid)->Oid();
+	const ULONG size = oids->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		if (*(*oids)[ul] == oid)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::FSyscacheInvalidated
+//
+//	@doc:
+//		Was the tuple of the given OID-keyed syscache that describes the
+//		given object invalidated? The syscache hash value is computed at
+//		most once, and only if the syscache had an invalidation
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheInvalidator::FSyscacheInvalidated(int cacheid, const IMDId *mdid) const
+{
+	if (!IMDId::IsValid(mdid) || IMDId::EmdidGPDB != mdid->MdidType())
+	{
+		return false;
+	}
+
+	BOOL hashed = false;
+	uint32 hashvalue = 0;
+	for (ULONG ul = 0; ul < m_num_invalidations; ul++)
+	{
+		if (cacheid != m_invalidations[ul].cacheid)
+		{
+			continue;
+		}
+
+		if (!hashed)
+		{
+			hashvalue = gpdb::GetSysCacheHashValue(
+				cacheid, ObjectIdGetDatum(CMDIdGPDB::CastMdid(mdid)->Oid()));
+			hashed = true;
+		}
+
+		if (hashvalue == m_invalidations[ul].hashvalue)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::FCastInvalidated
+//
+//	@doc:
+//		Was the pg_cast tuple of the given cast invalidated?
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheInvalidator::FCastInvalidated(const IMDCast *md_cast) const
+{
+	BOOL hashed = false;
+	uint32 hashvalue = 0;
+	for (ULONG ul = 0; ul < m_num_invalidations; ul++)
+	{
+		if (CASTSOURCETARGET != m_invalidations[ul].cacheid)
+		{
+			continue;
+		}
+
+		if (!hashed)
+		{
+			OID src_oid = CMDIdGPDB::CastMdid(md_cast->MdidSrc())->Oid();
+			OID dest_oid = CMDIdGPDB::CastMdid(md_cast->MdidDest())->Oid();
+			hashvalue = gpdb::GetSysCacheHashValue(CASTSOURCETARGET,
+												   ObjectIdGetDatum(src_oid),
+												   ObjectIdGetDatum(dest_oid));
+			hashed = true;
+		}
+
+		if (hashvalue == m_invalidations[ul].hashvalue)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::TraceColStats
+//
+//	@doc:
+//		Trace pg_statistic changes to the columns of the given relation,
+//		recording the affected column statistics and flagging the traced
+//		changes
+//
+//---------------------------------------------------------------------------
+void
+CMDCacheInvalidator::TraceColStats(const IMDRelation *md_rel)
+{
+	CMDIdGPDB *rel_mdid = CMDIdGPDB::CastMdid(md_rel->MDId());
+	const ULONG num_cols = md_rel->ColumnCount();
+	for (ULONG pos = 0; pos < num_cols; pos++)
+	{
+		INT attno = md_rel->GetMdCol(pos)->AttrNum();
+
+		// system columns have no pg_statistic tuples
+		if (0 >= attno)
+		{
+			continue;
+		}
+
+		for (ULONG inh = 0; inh < 2; inh++)
+		{
+			uint32 hashvalue = gpdb::GetSysCacheHashValue(
+				STATRELATTINH, ObjectIdGetDatum(rel_mdid->Oid()),
+				Int16GetDatum(attno), BoolGetDatum(1 == inh));
+
+			for (ULONG ul = 0; ul < m_num_invalidations; ul++)
+			{
+				if (STATRELATTINH != m_invalidations[ul].cacheid ||
+					hashvalue != m_invalidations[ul].hashvalue)
+				{
+					continue;
+				}
+
+				m_stats_traced[ul] = true;
+				rel_mdid->AddRef();
+				CMDIdColStats *mdid_col_stats =
+					GPOS_NEW(m_mp) CMDIdColStats(rel_mdid, pos);
+				if (!m_col_stats->Insert(mdid_col_stats))
+				{
+					mdid_col_stats->Release();
+				}
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::FInvalidated
+//
+//	@doc:
+//		Is the given cached object affected by the catalog changes?
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheInvalidator::FInvalidated(const IMDCacheObject *md_obj) const
+{
+	IMDId *mdid = md_obj->MDId();
+
+	switch (md_obj->MDType())
+	{
+		case IMDCacheObject::EmdtRel:
+		case IMDCacheObject::EmdtInd:
+			return FContainsOid(m_rel_oids, mdid);
+
+		case IMDCacheObject::EmdtTrigger:
+			return FContainsOid(
+				m_rel_oids,
+				dynamic_cast<const IMDTrigger *>(md_obj)->GetRelMdId());
+
+		case IMDCacheObject::EmdtCheckConstraint:
+			return FSyscacheInvalidated(CONSTROID, mdid) ||
+				   FContainsOid(m_rel_oids,
+								dynamic_cast<const IMDCheckConstraint *>(md_obj)
+									->GetRelMdId());
+
+		case IMDCacheObject::EmdtType:
+			return FSyscacheInvalidated(TYPEOID, mdid);
+
+		case IMDCacheObject::EmdtFunc:
+			return FSyscacheInvalidated(PROCOID, mdid);
+
+		case IMDCacheObject::EmdtAgg:
+			return FSyscacheInvalidated(AGGFNOID, mdid) ||
+				   FSyscacheInvalidated(PROCOID, mdid);
+
+		case IMDCacheObject::EmdtOp:
+			// operator objects copy properties of their implementing function
+			return FSyscacheInvalidated(OPEROID, mdid) ||
+				   FSyscacheInvalidated(
+					   PROCOID,
+					   dynamic_cast<const IMDScalarOp *>(md_obj)->FuncMdId());
+
+		case IMDCacheObject::EmdtCastFunc:
+		{
+			const IMDCast *md_cast = dynamic_cast<const IMDCast *>(md_obj);
+			return FCastInvalidated(md_cast) ||
+				   FSyscacheInvalidated(PROCOID, md_cast->GetCastFuncMdId());
+		}
+
+		case IMDCacheObject::EmdtScCmp:
+			return FSyscacheInvalidated(
+				OPEROID, dynamic_cast<const IMDScCmp *>(md_obj)->MdIdOp());
+
+		case IMDCacheObject::EmdtRelStats:
+			return FContainsOid(m_stats_rel_oids,
+								CMDIdRelStats::CastMdid(mdid)->GetRelMdId());
+
+		case IMDCacheObject::EmdtColStats:
+		{
+			IMDId *rel_mdid = CMDIdColStats::CastMdid(mdid)->GetRelMdId();
+			return FContainsOid(m_stats_rel_oids, rel_mdid) ||
+				   m_col_stats->Contains(mdid) ||
+				   (m_has_untraced_stats && !m_cached_rels->Contains(rel_mdid));
+		}
+
+		default:
+			// be conservative about objects we do not know how to match
+			return true;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::FTraceColStats
+//
+//	@doc:
+//		Cache visitor recording the cached relations and the column
+//		statistics affected by pg_statistic changes; selects no entries
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheInvalidator::FTraceColStats(CMDKey *const &,  // key
+									IMDCacheObject *md_obj, void *arg)
+{
+	if (IMDCacheObject::EmdtRel != md_obj->MDType())
+	{
+		return false;
+	}
+
+	CMDCacheInvalidator *invalidator = static_cast<CMDCacheInvalidator *>(arg);
+
+	IMDId *rel_mdid = md_obj->MDId();
+	rel_mdid->AddRef();
+	if (!invalidator->m_cached_rels->Insert(rel_mdid))
+	{
+		rel_mdid->Release();
+	}
+
+	invalidator->TraceColStats(dynamic_cast<IMDRelation *>(md_obj));
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::FInvalidate
+//
+//	@doc:
+//		Cache predicate selecting the entries affected by the catalog changes
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheInvalidator::FInvalidate(CMDKey *const &,  // key
+								 IMDCacheObject *md_obj, void *arg)
+{
+	return static_cast<CMDCacheInvalidator *>(arg)->FInvalidated(md_obj);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheInvalidator::UlInvalidate
+//
+//	@doc:
+//		Drop the affected entries from the metadata cache, and return their
+//		number
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCacheInvalidator::UlInvalidate()
+{
+	if (0 == m_num_invalidations)
+	{
+		return 0;
+	}
+
+	if (0 < m_num_stats_invalidations)
+	{
+		// first pass: pin pg_statistic changes down to column statistics
+		m_stats_traced = GPOS_NEW_ARRAY(m_mp, BOOL, m_num_invalidations);
+		for (ULONG ul = 0; ul < m_num_invalidations; ul++)
+		{
+			m_stats_traced[ul] = false;
+		}
+
+		(void) CMDCache::UlInvalidate(FTraceColStats, this);
+
+		for (ULONG ul = 0; ul < m_num_invalidations; ul++)
+		{
+			if (STATRELATTINH == m_invalidations[ul].cacheid &&
+				!m_stats_traced[ul])
+			{
+				m_has_untraced_stats = true;
+				break;
+			}
+		}
+	}
+
+	return CMDCache::UlInvalidate(FInvalidate, this);
+}
+
+// EOF
@@ -0,0 +1,403 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMDCacheShared.cpp
+//
+//	@doc:
+//		Implementation of the access to the metadata cache shared by all
+//		backends
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+#include "postgres.h"
+
+#include "utils/guc.h"
+#include "utils/syscache.h"
+}
+#include "gpopt/relcache/CMDCacheShared.h"
+#include "gpopt/mdcache/CMDAccessor.h"
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDCast.h"
+#include "naucrates/md/IMDCheckConstraint.h"
+#include "naucrates/md/IMDColumn.h"
+#include "naucrates/md/IMDRelation.h"
+#include "naucrates/md/IMDScCmp.h"
+#include "naucrates/md/IMDScalarOp.h"
+#include "naucrates/md/IMDTrigger.h"
+
+using namespace gpos;
+using namespace gpopt;
+using namespace gpdxl;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::CMDCacheShared
+//
+//	@doc:
+//		Ctor; the key of the object is its mdid string, if that is short
+//		and plain ASCII
+//
+//---------------------------------------------------------------------------
+CMDCacheShared::CMDCacheShared(const IMDId *mdid)
+	: m_has_key(false), m_stamp(0), m_num_deps(0)
+{
+	GPOS_ASSERT(IMDId::IsValid(mdid));
+
+	m_key[0] = '\0';
+
+	// CTAS objects have a fixed mdid, whatever the table being created
+	if (!gpdb::MDCacheSharedEnabled() ||
+		IMDId::EmdidGPDBCtas == mdid->MdidType())
+	{
+		return;
+	}
+
+	const WCHAR *buffer = mdid->GetBuffer();
+	ULONG len = 0;
+	for (; WCHAR_EOS != buffer[len]; len++)
+	{
+		if (MDCACHE_SHARED_KEY_LEN - 1 <= len || 0x7f < buffer[len])
+		{
+			return;
+		}
+		m_key[len] = (CHAR) buffer[len];
+	}
+	m_key[len] = '\0';
+	m_has_key = true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::Lookup
+//
+//	@doc:
+//		Binary DXL document of the object, allocated with palloc, if it is in
+//		the shared cache, NULL otherwise
+//
+//---------------------------------------------------------------------------
+BYTE *
+CMDCacheShared::Lookup(ULONG *length) const
+{
+	if (!m_has_key)
+	{
+		return NULL;
+	}
+
+	Size len = 0;
+	char *data = gpdb::MDCacheSharedLookup(m_key, &len);
+	*length = (ULONG) len;
+
+	return (BYTE *) data;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::GetMDObj
+//
+//	@doc:
+//		The object, allocated in the given memory pool, if it is in the
+//		shared cache, NULL otherwise. Objects are kept there as binary DXL,
+//		which is read back without going through the XML parser
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDCacheShared::GetMDObj(CMemoryPool *mp) const
+{
+	ULONG length = 0;
+	BYTE *data = Lookup(&length);
+	if (NULL == data)
+	{
+		return NULL;
+	}
+
+	CAutoP<CParseHandlerDXL> parse_handler_dxl(
+		CDXLUtils::GetParseHandlerForDXLBinary(mp, data, length));
+	gpdb::GPDBFree(data);
+
+	IMDCacheObjectArray *md_obj_array =
+		parse_handler_dxl->GetMdIdCachedObjArray();
+	GPOS_ASSERT(1 == md_obj_array->Size());
+
+	IMDCacheObject *md_obj = (*md_obj_array)[0];
+	md_obj->AddRef();
+
+	return md_obj;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::GetDXLStr
+//
+//	@doc:
+//		DXL string of the object if it is in the shared cache, NULL otherwise;
+//		only needed to capture minidumps
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+CMDCacheShared::GetDXLStr(CMemoryPool *mp) const
+{
+	ULONG length = 0;
+	BYTE *data = Lookup(&length);
+	if (NULL == data)
+	{
+		return NULL;
+	}
+
+	CWStringDynamic *dxl_str = CDXLUtils::ConvertBinaryToXML(
+		mp, data, length, false /*indentation*/);
+	gpdb::GPDBFree(data);
+
+	return dxl_str;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::BeginFetch
+//
+//	@doc:
+//		Start reading the object from the catalogs; only objects read after
+//		this call may be published
+//
+//---------------------------------------------------------------------------
+void
+CMDCacheShared::BeginFetch()
+{
+	if (m_has_key)
+	{
+		m_stamp = gpdb::MDCacheSharedBeginFetch();
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::AddDependency
+//
+//	@doc:
+//		Add a catalog dependency
+//
+//---------------------------------------------------------------------------
+void
+CMDCacheShared::AddDependency(int cacheid, uint32 hashvalue)
+{
+	GPOS_ASSERT(MDCACHE_SHARED_MAX_DEPS > m_num_deps);
+
+	m_deps[m_num_deps++] = gpdb::MDCacheSharedDependency(cacheid, hashvalue);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::AddRelDependency
+//
+//	@doc:
+//		Add a dependency on the relcache entry of the given relation
+//
+//---------------------------------------------------------------------------
+void
+CMDCacheShared::AddRelDependency(const IMDId *mdid)
+{
+	AddDependency(MDCACHE_SHARED_RELCACHE, CMDIdGPDB::CastMdid(mdid)->Oid());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::AddSyscacheDependency
+//
+//	@doc:
+//		Add a dependency on the tuple of the given OID-keyed syscache that
+//		describes the given object, if any
+//
+//---------------------------------------------------------------------------
+void
+CMDCacheShared::AddSyscacheDependency(int cacheid, const IMDId *mdid)
+{
+	if (!IMDId::IsValid(mdid))
+	{
+		return;
+	}
+
+	OID oid = CMDIdGPDB::CastMdid(mdid)->Oid();
+	AddDependency(cacheid,
+				  gpdb::GetSysCacheHashValue(cacheid, ObjectIdGetDatum(oid)));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::FAddStatsDependencies
+//
+//	@doc:
+//		Add the dependencies of the given statistics object. Statistics of
+//		partitioned tables are estimated from their partitions, and sizes
+//		collected from the storage change without any catalog change, so
+//		neither can be tracked
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheShared::FAddStatsDependencies(CMDAccessor *md_accessor,
+									  const IMDCacheObject *md_obj)
+{
+	IMDId *mdid = md_obj->MDId();
+	IMDId *rel_mdid = NULL;
+	if (IMDCacheObject::EmdtRelStats == md_obj->MDType())
+	{
+		rel_mdid = CMDIdRelStats::CastMdid(mdid)->GetRelMdId();
+	}
+	else
+	{
+		rel_mdid = CMDIdColStats::CastMdid(mdid)->GetRelMdId();
+	}
+
+	OID rel_oid = CMDIdGPDB::CastMdid(rel_mdid)->Oid();
+	if (gp_enable_relsize_collection || gpdb::RelIsPartitioned(rel_oid))
+	{
+		return false;
+	}
+
+	AddRelDependency(rel_mdid);
+
+	if (IMDCacheObject::EmdtColStats == md_obj->MDType())
+	{
+		ULONG pos = CMDIdColStats::CastMdid(mdid)->Position();
+		INT attno =
+			md_accessor->RetrieveRel(rel_mdid)->GetMdCol(pos)->AttrNum();
+
+		// system columns have no pg_statistic tuples
+		for (ULONG inh = 0; 0 < attno && inh < 2; inh++)
+		{
+			AddDependency(STATRELATTINH,
+						  gpdb::GetSysCacheHashValue(
+							  STATRELATTINH, ObjectIdGetDatum(rel_oid),
+							  Int16GetDatum(attno), BoolGetDatum(1 == inh)));
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::FAddDependencies
+//
+//	@doc:
+//		Add the dependencies of the given object; returns false for objects
+//		whose dependencies cannot be determined
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCacheShared::FAddDependencies(CMDAccessor *md_accessor,
+								 const IMDCacheObject *md_obj)
+{
+	IMDId *mdid = md_obj->MDId();
+
+	switch (md_obj->MDType())
+	{
+		case IMDCacheObject::EmdtRel:
+		case IMDCacheObject::EmdtInd:
+			AddRelDependency(mdid);
+			return true;
+
+		case IMDCacheObject::EmdtTrigger:
+			AddRelDependency(
+				dynamic_cast<const IMDTrigger *>(md_obj)->GetRelMdId());
+			return true;
+
+		case IMDCacheObject::EmdtCheckConstraint:
+			AddSyscacheDependency(CONSTROID, mdid);
+			AddRelDependency(dynamic_cast<const IMDCheckConstraint *>(md_obj)
+								 ->GetRelMdId());
+			return true;
+
+		case IMDCacheObject::EmdtType:
+			AddSyscacheDependency(TYPEOID, mdid);
+			return true;
+
+		case IMDCacheObject::EmdtFunc:
+			AddSyscacheDependency(PROCOID, mdid);
+			return true;
+
+		case IMDCacheObject::EmdtAgg:
+			AddSyscacheDependency(AGGFNOID, mdid);
+			AddSyscacheDependency(PROCOID, mdid);
+			return true;
+
+		case IMDCacheObject::EmdtOp:
+			// operator objects copy properties of their implementing function
+			AddSyscacheDependency(OPEROID, mdid);
+			AddSyscacheDependency(
+				PROCOID, dynamic_cast<const IMDScalarOp *>(md_obj)->FuncMdId());
+			return true;
+
+		case IMDCacheObject::EmdtCastFunc:
+		{
+			const IMDCast *md_cast = dynamic_cast<const IMDCast *>(md_obj);
+			OID src_oid = CMDIdGPDB::CastMdid(md_cast->MdidSrc())->Oid();
+			OID dest_oid = CMDIdGPDB::CastMdid(md_cast->MdidDest())->Oid();
+			AddDependency(
+				CASTSOURCETARGET,
+				gpdb::GetSysCacheHashValue(CASTSOURCETARGET,
+										   ObjectIdGetDatum(src_oid),
+										   ObjectIdGetDatum(dest_oid)));
+			AddSyscacheDependency(PROCOID, md_cast->GetCastFuncMdId());
+			return true;
+		}
+
+		case IMDCacheObject::EmdtScCmp:
+			AddSyscacheDependency(
+				OPEROID, dynamic_cast<const IMDScCmp *>(md_obj)->MdIdOp());
+			return true;
+
+		case IMDCacheObject::EmdtRelStats:
+		case IMDCacheObject::EmdtColStats:
+			return FAddStatsDependencies(md_accessor, md_obj);
+
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCacheShared::Insert
+//
+//	@doc:
+//		Publish the object read from the catalogs, along with its catalog
+//		dependencies. The object is serialized into binary DXL here, and
+//		only if it can be published
+//
+//---------------------------------------------------------------------------
+void
+CMDCacheShared::Insert(CMemoryPool *mp, CMDAccessor *md_accessor,
+					   const IMDCacheObject *md_obj)
+{
+	if (0 == m_stamp)
+	{
+		return;
+	}
+
+	m_num_deps = 0;
+	if (!FAddDependencies(md_accessor, md_obj))
+	{
+		return;
+	}
+
+	ULONG length = 0;
+	CAutoRg<BYTE> data(CDXLUtils::SerializeMDObjToBinary(mp, md_obj, &length));
+	gpdb::MDCacheSharedInsert(m_key, m_stamp, m_deps, m_num_deps,
+							  (const char *) data.Rgt(), length);
+}
+
+// EOF
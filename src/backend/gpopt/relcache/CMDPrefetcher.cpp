@@ -0,0 +1,333 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMDPrefetcher.cpp
+//
+//	@doc:
+//		Implementation of the prefetching of the metadata of the relations
+//		referenced by a query
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+#include "postgres.h"
+
+#include "access/sysattr.h"
+#include "nodes/bitmapset.h"
+#include "nodes/nodeFuncs.h"
+#include "nodes/parsenodes.h"
+#include "parser/parsetree.h"
+}
+#include "gpopt/relcache/CMDPrefetcher.h"
+#include "gpopt/mdcache/CMDAccessor.h"
+
+#include "gpos/common/CAutoTimer.h"
+
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDColumn.h"
+#include "naucrates/md/IMDRelation.h"
+#include "naucrates/traceflags/traceflags.h"
+
+using namespace gpos;
+using namespace gpopt;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::CMDPrefetcher
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMDPrefetcher::CMDPrefetcher(CMemoryPool *mp, CMDAccessor *md_accessor)
+	: m_mp(mp), m_md_accessor(md_accessor), m_rel_attnos(NULL)
+{
+	GPOS_ASSERT(NULL != md_accessor);
+
+	m_rel_attnos = GPOS_NEW(mp) OidToAttnoSetMap(mp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::~CMDPrefetcher
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMDPrefetcher::~CMDPrefetcher()
+{
+	m_rel_attnos->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::AddRelation
+//
+//	@doc:
+//		Record a relation referenced by the query, and return the set of its
+//		columns to prefetch
+//
+//---------------------------------------------------------------------------
+CBitSet *
+CMDPrefetcher::AddRelation(OID oid)
+{
+	ULONG key = oid;
+	CBitSet *attnos = m_rel_attnos->Find(&key);
+	if (NULL == attnos)
+	{
+		attnos = GPOS_NEW(m_mp) CBitSet(m_mp);
+		BOOL result GPOS_ASSERTS_ONLY =
+			m_rel_attnos->Insert(GPOS_NEW(m_mp) ULONG(oid), attnos);
+		GPOS_ASSERT(result);
+	}
+
+	return attnos;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::AddVar
+//
+//	@doc:
+//		Record the column referenced by the given variable of the given
+//		query. Join alias variables are resolved to the columns they stand
+//		for; whole-row references are not followed
+//
+//---------------------------------------------------------------------------
+void
+CMDPrefetcher::AddVar(Query *query, const Var *var)
+{
+	if (0 != var->varlevelsup || 0 >= var->varattno ||
+		(ULONG) list_length(query->rtable) < var->varno)
+	{
+		return;
+	}
+
+	RangeTblEntry *rte = rt_fetch(var->varno, query->rtable);
+	if (RTE_RELATION == rte->rtekind)
+	{
+		(void) AddRelation(rte->relid)->ExchangeSet(var->varattno);
+	}
+	else if (RTE_JOIN == rte->rtekind &&
+			 var->varattno <= list_length(rte->joinaliasvars))
+	{
+		SCollectContext ctxt = {this, query};
+		(void) CollectWalker(
+			(Node *) list_nth(rte->joinaliasvars, var->varattno - 1), &ctxt);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::CollectWalker
+//
+//	@doc:
+//		Walker recording the columns referenced by an expression of a query;
+//		subqueries are visited by PrefetchWalker
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDPrefetcher::CollectWalker(Node *node, SCollectContext *ctxt)
+{
+	if (NULL == node)
+	{
+		return false;
+	}
+
+	if (IsA(node, Var))
+	{
+		ctxt->m_prefetcher->AddVar(ctxt->m_query, (Var *) node);
+		return false;
+	}
+
+	if (IsA(node, Query))
+	{
+		return false;
+	}
+
+	return expression_tree_walker(
+		node, (BOOL(*)()) CMDPrefetcher::CollectWalker, ctxt);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::FSortGroupRef
+//
+//	@doc:
+//		Does one of the given sort/group clauses refer to the given target
+//		list entry?
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDPrefetcher::FSortGroupRef(List *clauses, const TargetEntry *target_entry)
+{
+	if (0 == target_entry->ressortgroupref)
+	{
+		return false;
+	}
+
+	ListCell *lc = NULL;
+	ForEach(lc, clauses)
+	{
+		SortGroupClause *clause = (SortGroupClause *) lfirst(lc);
+		if (clause->tleSortGroupRef == target_entry->ressortgroupref)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::CollectQuery
+//
+//	@doc:
+//		Record the columns the given query filters, joins or groups on; the
+//		statistics of those are the ones cardinality estimation looks up.
+//		Columns of the outer queries referenced by a subquery are left to be
+//		fetched on demand
+//
+//---------------------------------------------------------------------------
+void
+CMDPrefetcher::CollectQuery(Query *query)
+{
+	SCollectContext ctxt = {this, query};
+
+	// WHERE clause and join conditions
+	(void) CollectWalker((Node *) query->jointree, &ctxt);
+	(void) CollectWalker(query->havingQual, &ctxt);
+
+	// grouping and DISTINCT columns
+	ListCell *lc = NULL;
+	ForEach(lc, query->targetList)
+	{
+		TargetEntry *target_entry = (TargetEntry *) lfirst(lc);
+		if (FSortGroupRef(query->groupClause, target_entry) ||
+			FSortGroupRef(query->distinctClause, target_entry))
+		{
+			(void) CollectWalker((Node *) target_entry->expr, &ctxt);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::PrefetchRelation
+//
+//	@doc:
+//		Fetch the relation statistics of the given relation, and the column
+//		statistics of the given columns
+//
+//---------------------------------------------------------------------------
+void
+CMDPrefetcher::PrefetchRelation(OID oid, const CBitSet *attnos)
+{
+	CMDIdGPDB *rel_mdid = GPOS_NEW(m_mp) CMDIdGPDB(oid);
+	const IMDRelation *md_rel = m_md_accessor->RetrieveRel(rel_mdid);
+
+	rel_mdid->AddRef();
+	CMDIdRelStats *rel_stats_mdid = GPOS_NEW(m_mp) CMDIdRelStats(rel_mdid);
+	(void) m_md_accessor->Pmdrelstats(rel_stats_mdid);
+	rel_stats_mdid->Release();
+
+	const ULONG num_columns = md_rel->ColumnCount();
+	for (ULONG ul = 0; ul < num_columns; ul++)
+	{
+		const IMDColumn *md_col = md_rel->GetMdCol(ul);
+		if (md_col->IsDropped() || md_col->IsSystemColumn() ||
+			!attnos->Get(md_col->AttrNum()))
+		{
+			continue;
+		}
+
+		rel_mdid->AddRef();
+		CMDIdColStats *col_stats_mdid =
+			GPOS_NEW(m_mp) CMDIdColStats(rel_mdid, ul);
+		(void) m_md_accessor->Pmdcolstats(col_stats_mdid);
+		col_stats_mdid->Release();
+	}
+
+	rel_mdid->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::PrefetchWalker
+//
+//	@doc:
+//		Walker visiting the range table entries of a query, and those of its
+//		subqueries, sublinks and CTEs
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDPrefetcher::PrefetchWalker(Node *node, CMDPrefetcher *prefetcher)
+{
+	if (NULL == node)
+	{
+		return false;
+	}
+
+	if (IsA(node, RangeTblEntry))
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) node;
+		if (RTE_RELATION == rte->rtekind)
+		{
+			(void) prefetcher->AddRelation(rte->relid);
+		}
+
+		return false;
+	}
+
+	if (IsA(node, Query))
+	{
+		prefetcher->CollectQuery((Query *) node);
+
+		return query_tree_walker((Query *) node,
+								 (BOOL(*)()) CMDPrefetcher::PrefetchWalker,
+								 prefetcher, QTW_EXAMINE_RTES_BEFORE);
+	}
+
+	return expression_tree_walker(
+		node, (BOOL(*)()) CMDPrefetcher::PrefetchWalker, prefetcher);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDPrefetcher::Prefetch
+//
+//	@doc:
+//		Fetch the statistics of the relations referenced by the given query.
+//		The whole query is walked first, so that each relation is fetched
+//		once for all the places it is referenced from
+//
+//---------------------------------------------------------------------------
+void
+CMDPrefetcher::Prefetch(Query *query)
+{
+	CAutoTimer at("\n[OPT]: Metadata Prefetch Time",
+				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
+
+	CollectQuery(query);
+	(void) gpdb::WalkQueryOrExpressionTree(
+		(Node *) query, (BOOL(*)()) CMDPrefetcher::PrefetchWalker, this,
+		QTW_EXAMINE_RTES_BEFORE);
+
+	OidToAttnoSetMapIter it(m_rel_attnos);
+	while (it.Advance())
+	{
+		PrefetchRelation(*it.Key(), it.Value());
+	}
+}
+
+// EOF
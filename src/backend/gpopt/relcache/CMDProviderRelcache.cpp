@@ -18,10 +18,18 @@ extern "C" {
 #include "postgres.h"
 }
 #include "gpopt/relcache/CMDProviderRelcache.h"
+#include "gpopt/relcache/CMDCacheShared.h"
 #include "gpopt/translate/CTranslatorRelcacheToDXL.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 
+#include "gpos/common/CAutoRef.h"
+
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/md/CMDIdCast.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/CMDIdScCmp.h"
 
 #include "naucrates/exception.h"
 
@@ -47,20 +55,34 @@ CMDProviderRelcache::CMDProviderRelcache(CMemoryPool *mp) : m_mp(mp)
 //		CMDProviderRelcache::GetMDObjDXLStr
 //
 //	@doc:
-//		Returns the DXL of the requested object in the provided memory pool
+//		Returns the DXL of the requested object in the provided memory pool.
+//		Only used to capture minidumps; the optimizer gets its objects
+//		through GetMDObj
 //
 //---------------------------------------------------------------------------
 CWStringBase *
 CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 									IMDId *md_id) const
 {
+	CMDCacheShared md_cache_shared(md_id);
+
+	CWStringDynamic *str = md_cache_shared.GetDXLStr(m_mp);
+	if (NULL != str)
+	{
+		return str;
+	}
+
+	md_cache_shared.BeginFetch();
+
 	IMDCacheObject *md_obj =
 		CTranslatorRelcacheToDXL::RetrieveObject(mp, md_accessor, md_id);
 
 	GPOS_ASSERT(NULL != md_obj);
 
-	CWStringDynamic *str = CDXLUtils::SerializeMDObj(
-		m_mp, md_obj, true /*fSerializeHeaders*/, false /*findent*/);
+	str = CDXLUtils::SerializeMDObj(m_mp, md_obj, true /*fSerializeHeaders*/,
+									false /*findent*/);
+
+	md_cache_shared.Insert(mp, md_accessor, md_obj);
 
 	// cleanup DXL object
 	md_obj->Release();
@@ -68,4 +90,98 @@ CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 	return str;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderRelcache::CopyMDId
+//
+//	@doc:
+//		Copy of the given mdid, allocated in the given memory pool
+//
+//---------------------------------------------------------------------------
+IMDId *
+CMDProviderRelcache::CopyMDId(CMemoryPool *mp, IMDId *md_id)
+{
+	switch (md_id->MdidType())
+	{
+		case IMDId::EmdidGPDB:
+			return GPOS_NEW(mp) CMDIdGPDB(*CMDIdGPDB::CastMdid(md_id));
+
+		case IMDId::EmdidRelStats:
+		{
+			CMDIdRelStats *mdid_rel_stats = CMDIdRelStats::CastMdid(md_id);
+			return GPOS_NEW(mp) CMDIdRelStats(
+				CMDIdGPDB::CastMdid(CopyMDId(mp, mdid_rel_stats->GetRelMdId())));
+		}
+
+		case IMDId::EmdidColStats:
+		{
+			CMDIdColStats *mdid_col_stats = CMDIdColStats::CastMdid(md_id);
+			return GPOS_NEW(mp) CMDIdColStats(
+				CMDIdGPDB::CastMdid(CopyMDId(mp, mdid_col_stats->GetRelMdId())),
+				mdid_col_stats->Position());
+		}
+
+		case IMDId::EmdidCastFunc:
+		{
+			CMDIdCast *mdid_cast = CMDIdCast::CastMdid(md_id);
+			return GPOS_NEW(mp) CMDIdCast(
+				CMDIdGPDB::CastMdid(CopyMDId(mp, mdid_cast->MdidSrc())),
+				CMDIdGPDB::CastMdid(CopyMDId(mp, mdid_cast->MdidDest())));
+		}
+
+		case IMDId::EmdidScCmp:
+		{
+			CMDIdScCmp *mdid_sc_cmp = CMDIdScCmp::CastMdid(md_id);
+			return GPOS_NEW(mp) CMDIdScCmp(
+				CMDIdGPDB::CastMdid(CopyMDId(mp, mdid_sc_cmp->GetLeftMdid())),
+				CMDIdGPDB::CastMdid(CopyMDId(mp, mdid_sc_cmp->GetRightMdid())),
+				mdid_sc_cmp->ParseCmpType());
+		}
+
+		default:
+			// no catalog object has such an mdid
+			GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
+					   md_id->GetBuffer());
+			return NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderRelcache::GetMDObj
+//
+//	@doc:
+//		Returns the requested object, allocated in the provided memory pool.
+//		Objects are read back from the shared metadata cache if possible, or
+//		else translated from the catalogs right into that pool, from a copy
+//		of their mdid. The translation copies whatever it takes from the
+//		objects it looks up through the metadata accessor, which live in
+//		other pools
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDProviderRelcache::GetMDObj(CMemoryPool *mp, CMDAccessor *md_accessor,
+							  IMDId *md_id) const
+{
+	CMDCacheShared md_cache_shared(md_id);
+
+	IMDCacheObject *md_obj = md_cache_shared.GetMDObj(mp);
+	if (NULL != md_obj)
+	{
+		return md_obj;
+	}
+
+	md_cache_shared.BeginFetch();
+
+	CAutoRef<IMDId> a_pmdid(CopyMDId(mp, md_id));
+	md_obj = CTranslatorRelcacheToDXL::RetrieveObject(mp, md_accessor,
+													  a_pmdid.Value());
+
+	GPOS_ASSERT(NULL != md_obj);
+
+	md_cache_shared.Insert(m_mp, md_accessor, md_obj);
+
+	return md_obj;
+}
+
 // EOF
@@ -68,6 +68,7 @@ extern "C" {
 #include "naucrates/md/CMDIndexGPDB.h"
 #include "naucrates/md/CMDPartConstraintGPDB.h"
 #include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDRelStats.h"
 #include "naucrates/md/CDXLRelStats.h"
 #include "naucrates/md/CMDIdColStats.h"
 #include "naucrates/md/CDXLColStats.h"
@@ -1884,8 +1885,9 @@ CTranslatorRelcacheToDXL::RetrieveCheckConstraints(CMemoryPool *mp,
 		const IMDColumn *md_col = md_rel->GetMdCol(ul);
 		CMDName *md_colname =
 			GPOS_NEW(mp) CMDName(mp, md_col->Mdname().GetMDName());
-		CMDIdGPDB *mdid_col_type = CMDIdGPDB::CastMdid(md_col->MdidType());
-		mdid_col_type->AddRef();
+		// the relation lives in the pool of another cache entry
+		CMDIdGPDB *mdid_col_type = GPOS_NEW(mp)
+			CMDIdGPDB(*CMDIdGPDB::CastMdid(md_col->MdidType()));
 
 		// create a column descriptor for the column
 		CDXLColDescr *dxl_col_descr = GPOS_NEW(mp) CDXLColDescr(
@@ -2114,11 +2116,14 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	const IMDColumn *md_col = md_rel->GetMdCol(pos);
 	AttrNumber attno = (AttrNumber) md_col->AttrNum();
 
-	// number of rows from pg_class
-	double num_rows;
-
-	num_rows =
-		gpdb::CdbEstimatePartitionedNumTuples(gpdb::GetRelation(rel_oid).get());
+	// number of rows, as estimated for the relation stats, so that the
+	// partitions of a partitioned table are scanned once for all its columns
+	mdid_rel->AddRef();
+	CMDIdRelStats *mdid_rel_stats =
+		GPOS_NEW(mp) CMDIdRelStats(CMDIdGPDB::CastMdid(mdid_rel));
+	double num_rows =
+		md_accessor->Pmdrelstats(mdid_rel_stats)->Rows().Get();
+	mdid_rel_stats->Release();
 
 	// extract column name and type
 	CMDName *md_colname =
@@ -3126,8 +3131,9 @@ CTranslatorRelcacheToDXL::RetrievePartConstraintForIndex(
 		const IMDColumn *md_col = md_rel->GetMdCol(ul);
 		CMDName *md_colname =
 			GPOS_NEW(mp) CMDName(mp, md_col->Mdname().GetMDName());
-		CMDIdGPDB *mdid_col_type = CMDIdGPDB::CastMdid(md_col->MdidType());
-		mdid_col_type->AddRef();
+		// the relation lives in the pool of another cache entry
+		CMDIdGPDB *mdid_col_type = GPOS_NEW(mp)
+			CMDIdGPDB(*CMDIdGPDB::CastMdid(md_col->MdidType()));
 
 		// create a column descriptor for the column
 		CDXLColDescr *dxl_col_descr = GPOS_NEW(mp) CDXLColDescr(
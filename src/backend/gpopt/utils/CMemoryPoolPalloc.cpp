@@ -53,7 +53,7 @@ CMemoryPoolPalloc::NewImpl(const ULONG bytes, const CHAR *, const ULONG,
 
 		SArrayAllocHeader *header = static_cast<SArrayAllocHeader *>(ptr);
 
-		header->m_user_size = bytes;
+		header->m_shifted_user_size = (ULONG_PTR) bytes << 1;
 		return static_cast<BYTE *>(ptr) +
 			   GPOS_MEM_ALIGNED_STRUCT_SIZE(SArrayAllocHeader);
 	}
@@ -97,7 +97,7 @@ CMemoryPoolPalloc::UserSizeOfAlloc(const void *ptr)
 						GPOS_MEM_ALIGNED_STRUCT_SIZE(SArrayAllocHeader);
 	const SArrayAllocHeader *header =
 		static_cast<SArrayAllocHeader *>(void_header);
-	return header->m_user_size;
+	return (ULONG)(header->m_shifted_user_size >> 1);
 }
 
 
@@ -17,6 +17,8 @@
 #include "gpopt/utils/CConstExprEvaluatorProxy.h"
 #include "gpopt/utils/COptTasks.h"
 #include "gpopt/relcache/CMDProviderRelcache.h"
+#include "gpopt/relcache/CMDCacheInvalidator.h"
+#include "gpopt/relcache/CMDPrefetcher.h"
 #include "gpopt/config/CConfigParamMapping.h"
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
 #include "gpopt/translate/CTranslatorExprToDXL.h"
@@ -38,6 +40,8 @@
 
 #include "gpos/_api.h"
 #include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/task/CAutoTraceFlag.h"
@@ -48,6 +52,7 @@
 
 #include "gpopt/base/CAutoOptCtxt.h"
 #include "gpopt/engine/CEnumeratorConfig.h"
+#include "gpopt/engine/COptimizationStats.h"
 #include "gpopt/engine/CStatisticsConfig.h"
 #include "gpopt/engine/CCTEConfig.h"
 #include "gpopt/mdcache/CAutoMDAccessor.h"
@@ -55,6 +60,7 @@
 #include "gpopt/minidump/CMinidumperUtils.h"
 #include "gpopt/optimizer/COptimizer.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/CPlanCache.h"
 #include "gpopt/xforms/CXformFactory.h"
 #include "gpopt/exception.h"
 
@@ -218,6 +224,36 @@ COptTasks::CreateMultiByteCharStringFromWCString(const WCHAR *wcstr)
 	return str;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CreateHexStringFromBinary
+//
+//	@doc:
+//		Return the given binary document as a hex string in the bytea
+//		escape format, e.g. "\x0a1b"
+//
+//---------------------------------------------------------------------------
+CHAR *
+COptTasks::CreateHexStringFromBinary(const BYTE *data, ULONG length)
+{
+	GPOS_ASSERT(NULL != data);
+
+	static const CHAR hex_digits[] = "0123456789abcdef";
+
+	CHAR *str = (CHAR *) gpdb::GPDBAlloc(2 * length + 3);
+	CHAR *pos = str;
+	*pos++ = '\\';
+	*pos++ = 'x';
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		*pos++ = hex_digits[data[ul] >> 4];
+		*pos++ = hex_digits[data[ul] & 0xf];
+	}
+	*pos = '\0';
+
+	return str;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::Execute
@@ -321,6 +357,71 @@ COptTasks::ConvertToPlanStmtFromDXL(
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::CreateOptimizerProfile
+//
+//	@doc:
+//		Summarize the counters of an optimization into the profile shown by
+//		EXPLAIN, with times in milliseconds
+//
+//---------------------------------------------------------------------------
+OptimizerProfile *
+COptTasks::CreateOptimizerProfile(COptimizationStats *optimization_stats)
+{
+	OptimizerProfile *profile = MakeNode(OptimizerProfile);
+
+	const double usec_in_msec = (double) GPOS_USEC_IN_MSEC;
+	profile->translateTime =
+		optimization_stats->UllPhaseTime(
+			COptimizationStats::EphQueryTranslation) /
+		usec_in_msec;
+	profile->preprocessTime =
+		optimization_stats->UllPhaseTime(COptimizationStats::EphPreprocessing) /
+		usec_in_msec;
+	profile->exploreTime =
+		optimization_stats->UllPhaseTime(COptimizationStats::EphExploration) /
+		usec_in_msec;
+	profile->statsTime =
+		optimization_stats->UllPhaseTime(
+			COptimizationStats::EphStatsDerivation) /
+		usec_in_msec;
+	profile->implementTime =
+		optimization_stats->UllPhaseTime(
+			COptimizationStats::EphImplementation) /
+		usec_in_msec;
+	profile->optimizeTime =
+		optimization_stats->UllPhaseTime(COptimizationStats::EphOptimization) /
+		usec_in_msec;
+	profile->planTime =
+		optimization_stats->UllPhaseTime(
+			COptimizationStats::EphPlanTranslation) /
+		usec_in_msec;
+
+	profile->mdFetchTime = optimization_stats->UllMDFetchTime() / usec_in_msec;
+	profile->mdCacheHits = optimization_stats->UlMDCacheHits();
+	profile->mdCacheMisses = optimization_stats->UlMDCacheMisses();
+
+	profile->memoGroups = optimization_stats->UlGroups();
+	profile->memoGroupExprs = optimization_stats->UlGroupExprs();
+	profile->searchStages = optimization_stats->UlSearchStages();
+
+	ULONG xforms[OPTIMIZER_PROFILE_XFORMS];
+	profile->numXforms =
+		optimization_stats->UlTopXforms(xforms, OPTIMIZER_PROFILE_XFORMS);
+	for (int i = 0; i < profile->numXforms; i++)
+	{
+		CXform *xform =
+			CXformFactory::Pxff()->Pxf((CXform::EXformId) xforms[i]);
+		profile->xformNames[i] = PStrDup(xform->SzId());
+		profile->xformTimes[i] =
+			optimization_stats->UllXformTime(xforms[i]) / usec_in_msec;
+		profile->xformCalls[i] = optimization_stats->UlXformCalls(xforms[i]);
+	}
+
+	return profile;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::LoadSearchStrategy
@@ -366,6 +467,56 @@ COptTasks::LoadSearchStrategy(CMemoryPool *mp, char *path)
 	return search_strategy_arr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::LoadCostModelParams
+//
+//	@doc:
+//		Load the parameters of the calibrated cost model from given file,
+//		as written by the cost model calibration script. Parameters not
+//		in the file keep their default values
+//
+//---------------------------------------------------------------------------
+CCostModelParamsGPDB *
+COptTasks::LoadCostModelParams(CMemoryPool *mp, char *path)
+{
+	CCostModelParamsGPDB *cost_model_params = NULL;
+	CParseHandlerDXL *dxl_parse_handler = NULL;
+
+	GPOS_TRY
+	{
+		if (NULL != path && '\0' != path[0])
+		{
+			dxl_parse_handler =
+				CDXLUtils::GetParseHandlerForDXLFile(mp, path, NULL);
+			if (NULL != dxl_parse_handler &&
+				NULL != dxl_parse_handler->GetCostModelParams())
+			{
+				elog(DEBUG2, "\n[OPT]: Using cost model parameters in (%s)",
+					 path);
+
+				cost_model_params = dynamic_cast<CCostModelParamsGPDB *>(
+					dxl_parse_handler->GetCostModelParams());
+				cost_model_params->AddRef();
+			}
+		}
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (GPOS_MATCH_EX(ex, gpdxl::ExmaGPDB, gpdxl::ExmiGPDBError))
+		{
+			GPOS_RETHROW(ex);
+		}
+		elog(DEBUG2, "\n[OPT]: Using default cost model parameters");
+		GPOS_RESET_EX;
+	}
+	GPOS_CATCH_END;
+
+	GPOS_DELETE(dxl_parse_handler);
+
+	return cost_model_params;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::CreateOptimizerConfig
@@ -479,7 +630,12 @@ COptTasks::GetCostModel(CMemoryPool *mp, ULONG num_segments)
 	ICostModel *cost_model = NULL;
 	if (optimizer_cost_model >= OPTIMIZER_GPDB_CALIBRATED)
 	{
-		cost_model = GPOS_NEW(mp) CCostModelGPDB(mp, num_segments);
+		// the parameters of a calibration take the place of the defaults,
+		// the cost factor GUCs are applied on top of them below
+		CCostModelParamsGPDB *cost_model_params =
+			LoadCostModelParams(mp, optimizer_cost_model_params_path);
+		cost_model =
+			GPOS_NEW(mp) CCostModelGPDB(mp, num_segments, cost_model_params);
 	}
 	else
 	{
@@ -509,7 +665,12 @@ COptTasks::OptimizeTask(void *ptr)
 	GPOS_ASSERT(NULL == opt_ctxt->m_plan_dxl);
 	GPOS_ASSERT(NULL == opt_ctxt->m_plan_stmt);
 
-	AUTO_MEM_POOL(amp);
+	// everything allocated during optimization is released together with
+	// this pool, which is what arenas are made for
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc,
+						optimizer_use_arena_memory_pool
+							? CAutoMemoryPool::EptArena
+							: CAutoMemoryPool::EptDefault);
 	CMemoryPool *mp = amp.Pmp();
 
 	// Does the metadatacache need to be reset?
@@ -531,10 +692,57 @@ COptTasks::OptimizeTask(void *ptr)
 		CMDCache::Reset();
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
 	}
-	else if (CMDCache::ULLGetCacheQuota() !=
-			 (ULLONG) optimizer_mdcache_size * 1024L)
+	else
 	{
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		// drop the entries affected by catalog changes since the last query
+		const gpdb::MDCacheInvalidation *invalidations = NULL;
+		int num_invalidations = gpdb::MDCacheGetInvalidations(&invalidations);
+		if (0 < num_invalidations)
+		{
+			CMDCacheInvalidator mdcache_invalidator(mp, invalidations,
+													num_invalidations);
+			ULONG num_invalidated = mdcache_invalidator.UlInvalidate();
+			elog(DEBUG2,
+				 "\n[OPT]: Dropped %u metadata cache entries for %d catalog "
+				 "changes",
+				 num_invalidated, num_invalidations);
+		}
+
+		if (CMDCache::ULLGetCacheQuota() !=
+			(ULLONG) optimizer_mdcache_size * 1024L)
+		{
+			CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		}
+	}
+
+	// cached plans depend on the metadata they were optimized with, so any
+	// catalog change drops all of them
+	if (!optimizer_plan_caching)
+	{
+		if (CPlanCache::FInitialized())
+		{
+			CPlanCache::Shutdown();
+		}
+	}
+	else if (!CPlanCache::FInitialized())
+	{
+		CPlanCache::Init();
+		CPlanCache::SetCacheQuota(optimizer_plan_cache_size * 1024L);
+	}
+	else
+	{
+		const gpdb::MDCacheInvalidation *invalidations = NULL;
+		if (reset_mdcache ||
+			0 < gpdb::MDCacheGetInvalidations(&invalidations))
+		{
+			CPlanCache::Reset();
+			CPlanCache::SetCacheQuota(optimizer_plan_cache_size * 1024L);
+		}
+		else if (CPlanCache::ULLGetCacheQuota() !=
+				 (ULLONG) optimizer_plan_cache_size * 1024L)
+		{
+			CPlanCache::SetCacheQuota(optimizer_plan_cache_size * 1024L);
+		}
 	}
 
 
@@ -574,13 +782,23 @@ COptTasks::OptimizeTask(void *ptr)
 				num_segments_for_costing = num_segments;
 			}
 
-			CAutoP<CTranslatorQueryToDXL> query_to_dxl_translator;
-			query_to_dxl_translator = CTranslatorQueryToDXL::QueryToDXLInstance(
-				mp, &mda, (Query *) opt_ctxt->m_query);
-
+			// where the optimizer spends its time is collected for EXPLAIN,
+			// if asked for, as it times every xform
+			CWallClock clock;
 			ICostModel *cost_model = GetCostModel(mp, num_segments_for_costing);
 			COptimizerConfig *optimizer_config =
 				CreateOptimizerConfig(mp, cost_model);
+			if (optimizer_explain_profile)
+			{
+				optimizer_config->SetOptimizationStats(
+					GPOS_NEW(mp) COptimizationStats(mp));
+			}
+			COptimizationStats *optimization_stats =
+				optimizer_config->GetOptimizationStats();
+
+			CAutoP<CTranslatorQueryToDXL> query_to_dxl_translator;
+			query_to_dxl_translator = CTranslatorQueryToDXL::QueryToDXLInstance(
+				mp, &mda, (Query *) opt_ctxt->m_query);
 			CConstExprEvaluatorProxy expr_eval_proxy(mp, &mda);
 			IConstExprEvaluator *expr_evaluator =
 				GPOS_NEW(mp) CConstExprEvaluatorDXL(mp, &mda, &expr_eval_proxy);
@@ -592,6 +810,18 @@ COptTasks::OptimizeTask(void *ptr)
 			CDXLNodeArray *cte_dxlnode_array =
 				query_to_dxl_translator->GetCTEs();
 			GPOS_ASSERT(NULL != query_output_dxlnode_array);
+			if (NULL != optimization_stats)
+			{
+				optimization_stats->AddPhaseTime(
+					COptimizationStats::EphQueryTranslation,
+					clock.ElapsedUS());
+			}
+
+			if (optimizer_prefetch_metadata)
+			{
+				CMDPrefetcher md_prefetcher(mp, &mda);
+				md_prefetcher.Prefetch((Query *) opt_ctxt->m_query);
+			}
 
 			BOOL is_master_only =
 				!optimizer_enable_motions ||
@@ -610,7 +840,20 @@ COptTasks::OptimizeTask(void *ptr)
 				cte_dxlnode_array, expr_evaluator, num_segments, gp_session_id,
 				gp_command_count, search_strategy_arr, optimizer_config);
 
-			if (opt_ctxt->m_should_serialize_plan_dxl)
+			if (opt_ctxt->m_should_serialize_plan_dxl &&
+				GPOS_FTRACE(EopttraceBinaryDXL))
+			{
+				// serialize DXL to binary, printed in hex
+				ULONG length = 0;
+				CAutoRg<BYTE> plan_binary(CDXLUtils::SerializePlanToBinary(
+					mp, plan_dxl,
+					optimizer_config->GetEnumeratorCfg()->GetPlanId(),
+					optimizer_config->GetEnumeratorCfg()->GetPlanSpaceSize(),
+					&length));
+				opt_ctxt->m_plan_dxl =
+					CreateHexStringFromBinary(plan_binary.Rgt(), length);
+			}
+			else if (opt_ctxt->m_should_serialize_plan_dxl)
 			{
 				// serialize DXL to xml
 				CWStringDynamic plan_str(mp);
@@ -629,11 +872,24 @@ COptTasks::OptimizeTask(void *ptr)
 			{
 				// always use opt_ctxt->m_query->can_set_tag as the query_to_dxl_translator->Pquery() is a mutated Query object
 				// that may not have the correct can_set_tag
+				clock.Restart();
 				opt_ctxt->m_plan_stmt =
 					(PlannedStmt *) gpdb::CopyObject(ConvertToPlanStmtFromDXL(
 						mp, &mda, opt_ctxt->m_query, plan_dxl,
 						opt_ctxt->m_query->canSetTag,
 						query_to_dxl_translator->GetDistributionHashOpsKind()));
+				if (NULL != optimization_stats)
+				{
+					optimization_stats->AddPhaseTime(
+						COptimizationStats::EphPlanTranslation,
+						clock.ElapsedUS());
+
+					optimization_stats->RecordMetadata(
+						(ULLONG)(mda.DFetchTime().Get() * GPOS_USEC_IN_MSEC),
+						mda.UlCacheHits(), mda.UlCacheMisses());
+					opt_ctxt->m_plan_stmt->optimizerProfile =
+						CreateOptimizerProfile(optimization_stats);
+				}
 			}
 
 			CStatisticsConfig *stats_conf = optimizer_config->GetStatsConf();
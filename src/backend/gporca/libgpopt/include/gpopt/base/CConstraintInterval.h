@@ -26,6 +26,8 @@
 
 namespace gpopt
 {
+class CDatumSortedSet;
+
 // range array
 typedef CDynamicPtrArray<CRange, CleanupRelease> CRangeArray;
 
@@ -55,6 +57,15 @@ private:
 	// does the interval include the null value
 	BOOL m_fIncludesNull;
 
+	// is the interval derived from an IN or NOT IN list
+	BOOL m_fFromArray;
+
+	// are all the given ranges single datum points
+	static BOOL FPointsOnly(CRangeArray *pdrgprng);
+
+	// does the current interval contain all the given sorted points
+	BOOL FContainsPoints(CRangeArray *pdrgprngPoints) const;
+
 	// adds ranges from a source array to a destination array, starting
 	// at the range with the given index
 	void AddRemainingRanges(CMemoryPool *mp, CRangeArray *pdrgprngSrc,
@@ -119,7 +130,8 @@ public:
 
 	// ctor
 	CConstraintInterval(CMemoryPool *mp, const CColRef *colref,
-						CRangeArray *pdrgprng, BOOL is_null);
+						CRangeArray *pdrgprng, BOOL is_null,
+						BOOL fFromArray = false);
 
 	// dtor
 	~CConstraintInterval() override;
@@ -152,6 +164,13 @@ public:
 		return m_fIncludesNull;
 	}
 
+	// is the interval derived from an IN or NOT IN list
+	BOOL
+	FFromArray() const
+	{
+		return m_fFromArray;
+	}
+
 	// is this constraint a contradiction
 	BOOL FContradiction() const override;
 
@@ -251,6 +270,11 @@ public:
 		CMemoryPool *mp, CExpression *pexpr, CColRef *colref,
 		BOOL infer_nulls_as = false);
 
+	// create interval from an IN or NOT IN list of sorted values
+	static CConstraintInterval *PciIntervalFromDatumSortedSet(
+		CMemoryPool *mp, CColRef *colref, IMDType::ECmpType cmp_type,
+		const CDatumSortedSet *pdatumsortedset, BOOL infer_nulls_as = false);
+
 };	// class CConstraintInterval
 
 // shorthand for printing, reference
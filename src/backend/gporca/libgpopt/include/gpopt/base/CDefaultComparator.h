@@ -76,6 +76,12 @@ private:
 				   EopttraceUseExternalConstantExpressionEvaluationForInts);
 	}
 
+	// return true iff the two data are integers compared by the built-in
+	// evaluators; the type is taken from the datum, not looked up in the
+	// metadata cache
+	static BOOL FUseBuiltinIntComparison(const IDatum *datum1,
+										 const IDatum *datum2);
+
 public:
 	CDefaultComparator(const CDefaultComparator &) = delete;
 
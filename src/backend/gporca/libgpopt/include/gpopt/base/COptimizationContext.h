@@ -341,12 +341,6 @@ public:
 										  COptimizationContext *poc,
 										  ULONG ulSearchStages);
 
-	// link for optimization context hash table in CGroup
-	SLink m_link;
-
-	// invalid optimization context, needed for hash table iteration
-	static const COptimizationContext m_ocInvalid;
-
 	// invalid optimization context pointer, needed for cost contexts hash table iteration
 	static const OPTCTXT_PTR m_pocInvalid;
 
@@ -12,7 +12,9 @@
 #define GPOPT_CEngine_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 
+#include "gpopt/engine/COptimizationStats.h"
 #include "gpopt/xforms/CXform.h"
 #include "gpopt/search/CMemo.h"
 #include "gpopt/search/CSearchStage.h"
@@ -80,6 +82,12 @@ private:
 	// number of alternatives generated by each xform
 	UlongPtrArray *m_pdrgpulpXformResults;
 
+	// counters of the optimization requested by the caller, if any
+	COptimizationStats *m_optimization_stats;
+
+	// time since the end of the last timed phase
+	CWallClock m_phase_timer;
+
 #ifdef GPOS_DEBUG
 
 	// a set of internal debugging function used for recursive
@@ -149,6 +157,9 @@ private:
 	// create and schedule the main optimization job
 	void ScheduleMainJob(CSchedulerContext *psc, COptimizationContext *poc);
 
+	// add the time since the end of the last timed phase to the given one
+	void RecordPhase(COptimizationStats::EPhase eph);
+
 	// print activated xform
 	void PrintActivatedXforms(IOstream &os) const;
 
@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		COptimizationStats.h
+//
+//	@doc:
+//		Counters of a single optimization
+//---------------------------------------------------------------------------
+#ifndef GPOPT_COptimizationStats_H
+#define GPOPT_COptimizationStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CRefCount.h"
+#include "gpos/memory/CMemoryPool.h"
+
+namespace gpopt
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		COptimizationStats
+//
+//	@doc:
+//		Counters filled in while a query is optimized: time spent in every
+//		phase, metadata fetches, memo size, number of search stages, and the
+//		applications of every xform. They are only collected when an
+//		instance is attached to the optimizer configuration, and are read
+//		by the caller once optimization is complete.
+//
+//		The phases before and after the optimizer proper, translating the
+//		query into DXL and the plan out of it, are timed by the caller.
+//
+//---------------------------------------------------------------------------
+class COptimizationStats : public CRefCount
+{
+public:
+	// phases of an optimization
+	enum EPhase
+	{
+		EphQueryTranslation = 0,  // query to DXL to expression
+		EphPreprocessing,
+		EphExploration,
+		EphStatsDerivation,
+		EphImplementation,
+		EphOptimization,
+		EphPlanTranslation,	 // expression to DXL to plan
+
+		EphSentinel
+	};
+
+private:
+	// time spent in every phase, in microseconds
+	ULLONG m_rgullPhaseTimes[EphSentinel];
+
+	// time spent fetching metadata from the providers, in microseconds
+	ULLONG m_ullMDFetchTime;
+
+	// number of metadata lookups found in the cache, and fetched from the
+	// providers
+	ULONG m_ulMDCacheHits;
+	ULONG m_ulMDCacheMisses;
+
+	// number of memo groups
+	ULONG m_ulGroups;
+
+	// number of duplicate memo groups
+	ULONG m_ulDuplicateGroups;
+
+	// number of group expressions
+	ULONG m_ulGroupExprs;
+
+	// number of search stages run
+	ULONG m_ulSearchStages;
+
+	// number of applications of every xform that produced alternatives,
+	// indexed by xform id
+	ULONG *m_rgulXformCalls;
+
+	// number of alternatives produced by every xform
+	ULONG *m_rgulXformResults;
+
+	// time spent in every xform, in microseconds
+	ULLONG *m_rgullXformTimes;
+
+public:
+	COptimizationStats(const COptimizationStats &) = delete;
+
+	// ctor
+	explicit COptimizationStats(CMemoryPool *mp);
+
+	// dtor
+	~COptimizationStats() override;
+
+	// clear all counters
+	void Reset();
+
+	// add to the time spent in the given phase
+	void
+	AddPhaseTime(EPhase eph, ULLONG ullTimeUS)
+	{
+		GPOS_ASSERT(EphSentinel > eph);
+
+		m_rgullPhaseTimes[eph] += ullTimeUS;
+	}
+
+	// record the metadata lookups
+	void RecordMetadata(ULLONG ullFetchTimeUS, ULONG ulCacheHits,
+						ULONG ulCacheMisses);
+
+	// record the size of the memo
+	void RecordMemo(ULONG ulGroups, ULONG ulDuplicateGroups,
+					ULONG ulGroupExprs);
+
+	// record the number of search stages run
+	void
+	RecordSearchStages(ULONG ulSearchStages)
+	{
+		m_ulSearchStages = ulSearchStages;
+	}
+
+	// record an application of the given xform
+	void RecordXform(ULONG ulXform, ULONG ulResults, ULONG ulTimeUS);
+
+	// time spent in the given phase, in microseconds
+	ULLONG
+	UllPhaseTime(EPhase eph) const
+	{
+		GPOS_ASSERT(EphSentinel > eph);
+
+		return m_rgullPhaseTimes[eph];
+	}
+
+	// time spent fetching metadata, in microseconds
+	ULLONG
+	UllMDFetchTime() const
+	{
+		return m_ullMDFetchTime;
+	}
+
+	// number of metadata lookups found in the cache
+	ULONG
+	UlMDCacheHits() const
+	{
+		return m_ulMDCacheHits;
+	}
+
+	// number of metadata lookups fetched from the providers
+	ULONG
+	UlMDCacheMisses() const
+	{
+		return m_ulMDCacheMisses;
+	}
+
+	// number of memo groups
+	ULONG
+	UlGroups() const
+	{
+		return m_ulGroups;
+	}
+
+	// number of duplicate memo groups
+	ULONG
+	UlDuplicateGroups() const
+	{
+		return m_ulDuplicateGroups;
+	}
+
+	// number of group expressions
+	ULONG
+	UlGroupExprs() const
+	{
+		return m_ulGroupExprs;
+	}
+
+	// number of search stages run
+	ULONG
+	UlSearchStages() const
+	{
+		return m_ulSearchStages;
+	}
+
+	// number of applications of the given xform
+	ULONG UlXformCalls(ULONG ulXform) const;
+
+	// number of alternatives produced by the given xform
+	ULONG UlXformResults(ULONG ulXform) const;
+
+	// time spent in the given xform, in microseconds
+	ULLONG UllXformTime(ULONG ulXform) const;
+
+	// total number of xform applications
+	ULONG UlXformCallsTotal() const;
+
+	// fill the given array with the ids of the applied xforms that took the
+	// most time, slowest first; return their number
+	ULONG UlTopXforms(ULONG *rgulXforms, ULONG ulSize) const;
+
+	// name of the given phase
+	static const CHAR *SzPhase(EPhase eph);
+
+	// print function
+	IOstream &OsPrint(IOstream &os) const;
+
+};	// class COptimizationStats
+
+}  // namespace gpopt
+
+#endif	// !GPOPT_COptimizationStats_H
+
+// EOF
@@ -223,6 +223,11 @@ private:
 	// this time is currently dominated by serialization time
 	CDouble m_dFetchTime;
 
+	// number of objects found in the MD cache, and fetched from the MD
+	// providers
+	ULONG m_ulCacheHits;
+	ULONG m_ulCacheMisses;
+
 	// interface to a MD cache object
 	const IMDCacheObject *GetImdObj(IMDId *mdid);
 
@@ -288,6 +293,27 @@ public:
 		return m_pcache;
 	}
 
+	// total time spent fetching objects from the MD providers, in msec
+	CDouble
+	DFetchTime() const
+	{
+		return m_dFetchTime;
+	}
+
+	// number of objects found in the MD cache
+	ULONG
+	UlCacheHits() const
+	{
+		return m_ulCacheHits;
+	}
+
+	// number of objects fetched from the MD providers
+	ULONG
+	UlCacheMisses() const
+	{
+		return m_ulCacheMisses;
+	}
+
 	// register a new MD provider
 	void RegisterProvider(CSystemId sysid, IMDProvider *pmdp);
 
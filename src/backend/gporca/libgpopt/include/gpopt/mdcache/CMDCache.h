@@ -74,6 +74,19 @@ public:
 	// get the number of times we evicted entries from this cache
 	static ULLONG ULLGetCacheEvictionCounter();
 
+	// get the number of cache lookups that found a metadata object
+	static ULLONG ULLGetCacheHitCounter();
+
+	// get the number of cache lookups that did not find a metadata object
+	static ULLONG ULLGetCacheMissCounter();
+
+	// get the number of metadata objects dropped by invalidation
+	static ULLONG ULLGetCacheInvalidationCounter();
+
+	// drop the metadata objects selected by the given predicate
+	static ULONG UlInvalidate(
+		CMDAccessor::MDCache::InvalidateFuncPtr pfnInvalidate, void *pvArg);
+
 	// reset global instance
 	static void Reset();
 
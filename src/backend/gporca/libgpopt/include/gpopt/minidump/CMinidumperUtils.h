@@ -48,6 +48,10 @@ public:
 	// finalize minidump and dump to a file
 	static void Finalize(CMiniDumperDXL *pmdp, BOOL fSerializeErrCtx);
 
+	// write the given finalized minidump to a file, as binary DXL or XML
+	static void Write(CMemoryPool *mp, const CHAR *file_name,
+					  const CWStringDynamic *str, BOOL fBinary);
+
 	// load and execute the minidump in the specified file
 	static CDXLNode *PdxlnExecuteMinidump(CMemoryPool *mp,
 										  const CHAR *file_name,
@@ -14,6 +14,8 @@
 #define GPOPT_CExpressionPreprocessor_H
 
 #include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CTimerUser.h"
 #include "gpopt/base/CColumnFactory.h"
 
 #include "gpopt/operators/CExpression.h"
@@ -47,6 +49,84 @@ private:
 						 CleanupRelease<CExpressionArray> >
 		CTEPredsMapIter;
 
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CPassTracker
+	//
+	//	@doc:
+	//		Carries the expression through the preprocessing passes. A pass
+	//		that only acts on some operators is skipped when none of them is
+	//		in the expression; the operators in the expression are collected
+	//		again only after a pass changed it. Passes return their input
+	//		when they change nothing. Pass times are traced along with the
+	//		other optimization statistics
+	//
+	//---------------------------------------------------------------------------
+	class CPassTracker
+	{
+	private:
+		// memory pool
+		CMemoryPool *m_mp;
+
+		// current expression
+		CExpression *m_pexpr;
+
+		// operators in the current expression, NULL if not collected yet
+		CBitSet *m_pbsOperators;
+
+		// name of the running pass
+		const CHAR *m_szPass;
+
+		// timer of the running pass
+		CTimerUser m_timer;
+
+		// trace pass times?
+		BOOL m_fTrace;
+
+		// number of passes run, skipped, and run without changes
+		ULONG m_ulRun;
+		ULONG m_ulSkipped;
+		ULONG m_ulUnchanged;
+
+		// collect the operators in the given expression
+		static void CollectOperators(CExpression *pexpr, CBitSet *pbs);
+
+	public:
+		CPassTracker(const CPassTracker &) = delete;
+
+		// ctor
+		CPassTracker(CMemoryPool *mp, CExpression *pexpr);
+
+		// dtor
+		~CPassTracker();
+
+		// current expression
+		CExpression *
+		Pexpr() const
+		{
+			return m_pexpr;
+		}
+
+		// start the given pass, unless it acts on the given operators only
+		// and none of them is in the current expression
+		BOOL FStart(const CHAR *szPass,
+					COperator::EOperatorId eopid1 = COperator::EopSentinel,
+					COperator::EOperatorId eopid2 = COperator::EopSentinel,
+					COperator::EOperatorId eopid3 = COperator::EopSentinel);
+
+		// finish the running pass with the expression it returned
+		void Finish(CExpression *pexprNew);
+
+		// hand over the current expression
+		CExpression *PexprResult();
+
+	};	// class CPassTracker
+
+	// expression with the operator of the given expression and the given
+	// children; the given expression itself if they are its own children
+	static CExpression *PexprRebuild(CMemoryPool *mp, CExpression *pexpr,
+									 CExpressionArray *pdrgpexprChildren);
+
 	// generate a conjunction of equality predicates between the columns in the given set
 	static CExpression *PexprConjEqualityPredicates(CMemoryPool *mp,
 													CColRefSet *pcrs);
@@ -59,13 +59,6 @@ private:
 	static BOOL FValidRefsOnly(CExpression *pexprScalar,
 							   CColRefSet *pcrsAllowedRefs);
 
-	// determine which predicates we should test implication for
-	static BOOL FCheckPredicateImplication(CExpression *pexprPred);
-
-	// check if predicate is implied by given equivalence classes
-	static BOOL FImpliedPredicate(CExpression *pexprPred,
-								  CColRefSetArray *pdrgpcrsEquivClasses);
-
 	// helper to create index lookup comparison predicate with index key on left side
 	static CExpression *PexprIndexLookupKeyOnLeft(CMemoryPool *mp,
 												  CMDAccessor *md_accessor,
@@ -406,6 +399,13 @@ public:
 													CExpression *pexprScalar,
 													CExpressionHandle &exprhdl);
 
+	// determine which predicates we should test implication for
+	static BOOL FCheckPredicateImplication(CExpression *pexprPred);
+
+	// check if predicate is implied by given equivalence classes
+	static BOOL FImpliedPredicate(CExpression *pexprPred,
+								  CColRefSetArray *pdrgpcrsEquivClasses);
+
 	//	check if given correlations are valid for semi join operator;
 	static BOOL FValidSemiJoinCorrelations(
 		CMemoryPool *mp, CExpression *pexprOuter, CExpression *pexprInner,
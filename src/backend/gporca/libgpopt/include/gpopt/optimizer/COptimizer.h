@@ -12,7 +12,9 @@
 #define GPOPT_COptimizer_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 
+#include "gpopt/engine/COptimizationStats.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/search/CSearchStage.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
@@ -78,6 +80,10 @@ private:
 	static void PrintQueryOrPlan(CMemoryPool *mp, CExpression *pexpr,
 								 CQueryContext *pqc = NULL);
 
+	// add the time measured by the given clock to the given phase
+	static void RecordPhase(COptimizationStats *optimization_stats,
+							COptimizationStats::EPhase eph, CWallClock *clock);
+
 	// Check for a plan with CTE, if both CTEProducer and CTEConsumer are executed on the same locality.
 	static void CheckCTEConsistency(CMemoryPool *mp, CExpression *pexpr);
 
@@ -28,6 +28,7 @@ using namespace gpos;
 
 // forward decl
 class ICostModel;
+class COptimizationStats;
 
 //---------------------------------------------------------------------------
 //	@class:
@@ -65,6 +66,9 @@ private:
 	// default window oids
 	CWindowOids *m_window_oids;
 
+	// counters filled in during optimization, if any
+	COptimizationStats *m_optimization_stats;
+
 public:
 	// ctor
 	COptimizerConfig(CEnumeratorConfig *pec, CStatisticsConfig *stats_config,
@@ -117,6 +121,17 @@ public:
 		return m_hint;
 	}
 
+	// counters filled in during optimization, NULL if they are not
+	// collected
+	COptimizationStats *
+	GetOptimizationStats() const
+	{
+		return m_optimization_stats;
+	}
+
+	// collect counters of the optimization into the given object
+	void SetOptimizationStats(COptimizationStats *optimization_stats);
+
 	// generate default optimizer configurations
 	static COptimizerConfig *PoconfDefault(CMemoryPool *mp);
 
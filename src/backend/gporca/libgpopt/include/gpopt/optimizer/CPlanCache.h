@@ -0,0 +1,326 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CPlanCache.h
+//
+//	@doc:
+//		Cache of optimized plans, keyed on the normalized query DXL
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CPlanCache_H
+#define GPOPT_CPlanCache_H
+
+#include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/common/CRefCount.h"
+#include "gpos/memory/CCache.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/md/IMDId.h"
+
+namespace gpopt
+{
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpmd;
+
+// fwd declarations
+class COptimizerConfig;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CNormalizedQuery
+//
+//	@doc:
+//		A query in the form it is looked up in the plan cache: the key is
+//		the serialized query DXL with the values of all constants masked,
+//		followed by the optimizer configuration, the trace flags and the
+//		number of segments; the constants are kept apart, both serialized
+//		and as DXL nodes to be bound into a cached plan
+//
+//---------------------------------------------------------------------------
+class CNormalizedQuery
+{
+public:
+	// hash function for strings
+	static ULONG HashStr(const CWStringBase *str);
+
+	// equality function for strings
+	static BOOL EqualStrs(const CWStringBase *str1, const CWStringBase *str2);
+
+private:
+	// map from serialized constants to their positions
+	typedef CHashMap<CWStringBase, ULONG, HashStr, EqualStrs,
+					 CleanupNULL<CWStringBase>, CleanupDelete<ULONG> >
+		StringToPosMap;
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// key of the query
+	CWStringDynamic *m_key;
+
+	// serialized constants, in the order they appear in the query
+	CWStringDynamic *m_constants_str;
+
+	// constants, in the same order
+	CDXLNodeArray *m_constants;
+
+	// each constant serialized on its own
+	StringPtrArray *m_constant_strs;
+
+	// positions of the constants, for the first of equal ones
+	StringToPosMap *m_positions;
+
+	// types of the constants
+	MdidHashSet *m_const_types;
+
+	// is any of the constants null?
+	BOOL m_has_null;
+
+	// are two of the constants equal?
+	BOOL m_has_duplicates;
+
+	// does the query hold values other than in scalar const values?
+	BOOL m_has_other_datums;
+
+	// copy of the given tree with the values of all constants masked,
+	// collecting the constants
+	CDXLNode *PdxlnMask(const CDXLNode *dxlnode);
+
+	// same as above for an array of trees
+	CDXLNodeArray *PdrgpdxlnMask(const CDXLNodeArray *dxl_array);
+
+	// add a constant of the query
+	void AddConstant(CDXLNode *dxlnode);
+
+public:
+	CNormalizedQuery(const CNormalizedQuery &) = delete;
+
+	// ctor
+	CNormalizedQuery(CMemoryPool *mp, const CDXLNode *query,
+					 const CDXLNodeArray *query_output_dxlnode_array,
+					 const CDXLNodeArray *cte_producers,
+					 const COptimizerConfig *optimizer_config, ULONG ulHosts);
+
+	// dtor
+	~CNormalizedQuery();
+
+	// key of the query
+	const CWStringDynamic *
+	Key() const
+	{
+		return m_key;
+	}
+
+	// serialized constants
+	const CWStringDynamic *
+	ConstantsStr() const
+	{
+		return m_constants_str;
+	}
+
+	// constants
+	const CDXLNodeArray *
+	Constants() const
+	{
+		return m_constants;
+	}
+
+	// can the constants of the query be bound into a rebindable plan?
+	BOOL
+	FBindable() const
+	{
+		return !m_has_null;
+	}
+
+	// can a plan of the query be made rebindable?
+	BOOL
+	FRebindable() const
+	{
+		return !m_has_null && !m_has_duplicates && !m_has_other_datums;
+	}
+
+	// position of the constant with the given serialization, if any
+	ULONG UlPosition(const CWStringBase *str) const;
+
+	// is there a constant of the given type?
+	BOOL FConstType(IMDId *mdid) const;
+
+	// serialize a const value on its own
+	static CWStringDynamic *PstrConst(CMemoryPool *mp,
+									  const CDXLNode *dxlnode);
+
+};	// class CNormalizedQuery
+
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CPlanCacheEntry
+//
+//	@doc:
+//		A cached plan, along with the query it was optimized for. A plan is
+//		rebindable if each of its constants that may come from the query
+//		is known to be a copy of one particular query constant, so that
+//		binding the plan to other constants replaces exactly these
+//
+//---------------------------------------------------------------------------
+class CPlanCacheEntry : public CRefCount
+{
+private:
+	// key of the query
+	CWStringDynamic *m_key;
+
+	// serialized constants of the query
+	CWStringDynamic *m_constants_str;
+
+	// binary DXL of the plan
+	BYTE *m_plan;
+
+	// length of the binary DXL
+	ULONG m_plan_length;
+
+	// for every const value of the plan in pre-order, the position of the
+	// query constant it is a copy of; NULL if the plan is not rebindable
+	ULONG *m_const_positions;
+
+	// number of const values of the plan
+	ULONG m_num_plan_consts;
+
+	// collect the positions of the query constants that the const values
+	// below the given node are copies of; returns false if the plan is
+	// not rebindable
+	static BOOL FCollectPositions(CMemoryPool *mp, const CDXLNode *dxlnode,
+								  const CNormalizedQuery *query,
+								  ULongPtrArray *positions,
+								  CBitSet *found_positions);
+
+	// bind the const values below the given node to the constants of the
+	// given query
+	void Bind(CDXLNode *dxlnode, const CNormalizedQuery *query,
+			  ULONG *plan_const) const;
+
+public:
+	CPlanCacheEntry(const CPlanCacheEntry &) = delete;
+
+	// ctor
+	CPlanCacheEntry(CMemoryPool *mp, const CNormalizedQuery *query,
+					const CDXLNode *plan);
+
+	// dtor
+	~CPlanCacheEntry() override;
+
+	// key of the query
+	CWStringDynamic *
+	Key() const
+	{
+		return m_key;
+	}
+
+	// is the plan rebindable?
+	BOOL
+	FRebindable() const
+	{
+		return NULL != m_const_positions;
+	}
+
+	// does the cached plan fit the given query?
+	BOOL FMatch(const CNormalizedQuery *query) const;
+
+	// cached plan, bound to the constants of the given query
+	CDXLNode *PdxlnPlan(CMemoryPool *mp, const CNormalizedQuery *query) const;
+
+};	// class CPlanCacheEntry
+
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CPlanCache
+//
+//	@doc:
+//		A wrapper for a generic cache of optimized plans, encapsulating a
+//		singleton cache object, along the lines of CMDCache. Plans depend
+//		on the metadata they were optimized with; the cache does not track
+//		these dependencies, the caller resets it whenever metadata changes
+//
+//---------------------------------------------------------------------------
+class CPlanCache
+{
+public:
+	// type of the underlying cache
+	typedef CCache<CPlanCacheEntry *, CWStringDynamic *> PlanCache;
+
+private:
+	// pointer to the underlying cache
+	static PlanCache *m_pcache;
+
+	// the maximum size of the cache
+	static ULLONG m_ullCacheQuota;
+
+	// number of lookups that returned a plan
+	static ULLONG m_ullHitCounter;
+
+	// number of lookups that did not return a plan
+	static ULLONG m_ullMissCounter;
+
+	// hash function for keys
+	static ULONG UlHashKey(CWStringDynamic *const &key);
+
+	// equality function for keys
+	static BOOL FEqualKeys(CWStringDynamic *const &key1,
+						   CWStringDynamic *const &key2);
+
+	// private ctor
+	CPlanCache() = default;
+
+	// private dtor
+	~CPlanCache() = default;
+
+public:
+	CPlanCache(const CPlanCache &) = delete;
+
+	// initialize underlying cache
+	static void Init();
+
+	// has cache been initialized?
+	static BOOL
+	FInitialized()
+	{
+		return (NULL != m_pcache);
+	}
+
+	// destroy global instance
+	static void Shutdown();
+
+	// reset global instance
+	static void Reset();
+
+	// set the maximum size of the cache
+	static void SetCacheQuota(ULLONG ullCacheQuota);
+
+	// get the maximum size of the cache
+	static ULLONG ULLGetCacheQuota();
+
+	// get the number of lookups that returned a plan
+	static ULLONG ULLGetCacheHitCounter();
+
+	// get the number of lookups that did not return a plan
+	static ULLONG ULLGetCacheMissCounter();
+
+	// look up a plan for the given query; returns NULL on a miss
+	static CDXLNode *PdxlnLookup(CMemoryPool *mp,
+								 const CNormalizedQuery *query);
+
+	// cache the plan optimized for the given query
+	static void Insert(const CNormalizedQuery *query, const CDXLNode *plan);
+
+};	// class CPlanCache
+
+}  // namespace gpopt
+
+#endif	// !GPOPT_CPlanCache_H
+
+// EOF
@@ -14,9 +14,10 @@
 #include "gpos/base.h"
 
 #include "gpos/common/CDynamicPtrArray.h"
-#include "gpos/common/CSyncHashtable.h"
+#include "gpos/common/COpenHashtable.h"
 #include "gpos/common/CSyncList.h"
 
+#include "gpopt/base/COptimizationContext.h"
 #include "gpopt/search/CJobQueue.h"
 #include "gpopt/operators/CLogical.h"
 #include "gpopt/search/CTreeMap.h"
@@ -77,8 +78,9 @@ class CGroup : public CRefCount
 
 public:
 	// type definition of optimization context hash table
-	typedef CSyncHashtable<COptimizationContext,  // entry
-						   COptimizationContext /* search key */>
+	typedef COpenHashtable<COptimizationContext,
+						   COptimizationContext::HashValue,
+						   COptimizationContext::Equals>
 		ShtOC;
 
 	// states of a group
@@ -101,20 +103,11 @@ public:
 
 private:
 	// definition of hash table iter
-	typedef CSyncHashtableIter<COptimizationContext,  // entry
-							   COptimizationContext>
+	typedef COpenHashtableIter<COptimizationContext,
+							   COptimizationContext::HashValue,
+							   COptimizationContext::Equals>
 		ShtIter;
 
-	// definition of hash table iter accessor
-	typedef CSyncHashtableAccessByIter<COptimizationContext,  // entry
-									   COptimizationContext>
-		ShtAccIter;
-
-	// definition of hash table accessor
-	typedef CSyncHashtableAccessByKey<COptimizationContext,	 // entry
-									  COptimizationContext>
-		ShtAcc;
-
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		SContextLink
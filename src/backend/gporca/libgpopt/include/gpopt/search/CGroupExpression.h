@@ -424,7 +424,7 @@ public:
 	// link for list in Group
 	SLink m_linkGroup;
 
-	// link for group expression hash table
+	// link for the list of group expressions rehashed by the memo
 	SLink m_linkMemo;
 
 	// invalid group expression
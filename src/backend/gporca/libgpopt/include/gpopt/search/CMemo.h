@@ -12,8 +12,9 @@
 #define GPOPT_CMemo_H
 
 #include "gpos/base.h"
+#include "gpos/common/CList.h"
 #include "gpos/common/CRefCount.h"
-#include "gpos/common/CSyncHashtable.h"
+#include "gpos/common/COpenHashtable.h"
 #include "gpos/common/CSyncList.h"
 
 #include "gpopt/search/CGroupExpression.h"
@@ -44,20 +45,10 @@ using namespace gpos;
 class CMemo
 {
 private:
-	// definition of hash table key accessor
-	typedef CSyncHashtableAccessByKey<CGroupExpression,	 // entry
-									  CGroupExpression>
-		ShtAcc;
-
-	// definition of hash table iterator
-	typedef CSyncHashtableIter<CGroupExpression,  // entry
-							   CGroupExpression>
-		ShtIter;
-
-	// definition of hash table iterator accessor
-	typedef CSyncHashtableAccessByIter<CGroupExpression,  // entry
-									   CGroupExpression>
-		ShtAccIter;
+	// definition of group expressions hash table
+	typedef COpenHashtable<CGroupExpression, CGroupExpression::HashValue,
+						   CGroupExpression::Equals>
+		ShtGExpr;
 
 	// memory pool
 	CMemoryPool *m_mp;
@@ -78,9 +69,10 @@ private:
 	CSyncList<CGroup> m_listGroups;
 
 	// hashtable of all group expressions
-	CSyncHashtable<CGroupExpression,  // entry
-				   CGroupExpression>
-		m_sht;
+	ShtGExpr m_sht;
+
+	// group expressions of the hashtable in insertion order
+	CList<CGroupExpression> m_listGExprs;
 
 	// add new group
 	void Add(CGroup *pgroup, CExpression *pexprOrigin);
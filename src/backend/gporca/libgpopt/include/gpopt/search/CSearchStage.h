@@ -17,6 +17,10 @@
 
 #include "gpopt/xforms/CXform.h"
 
+// cost below which the plan of the first stage of an adaptive search
+// strategy is accepted without escalating to the full search
+#define GPOPT_ADAPTIVE_SEARCH_COST_THRESHOLD 10000.0
+
 
 namespace gpopt
 {
@@ -40,7 +44,52 @@ typedef CDynamicPtrArray<CSearchStage, CleanupDelete> CSearchStageArray;
 //---------------------------------------------------------------------------
 class CSearchStage
 {
+public:
+	// complexity classes of queries, used to pick an adaptive search
+	// strategy
+	enum EQueryComplexity
+	{
+		EqcSimple = 0,	// at most one join, no subqueries, no partitions
+		EqcModerate,
+		EqcComplex,
+
+		EqcSentinel
+	};
+
 private:
+	// counters describing the shape of a query
+	struct SQueryShape
+	{
+		// number of joins, an n-ary join counts as n-1
+		ULONG m_ulJoins;
+
+		// deepest nesting of subqueries
+		ULONG m_ulSubqueryDepth;
+
+		// number of partitioned tables
+		ULONG m_ulPartitionedTables;
+
+		// estimated number of memo groups
+		ULLONG m_ullMemoGroups;
+
+		SQueryShape()
+			: m_ulJoins(0),
+			  m_ulSubqueryDepth(0),
+			  m_ulPartitionedTables(0),
+			  m_ullMemoGroups(0)
+		{
+		}
+	};
+
+	// collect the shape of the given expression
+	static void CollectShape(CExpression *pexpr, ULONG ulSubqueryDepth,
+							 SQueryShape *pqs);
+
+	// exploration xforms without the given ones
+	static CXformSet *PxfsExplorationWithout(CMemoryPool *mp,
+											 const CXform::EXformId *rgexfid,
+											 ULONG ulXforms);
+
 	// set of xforms to be applied during stage
 	CXformSet *m_xforms;
 
@@ -143,6 +192,14 @@ public:
 
 	// generate default search strategy
 	static CSearchStageArray *PdrgpssDefault(CMemoryPool *mp);
+
+	// complexity class of the given preprocessed query
+	static EQueryComplexity Eqc(CExpression *pexpr);
+
+	// generate a search strategy for the complexity of the given
+	// preprocessed query
+	static CSearchStageArray *PdrgpssAdaptive(CMemoryPool *mp,
+											  CExpression *pexpr);
 };
 
 // shorthand for printing
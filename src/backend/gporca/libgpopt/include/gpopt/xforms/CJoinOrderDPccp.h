@@ -0,0 +1,203 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CJoinOrderDPccp.h
+//
+//	@doc:
+//		Dynamic programming-based join order generation enumerating
+//		connected subgraph complement pairs
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CJoinOrderDPccp_H
+#define GPOPT_CJoinOrderDPccp_H
+
+#include "gpos/base.h"
+#include "gpos/io/IOstream.h"
+#include "gpopt/xforms/CJoinOrder.h"
+#include "gpopt/operators/CExpression.h"
+
+// maximum number of components the enumerator accepts, its tables have an
+// entry for every subset of the components
+#define GPOPT_DPCCP_MAX_COMPONENTS ULONG(16)
+
+namespace gpopt
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CJoinOrderDPccp
+//
+//	@doc:
+//		Helper class for creating join orders using dynamic programming.
+//
+//		Sets of components are ULLONG bit masks, and the DP tables are flat
+//		arrays indexed by them. Only pairs of disjoint connected sets that
+//		are connected to each other are enumerated (DPccp, Moerkotte and
+//		Neumann, VLDB 2006), in an order where the best plan of a set is
+//		final before the set is joined with another; the number of pairs
+//		grows with the shape of the join graph rather than with 3^n.
+//
+//		An edge covering more than two components is a hyperedge; for the
+//		enumeration it connects each pair of its components, and it becomes
+//		a predicate of the lowest join that covers it. Non-inner joins are
+//		components of their own, as in the other join order helpers that
+//		do not include LOJ children.
+//
+//		The cost of a join is the cost of its children plus their number
+//		of rows, and components are costed the same way down to their
+//		leaves. Statistics are only derived for the best plan of each set,
+//		when the set is joined with another, and straight from the
+//		statistics and equivalence classes of its two inputs, as join
+//		stats derivation would on the join expression; they only carry
+//		the histograms of the columns of the edges leaving the set.
+//		Expressions are only created for the join orders that are
+//		returned.
+//
+//---------------------------------------------------------------------------
+class CJoinOrderDPccp : public CJoinOrder
+{
+private:
+	// set of components
+	typedef ULLONG SET;
+
+	// set of all components
+	SET m_setAll;
+
+	// components connected to each component by an edge
+	SET *m_rgsetNeighbors;
+
+	// components covered by each edge
+	SET *m_rgsetEdgeCover;
+
+	// DP table: left input of the best join of a set, empty if the set
+	// has no plan
+	SET *m_rgsetBestLeft;
+
+	// DP table: cost of the best plan of a set
+	DOUBLE *m_rgdCost;
+
+	// DP table: expression of the best plan of a set, created on demand
+	CExpression **m_rgpexpr;
+
+	// DP table: statistics of the best plan of a set, derived on demand
+	IStatistics **m_rgpstats;
+
+	// DP table: equivalence classes of the best plan of a set, derived
+	// with its statistics
+	CColRefSetArray **m_rgpdrgpcrs;
+
+	// equivalence classes of each edge, NULL if it has none
+	CColRefSetArray **m_rgpdrgpcrsEdge;
+
+	// columns used by the edges, the components producing them, and the
+	// components covered by the edges using them
+	ULONG m_ulEdgeCols;
+	CColRef **m_rgpcrEdgeCol;
+	SET *m_rgsetEdgeColComp;
+	SET *m_rgsetEdgeColUsers;
+
+	// does each edge use a column produced by no component
+	BOOL *m_rgfEdgeOuterRefs;
+
+	// operator of the joins whose statistics are derived
+	COperator *m_popJoin;
+
+	// left inputs and costs of the best joins of all components
+	SET *m_rgsetTopKLeft;
+	DOUBLE *m_rgdTopKCost;
+	ULONG m_ulTopK;
+
+	// array of top-k join expression
+	CExpressionArray *m_pdrgpexprTopKOrders;
+
+	// cost of the given component
+	DOUBLE DCostComponent(CExpression *pexpr);
+
+	// is the given column of the edges produced by the given set and used
+	// by an edge leaving it
+	BOOL FEdgeColLeaving(ULONG ulCol, SET set) const;
+
+	// equivalence classes of the given set for joining it with others
+	CColRefSetArray *PdrgpcrsEdgeCols(CColRefSetArray *pdrgpcrs,
+									  SET set) const;
+
+	// statistics of the given set for joining it with others
+	IStatistics *PstatsEdgeCols(const IStatistics *stats, SET set) const;
+
+	// lowest component in the given set
+	static ULONG UlLowest(SET set);
+
+	// components connected to the given set by an edge, and not in the
+	// given excluded set
+	SET SetNeighbors(SET set, SET setExcluded) const;
+
+	// enumerate the connected sets that extend the given one with
+	// components not in the given excluded set
+	void EnumerateCsgRec(SET set, SET setExcluded);
+
+	// enumerate the complements of the given connected set
+	void EmitCsg(SET set);
+
+	// enumerate the complements of the first set that extend the second
+	// one with components not in the given excluded set
+	void EnumerateCmpRec(SET setFst, SET setSnd, SET setExcluded);
+
+	// consider joining the given sets
+	void EmitCsgCmp(SET setFst, SET setSnd);
+
+	// add the given join of all components to the top-k joins
+	void AddJoinOrder(SET setLeft, DOUBLE dCost);
+
+	// expression of the best plan of the given set
+	CExpression *PexprBest(SET set);
+
+	// statistics of the best plan of the given set
+	IStatistics *PstatsBest(SET set);
+
+	// predicate joining the two given sets
+	CExpression *PexprPred(SET setFst, SET setSnd) const;
+
+	// join the plans of the two given sets
+	CExpression *PexprJoin(SET setFst, SET setSnd);
+
+	// cross product of the best plans of the connected parts of all
+	// components, for join graphs that are not connected
+	CExpression *PexprCross();
+
+	// derive stats on given expression
+	void DeriveStats(CExpression *pexpr) override;
+
+public:
+	// ctor
+	CJoinOrderDPccp(CMemoryPool *mp, CExpressionArray *pdrgpexprComponents,
+					CExpressionArray *pdrgpexprConjuncts);
+
+	// dtor
+	~CJoinOrderDPccp() override;
+
+	// main handler
+	virtual CExpression *PexprExpand();
+
+	// best join orders
+	CExpressionArray *
+	PdrgpexprTopK() const
+	{
+		return m_pdrgpexprTopKOrders;
+	}
+
+	// print function
+	IOstream &OsPrint(IOstream &) const;
+
+#ifdef GPOS_DEBUG
+	void DbgPrint();
+#endif
+
+};	// class CJoinOrderDPccp
+
+}  // namespace gpopt
+
+#endif	// !GPOPT_CJoinOrderDPccp_H
+
+// EOF
@@ -24,6 +24,7 @@
 #include "gpopt/base/CConstraintConjunction.h"
 #include "gpopt/base/CConstraintDisjunction.h"
 #include "gpopt/base/CConstraintNegation.h"
+#include "gpopt/base/CDatumSortedSet.h"
 #include "gpopt/operators/CScalarIdent.h"
 #include "gpopt/operators/CScalarArrayCmp.h"
 #include "gpopt/operators/CScalarCmp.h"
@@ -70,6 +71,46 @@ CConstraint::~CConstraint()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		PciFromSortedArray
+//
+//	@doc:
+//		Create an interval constraint from an IN ('= ANY') or NOT IN
+//		('<> ALL') list of constants, sorting and de-duplicating the list
+//		once instead of creating and merging an interval per element.
+//		Returns NULL for other array comparisons and for lists with NULLs
+//
+//---------------------------------------------------------------------------
+static CConstraint *
+PciFromSortedArray(CMemoryPool *mp, CExpression *pexprArray, CColRef *colref,
+				   IMDType::ECmpType cmp_type,
+				   CScalarArrayCmp::EArrCmpType earrccmpt, BOOL infer_nulls_as)
+{
+	GPOS_ASSERT(0 < CUtils::UlScalarArrayArity(pexprArray));
+
+	if (!(IMDType::EcmptEq == cmp_type &&
+		  CScalarArrayCmp::EarrcmpAny == earrccmpt) &&
+		!(IMDType::EcmptNEq == cmp_type &&
+		  CScalarArrayCmp::EarrcmpAll == earrccmpt))
+	{
+		return NULL;
+	}
+
+	const IComparator *pcomp = COptCtxt::PoctxtFromTLS()->Pcomp();
+	CAutoRef<CDatumSortedSet> apdatumsortedset(
+		GPOS_NEW(mp) CDatumSortedSet(mp, pexprArray, pcomp));
+	if (apdatumsortedset->FIncludesNull())
+	{
+		// a NULL element makes the comparison NULL instead of false for
+		// the values not in the list
+		return NULL;
+	}
+
+	return CConstraintInterval::PciIntervalFromDatumSortedSet(
+		mp, colref, cmp_type, apdatumsortedset.Value(), infer_nulls_as);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CConstraint::PcnstrFromScalarArrayCmp
@@ -124,7 +165,8 @@ CConstraint::PcnstrFromScalarArrayCmp(CMemoryPool *mp, CExpression *pexpr,
 		const ULONG arity = CUtils::UlScalarArrayArity(pexprArray);
 
 		// When array size exceeds the constraint derivation threshold,
-		// don't expand it into a DNF and don't derive constraints
+		// don't expand it into a DNF. IN and NOT IN lists of constants still
+		// get a constraint: a single interval built from the sorted values
 		COptimizerConfig *optimizer_config =
 			COptCtxt::PoctxtFromTLS()->GetOptimizerConfig();
 		ULONG array_expansion_threshold =
@@ -132,7 +174,8 @@ CConstraint::PcnstrFromScalarArrayCmp(CMemoryPool *mp, CExpression *pexpr,
 
 		if (arity > array_expansion_threshold)
 		{
-			return NULL;
+			return PciFromSortedArray(mp, pexprArray, colref, cmp_type,
+									  earrccmpt, infer_nulls_as);
 		}
 
 		if (arity == 0)
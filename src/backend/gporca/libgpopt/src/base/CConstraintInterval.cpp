@@ -21,12 +21,32 @@
 #include "gpopt/operators/CScalarArray.h"
 #include "gpopt/operators/CScalarIdent.h"
 #include "gpopt/operators/CScalarIsDistinctFrom.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 #include "naucrates/md/IMDScalarOp.h"
 #include "gpopt/base/CDatumSortedSet.h"
 #include "gpos/common/CAutoRef.h"
 
 using namespace gpopt;
 
+//---------------------------------------------------------------------------
+//	@function:
+//		FSingleDatumPoint
+//
+//	@doc:
+//		Is the given range a point with the same datum as both of its ends,
+//		as the ranges of IN lists are; unlike CRange::FPoint, this does not
+//		compare the ends
+//
+//---------------------------------------------------------------------------
+static BOOL
+FSingleDatumPoint(CRange *prange)
+{
+	return prange->PdatumLeft() == prange->PdatumRight() &&
+		   NULL != prange->PdatumLeft() &&
+		   CRange::EriIncluded == prange->EriLeft() &&
+		   CRange::EriIncluded == prange->EriRight();
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CConstraintInterval::CConstraintInterval
@@ -37,11 +57,12 @@ using namespace gpopt;
 //---------------------------------------------------------------------------
 CConstraintInterval::CConstraintInterval(CMemoryPool *mp, const CColRef *colref,
 										 CRangeArray *pdrgprng,
-										 BOOL fIncludesNull)
+										 BOOL fIncludesNull, BOOL fFromArray)
 	: CConstraint(mp),
 	  m_pcr(colref),
 	  m_pdrgprng(pdrgprng),
-	  m_fIncludesNull(fIncludesNull)
+	  m_fIncludesNull(fIncludesNull),
+	  m_fFromArray(fFromArray)
 {
 	GPOS_ASSERT(NULL != colref);
 	GPOS_ASSERT(NULL != pdrgprng);
@@ -248,6 +269,33 @@ CConstraintInterval::PcnstrIntervalFromScalarArrayCmp(CMemoryPool *mp,
 	const IComparator *pcomp = COptCtxt::PoctxtFromTLS()->Pcomp();
 	gpos::CAutoRef<CDatumSortedSet> apdatumsortedset(
 		GPOS_NEW(mp) CDatumSortedSet(mp, pexprArray, pcomp));
+
+	return PciIntervalFromDatumSortedSet(mp, colref, cmp_type,
+										 apdatumsortedset.Value(),
+										 infer_nulls_as);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintInterval::PciIntervalFromDatumSortedSet
+//
+//	@doc:
+//		Create the interval of an IN (equality) or NOT IN (inequality) list
+//		of the values of the given sorted set, in a single pass over the
+//		set. Returns NULL for other comparisons, and for a NOT IN list
+//		without non-NULL values
+//
+//---------------------------------------------------------------------------
+CConstraintInterval *
+CConstraintInterval::PciIntervalFromDatumSortedSet(
+	CMemoryPool *mp, CColRef *colref, IMDType::ECmpType cmp_type,
+	const CDatumSortedSet *pdatumsortedset, BOOL infer_nulls_as)
+{
+	GPOS_ASSERT(NULL != pdatumsortedset);
+
+	const IComparator *pcomp = COptCtxt::PoctxtFromTLS()->Pcomp();
+	const ULONG size = pdatumsortedset->Size();
+
 	// construct ranges representing IN or NOT IN
 	CRangeArray *prgrng = GPOS_NEW(mp) CRangeArray(mp);
 
@@ -256,29 +304,35 @@ CConstraintInterval::PcnstrIntervalFromScalarArrayCmp(CMemoryPool *mp,
 		case IMDType::EcmptEq:
 		{
 			// IN case, create ranges [X, X] [Y, Y] [Z, Z]
-			for (ULONG ul = 0; ul < apdatumsortedset->Size(); ul++)
+			for (ULONG ul = 0; ul < size; ul++)
 			{
-				(*apdatumsortedset)[ul]->AddRef();
+				(*pdatumsortedset)[ul]->AddRef();
 				CRange *prng = GPOS_NEW(mp)
-					CRange(pcomp, IMDType::EcmptEq, (*apdatumsortedset)[ul]);
+					CRange(pcomp, IMDType::EcmptEq, (*pdatumsortedset)[ul]);
 				prgrng->Append(prng);
 			}
 			break;
 		}
 		case IMDType::EcmptNEq:
 		{
+			if (0 == size)
+			{
+				prgrng->Release();
+				return NULL;
+			}
+
 			// NOT IN case, create ranges: (-inf, X) (X, Y) (Y, Z) (Z, inf)
 			IDatum *pprevdatum = NULL;
 			IDatum *datum = NULL;
 
-			for (ULONG ul = 0; ul < apdatumsortedset->Size(); ul++)
+			for (ULONG ul = 0; ul < size; ul++)
 			{
 				if (0 != ul)
 				{
 					pprevdatum->AddRef();
 				}
 
-				datum = (*apdatumsortedset)[ul];
+				datum = (*pdatumsortedset)[ul];
 				datum->AddRef();
 
 				IMDId *mdid = datum->MDId();
@@ -310,7 +364,8 @@ CConstraintInterval::PcnstrIntervalFromScalarArrayCmp(CMemoryPool *mp,
 		}
 	}
 
-	return GPOS_NEW(mp) CConstraintInterval(mp, colref, prgrng, infer_nulls_as);
+	return GPOS_NEW(mp) CConstraintInterval(mp, colref, prgrng, infer_nulls_as,
+											true /*fFromArray*/);
 }
 
 //---------------------------------------------------------------------------
@@ -739,7 +794,15 @@ CConstraintInterval::PexprConstructScalar(CMemoryPool *mp) const
 											false /*is_null*/);
 	}
 
-	if (GPOS_FTRACE(EopttraceArrayConstraints))
+	// IN and NOT IN lists above the array expansion threshold are never
+	// expanded into a disjunction, see CConstraint::PcnstrFromScalarArrayCmp;
+	// intervals of OR lists keep their disjunction whatever their size
+	ULONG array_expansion_threshold = COptCtxt::PoctxtFromTLS()
+										  ->GetOptimizerConfig()
+										  ->GetHint()
+										  ->UlArrayExpansionThreshold();
+	if (GPOS_FTRACE(EopttraceArrayConstraints) ||
+		(m_fFromArray && m_pdrgprng->Size() > array_expansion_threshold))
 	{
 		// try creating an array IN/NOT IN expression
 		CExpression *pexpr = PexprConstructArrayScalar(mp);
@@ -1027,8 +1090,8 @@ CConstraintInterval::PcnstrRemapForColumn(CMemoryPool *mp,
 {
 	GPOS_ASSERT(NULL != colref);
 	m_pdrgprng->AddRef();
-	return GPOS_NEW(mp)
-		CConstraintInterval(mp, colref, m_pdrgprng, m_fIncludesNull);
+	return GPOS_NEW(mp) CConstraintInterval(mp, colref, m_pdrgprng,
+											m_fIncludesNull, m_fFromArray);
 }
 
 //---------------------------------------------------------------------------
@@ -1049,6 +1112,7 @@ CConstraintInterval::PciIntersect(CMemoryPool *mp, CConstraintInterval *pci)
 
 	CRangeArray *pdrgprngNew = GPOS_NEW(mp) CRangeArray(mp);
 
+	const IComparator *pcomp = COptCtxt::PoctxtFromTLS()->Pcomp();
 	ULONG ulFst = 0;
 	ULONG ulSnd = 0;
 	const ULONG ulNumRangesFst = m_pdrgprng->Size();
@@ -1058,6 +1122,29 @@ CConstraintInterval::PciIntersect(CMemoryPool *mp, CConstraintInterval *pci)
 		CRange *prangeThis = (*m_pdrgprng)[ulFst];
 		CRange *prangeOther = (*pdrgprngOther)[ulSnd];
 
+		if (FSingleDatumPoint(prangeThis) && FSingleDatumPoint(prangeOther))
+		{
+			// merge step of two sorted lists of values
+			IDatum *pdatumThis = prangeThis->PdatumLeft();
+			IDatum *pdatumOther = prangeOther->PdatumLeft();
+			if (pcomp->IsLessThan(pdatumThis, pdatumOther))
+			{
+				ulFst++;
+			}
+			else if (pcomp->IsLessThan(pdatumOther, pdatumThis))
+			{
+				ulSnd++;
+			}
+			else
+			{
+				prangeThis->AddRef();
+				pdrgprngNew->Append(prangeThis);
+				ulFst++;
+				ulSnd++;
+			}
+			continue;
+		}
+
 		CRange *prangeNew = NULL;
 		if (prangeOther->FEndsAfter(prangeThis))
 		{
@@ -1077,7 +1164,8 @@ CConstraintInterval::PciIntersect(CMemoryPool *mp, CConstraintInterval *pci)
 	}
 
 	return GPOS_NEW(mp) CConstraintInterval(
-		mp, m_pcr, pdrgprngNew, m_fIncludesNull && pci->FIncludesNull());
+		mp, m_pcr, pdrgprngNew, m_fIncludesNull && pci->FIncludesNull(),
+		m_fFromArray || pci->FFromArray());
 }
 
 //---------------------------------------------------------------------------
@@ -1098,6 +1186,7 @@ CConstraintInterval::PciUnion(CMemoryPool *mp, CConstraintInterval *pci)
 
 	CRangeArray *pdrgprngNew = GPOS_NEW(mp) CRangeArray(mp);
 
+	const IComparator *pcomp = COptCtxt::PoctxtFromTLS()->Pcomp();
 	ULONG ulFst = 0;
 	ULONG ulSnd = 0;
 	const ULONG ulNumRangesFst = m_pdrgprng->Size();
@@ -1107,6 +1196,31 @@ CConstraintInterval::PciUnion(CMemoryPool *mp, CConstraintInterval *pci)
 		CRange *prangeThis = (*m_pdrgprng)[ulFst];
 		CRange *prangeOther = (*pdrgprngOther)[ulSnd];
 
+		if (FSingleDatumPoint(prangeThis) && FSingleDatumPoint(prangeOther))
+		{
+			// merge step of two sorted lists of values
+			IDatum *pdatumThis = prangeThis->PdatumLeft();
+			IDatum *pdatumOther = prangeOther->PdatumLeft();
+			CRange *prangeNext = prangeThis;
+			if (pcomp->IsLessThan(pdatumThis, pdatumOther))
+			{
+				ulFst++;
+			}
+			else if (pcomp->IsLessThan(pdatumOther, pdatumThis))
+			{
+				prangeNext = prangeOther;
+				ulSnd++;
+			}
+			else
+			{
+				ulFst++;
+				ulSnd++;
+			}
+			prangeNext->AddRef();
+			AppendOrExtend(mp, pdrgprngNew, prangeNext);
+			continue;
+		}
+
 		CRange *prangeNew = NULL;
 		if (prangeOther->FEndsAfter(prangeThis))
 		{
@@ -1126,7 +1240,8 @@ CConstraintInterval::PciUnion(CMemoryPool *mp, CConstraintInterval *pci)
 	AddRemainingRanges(mp, pdrgprngOther, ulSnd, pdrgprngNew);
 
 	return GPOS_NEW(mp) CConstraintInterval(
-		mp, m_pcr, pdrgprngNew, m_fIncludesNull || pci->FIncludesNull());
+		mp, m_pcr, pdrgprngNew, m_fIncludesNull || pci->FIncludesNull(),
+		m_fFromArray || pci->FFromArray());
 }
 
 //---------------------------------------------------------------------------
@@ -1189,7 +1304,8 @@ CConstraintInterval::PciDifference(CMemoryPool *mp, CConstraintInterval *pci)
 	AddRemainingRanges(mp, m_pdrgprng, ulFst, pdrgprngNew);
 
 	return GPOS_NEW(mp) CConstraintInterval(
-		mp, m_pcr, pdrgprngNew, m_fIncludesNull && !pci->FIncludesNull());
+		mp, m_pcr, pdrgprngNew, m_fIncludesNull && !pci->FIncludesNull(),
+		m_fFromArray || pci->FFromArray());
 }
 
 //---------------------------------------------------------------------------
@@ -1218,6 +1334,11 @@ CConstraintInterval::FContainsInterval(CMemoryPool *mp,
 		return false;
 	}
 
+	if (FPointsOnly(pci->Pdrgprng()))
+	{
+		return FContainsPoints(pci->Pdrgprng());
+	}
+
 	CConstraintInterval *pciDiff = pci->PciDifference(mp, this);
 
 	// if the difference is empty, then this interval contains the given one
@@ -1227,6 +1348,67 @@ CConstraintInterval::FContainsInterval(CMemoryPool *mp,
 	return fContains;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintInterval::FPointsOnly
+//
+//	@doc:
+//		Are all the given ranges single datum points, such as the ranges of
+//		an IN list
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstraintInterval::FPointsOnly(CRangeArray *pdrgprng)
+{
+	const ULONG length = pdrgprng->Size();
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		if (!FSingleDatumPoint((*pdrgprng)[ul]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintInterval::FContainsPoints
+//
+//	@doc:
+//		Does the current interval contain all the given sorted points? Both
+//		arrays are sorted, so they are merged without creating the
+//		difference of the intervals
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstraintInterval::FContainsPoints(CRangeArray *pdrgprngPoints) const
+{
+	ULONG ulThis = 0;
+	const ULONG ulNumRangesThis = m_pdrgprng->Size();
+	const ULONG ulNumPoints = pdrgprngPoints->Size();
+	for (ULONG ul = 0; ul < ulNumPoints; ul++)
+	{
+		CRange *prangePoint = (*pdrgprngPoints)[ul];
+
+		// skip the ranges that end before the point
+		while (ulThis < ulNumRangesThis &&
+			   (*m_pdrgprng)[ulThis]->FDisjointLeft(prangePoint))
+		{
+			ulThis++;
+		}
+
+		if (ulThis == ulNumRangesThis ||
+			!(*m_pdrgprng)[ulThis]->Contains(prangePoint))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CConstraintInterval::PciUnbounded
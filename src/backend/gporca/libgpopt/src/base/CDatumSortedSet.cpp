@@ -38,6 +38,12 @@ CDatumSortedSet::CDatumSortedSet(CMemoryPool *mp, CExpression *pexprArray,
 
 	// de-duplicate
 	const ULONG ulRangeArrayArity = aprngdatum->Size();
+	if (0 == ulRangeArrayArity)
+	{
+		// all elements are NULL
+		return;
+	}
+
 	IDatum *pdatumPrev = (*aprngdatum)[0];
 	pdatumPrev->AddRef();
 	Append(pdatumPrev);
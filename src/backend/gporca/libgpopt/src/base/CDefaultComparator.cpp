@@ -48,6 +48,35 @@ CDefaultComparator::CDefaultComparator(IConstExprEvaluator *pceeval)
 	GPOS_ASSERT(NULL != pceeval);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDefaultComparator::FUseBuiltinIntComparison
+//
+//	@doc:
+//		Are the two data integers compared by the built-in evaluators. The
+//		type info of the datum is the same as that of its type, so the
+//		metadata accessor is not needed. Integer types are constrainable,
+//		so the callers check this first
+//
+//---------------------------------------------------------------------------
+BOOL
+CDefaultComparator::FUseBuiltinIntComparison(const IDatum *datum1,
+											 const IDatum *datum2)
+{
+	if (!FUseBuiltinIntEvaluators())
+	{
+		return false;
+	}
+
+	IMDType::ETypeInfo type_info1 = datum1->GetDatumType();
+	IMDType::ETypeInfo type_info2 = datum2->GetDatumType();
+
+	return (IMDType::EtiInt2 == type_info1 || IMDType::EtiInt4 == type_info1 ||
+			IMDType::EtiInt8 == type_info1) &&
+		   (IMDType::EtiInt2 == type_info2 || IMDType::EtiInt4 == type_info2 ||
+			IMDType::EtiInt8 == type_info2);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDefaultComparator::PexprEvalComparison
@@ -97,16 +126,15 @@ CDefaultComparator::FEvalComparison(CMemoryPool *mp, const IDatum *datum1,
 BOOL
 CDefaultComparator::Equals(const IDatum *datum1, const IDatum *datum2) const
 {
+	if (FUseBuiltinIntComparison(datum1, datum2))
+	{
+		return datum1->StatsAreEqual(datum2);
+	}
 	if (!CUtils::FConstrainableType(datum1->MDId()) ||
 		!CUtils::FConstrainableType(datum2->MDId()))
 	{
 		return false;
 	}
-	if (FUseBuiltinIntEvaluators() && CUtils::FIntType(datum1->MDId()) &&
-		CUtils::FIntType(datum2->MDId()))
-	{
-		return datum1->StatsAreEqual(datum2);
-	}
 	CAutoMemoryPool amp;
 
 	// NULL datum is a special case and is being handled here. Assumptions made are
@@ -132,16 +160,15 @@ CDefaultComparator::Equals(const IDatum *datum1, const IDatum *datum2) const
 BOOL
 CDefaultComparator::IsLessThan(const IDatum *datum1, const IDatum *datum2) const
 {
+	if (FUseBuiltinIntComparison(datum1, datum2))
+	{
+		return datum1->StatsAreLessThan(datum2);
+	}
 	if (!CUtils::FConstrainableType(datum1->MDId()) ||
 		!CUtils::FConstrainableType(datum2->MDId()))
 	{
 		return false;
 	}
-	if (FUseBuiltinIntEvaluators() && CUtils::FIntType(datum1->MDId()) &&
-		CUtils::FIntType(datum2->MDId()))
-	{
-		return datum1->StatsAreLessThan(datum2);
-	}
 	CAutoMemoryPool amp;
 
 	// NULL datum is a special case and is being handled here. Assumptions made are
@@ -168,17 +195,16 @@ BOOL
 CDefaultComparator::IsLessThanOrEqual(const IDatum *datum1,
 									  const IDatum *datum2) const
 {
+	if (FUseBuiltinIntComparison(datum1, datum2))
+	{
+		return datum1->StatsAreLessThan(datum2) ||
+			   datum1->StatsAreEqual(datum2);
+	}
 	if (!CUtils::FConstrainableType(datum1->MDId()) ||
 		!CUtils::FConstrainableType(datum2->MDId()))
 	{
 		return false;
 	}
-	if (FUseBuiltinIntEvaluators() && CUtils::FIntType(datum1->MDId()) &&
-		CUtils::FIntType(datum2->MDId()))
-	{
-		return datum1->StatsAreLessThan(datum2) ||
-			   datum1->StatsAreEqual(datum2);
-	}
 	CAutoMemoryPool amp;
 
 	// NULL datum is a special case and is being handled here. Assumptions made are
@@ -212,16 +238,15 @@ BOOL
 CDefaultComparator::IsGreaterThan(const IDatum *datum1,
 								  const IDatum *datum2) const
 {
+	if (FUseBuiltinIntComparison(datum1, datum2))
+	{
+		return datum1->StatsAreGreaterThan(datum2);
+	}
 	if (!CUtils::FConstrainableType(datum1->MDId()) ||
 		!CUtils::FConstrainableType(datum2->MDId()))
 	{
 		return false;
 	}
-	if (FUseBuiltinIntEvaluators() && CUtils::FIntType(datum1->MDId()) &&
-		CUtils::FIntType(datum2->MDId()))
-	{
-		return datum1->StatsAreGreaterThan(datum2);
-	}
 	CAutoMemoryPool amp;
 
 	// NULL datum is a special case and is being handled here. Assumptions made are
@@ -248,17 +273,16 @@ BOOL
 CDefaultComparator::IsGreaterThanOrEqual(const IDatum *datum1,
 										 const IDatum *datum2) const
 {
+	if (FUseBuiltinIntComparison(datum1, datum2))
+	{
+		return datum1->StatsAreGreaterThan(datum2) ||
+			   datum1->StatsAreEqual(datum2);
+	}
 	if (!CUtils::FConstrainableType(datum1->MDId()) ||
 		!CUtils::FConstrainableType(datum2->MDId()))
 	{
 		return false;
 	}
-	if (FUseBuiltinIntEvaluators() && CUtils::FIntType(datum1->MDId()) &&
-		CUtils::FIntType(datum2->MDId()))
-	{
-		return datum1->StatsAreGreaterThan(datum2) ||
-			   datum1->StatsAreEqual(datum2);
-	}
 	CAutoMemoryPool amp;
 
 	// NULL datum is a special case and is being handled here. Assumptions made are
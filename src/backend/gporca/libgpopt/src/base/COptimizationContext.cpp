@@ -28,9 +28,6 @@
 using namespace gpopt;
 
 
-// invalid optimization context
-const COptimizationContext COptimizationContext::m_ocInvalid;
-
 // invalid optimization context pointer
 const OPTCTXT_PTR COptimizationContext::m_pocInvalid = NULL;
 
@@ -11,6 +11,7 @@
 #include "gpos/base.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/common/CAutoTimer.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/common/syslibwrapper.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
@@ -29,6 +30,7 @@
 #include "gpopt/base/COptCtxt.h"
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/engine/CEnumeratorConfig.h"
+#include "gpopt/engine/COptimizationStats.h"
 #include "gpopt/engine/CStatisticsConfig.h"
 #include "gpopt/minidump/CSerializableStackTrace.h"
 #include "gpopt/operators/CExpression.h"
@@ -85,7 +87,8 @@ CEngine::CEngine(CMemoryPool *mp)
 	  m_pdrgpulpXformCalls(NULL),
 	  m_pdrgpulpXformTimes(NULL),
 	  m_pdrgpulpXformBindings(NULL),
-	  m_pdrgpulpXformResults(NULL)
+	  m_pdrgpulpXformResults(NULL),
+	  m_optimization_stats(NULL)
 {
 	m_pmemo = GPOS_NEW(mp) CMemo(mp);
 	m_pexprEnforcerPattern =
@@ -195,6 +198,12 @@ CEngine::Init(CQueryContext *pqc, CSearchStageArray *search_stage_array)
 		}
 	}
 
+	// the counters are reset by the caller, as they also cover the phases
+	// before and after the engine
+	m_optimization_stats = COptCtxt::PoctxtFromTLS()
+							   ->GetOptimizerConfig()
+							   ->GetOptimizationStats();
+
 	m_pqc = pqc;
 	InitLogicalExpression(m_pqc->Pexpr());
 
@@ -353,7 +362,7 @@ void
 CEngine::InsertXformResult(
 	CGroup *pgroupOrigin, CXformResult *pxfres, CXform::EXformId exfidOrigin,
 	CGroupExpression *pgexprOrigin,
-	ULONG ulXformTime,	// time consumed by transformation in msec
+	ULONG ulXformTime,	// time consumed by transformation in usec
 	ULONG ulNumberOfBindings)
 {
 	GPOS_ASSERT(NULL != pxfres);
@@ -374,6 +383,12 @@ CEngine::InsertXformResult(
 			pxfres->Pdrgpexpr()->Size();
 	}
 
+	if (NULL != m_optimization_stats && 0 < pxfres->Pdrgpexpr()->Size())
+	{
+		m_optimization_stats->RecordXform(
+			exfidOrigin, pxfres->Pdrgpexpr()->Size(), ulXformTime);
+	}
+
 	CExpression *pexpr = pxfres->PexprNext();
 	while (NULL != pexpr)
 	{
@@ -1434,6 +1449,27 @@ CEngine::ScheduleMainJob(CSchedulerContext *psc, COptimizationContext *poc)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::RecordPhase
+//
+//	@doc:
+//		Add the time since the end of the last timed phase to the given
+//		phase; exploration, implementation and optimization of a search
+//		stage run in this order, each finishing before the next starts
+//
+//---------------------------------------------------------------------------
+void
+CEngine::RecordPhase(COptimizationStats::EPhase eph)
+{
+	if (NULL != m_optimization_stats)
+	{
+		m_optimization_stats->AddPhaseTime(eph, m_phase_timer.ElapsedUS());
+		m_phase_timer.Restart();
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::FinalizeExploration
@@ -1445,6 +1481,8 @@ CEngine::ScheduleMainJob(CSchedulerContext *psc, COptimizationContext *poc)
 void
 CEngine::FinalizeExploration()
 {
+	RecordPhase(COptimizationStats::EphExploration);
+
 	GroupMerge();
 
 	if (m_pqc->FDeriveStats())
@@ -1460,6 +1498,8 @@ CEngine::FinalizeExploration()
 		m_pmemo->DeriveStatsIfAbsent(m_mp);
 	}
 
+	RecordPhase(COptimizationStats::EphStatsDerivation);
+
 	if (GPOS_FTRACE(EopttracePrintMemoAfterExploration))
 	{
 		{
@@ -1494,6 +1534,8 @@ CEngine::FinalizeExploration()
 void
 CEngine::FinalizeImplementation()
 {
+	RecordPhase(COptimizationStats::EphImplementation);
+
 	if (GPOS_FTRACE(EopttracePrintMemoAfterImplementation))
 	{
 		{
@@ -1568,7 +1610,8 @@ CEngine::PrintActivatedXforms(IOstream &os) const
 				*m_pdrgpulpXformResults)[m_ulCurrSearchStage][pxform->Exfid()];
 			os << pxform->SzId() << ": " << ulCalls << " calls, " << ulBindings
 			   << " total bindings, " << ulResults
-			   << " alternatives generated, " << ulTime << "ms" << std::endl;
+			   << " alternatives generated, " << ulTime / GPOS_USEC_IN_MSEC
+			   << "ms" << std::endl;
 		}
 		os << "[OPT]: <End Xforms - stage " << m_ulCurrSearchStage << ">"
 		   << std::endl;
@@ -1697,6 +1740,7 @@ CEngine::Optimize()
 	for (ULONG ul = 0; !FSearchTerminated() && ul < ulSearchStages; ul++)
 	{
 		PssCurrent()->RestartTimer();
+		m_phase_timer.Restart();
 
 		// optimize root group
 		m_pqc->Prpp()->AddRef();
@@ -1713,6 +1757,7 @@ CEngine::Optimize()
 
 		// run optimization job
 		CScheduler::Run(&sc);
+		RecordPhase(COptimizationStats::EphOptimization);
 
 		poc->Release();
 
@@ -1726,6 +1771,14 @@ CEngine::Optimize()
 	}
 
 
+	if (NULL != m_optimization_stats)
+	{
+		m_optimization_stats->RecordMemo((ULONG) m_pmemo->UlpGroups(),
+										 m_pmemo->UlDuplicateGroups(),
+										 m_pmemo->UlGrpExprs());
+		m_optimization_stats->RecordSearchStages(m_ulCurrSearchStage);
+	}
+
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 	{
 		CAutoTrace atSearch(m_mp);
@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		COptimizationStats.cpp
+//
+//	@doc:
+//		Implementation of the counters of a single optimization
+//---------------------------------------------------------------------------
+
+#include "gpopt/engine/COptimizationStats.h"
+
+#include "gpopt/xforms/CXform.h"
+#include "gpopt/xforms/CXformFactory.h"
+
+using namespace gpopt;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::COptimizationStats
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+COptimizationStats::COptimizationStats(CMemoryPool *mp)
+	: m_ullMDFetchTime(0),
+	  m_ulMDCacheHits(0),
+	  m_ulMDCacheMisses(0),
+	  m_ulGroups(0),
+	  m_ulDuplicateGroups(0),
+	  m_ulGroupExprs(0),
+	  m_ulSearchStages(0),
+	  m_rgulXformCalls(NULL),
+	  m_rgulXformResults(NULL),
+	  m_rgullXformTimes(NULL)
+{
+	m_rgulXformCalls = GPOS_NEW_ARRAY(mp, ULONG, CXform::ExfSentinel);
+	m_rgulXformResults = GPOS_NEW_ARRAY(mp, ULONG, CXform::ExfSentinel);
+	m_rgullXformTimes = GPOS_NEW_ARRAY(mp, ULLONG, CXform::ExfSentinel);
+	Reset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::~COptimizationStats
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+COptimizationStats::~COptimizationStats()
+{
+	GPOS_DELETE_ARRAY(m_rgulXformCalls);
+	GPOS_DELETE_ARRAY(m_rgulXformResults);
+	GPOS_DELETE_ARRAY(m_rgullXformTimes);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::Reset
+//
+//	@doc:
+//		Clear all counters, so that the instance can be used for another
+//		optimization
+//
+//---------------------------------------------------------------------------
+void
+COptimizationStats::Reset()
+{
+	for (ULONG ul = 0; ul < EphSentinel; ul++)
+	{
+		m_rgullPhaseTimes[ul] = 0;
+	}
+
+	m_ullMDFetchTime = 0;
+	m_ulMDCacheHits = 0;
+	m_ulMDCacheMisses = 0;
+	m_ulGroups = 0;
+	m_ulDuplicateGroups = 0;
+	m_ulGroupExprs = 0;
+	m_ulSearchStages = 0;
+
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		m_rgulXformCalls[ul] = 0;
+		m_rgulXformResults[ul] = 0;
+		m_rgullXformTimes[ul] = 0;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::RecordMetadata
+//
+//	@doc:
+//		Record the metadata lookups of the optimization
+//
+//---------------------------------------------------------------------------
+void
+COptimizationStats::RecordMetadata(ULLONG ullFetchTimeUS, ULONG ulCacheHits,
+								   ULONG ulCacheMisses)
+{
+	m_ullMDFetchTime = ullFetchTimeUS;
+	m_ulMDCacheHits = ulCacheHits;
+	m_ulMDCacheMisses = ulCacheMisses;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::RecordMemo
+//
+//	@doc:
+//		Record the size of the memo
+//
+//---------------------------------------------------------------------------
+void
+COptimizationStats::RecordMemo(ULONG ulGroups, ULONG ulDuplicateGroups,
+							   ULONG ulGroupExprs)
+{
+	m_ulGroups = ulGroups;
+	m_ulDuplicateGroups = ulDuplicateGroups;
+	m_ulGroupExprs = ulGroupExprs;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::RecordXform
+//
+//	@doc:
+//		Record an application of the given xform
+//
+//---------------------------------------------------------------------------
+void
+COptimizationStats::RecordXform(ULONG ulXform, ULONG ulResults,
+								ULONG ulTimeUS)
+{
+	GPOS_ASSERT(ulXform < CXform::ExfSentinel);
+
+	m_rgulXformCalls[ulXform]++;
+	m_rgulXformResults[ulXform] += ulResults;
+	m_rgullXformTimes[ulXform] += ulTimeUS;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::UlXformCalls
+//
+//	@doc:
+//		Number of applications of the given xform
+//
+//---------------------------------------------------------------------------
+ULONG
+COptimizationStats::UlXformCalls(ULONG ulXform) const
+{
+	GPOS_ASSERT(ulXform < CXform::ExfSentinel);
+
+	return m_rgulXformCalls[ulXform];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::UlXformResults
+//
+//	@doc:
+//		Number of alternatives produced by the given xform
+//
+//---------------------------------------------------------------------------
+ULONG
+COptimizationStats::UlXformResults(ULONG ulXform) const
+{
+	GPOS_ASSERT(ulXform < CXform::ExfSentinel);
+
+	return m_rgulXformResults[ulXform];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::UllXformTime
+//
+//	@doc:
+//		Time spent in the given xform
+//
+//---------------------------------------------------------------------------
+ULLONG
+COptimizationStats::UllXformTime(ULONG ulXform) const
+{
+	GPOS_ASSERT(ulXform < CXform::ExfSentinel);
+
+	return m_rgullXformTimes[ulXform];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::UlXformCallsTotal
+//
+//	@doc:
+//		Total number of xform applications
+//
+//---------------------------------------------------------------------------
+ULONG
+COptimizationStats::UlXformCallsTotal() const
+{
+	ULONG ulCalls = 0;
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		ulCalls += m_rgulXformCalls[ul];
+	}
+
+	return ulCalls;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::UlTopXforms
+//
+//	@doc:
+//		Fill the given array with the ids of the applied xforms that took
+//		the most time, slowest first, and return their number
+//
+//---------------------------------------------------------------------------
+ULONG
+COptimizationStats::UlTopXforms(ULONG *rgulXforms, ULONG ulSize) const
+{
+	GPOS_ASSERT(NULL != rgulXforms);
+
+	// insertion into the sorted prefix, the array is short
+	ULONG ulTop = 0;
+	for (ULONG ulXform = 0; ulXform < CXform::ExfSentinel; ulXform++)
+	{
+		if (0 == m_rgulXformCalls[ulXform])
+		{
+			continue;
+		}
+
+		ULONG ulPos = ulTop;
+		while (0 < ulPos &&
+			   m_rgullXformTimes[rgulXforms[ulPos - 1]] <
+				   m_rgullXformTimes[ulXform])
+		{
+			if (ulPos < ulSize)
+			{
+				rgulXforms[ulPos] = rgulXforms[ulPos - 1];
+			}
+			ulPos--;
+		}
+
+		if (ulPos < ulSize)
+		{
+			rgulXforms[ulPos] = ulXform;
+			ulTop = std::min(ulTop + 1, ulSize);
+		}
+	}
+
+	return ulTop;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::SzPhase
+//
+//	@doc:
+//		Name of the given phase
+//
+//---------------------------------------------------------------------------
+const CHAR *
+COptimizationStats::SzPhase(EPhase eph)
+{
+	GPOS_ASSERT(EphSentinel > eph);
+
+	static const CHAR *rgszPhases[EphSentinel] = {
+		"Query Translation", "Preprocessing",  "Exploration",
+		"Statistics Derivation", "Implementation", "Optimization",
+		"Plan Translation"};
+
+	return rgszPhases[eph];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationStats::OsPrint
+//
+//	@doc:
+//		Print function
+//
+//---------------------------------------------------------------------------
+IOstream &
+COptimizationStats::OsPrint(IOstream &os) const
+{
+	for (ULONG ul = 0; ul < EphSentinel; ul++)
+	{
+		os << SzPhase((EPhase) ul) << ": "
+		   << m_rgullPhaseTimes[ul] / GPOS_USEC_IN_MSEC << "ms" << std::endl;
+	}
+
+	os << "Metadata: " << m_ulMDCacheHits << " cache hits, "
+	   << m_ulMDCacheMisses << " fetched in "
+	   << m_ullMDFetchTime / GPOS_USEC_IN_MSEC << "ms" << std::endl
+	   << "Memo: " << m_ulGroups << " groups, " << m_ulDuplicateGroups
+	   << " duplicate groups, " << m_ulGroupExprs << " group expressions"
+	   << std::endl
+	   << "Search stages: " << m_ulSearchStages << std::endl;
+
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		if (0 == m_rgulXformCalls[ul])
+		{
+			continue;
+		}
+
+		os << CXformFactory::Pxff()->Pxf((CXform::EXformId) ul)->SzId()
+		   << ": " << m_rgulXformCalls[ul] << " calls, "
+		   << m_rgulXformResults[ul] << " alternatives generated, "
+		   << m_rgullXformTimes[ul] / GPOS_USEC_IN_MSEC << "ms" << std::endl;
+	}
+
+	return os;
+}
+
+// EOF
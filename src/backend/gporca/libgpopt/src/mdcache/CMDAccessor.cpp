@@ -245,7 +245,10 @@ CMDAccessor::SMDProviderElem::HashValue(const SMDProviderElem &mdpelem)
 //
 //---------------------------------------------------------------------------
 CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache)
-	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0), m_dFetchTime(0.0)
+	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0),
+	  m_dFetchTime(0.0),
+	  m_ulCacheHits(0),
+	  m_ulCacheMisses(0)
 {
 	GPOS_ASSERT(NULL != m_mp);
 	GPOS_ASSERT(NULL != m_pcache);
@@ -265,7 +268,10 @@ CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache)
 //---------------------------------------------------------------------------
 CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache, CSystemId sysid,
 						 IMDProvider *pmdp)
-	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0), m_dFetchTime(0.0)
+	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0),
+	  m_dFetchTime(0.0),
+	  m_ulCacheHits(0),
+	  m_ulCacheMisses(0)
 {
 	GPOS_ASSERT(NULL != m_mp);
 	GPOS_ASSERT(NULL != m_pcache);
@@ -289,7 +295,10 @@ CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache, CSystemId sysid,
 CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache,
 						 const CSystemIdArray *pdrgpsysid,
 						 const CMDProviderArray *pdrgpmdp)
-	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0), m_dFetchTime(0.0)
+	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0),
+	  m_dFetchTime(0.0),
+	  m_ulCacheHits(0),
+	  m_ulCacheMisses(0)
 {
 	GPOS_ASSERT(NULL != m_mp);
 	GPOS_ASSERT(NULL != m_pcache);
@@ -387,6 +396,11 @@ CMDAccessor::~CMDAccessor()
 				<< std::endl;
 		at.Os() << "[OPT]: Total metadata lookup time (including fetch time): "
 				<< m_dLookupTime << "ms" << std::endl;
+		at.Os() << "[OPT]: Metadata cache hits: " << m_pcache->GetHitCounter()
+				<< ", misses: " << m_pcache->GetMissCounter()
+				<< ", evictions: " << m_pcache->GetEvictionCounter()
+				<< ", invalidated objects: "
+				<< m_pcache->GetInvalidationCounter() << std::endl;
 	}
 }
 
@@ -514,18 +528,17 @@ CMDAccessor::GetImdObj(IMDId *mdid)
 		a_pmdcacc = GPOS_NEW(m_mp) CacheAccessorMD(m_pcache);
 		a_pmdcacc->Lookup(&mdkey);
 		IMDCacheObject *pmdobjNew = a_pmdcacc->Val();
-		if (NULL == pmdobjNew)
+		if (NULL != pmdobjNew)
 		{
-			// object not found in MD cache: retrieve it from MD provider
+			m_ulCacheHits++;
+		}
+		else
+		{
+			// object not found in MD cache: retrieve it from MD provider;
+			// fetches are always timed, they are few and expensive
+			m_ulCacheMisses++;
 			CTimerUser timerFetch;
-			if (fPrintOptStats)
-			{
-				timerFetch.Restart();
-			}
-			CAutoP<CWStringBase> a_pstr;
-			a_pstr = pmdp->GetMDObjDXLStr(m_mp, this, mdid);
-
-			GPOS_ASSERT(NULL != a_pstr.Value());
+			timerFetch.Restart();
 			CMemoryPool *mp = m_mp;
 
 			if (IMDId::EmdidGPDBCtas != mdid->MdidType())
@@ -534,17 +547,13 @@ CMDAccessor::GetImdObj(IMDId *mdid)
 				mp = a_pmdcacc->Pmp();
 			}
 
-			pmdobjNew = gpdxl::CDXLUtils::ParseDXLToIMDIdCacheObj(
-				mp, a_pstr.Value(), NULL /* XSD path */);
+			pmdobjNew = pmdp->GetMDObj(mp, this, mdid);
 			GPOS_ASSERT(NULL != pmdobjNew);
 
-			if (fPrintOptStats)
-			{
-				// add fetch time in msec
-				CDouble dFetch(timerFetch.ElapsedUS() /
-							   CDouble(GPOS_USEC_IN_MSEC));
-				m_dFetchTime = CDouble(m_dFetchTime.Get() + dFetch.Get());
-			}
+			// add fetch time in msec
+			CDouble dFetch(timerFetch.ElapsedUS() /
+						   CDouble(GPOS_USEC_IN_MSEC));
+			m_dFetchTime = CDouble(m_dFetchTime.Get() + dFetch.Get());
 
 			// For CTAS mdid, we avoid adding the corresponding object to the MD cache
 			// since those objects have a fixed id, and if caching is enabled and those
@@ -109,6 +109,69 @@ CMDCache::ULLGetCacheEvictionCounter()
 	return m_pcache->GetEvictionCounter();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheHitCounter
+//
+//	@doc:
+// 		Get the number of cache lookups that found a metadata object
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheHitCounter()
+{
+	GPOS_ASSERT(NULL != m_pcache);
+	return m_pcache->GetHitCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheMissCounter
+//
+//	@doc:
+// 		Get the number of cache lookups that did not find a metadata object
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheMissCounter()
+{
+	GPOS_ASSERT(NULL != m_pcache);
+	return m_pcache->GetMissCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheInvalidationCounter
+//
+//	@doc:
+// 		Get the number of metadata objects dropped by invalidation
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheInvalidationCounter()
+{
+	GPOS_ASSERT(NULL != m_pcache);
+	return m_pcache->GetInvalidationCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::UlInvalidate
+//
+//	@doc:
+//		Drop the metadata objects selected by the given predicate, and
+//		return their number. Objects still referenced by a running
+//		optimization are hidden from lookups and freed once released
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCache::UlInvalidate(CMDAccessor::MDCache::InvalidateFuncPtr pfnInvalidate,
+					   void *pvArg)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+	return m_pcache->InvalidateEntries(pfnInvalidate, pvArg);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Reset
@@ -12,6 +12,7 @@
 #include "gpos/base.h"
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/common/syslibwrapper.h"
 #include "gpos/error/CAutoTrace.h"
@@ -213,6 +214,35 @@ CMinidumperUtils::Finalize(CMiniDumperDXL *pmdmp, BOOL fSerializeErrCtx)
 	pmdmp->Finalize();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMinidumperUtils::Write
+//
+//	@doc:
+//		Write the given finalized minidump to the given file, converted to
+//		binary DXL if requested; PdxlmdLoad loads both formats
+//
+//---------------------------------------------------------------------------
+void
+CMinidumperUtils::Write(CMemoryPool *mp, const CHAR *file_name,
+						const CWStringDynamic *str, BOOL fBinary)
+{
+	CAutoRg<CHAR> xml(CDXLUtils::CreateMultiByteCharStringFromWCString(
+		mp, str->GetBuffer()));
+
+	std::ofstream os(file_name, std::ios::binary);
+	if (!fBinary)
+	{
+		os << xml.Rgt();
+		return;
+	}
+
+	ULONG length = 0;
+	CAutoRg<BYTE> binary(
+		CDXLUtils::ConvertXMLToBinary(mp, xml.Rgt(), &length));
+	os.write((const char *) binary.Rgt(), length);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMinidumperUtils::PdxlnExecuteMinidump
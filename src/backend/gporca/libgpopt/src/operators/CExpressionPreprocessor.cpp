@@ -17,6 +17,7 @@
 #include "gpopt/base/CConstraintInterval.h"
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/common/CAutoRef.h"
+#include "gpos/task/CAutoSuspendAbort.h"
 #include "gpopt/exception.h"
 
 #include "gpopt/operators/CWindowPreprocessor.h"
@@ -62,6 +63,36 @@ using namespace gpopt;
 // maximum number of equality predicates to be derived from existing equalities
 #define GPOPT_MAX_DERIVED_PREDS 50
 
+// expression with the operator of the given expression and the given
+// children; when the children are those of the given expression, it is
+// returned instead so that unchanged subtrees are shared, not copied
+CExpression *
+CExpressionPreprocessor::PexprRebuild(CMemoryPool *mp, CExpression *pexpr,
+									  CExpressionArray *pdrgpexprChildren)
+{
+	GPOS_ASSERT(NULL != pexpr);
+	GPOS_ASSERT(NULL != pdrgpexprChildren);
+	GPOS_ASSERT(pexpr->Arity() == pdrgpexprChildren->Size());
+
+	const ULONG arity = pexpr->Arity();
+	BOOL fUnchanged = true;
+	for (ULONG ul = 0; fUnchanged && ul < arity; ul++)
+	{
+		fUnchanged = ((*pexpr)[ul] == (*pdrgpexprChildren)[ul]);
+	}
+
+	if (fUnchanged)
+	{
+		pdrgpexprChildren->Release();
+		pexpr->AddRef();
+		return pexpr;
+	}
+
+	COperator *pop = pexpr->Pop();
+	pop->AddRef();
+	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+}
+
 // eliminate self comparisons in the given expression
 CExpression *
 CExpressionPreprocessor::PexprEliminateSelfComparison(CMemoryPool *mp,
@@ -87,10 +118,7 @@ CExpressionPreprocessor::PexprEliminateSelfComparison(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	COperator *pop = pexpr->Pop();
-	pop->AddRef();
-
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // remove superfluous equality operations
@@ -118,9 +146,7 @@ CExpressionPreprocessor::PexprPruneSuperfluousEquality(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	COperator *pop = pexpr->Pop();
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // an existential subquery whose inner expression is a GbAgg
@@ -178,8 +204,7 @@ CExpressionPreprocessor::PexprTrimExistentialSubqueries(CMemoryPool *mp,
 		return CPredicateUtils::PexprDisjunction(mp, pdrgpexprChildren);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 
@@ -261,8 +286,7 @@ CExpressionPreprocessor::PexprSimplifyQuantifiedSubqueries(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // preliminary unnesting of scalar subqueries
@@ -368,8 +392,7 @@ CExpressionPreprocessor::PexprUnnestScalarSubqueries(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // an intermediate limit is removed if it has neither row count nor offset
@@ -409,8 +432,7 @@ CExpressionPreprocessor::PexprRemoveSuperfluousLimit(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // distinct is removed from a DQA if it has a max or min agg
@@ -835,7 +857,6 @@ CExpressionPreprocessor::PexprCollapseJoins(CMemoryPool *mp, CExpression *pexpr)
 	GPOS_ASSERT(NULL != mp);
 	GPOS_ASSERT(NULL != pexpr);
 
-	COperator *pop = pexpr->Pop();
 	const ULONG arity = pexpr->Arity();
 
 	if (CPredicateUtils::FInnerOrNAryJoin(pexpr) ||
@@ -956,8 +977,7 @@ CExpressionPreprocessor::PexprCollapseJoins(CMemoryPool *mp, CExpression *pexpr)
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // collect the children of a join backbone into an array of logical leaf
@@ -1093,10 +1113,7 @@ CExpressionPreprocessor::PexprCollapseProjects(CMemoryPool *mp,
 		pdrgpexpr->Append(pexprChild);
 	}
 
-	COperator *pop = pexpr->Pop();
-	pop->AddRef();
-
-	CExpression *pexprNew = GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+	CExpression *pexprNew = PexprRebuild(mp, pexpr, pdrgpexpr);
 	CExpression *pexprCollapsed = CUtils::PexprCollapseProjects(mp, pexprNew);
 
 	if (NULL == pexprCollapsed)
@@ -1214,8 +1231,7 @@ CExpressionPreprocessor::PexprProjBelowSubquery(CMemoryPool *mp,
 		pdrgpexpr->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+	return PexprRebuild(mp, pexpr, pdrgpexpr);
 }
 
 // collapse cascaded union/union all into an NAry union/union all operator
@@ -1240,8 +1256,7 @@ CExpressionPreprocessor::PexprCollapseUnionUnionAll(CMemoryPool *mp,
 		pdrgpexpr->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	CExpression *pexprNew = GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+	CExpression *pexprNew = PexprRebuild(mp, pexpr, pdrgpexpr);
 	if (!CPredicateUtils::FUnionOrUnionAll(pexprNew))
 	{
 		return pexprNew;
@@ -1411,8 +1426,7 @@ CExpressionPreprocessor::PexprOuterJoinToInnerJoin(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	return PexprRebuild(mp, pexpr, pdrgpexprChildren);
 }
 
 // generate n*(n-1)/2 equality predicates, up to GPOPT_MAX_DERIVED_PREDS, between
@@ -1874,8 +1888,7 @@ CExpressionPreprocessor::PexprPruneEmptySubtrees(CMemoryPool *mp,
 		pdrgpexpr->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+	return PexprRebuild(mp, pexpr, pdrgpexpr);
 }
 
 // eliminate CTE Anchors for CTEs that have zero consumers
@@ -1906,8 +1919,7 @@ CExpressionPreprocessor::PexprRemoveUnusedCTEs(CMemoryPool *mp,
 		pdrgpexpr->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+	return PexprRebuild(mp, pexpr, pdrgpexpr);
 }
 
 // for all consumers of the same CTE, collect all selection predicates
@@ -2347,8 +2359,7 @@ CExpressionPreprocessor::PexprReorderScalarCmpChildren(CMemoryPool *mp,
 		pdrgpexpr->Append(pexprChild);
 	}
 
-	pop->AddRef();
-	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+	return PexprRebuild(mp, pexpr, pdrgpexpr);
 }
 
 // converts IN subquery to a predicate AND an EXISTS subquery
@@ -2474,8 +2485,6 @@ CExpressionPreprocessor::PexprExistWithPredFromINSubq(CMemoryPool *mp,
 
 	// recursively process children
 	const ULONG arity = pexpr->Arity();
-	pop->AddRef();
-
 	CExpressionArray *pdrgpexprChildren = GPOS_NEW(mp) CExpressionArray(mp);
 	for (ULONG ul = 0; ul < arity; ul++)
 	{
@@ -2484,8 +2493,7 @@ CExpressionPreprocessor::PexprExistWithPredFromINSubq(CMemoryPool *mp,
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	CExpression *pexprNew =
-		GPOS_NEW(mp) CExpression(mp, pop, pdrgpexprChildren);
+	CExpression *pexprNew = PexprRebuild(mp, pexpr, pdrgpexprChildren);
 	//Check if the inner is a SubqueryAny
 	if (CUtils::FAnySubquery(pop))
 	{
@@ -2527,6 +2535,189 @@ CExpressionPreprocessor::PexprExistWithPredFromINSubq(CMemoryPool *mp,
 	return pexprNew;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessor::CPassTracker::CPassTracker
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CExpressionPreprocessor::CPassTracker::CPassTracker(CMemoryPool *mp,
+													CExpression *pexpr)
+	: m_mp(mp),
+	  m_pexpr(pexpr),
+	  m_pbsOperators(NULL),
+	  m_szPass(NULL),
+	  m_fTrace(GPOS_FTRACE(EopttracePrintOptimizationStatistics)),
+	  m_ulRun(0),
+	  m_ulSkipped(0),
+	  m_ulUnchanged(0)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	m_pexpr->AddRef();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessor::CPassTracker::~CPassTracker
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CExpressionPreprocessor::CPassTracker::~CPassTracker()
+{
+	if (m_fTrace)
+	{
+		// suspend cancellation - destructors should not throw
+		CAutoSuspendAbort asa;
+
+		GPOS_TRACE_FORMAT(
+			"[OPT]: Preprocessing Passes: %d run, %d skipped, %d unchanged",
+			m_ulRun, m_ulSkipped, m_ulUnchanged);
+	}
+
+	CRefCount::SafeRelease(m_pexpr);
+	CRefCount::SafeRelease(m_pbsOperators);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessor::CPassTracker::CollectOperators
+//
+//	@doc:
+//		Collect the operators in the given expression
+//
+//---------------------------------------------------------------------------
+void
+CExpressionPreprocessor::CPassTracker::CollectOperators(CExpression *pexpr,
+														CBitSet *pbs)
+{
+	// protect against stack overflow during recursion
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+
+	(void) pbs->ExchangeSet(pexpr->Pop()->Eopid());
+
+	const ULONG arity = pexpr->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CollectOperators((*pexpr)[ul], pbs);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessor::CPassTracker::FStart
+//
+//	@doc:
+//		Start the given pass and return true, unless it is given the
+//		operators it acts on and none of them is in the current expression
+//
+//---------------------------------------------------------------------------
+BOOL
+CExpressionPreprocessor::CPassTracker::FStart(const CHAR *szPass,
+											  COperator::EOperatorId eopid1,
+											  COperator::EOperatorId eopid2,
+											  COperator::EOperatorId eopid3)
+{
+	GPOS_ASSERT(NULL != szPass);
+	GPOS_ASSERT(NULL == m_szPass && "previous pass not finished");
+
+	if (COperator::EopSentinel != eopid1)
+	{
+		if (NULL == m_pbsOperators)
+		{
+			m_pbsOperators =
+				GPOS_NEW(m_mp) CBitSet(m_mp, COperator::EopSentinel);
+			CollectOperators(m_pexpr, m_pbsOperators);
+		}
+
+		if (!m_pbsOperators->Get(eopid1) &&
+			(COperator::EopSentinel == eopid2 ||
+			 !m_pbsOperators->Get(eopid2)) &&
+			(COperator::EopSentinel == eopid3 || !m_pbsOperators->Get(eopid3)))
+		{
+			m_ulSkipped++;
+			if (m_fTrace)
+			{
+				GPOS_TRACE_FORMAT("[OPT]: Preprocessing %s: skipped", szPass);
+			}
+
+			return false;
+		}
+	}
+
+	m_szPass = szPass;
+	m_timer.Restart();
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessor::CPassTracker::Finish
+//
+//	@doc:
+//		Finish the running pass with the expression it returned; a pass
+//		that changed nothing returns its input
+//
+//---------------------------------------------------------------------------
+void
+CExpressionPreprocessor::CPassTracker::Finish(CExpression *pexprNew)
+{
+	GPOS_ASSERT(NULL != m_szPass && "pass not started");
+	GPOS_ASSERT(NULL != pexprNew);
+
+	ULONG ulElapsedTimeUS = m_timer.ElapsedUS();
+	BOOL fUnchanged = (pexprNew == m_pexpr);
+
+	m_ulRun++;
+	if (fUnchanged)
+	{
+		m_ulUnchanged++;
+	}
+	else
+	{
+		// operators are collected again when a pass needs them
+		CRefCount::SafeRelease(m_pbsOperators);
+		m_pbsOperators = NULL;
+	}
+
+	m_pexpr->Release();
+	m_pexpr = pexprNew;
+
+	if (m_fTrace)
+	{
+		GPOS_TRACE_FORMAT("[OPT]: Preprocessing %s: %dus%s", m_szPass,
+						  ulElapsedTimeUS, fUnchanged ? " (unchanged)" : "");
+	}
+	m_szPass = NULL;
+
+	GPOS_CHECK_ABORT;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessor::CPassTracker::PexprResult
+//
+//	@doc:
+//		Hand over the current expression to the caller
+//
+//---------------------------------------------------------------------------
+CExpression *
+CExpressionPreprocessor::CPassTracker::PexprResult()
+{
+	GPOS_ASSERT(NULL == m_szPass && "pass not finished");
+
+	CExpression *pexpr = m_pexpr;
+	m_pexpr = NULL;
+
+	return pexpr;
+}
+
 // main driver, pre-processing of input logical expression
 CExpression *
 CExpressionPreprocessor::PexprPreprocess(
@@ -2541,174 +2732,207 @@ CExpressionPreprocessor::PexprPreprocess(
 	CAutoTimer at("\n[OPT]: Expression Preprocessing Time",
 				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
+	// passes given operators are skipped when the expression has none of them
+	CPassTracker passes(mp, pexpr);
+
 	// (1) remove unused CTE anchors
-	CExpression *pexprNoUnusedCTEs = PexprRemoveUnusedCTEs(mp, pexpr);
-	GPOS_CHECK_ABORT;
+	if (passes.FStart("(1) remove unused CTEs", COperator::EopLogicalCTEAnchor))
+	{
+		passes.Finish(PexprRemoveUnusedCTEs(mp, passes.Pexpr()));
+	}
 
 	// (2.a) remove intermediate superfluous limit
-	CExpression *pexprSimplifiedLimit =
-		PexprRemoveSuperfluousLimit(mp, pexprNoUnusedCTEs);
-	GPOS_CHECK_ABORT;
-	pexprNoUnusedCTEs->Release();
+	if (passes.FStart("(2.a) remove superfluous limit",
+					  COperator::EopLogicalLimit))
+	{
+		passes.Finish(PexprRemoveSuperfluousLimit(mp, passes.Pexpr()));
+	}
 
 	// (2.b) remove intermediate superfluous distinct
-	CExpression *pexprSimplifiedDistinct =
-		PexprRemoveSuperfluousDistinctInDQA(mp, pexprSimplifiedLimit);
-	GPOS_CHECK_ABORT;
-	pexprSimplifiedLimit->Release();
+	if (passes.FStart("(2.b) remove superfluous distinct in DQA",
+					  COperator::EopLogicalGbAgg))
+	{
+		passes.Finish(PexprRemoveSuperfluousDistinctInDQA(mp, passes.Pexpr()));
+	}
 
-	// (3) trim unnecessary existential subqueries
-	CExpression *pexprTrimmed =
-		PexprTrimExistentialSubqueries(mp, pexprSimplifiedDistinct);
-	GPOS_CHECK_ABORT;
-	pexprSimplifiedDistinct->Release();
+	// (3) trim unnecessary existential subqueries; AND/OR trees are rebuilt
+	// on the way, so they are kept for this pass too
+	if (passes.FStart("(3) trim existential subqueries",
+					  COperator::EopScalarSubqueryExists,
+					  COperator::EopScalarSubqueryNotExists,
+					  COperator::EopScalarBoolOp))
+	{
+		passes.Finish(PexprTrimExistentialSubqueries(mp, passes.Pexpr()));
+	}
 
 	// (4) collapse cascaded union / union all
-	CExpression *pexprNaryUnionUnionAll =
-		PexprCollapseUnionUnionAll(mp, pexprTrimmed);
-	GPOS_CHECK_ABORT;
-	pexprTrimmed->Release();
+	if (passes.FStart("(4) collapse union / union all",
+					  COperator::EopLogicalUnion, COperator::EopLogicalUnionAll))
+	{
+		passes.Finish(PexprCollapseUnionUnionAll(mp, passes.Pexpr()));
+	}
 
 	// (5) remove superfluous outer references from the order spec in limits, grouping columns in GbAgg, and
 	// Partition/Order columns in window operators
-	CExpression *pexprOuterRefsEleminated =
-		PexprRemoveSuperfluousOuterRefs(mp, pexprNaryUnionUnionAll);
-	GPOS_CHECK_ABORT;
-	pexprNaryUnionUnionAll->Release();
+	if (passes.FStart("(5) remove superfluous outer references",
+					  COperator::EopLogicalLimit, COperator::EopLogicalGbAgg,
+					  COperator::EopLogicalSequenceProject))
+	{
+		passes.Finish(PexprRemoveSuperfluousOuterRefs(mp, passes.Pexpr()));
+	}
 
 	// (6) remove superfluous equality
-	CExpression *pexprTrimmed2 =
-		PexprPruneSuperfluousEquality(mp, pexprOuterRefsEleminated);
-	GPOS_CHECK_ABORT;
-	pexprOuterRefsEleminated->Release();
+	if (passes.FStart("(6) prune superfluous equality"))
+	{
+		passes.Finish(PexprPruneSuperfluousEquality(mp, passes.Pexpr()));
+	}
 
 	// (7) simplify quantified subqueries
-	CExpression *pexprSubqSimplified =
-		PexprSimplifyQuantifiedSubqueries(mp, pexprTrimmed2);
-	GPOS_CHECK_ABORT;
-	pexprTrimmed2->Release();
+	if (passes.FStart("(7) simplify quantified subqueries",
+					  COperator::EopScalarSubqueryAny,
+					  COperator::EopScalarSubqueryAll))
+	{
+		passes.Finish(PexprSimplifyQuantifiedSubqueries(mp, passes.Pexpr()));
+	}
 
 	// (8) do preliminary unnesting of scalar subqueries
-	CExpression *pexprSubqUnnested =
-		PexprUnnestScalarSubqueries(mp, pexprSubqSimplified);
-	GPOS_CHECK_ABORT;
-	pexprSubqSimplified->Release();
+	if (passes.FStart("(8) unnest scalar subqueries",
+					  COperator::EopScalarSubquery))
+	{
+		passes.Finish(PexprUnnestScalarSubqueries(mp, passes.Pexpr()));
+	}
 
 	// (9) unnest AND/OR/NOT predicates
-	CExpression *pexprUnnested =
-		CExpressionUtils::PexprUnnest(mp, pexprSubqUnnested);
-	GPOS_CHECK_ABORT;
-	pexprSubqUnnested->Release();
-
-	CExpression *pexprConvert2In = pexprUnnested;
+	if (passes.FStart("(9) unnest AND/OR/NOT predicates"))
+	{
+		passes.Finish(CExpressionUtils::PexprUnnest(mp, passes.Pexpr()));
+	}
 
 	if (GPOS_FTRACE(EopttraceArrayConstraints))
 	{
 		// (9.5) ensure predicates are array IN or NOT IN where applicable
-		pexprConvert2In = PexprConvert2In(mp, pexprUnnested);
-		GPOS_CHECK_ABORT;
-		pexprUnnested->Release();
+		if (passes.FStart("(9.5) convert to IN / NOT IN"))
+		{
+			passes.Finish(PexprConvert2In(mp, passes.Pexpr()));
+		}
 	}
 
 	// (10) infer predicates from constraints
-	CExpression *pexprInferredPreds = PexprInferPredicates(mp, pexprConvert2In);
-	GPOS_CHECK_ABORT;
-	pexprConvert2In->Release();
+	if (passes.FStart("(10) infer predicates"))
+	{
+		passes.Finish(PexprInferPredicates(mp, passes.Pexpr()));
+	}
 
 	// (11) eliminate self comparisons
-	CExpression *pexprSelfCompEliminated =
-		PexprEliminateSelfComparison(mp, pexprInferredPreds);
-	GPOS_CHECK_ABORT;
-	pexprInferredPreds->Release();
+	if (passes.FStart("(11) eliminate self comparisons"))
+	{
+		passes.Finish(PexprEliminateSelfComparison(mp, passes.Pexpr()));
+	}
 
 	// (12) remove duplicate AND/OR children
-	CExpression *pexprDeduped =
-		CExpressionUtils::PexprDedupChildren(mp, pexprSelfCompEliminated);
-	GPOS_CHECK_ABORT;
-	pexprSelfCompEliminated->Release();
+	if (passes.FStart("(12) dedup AND/OR children"))
+	{
+		passes.Finish(CExpressionUtils::PexprDedupChildren(mp, passes.Pexpr()));
+	}
 
 	// (13) factorize common expressions
-	CExpression *pexprFactorized =
-		CExpressionFactorizer::PexprFactorize(mp, pexprDeduped);
-	GPOS_CHECK_ABORT;
-	pexprDeduped->Release();
+	if (passes.FStart("(13) factorize common expressions"))
+	{
+		passes.Finish(CExpressionFactorizer::PexprFactorize(mp, passes.Pexpr()));
+	}
 
 	// (14) infer filters out of components of disjunctive filters
-	CExpression *pexprPrefiltersExtracted =
-		CExpressionFactorizer::PexprExtractInferredFilters(mp, pexprFactorized);
-	GPOS_CHECK_ABORT;
-	pexprFactorized->Release();
+	if (passes.FStart("(14) extract inferred filters"))
+	{
+		passes.Finish(CExpressionFactorizer::PexprExtractInferredFilters(
+			mp, passes.Pexpr()));
+	}
 
 	// (15) pre-process window functions
-	CExpression *pexprWindowPreprocessed =
-		CWindowPreprocessor::PexprPreprocess(mp, pexprPrefiltersExtracted);
-	GPOS_CHECK_ABORT;
-	pexprPrefiltersExtracted->Release();
+	if (passes.FStart("(15) preprocess window functions",
+					  COperator::EopLogicalSequenceProject))
+	{
+		passes.Finish(CWindowPreprocessor::PexprPreprocess(mp, passes.Pexpr()));
+	}
 
 	// (16) eliminate unused computed columns
-	CExpression *pexprNoUnusedPrEl = PexprPruneUnusedComputedCols(
-		mp, pexprWindowPreprocessed, pcrsOutputAndOrderCols);
-	GPOS_CHECK_ABORT;
-	pexprWindowPreprocessed->Release();
+	if (passes.FStart("(16) prune unused computed columns"))
+	{
+		passes.Finish(PexprPruneUnusedComputedCols(mp, passes.Pexpr(),
+												   pcrsOutputAndOrderCols));
+	}
 
 	// (17) normalize expression
-	CExpression *pexprNormalized1 =
-		CNormalizer::PexprNormalize(mp, pexprNoUnusedPrEl);
-	GPOS_CHECK_ABORT;
-	pexprNoUnusedPrEl->Release();
+	if (passes.FStart("(17) normalize"))
+	{
+		passes.Finish(CNormalizer::PexprNormalize(mp, passes.Pexpr()));
+	}
 
 	// (18) transform outer join into inner join whenever possible
-	CExpression *pexprLOJToIJ = PexprOuterJoinToInnerJoin(mp, pexprNormalized1);
-	GPOS_CHECK_ABORT;
-	pexprNormalized1->Release();
+	if (passes.FStart("(18) outer join to inner join",
+					  COperator::EopLogicalLeftOuterJoin,
+					  COperator::EopLogicalInnerJoin,
+					  COperator::EopLogicalNAryJoin))
+	{
+		passes.Finish(PexprOuterJoinToInnerJoin(mp, passes.Pexpr()));
+	}
 
 	// (19) collapse cascaded inner and left outer joins
-	CExpression *pexprCollapsed = PexprCollapseJoins(mp, pexprLOJToIJ);
-	GPOS_CHECK_ABORT;
-	pexprLOJToIJ->Release();
+	if (passes.FStart("(19) collapse joins", COperator::EopLogicalInnerJoin,
+					  COperator::EopLogicalNAryJoin,
+					  COperator::EopLogicalLeftOuterJoin))
+	{
+		passes.Finish(PexprCollapseJoins(mp, passes.Pexpr()));
+	}
 
 	// (20) after transforming outer joins to inner joins, we may be able to generate more predicates from constraints
-	CExpression *pexprWithPreds =
-		PexprAddPredicatesFromConstraints(mp, pexprCollapsed);
-	GPOS_CHECK_ABORT;
-	pexprCollapsed->Release();
+	if (passes.FStart("(20) add predicates from constraints"))
+	{
+		passes.Finish(PexprAddPredicatesFromConstraints(mp, passes.Pexpr()));
+	}
 
 	// (21) eliminate empty subtrees
-	CExpression *pexprPruned = PexprPruneEmptySubtrees(mp, pexprWithPreds);
-	GPOS_CHECK_ABORT;
-	pexprWithPreds->Release();
+	if (passes.FStart("(21) prune empty subtrees"))
+	{
+		passes.Finish(PexprPruneEmptySubtrees(mp, passes.Pexpr()));
+	}
 
 	// (22) collapse cascade of projects
-	CExpression *pexprCollapsedProjects =
-		PexprCollapseProjects(mp, pexprPruned);
-	GPOS_CHECK_ABORT;
-	pexprPruned->Release();
+	if (passes.FStart("(22) collapse projects", COperator::EopLogicalProject))
+	{
+		passes.Finish(PexprCollapseProjects(mp, passes.Pexpr()));
+	}
 
 	// (23) insert dummy project when the scalar subquery is under a project and returns an outer reference
-	CExpression *pexprSubquery = PexprProjBelowSubquery(
-		mp, pexprCollapsedProjects, false /* fUnderPrList */);
-	GPOS_CHECK_ABORT;
-	pexprCollapsedProjects->Release();
+	if (passes.FStart("(23) project below subquery",
+					  COperator::EopScalarSubquery))
+	{
+		passes.Finish(PexprProjBelowSubquery(mp, passes.Pexpr(),
+											 false /* fUnderPrList */));
+	}
 
 	// (24) reorder the children of scalar cmp operator to ensure that left child is scalar ident and right child is scalar const
-	CExpression *pexrReorderedScalarCmpChildren =
-		PexprReorderScalarCmpChildren(mp, pexprSubquery);
-	GPOS_CHECK_ABORT;
-	pexprSubquery->Release();
+	if (passes.FStart("(24) reorder scalar cmp children",
+					  COperator::EopScalarCmp,
+					  COperator::EopScalarIsDistinctFrom))
+	{
+		passes.Finish(PexprReorderScalarCmpChildren(mp, passes.Pexpr()));
+	}
 
 	// (25) rewrite IN subquery to EXIST subquery with a predicate
-	CExpression *pexprExistWithPredFromINSubq =
-		PexprExistWithPredFromINSubq(mp, pexrReorderedScalarCmpChildren);
-	GPOS_CHECK_ABORT;
-	pexrReorderedScalarCmpChildren->Release();
+	if (passes.FStart("(25) IN subquery to EXISTS with predicate",
+					  COperator::EopScalarSubqueryAny))
+	{
+		passes.Finish(PexprExistWithPredFromINSubq(mp, passes.Pexpr()));
+	}
 
 	// (26) normalize expression again
-	CExpression *pexprNormalized2 =
-		CNormalizer::PexprNormalize(mp, pexprExistWithPredFromINSubq);
-	GPOS_CHECK_ABORT;
-	pexprExistWithPredFromINSubq->Release();
+	if (passes.FStart("(26) normalize again"))
+	{
+		passes.Finish(CNormalizer::PexprNormalize(mp, passes.Pexpr()));
+	}
 
-	return pexprNormalized2;
+	return passes.PexprResult();
 }
 
 // EOF
@@ -11,9 +11,11 @@
 
 #include "gpos/common/CBitSet.h"
 #include "gpos/common/CDebugCounter.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/error/CErrorHandlerStandard.h"
 #include "gpos/io/CFileDescriptor.h"
+#include "gpos/io/COstreamString.h"
 
 #include "naucrates/base/CDatumGenericGPDB.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
@@ -24,6 +26,7 @@
 #include "gpopt/base/CQueryContext.h"
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/engine/CEnumeratorConfig.h"
+#include "gpopt/engine/COptimizationStats.h"
 #include "gpopt/engine/CStatisticsConfig.h"
 #include "gpopt/exception.h"
 #include "gpopt/minidump/CMiniDumperDXL.h"
@@ -39,6 +42,7 @@
 
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/optimizer/COptimizer.h"
+#include "gpopt/optimizer/CPlanCache.h"
 #include "gpopt/cost/ICostModel.h"
 
 #include <fstream>
@@ -223,7 +227,8 @@ COptimizer::PrintQueryOrPlan(CMemoryPool *mp, CExpression *pexpr,
 //	@doc:
 //		Optimize given query
 //		the function is oblivious of trace flags setting/resetting which
-//		must happen at the caller side if needed
+//		must happen at the caller side if needed; if the plan cache is
+//		enabled, a cached plan of the query skips the optimization
 //
 //---------------------------------------------------------------------------
 CDXLNode *
@@ -244,25 +249,53 @@ COptimizer::PdxlnOptimize(
 
 	BOOL fMinidump = GPOS_FTRACE(EopttraceMinidump);
 
+	// plans are looked up in the plan cache, unless the optimization is to
+	// be recorded, or depends on more than the query and the configuration
+	CAutoP<CNormalizedQuery> apnq;
+	if (GPOS_FTRACE(EopttraceEnablePlanCache) && CPlanCache::FInitialized() &&
+		!fMinidump && !GPOS_FTRACE(EopttraceSamplePlans) &&
+		!GPOS_FTRACE(EopttraceEnableConstantExpressionEvaluation) &&
+		NULL == search_stage_array)
+	{
+		apnq = GPOS_NEW(mp)
+			CNormalizedQuery(mp, query, query_output_dxlnode_array,
+							 cte_producers, optimizer_config, ulHosts);
+		CDXLNode *pdxlnCached = CPlanCache::PdxlnLookup(mp, apnq.Value());
+		if (NULL != pdxlnCached)
+		{
+			return pdxlnCached;
+		}
+	}
+
 	// If minidump was requested, open the minidump file and initialize
 	// minidumper. (We create the minidumper object even if we're not
 	// dumping, but without the Init-call, it will stay inactive.)
 	CMiniDumperDXL mdmp;
 	CAutoP<std::wofstream> wosMinidump;
-	CAutoP<COstreamBasic> osMinidump;
+	CAutoP<CWStringDynamic> strMinidump;
+	CAutoP<COstream> osMinidump;
+	CHAR file_name[GPOS_FILE_NAME_BUF_SIZE];
 	if (fMinidump)
 	{
-		CHAR file_name[GPOS_FILE_NAME_BUF_SIZE];
-
 		CMinidumperUtils::GenerateMinidumpFileName(
 			file_name, GPOS_FILE_NAME_BUF_SIZE, ulSessionId, ulCmdId,
 			szMinidumpFileName);
 
-		// Note: std::wofstream won't throw an error on failure. The stream is merely marked as
-		// failed. We could check the state, and avoid the overhead of serializing the
-		// minidump if it failed, but it's hardly worth optimizing for an error case.
-		wosMinidump = GPOS_NEW(mp) std::wofstream(file_name);
-		osMinidump = GPOS_NEW(mp) COstreamBasic(wosMinidump.Value());
+		if (GPOS_FTRACE(EopttraceBinaryDXL))
+		{
+			// binary minidumps are collected as XML, and converted once
+			// complete
+			strMinidump = GPOS_NEW(mp) CWStringDynamic(mp);
+			osMinidump = GPOS_NEW(mp) COstreamString(strMinidump.Value());
+		}
+		else
+		{
+			// Note: std::wofstream won't throw an error on failure. The stream is merely marked as
+			// failed. We could check the state, and avoid the overhead of serializing the
+			// minidump if it failed, but it's hardly worth optimizing for an error case.
+			wosMinidump = GPOS_NEW(mp) std::wofstream(file_name);
+			osMinidump = GPOS_NEW(mp) COstreamBasic(wosMinidump.Value());
+		}
 
 		mdmp.Init(osMinidump.Value());
 	}
@@ -286,6 +319,11 @@ COptimizer::PdxlnOptimize(
 			// install opt context in TLS
 			CAutoOptCtxt aoc(mp, md_accessor, pceeval, optimizer_config);
 
+			// phases outside the engine are timed here
+			COptimizationStats *optimization_stats =
+				optimizer_config->GetOptimizationStats();
+			CWallClock clock;
+
 			// translate DXL Tree -> Expr Tree
 			CTranslatorDXLToExpr dxltr(mp, md_accessor);
 			CExpression *pexprTranslated = dxltr.PexprTranslateQuery(
@@ -293,11 +331,15 @@ COptimizer::PdxlnOptimize(
 			GPOS_CHECK_ABORT;
 			gpdxl::ULongPtrArray *pdrgpul = dxltr.PdrgpulOutputColRefs();
 			gpmd::CMDNameArray *pdrgpmdname = dxltr.Pdrgpmdname();
+			RecordPhase(optimization_stats,
+						COptimizationStats::EphQueryTranslation, &clock);
 
 			CQueryContext *pqc =
 				CQueryContext::PqcGenerate(mp, pexprTranslated, pdrgpul,
 										   pdrgpmdname, true /*fDeriveStats*/);
 			GPOS_CHECK_ABORT;
+			RecordPhase(optimization_stats,
+						COptimizationStats::EphPreprocessing, &clock);
 
 			PrintQueryOrPlan(mp, pexprTranslated, pqc);
 
@@ -313,15 +355,27 @@ COptimizer::PdxlnOptimize(
 				COptCtxt::PoctxtFromTLS()->Pcteinfo()->DisableInlining();
 			}
 
+			// unless a search strategy is given, pick one from the
+			// complexity of the preprocessed query
+			if (NULL == search_stage_array &&
+				GPOS_FTRACE(EopttraceEnableAdaptiveSearchStrategy))
+			{
+				search_stage_array =
+					CSearchStage::PdrgpssAdaptive(mp, pqc->Pexpr());
+			}
+
 			GPOS_CHECK_ABORT;
 			// optimize logical expression tree into physical expression tree.
 			CExpression *pexprPlan = PexprOptimize(mp, pqc, search_stage_array);
 			GPOS_CHECK_ABORT;
 
 			// translate plan into DXL
+			clock.Restart();
 			pdxlnPlan = CreateDXLNode(mp, md_accessor, pexprPlan,
 									  pqc->PdrgPcr(), pdrgpmdname, ulHosts);
 			GPOS_CHECK_ABORT;
+			RecordPhase(optimization_stats,
+						COptimizationStats::EphPlanTranslation, &clock);
 
 			if (fMinidump)
 			{
@@ -330,6 +384,11 @@ COptimizer::PdxlnOptimize(
 					optimizer_config->GetEnumeratorCfg()->GetPlanId(),
 					optimizer_config->GetEnumeratorCfg()->GetPlanSpaceSize());
 				CMinidumperUtils::Finalize(&mdmp, true /* fSerializeErrCtxt*/);
+				if (NULL != strMinidump.Value())
+				{
+					CMinidumperUtils::Write(mp, file_name, strMinidump.Value(),
+											true /*fBinary*/);
+				}
 				GPOS_CHECK_ABORT;
 			}
 
@@ -351,6 +410,13 @@ COptimizer::PdxlnOptimize(
 		if (fMinidump)
 		{
 			CMinidumperUtils::Finalize(&mdmp, false /* fSerializeErrCtxt*/);
+			// the minidump of a failed optimization is kept as XML, as
+			// converting it may raise while handling the error
+			if (NULL != strMinidump.Value())
+			{
+				CMinidumperUtils::Write(mp, file_name, strMinidump.Value(),
+										false /*fBinary*/);
+			}
 			HandleExceptionAfterFinalizingMinidump(ex);
 		}
 
@@ -358,9 +424,34 @@ COptimizer::PdxlnOptimize(
 	}
 	GPOS_CATCH_END;
 
+	if (NULL != apnq.Value())
+	{
+		CPlanCache::Insert(apnq.Value(), pdxlnPlan);
+	}
+
 	return pdxlnPlan;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::RecordPhase
+//
+//	@doc:
+//		Add the time measured by the given clock to the given phase, if the
+//		optimization is being measured, and restart the clock
+//
+//---------------------------------------------------------------------------
+void
+COptimizer::RecordPhase(COptimizationStats *optimization_stats,
+						COptimizationStats::EPhase eph, CWallClock *clock)
+{
+	if (NULL != optimization_stats)
+	{
+		optimization_stats->AddPhaseTime(eph, clock->ElapsedUS());
+	}
+	clock->Restart();
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptimizer::HandleExceptionAfterFinalizingMinidump
@@ -13,6 +13,7 @@
 #include "gpos/string/CWStringDynamic.h"
 
 #include "gpopt/cost/ICostModel.h"
+#include "gpopt/engine/COptimizationStats.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "naucrates/dxl/CCostModelConfigSerializer.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
@@ -37,7 +38,8 @@ COptimizerConfig::COptimizerConfig(CEnumeratorConfig *pec,
 	  m_cte_conf(pcteconf),
 	  m_cost_model(cost_model),
 	  m_hint(phint),
-	  m_window_oids(pwindowoids)
+	  m_window_oids(pwindowoids),
+	  m_optimization_stats(NULL)
 {
 	GPOS_ASSERT(NULL != pec);
 	GPOS_ASSERT(NULL != stats_config);
@@ -63,6 +65,23 @@ COptimizerConfig::~COptimizerConfig()
 	m_cost_model->Release();
 	m_hint->Release();
 	m_window_oids->Release();
+	CRefCount::SafeRelease(m_optimization_stats);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerConfig::SetOptimizationStats
+//
+//	@doc:
+//		Collect counters of the optimization into the given object, or stop
+//		collecting them if it is NULL; takes ownership of the object
+//
+//---------------------------------------------------------------------------
+void
+COptimizerConfig::SetOptimizationStats(COptimizationStats *optimization_stats)
+{
+	CRefCount::SafeRelease(m_optimization_stats);
+	m_optimization_stats = optimization_stats;
 }
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,790 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CPlanCache.cpp
+//
+//	@doc:
+//		Implementation of the cache of optimized plans
+//---------------------------------------------------------------------------
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CCacheAccessor.h"
+#include "gpos/memory/CCacheFactory.h"
+#include "gpos/task/CTask.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLDatumGeneric.h"
+#include "naucrates/dxl/operators/CDXLDirectDispatchInfo.h"
+#include "naucrates/dxl/operators/CDXLScalarConstValue.h"
+#include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/CPlanCache.h"
+
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpmd;
+using namespace gpopt;
+
+
+// global instance of plan cache
+CPlanCache::PlanCache *CPlanCache::m_pcache = NULL;
+
+// maximum size of the cache
+ULLONG CPlanCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
+
+// number of lookups that returned a plan
+ULLONG CPlanCache::m_ullHitCounter = 0;
+
+// number of lookups that did not return a plan
+ULLONG CPlanCache::m_ullMissCounter = 0;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::CNormalizedQuery
+//
+//	@doc:
+//		Ctor; the trace flags are taken from the current task
+//
+//---------------------------------------------------------------------------
+CNormalizedQuery::CNormalizedQuery(
+	CMemoryPool *mp, const CDXLNode *query,
+	const CDXLNodeArray *query_output_dxlnode_array,
+	const CDXLNodeArray *cte_producers, const COptimizerConfig *optimizer_config,
+	ULONG ulHosts)
+	: m_mp(mp),
+	  m_key(NULL),
+	  m_constants_str(NULL),
+	  m_constants(NULL),
+	  m_constant_strs(NULL),
+	  m_positions(NULL),
+	  m_const_types(NULL),
+	  m_has_null(false),
+	  m_has_duplicates(false),
+	  m_has_other_datums(false)
+{
+	GPOS_ASSERT(NULL != query);
+	GPOS_ASSERT(NULL != query_output_dxlnode_array);
+	GPOS_ASSERT(NULL != optimizer_config);
+
+	m_key = GPOS_NEW(mp) CWStringDynamic(mp);
+	m_constants_str = GPOS_NEW(mp) CWStringDynamic(mp);
+	m_constants = GPOS_NEW(mp) CDXLNodeArray(mp);
+	m_constant_strs = GPOS_NEW(mp) StringPtrArray(mp);
+	m_positions = GPOS_NEW(mp) StringToPosMap(mp);
+	m_const_types = GPOS_NEW(mp) MdidHashSet(mp);
+
+	CDXLNode *masked_query = PdxlnMask(query);
+	CDXLNodeArray *masked_output_array =
+		PdrgpdxlnMask(query_output_dxlnode_array);
+	CDXLNodeArray *masked_cte_producers = PdrgpdxlnMask(cte_producers);
+
+	COstreamString oss(m_key);
+	CDXLUtils::SerializeQuery(mp, oss, masked_query, masked_output_array,
+							  masked_cte_producers,
+							  false /*serialize_document_header_footer*/,
+							  false /*indentation*/);
+
+	masked_query->Release();
+	masked_output_array->Release();
+	CRefCount::SafeRelease(masked_cte_producers);
+
+	{
+		CXMLSerializer xml_serializer(mp, oss, false /*indentation*/);
+		CBitSet *trace_flags =
+			CTask::Self()->GetTaskCtxt()->copy_trace_flags(mp);
+		optimizer_config->Serialize(mp, &xml_serializer, trace_flags);
+		trace_flags->Release();
+	}
+	oss << ulHosts;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::~CNormalizedQuery
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CNormalizedQuery::~CNormalizedQuery()
+{
+	m_const_types->Release();
+	m_positions->Release();
+	m_constant_strs->Release();
+	m_constants->Release();
+	GPOS_DELETE(m_constants_str);
+	GPOS_DELETE(m_key);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::AddConstant
+//
+//	@doc:
+//		Add a constant of the query
+//
+//---------------------------------------------------------------------------
+void
+CNormalizedQuery::AddConstant(CDXLNode *dxlnode)
+{
+	const CDXLDatum *datum =
+		CDXLScalarConstValue::Cast(dxlnode->GetOperator())->GetDatumVal();
+	CWStringDynamic *str = PstrConst(m_mp, dxlnode);
+	ULONG pos = m_constants->Size();
+
+	dxlnode->AddRef();
+	m_constants->Append(dxlnode);
+	m_constant_strs->Append(str);
+	m_constants_str->Append(str);
+
+	m_has_null = m_has_null || datum->IsNull();
+	ULONG *pos_copy = GPOS_NEW(m_mp) ULONG(pos);
+	if (!m_positions->Insert(str, pos_copy))
+	{
+		GPOS_DELETE(pos_copy);
+		m_has_duplicates = true;
+	}
+
+	IMDId *mdid = datum->MDId();
+	mdid->AddRef();
+	if (!m_const_types->Insert(mdid))
+	{
+		mdid->Release();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::PdxlnMask
+//
+//	@doc:
+//		Copy of the given tree, sharing its operators, where every const
+//		value is replaced by a null of the same type
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CNormalizedQuery::PdxlnMask(const CDXLNode *dxlnode)
+{
+	CDXLOperator *dxl_op = dxlnode->GetOperator();
+
+	if (EdxlopScalarConstValue == dxl_op->GetDXLOperator())
+	{
+		const CDXLDatum *datum =
+			CDXLScalarConstValue::Cast(dxl_op)->GetDatumVal();
+		AddConstant(const_cast<CDXLNode *>(dxlnode));
+
+		IMDId *mdid = datum->MDId();
+		mdid->AddRef();
+		CDXLDatum *masked_datum = GPOS_NEW(m_mp)
+			CDXLDatumGeneric(m_mp, mdid, datum->TypeModifier(),
+							 true /*is_null*/, NULL /*data*/, 0 /*length*/);
+
+		return GPOS_NEW(m_mp) CDXLNode(
+			m_mp, GPOS_NEW(m_mp) CDXLScalarConstValue(m_mp, masked_datum));
+	}
+
+	if (EdxlopLogicalConstTable == dxl_op->GetDXLOperator())
+	{
+		// values of const tables remain part of the key
+		m_has_other_datums = true;
+	}
+
+	dxl_op->AddRef();
+	CDXLNode *masked_dxlnode = GPOS_NEW(m_mp) CDXLNode(m_mp, dxl_op);
+
+	const ULONG arity = dxlnode->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		masked_dxlnode->AddChild(PdxlnMask((*dxlnode)[ul]));
+	}
+
+	return masked_dxlnode;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::PdrgpdxlnMask
+//
+//	@doc:
+//		Masked copies of the given trees
+//
+//---------------------------------------------------------------------------
+CDXLNodeArray *
+CNormalizedQuery::PdrgpdxlnMask(const CDXLNodeArray *dxl_array)
+{
+	if (NULL == dxl_array)
+	{
+		return NULL;
+	}
+
+	CDXLNodeArray *masked_dxl_array = GPOS_NEW(m_mp) CDXLNodeArray(m_mp);
+	const ULONG size = dxl_array->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		masked_dxl_array->Append(PdxlnMask((*dxl_array)[ul]));
+	}
+
+	return masked_dxl_array;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::UlPosition
+//
+//	@doc:
+//		Position of the constant with the given serialization, or ulong_max
+//		if there is none
+//
+//---------------------------------------------------------------------------
+ULONG
+CNormalizedQuery::UlPosition(const CWStringBase *str) const
+{
+	const ULONG *pos = m_positions->Find(str);
+	if (NULL == pos)
+	{
+		return gpos::ulong_max;
+	}
+
+	return *pos;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::FConstType
+//
+//	@doc:
+//		Is there a constant of the given type?
+//
+//---------------------------------------------------------------------------
+BOOL
+CNormalizedQuery::FConstType(IMDId *mdid) const
+{
+	return m_const_types->Contains(mdid);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::PstrConst
+//
+//	@doc:
+//		Serialize a const value on its own
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+CNormalizedQuery::PstrConst(CMemoryPool *mp, const CDXLNode *dxlnode)
+{
+	GPOS_ASSERT(EdxlopScalarConstValue ==
+				dxlnode->GetOperator()->GetDXLOperator());
+
+	CWStringDynamic *str = GPOS_NEW(mp) CWStringDynamic(mp);
+	COstreamString oss(str);
+	CXMLSerializer xml_serializer(mp, oss, false /*indentation*/);
+	dxlnode->SerializeToDXL(&xml_serializer);
+
+	return str;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::HashStr
+//
+//	@doc:
+//		Hash function for strings
+//
+//---------------------------------------------------------------------------
+ULONG
+CNormalizedQuery::HashStr(const CWStringBase *str)
+{
+	return gpos::HashByteArray((const BYTE *) str->GetBuffer(),
+							   str->Length() * GPOS_SIZEOF(WCHAR));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CNormalizedQuery::EqualStrs
+//
+//	@doc:
+//		Equality function for strings
+//
+//---------------------------------------------------------------------------
+BOOL
+CNormalizedQuery::EqualStrs(const CWStringBase *str1, const CWStringBase *str2)
+{
+	return str1->Equals(str2);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::CPlanCacheEntry
+//
+//	@doc:
+//		Ctor; copies everything it keeps into the memory pool of the entry
+//
+//---------------------------------------------------------------------------
+CPlanCacheEntry::CPlanCacheEntry(CMemoryPool *mp, const CNormalizedQuery *query,
+								 const CDXLNode *plan)
+	: m_key(NULL),
+	  m_constants_str(NULL),
+	  m_plan(NULL),
+	  m_plan_length(0),
+	  m_const_positions(NULL),
+	  m_num_plan_consts(0)
+{
+	GPOS_ASSERT(NULL != query);
+	GPOS_ASSERT(NULL != plan);
+
+	m_key = GPOS_NEW(mp) CWStringDynamic(mp, query->Key()->GetBuffer());
+	m_constants_str =
+		GPOS_NEW(mp) CWStringDynamic(mp, query->ConstantsStr()->GetBuffer());
+	m_plan = CDXLUtils::SerializePlanToBinary(mp, plan, 0 /*plan_id*/,
+											  0 /*plan_space_size*/,
+											  &m_plan_length);
+
+	if (!query->FRebindable())
+	{
+		return;
+	}
+
+	ULongPtrArray *positions = GPOS_NEW(mp) ULongPtrArray(mp);
+	CBitSet *found_positions = GPOS_NEW(mp) CBitSet(mp);
+
+	// every query constant must have made it into the plan, otherwise the
+	// optimizer may have used its value to simplify the query
+	if (FCollectPositions(mp, plan, query, positions, found_positions) &&
+		found_positions->Size() == query->Constants()->Size())
+	{
+		m_num_plan_consts = positions->Size();
+		m_const_positions = GPOS_NEW_ARRAY(mp, ULONG, m_num_plan_consts);
+		for (ULONG ul = 0; ul < m_num_plan_consts; ul++)
+		{
+			m_const_positions[ul] = *(*positions)[ul];
+		}
+	}
+
+	found_positions->Release();
+	positions->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::~CPlanCacheEntry
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CPlanCacheEntry::~CPlanCacheEntry()
+{
+	GPOS_DELETE_ARRAY(m_const_positions);
+	GPOS_DELETE_ARRAY(m_plan);
+	GPOS_DELETE(m_constants_str);
+	GPOS_DELETE(m_key);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::FCollectPositions
+//
+//	@doc:
+//		Collect, for the const values below the given node in pre-order, the
+//		positions of the query constants they are copies of. A const value
+//		not serializing like any query constant is not bound, unless it has
+//		the type of a query constant, as it may then have been computed from
+//		one. Values outside of const values, like partition bounds and
+//		direct dispatch keys, cannot be bound at all
+//
+//---------------------------------------------------------------------------
+BOOL
+CPlanCacheEntry::FCollectPositions(CMemoryPool *mp, const CDXLNode *dxlnode,
+								   const CNormalizedQuery *query,
+								   ULongPtrArray *positions,
+								   CBitSet *found_positions)
+{
+	switch (dxlnode->GetOperator()->GetDXLOperator())
+	{
+		case EdxlopPhysicalConstTable:
+		case EdxlopPhysicalDynamicTableScan:
+		case EdxlopPhysicalDynamicIndexScan:
+		case EdxlopPhysicalDynamicBitmapTableScan:
+		case EdxlopPhysicalPartitionSelector:
+		case EdxlopScalarPartOid:
+		case EdxlopScalarPartDefault:
+		case EdxlopScalarPartBound:
+		case EdxlopScalarPartBoundInclusion:
+		case EdxlopScalarPartBoundOpen:
+		case EdxlopScalarPartListValues:
+		case EdxlopScalarPartListNullTest:
+			return false;
+
+		case EdxlopScalarConstValue:
+		{
+			CWStringDynamic *str = CNormalizedQuery::PstrConst(mp, dxlnode);
+			ULONG pos = query->UlPosition(str);
+			GPOS_DELETE(str);
+
+			if (gpos::ulong_max == pos)
+			{
+				const CDXLDatum *datum =
+					CDXLScalarConstValue::Cast(dxlnode->GetOperator())
+						->GetDatumVal();
+				if (query->FConstType(datum->MDId()))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				(void) found_positions->ExchangeSet(pos);
+			}
+
+			positions->Append(GPOS_NEW(mp) ULONG(pos));
+			return true;
+		}
+
+		default:
+			break;
+	}
+
+	CDXLDirectDispatchInfo *dxl_direct_dispatch_info =
+		dxlnode->GetDXLDirectDispatchInfo();
+	if (NULL != dxl_direct_dispatch_info &&
+		0 < dxl_direct_dispatch_info->GetDispatchIdentifierDatumArray()->Size())
+	{
+		return false;
+	}
+
+	const ULONG arity = dxlnode->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		if (!FCollectPositions(mp, (*dxlnode)[ul], query, positions,
+							   found_positions))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::Bind
+//
+//	@doc:
+//		Replace the const values below the given node by the constants of
+//		the given query they correspond to; visits const values in the
+//		same order as FCollectPositions
+//
+//---------------------------------------------------------------------------
+void
+CPlanCacheEntry::Bind(CDXLNode *dxlnode, const CNormalizedQuery *query,
+					  ULONG *plan_const) const
+{
+	const ULONG arity = dxlnode->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CDXLNode *child_dxlnode = (*dxlnode)[ul];
+		if (EdxlopScalarConstValue !=
+			child_dxlnode->GetOperator()->GetDXLOperator())
+		{
+			Bind(child_dxlnode, query, plan_const);
+			continue;
+		}
+
+		GPOS_ASSERT(*plan_const < m_num_plan_consts);
+		ULONG pos = m_const_positions[(*plan_const)++];
+		if (gpos::ulong_max != pos)
+		{
+			CDXLNode *constant = (*query->Constants())[pos];
+			constant->AddRef();
+			dxlnode->ReplaceChild(ul, constant);
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::FMatch
+//
+//	@doc:
+//		Does the cached plan fit the given query, which has the same key?
+//		It does if the query has the same constants, or if the plan can be
+//		bound to the constants of the query
+//
+//---------------------------------------------------------------------------
+BOOL
+CPlanCacheEntry::FMatch(const CNormalizedQuery *query) const
+{
+	GPOS_ASSERT(m_key->Equals(query->Key()));
+
+	return m_constants_str->Equals(query->ConstantsStr()) ||
+		   (FRebindable() && query->FBindable());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::PdxlnPlan
+//
+//	@doc:
+//		Cached plan, bound to the constants of the given query
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CPlanCacheEntry::PdxlnPlan(CMemoryPool *mp,
+						   const CNormalizedQuery *query) const
+{
+	GPOS_ASSERT(FMatch(query));
+
+	CAutoP<CParseHandlerDXL> parse_handler_dxl(
+		CDXLUtils::GetParseHandlerForDXLBinary(mp, m_plan, m_plan_length));
+	CDXLNode *plan = parse_handler_dxl->PdxlnPlan();
+	plan->AddRef();
+
+	if (!m_constants_str->Equals(query->ConstantsStr()))
+	{
+		ULONG plan_const = 0;
+		Bind(plan, query, &plan_const);
+		GPOS_ASSERT(plan_const == m_num_plan_consts);
+	}
+
+	return plan;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::UlHashKey
+//
+//	@doc:
+//		Hash function for keys
+//
+//---------------------------------------------------------------------------
+ULONG
+CPlanCache::UlHashKey(CWStringDynamic *const &key)
+{
+	return CNormalizedQuery::HashStr(key);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::FEqualKeys
+//
+//	@doc:
+//		Equality function for keys; the cache compares keys with NULL, its
+//		invalid key
+//
+//---------------------------------------------------------------------------
+BOOL
+CPlanCache::FEqualKeys(CWStringDynamic *const &key1,
+					   CWStringDynamic *const &key2)
+{
+	if (NULL == key1 || NULL == key2)
+	{
+		return key1 == key2;
+	}
+
+	return CNormalizedQuery::EqualStrs(key1, key2);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Init
+//
+//	@doc:
+//		Initializes global instance; plans of queries with different
+//		constants share keys, so the cache allows duplicate keys
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Init()
+{
+	GPOS_ASSERT(NULL == m_pcache && "Plan cache was already created");
+
+	m_pcache = CCacheFactory::CreateCache<CPlanCacheEntry *, CWStringDynamic *>(
+		false /*fUnique*/, m_ullCacheQuota, UlHashKey, FEqualKeys);
+	m_ullHitCounter = 0;
+	m_ullMissCounter = 0;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Shutdown
+//
+//	@doc:
+//		Cleans up the underlying cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Shutdown()
+{
+	GPOS_DELETE(m_pcache);
+	m_pcache = NULL;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Reset
+//
+//	@doc:
+//		Reset plan cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Reset()
+{
+	Shutdown();
+	Init();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::SetCacheQuota
+//
+//	@doc:
+//		Set the maximum size of the cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::SetCacheQuota(ULLONG ullCacheQuota)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Plan cache was not created");
+	m_ullCacheQuota = ullCacheQuota;
+	m_pcache->SetCacheQuota(ullCacheQuota);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheQuota
+//
+//	@doc:
+//		Get the maximum size of the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheQuota()
+{
+	GPOS_ASSERT_IMP(NULL != m_pcache,
+					m_pcache->GetCacheQuota() == m_ullCacheQuota);
+	return m_ullCacheQuota;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheHitCounter
+//
+//	@doc:
+// 		Get the number of lookups that returned a plan
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheHitCounter()
+{
+	return m_ullHitCounter;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheMissCounter
+//
+//	@doc:
+// 		Get the number of lookups that did not return a plan
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheMissCounter()
+{
+	return m_ullMissCounter;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::PdxlnLookup
+//
+//	@doc:
+//		Look up a plan for the given query among the cached plans with its
+//		key; returns NULL if none fits
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CPlanCache::PdxlnLookup(CMemoryPool *mp, const CNormalizedQuery *query)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Plan cache was not created");
+
+	CCacheAccessor<CPlanCacheEntry *, CWStringDynamic *> cache_accessor(
+		m_pcache);
+	cache_accessor.Lookup(const_cast<CWStringDynamic *>(query->Key()));
+
+	// the lookup hands out a reference to the first entry on top of the one
+	// the accessor holds until it moves on
+	CRefCount::SafeRelease(cache_accessor.Val());
+
+	for (CPlanCacheEntry *entry = cache_accessor.Val(); NULL != entry;
+		 entry = cache_accessor.Next())
+	{
+		if (entry->FMatch(query))
+		{
+			m_ullHitCounter++;
+			return entry->PdxlnPlan(mp, query);
+		}
+	}
+
+	m_ullMissCounter++;
+	return NULL;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Insert
+//
+//	@doc:
+//		Cache the plan optimized for the given query
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Insert(const CNormalizedQuery *query, const CDXLNode *plan)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Plan cache was not created");
+
+	CCacheAccessor<CPlanCacheEntry *, CWStringDynamic *> cache_accessor(
+		m_pcache);
+	CMemoryPool *mp = cache_accessor.Pmp();
+
+	CPlanCacheEntry *entry = GPOS_NEW(mp) CPlanCacheEntry(mp, query, plan);
+	(void) cache_accessor.Insert(entry->Key(), entry);
+
+	// the cache took its own reference
+	entry->Release();
+}
+
+// EOF
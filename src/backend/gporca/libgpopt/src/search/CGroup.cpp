@@ -38,7 +38,6 @@
 using namespace gpnaucrates;
 using namespace gpopt;
 
-#define GPOPT_OPTCTXT_HT_BUCKETS 100
 
 
 //---------------------------------------------------------------------------
@@ -164,6 +163,7 @@ CGroup::CGroup(CMemoryPool *mp, BOOL fScalar)
 	  m_pgroupDuplicate(NULL),
 	  m_plinkmap(NULL),
 	  m_pstatsmap(NULL),
+	  m_sht(mp),
 	  m_ulGExprs(0),
 	  m_pcostmap(NULL),
 	  m_ulpOptCtxts(0),
@@ -178,11 +178,6 @@ CGroup::CGroup(CMemoryPool *mp, BOOL fScalar)
 	m_listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkGroup));
 	m_listDupGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkGroup));
 
-	m_sht.Init(
-		mp, GPOPT_OPTCTXT_HT_BUCKETS, GPOS_OFFSET(COptimizationContext, m_link),
-		0, /*cKeyOffset (0 because we use COptimizationContext class as key)*/
-		&(COptimizationContext::m_ocInvalid), COptimizationContext::HashValue,
-		COptimizationContext::Equals);
 	m_plinkmap = GPOS_NEW(mp) LinkMap(mp);
 	m_pstatsmap = GPOS_NEW(mp) OptCtxtToIStatisticsMap(mp);
 	m_pcostmap = GPOS_NEW(mp) ReqdPropPlanToCostMap(mp);
@@ -252,22 +247,13 @@ CGroup::CleanupContexts()
 	{
 		CAutoSuspendAbort asa;
 
-		COptimizationContext *poc = NULL;
-		ShtIter shtit(m_sht);
-
-		while (NULL != poc || shtit.Advance())
+		ShtIter shtit(&m_sht);
+		while (shtit.Advance())
 		{
-			CRefCount::SafeRelease(poc);
-
-			// iter's accessor scope
-			{
-				ShtAccIter shtitacc(shtit);
-				if (NULL != (poc = shtitacc.Value()))
-				{
-					shtitacc.Remove(poc);
-				}
-			}
+			shtit.Value()->Release();
 		}
+
+		m_sht.Clear();
 	}
 }
 
@@ -288,11 +274,7 @@ CGroup::UpdateBestCost(COptimizationContext *poc, CCostContext *pcc)
 
 	COptimizationContext *pocFound = NULL;
 
-	{
-		// scope for accessor
-		ShtAcc shta(Sht(), *poc);
-		pocFound = shta.Find();
-	}
+	pocFound = m_sht.Find(*poc);
 
 	if (NULL == pocFound)
 	{
@@ -333,11 +315,7 @@ CGroup::PocLookup(CMemoryPool *mp, CReqdPropPlan *prpp,
 			mp),  // stats context is not used when looking up contexts
 		ulSearchStageIndex);
 
-	COptimizationContext *pocFound = NULL;
-	{
-		ShtAcc shta(Sht(), *poc);
-		pocFound = shta.Find();
-	}
+	COptimizationContext *pocFound = m_sht.Find(*poc);
 	poc->Release();
 
 	return pocFound;
@@ -392,18 +370,13 @@ CGroup::PocLookupBest(CMemoryPool *mp, ULONG ulSearchStages,
 COptimizationContext *
 CGroup::Ppoc(ULONG id) const
 {
-	COptimizationContext *poc = NULL;
-	ShtIter shtit(const_cast<CGroup *>(this)->m_sht);
+	ShtIter shtit(&m_sht);
 	while (shtit.Advance())
 	{
+		COptimizationContext *poc = shtit.Value();
+		if (poc->Id() == id)
 		{
-			ShtAccIter shtitacc(shtit);
-			poc = shtitacc.Value();
-
-			if (poc->Id() == id)
-			{
-				return poc;
-			}
+			return poc;
 		}
 	}
 	return NULL;
@@ -423,13 +396,11 @@ CGroup::Ppoc(ULONG id) const
 COptimizationContext *
 CGroup::PocInsert(COptimizationContext *poc)
 {
-	ShtAcc shta(Sht(), *poc);
-
-	COptimizationContext *pocFound = shta.Find();
+	COptimizationContext *pocFound = m_sht.Find(*poc);
 	if (NULL == pocFound)
 	{
 		poc->SetId((ULONG) UlpIncOptCtxts());
-		shta.Insert(poc);
+		m_sht.Insert(poc);
 		return poc;
 	}
 
@@ -448,8 +419,7 @@ CGroup::PocInsert(COptimizationContext *poc)
 CGroupExpression *
 CGroup::PgexprBest(COptimizationContext *poc)
 {
-	ShtAcc shta(Sht(), *poc);
-	COptimizationContext *pocFound = shta.Find();
+	COptimizationContext *pocFound = m_sht.Find(*poc);
 	if (NULL != pocFound)
 	{
 		return pocFound->PgexprBest();
@@ -16,6 +16,8 @@
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/COptimizationContext.h"
+#include "gpopt/base/COptCtxt.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/operators/CPhysicalAgg.h"
 #include "gpopt/search/CBinding.h"
 #include "gpopt/search/CGroupExpression.h"
@@ -770,15 +772,20 @@ void
 CGroupExpression::Transform(
 	CMemoryPool *mp, CMemoryPool *pmpLocal, CXform *pxform,
 	CXformResult *pxfres,
-	ULONG *pulElapsedTime,	// output: elapsed time in millisecond
+	ULONG *pulElapsedTime,	// output: elapsed time in microseconds
 	ULONG *pulNumberOfBindings)
 {
 	GPOS_ASSERT(NULL != pulElapsedTime);
 	GPOS_CHECK_ABORT;
 
-	BOOL fPrintOptStats = GPOS_FTRACE(EopttracePrintOptimizationStatistics);
+	// xforms are timed when optimization statistics are printed, or
+	// collected for the caller
+	BOOL fTimed = GPOS_FTRACE(EopttracePrintOptimizationStatistics) ||
+				  NULL != COptCtxt::PoctxtFromTLS()
+							  ->GetOptimizerConfig()
+							  ->GetOptimizationStats();
 	CTimerUser timer;
-	if (fPrintOptStats)
+	if (fTimed)
 	{
 		timer.Restart();
 	}
@@ -788,9 +795,9 @@ CGroupExpression::Transform(
 	if (GPOPT_FDISABLED_XFORM(pxform->Exfid()) ||
 		!pxform->FCompatible(m_exfidOrigin))
 	{
-		if (fPrintOptStats)
+		if (fTimed)
 		{
-			*pulElapsedTime = timer.ElapsedMS();
+			*pulElapsedTime = timer.ElapsedUS();
 		}
 		return;
 	}
@@ -801,9 +808,9 @@ CGroupExpression::Transform(
 	exprhdl.DeriveProps(NULL /*pdpctxt*/);
 	if (CXform::ExfpNone == pxform->Exfp(exprhdl))
 	{
-		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+		if (fTimed)
 		{
-			*pulElapsedTime = timer.ElapsedMS();
+			*pulElapsedTime = timer.ElapsedUS();
 		}
 		return;
 	}
@@ -847,9 +854,9 @@ CGroupExpression::Transform(
 	// post-prcoessing before applying xform to group expression
 	PostprocessTransform(pmpLocal, mp, pxform);
 
-	if (fPrintOptStats)
+	if (fTimed)
 	{
-		*pulElapsedTime = timer.ElapsedMS();
+		*pulElapsedTime = timer.ElapsedUS();
 	}
 }
 
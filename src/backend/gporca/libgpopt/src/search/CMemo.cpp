@@ -12,8 +12,6 @@
 #include "gpos/base.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/common/CAutoTimer.h"
-#include "gpos/common/CSyncHashtableAccessByIter.h"
-#include "gpos/common/CSyncHashtableAccessByKey.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
@@ -34,7 +32,8 @@
 
 using namespace gpopt;
 
-#define GPOPT_MEMO_HT_BUCKETS 50000
+// initial number of group expressions the memo hash table has room for
+#define GPOPT_MEMO_HT_INIT_SIZE 1024
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -45,17 +44,17 @@ using namespace gpopt;
 //
 //---------------------------------------------------------------------------
 CMemo::CMemo(CMemoryPool *mp)
-	: m_mp(mp), m_aul(0), m_pgroupRoot(NULL), m_ulpGrps(0), m_pmemotmap(NULL)
+	: m_mp(mp),
+	  m_aul(0),
+	  m_pgroupRoot(NULL),
+	  m_ulpGrps(0),
+	  m_pmemotmap(NULL),
+	  m_sht(mp, GPOPT_MEMO_HT_INIT_SIZE)
 {
 	GPOS_ASSERT(NULL != mp);
 
-	m_sht.Init(
-		mp, GPOPT_MEMO_HT_BUCKETS, GPOS_OFFSET(CGroupExpression, m_linkMemo),
-		0, /*cKeyOffset (0 because we use CGroupExpression class as key)*/
-		&(CGroupExpression::m_gexprInvalid), CGroupExpression::HashValue,
-		CGroupExpression::Equals);
-
 	m_listGroups.Init(GPOS_OFFSET(CGroup, m_link));
+	m_listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkMemo));
 }
 
 
@@ -167,13 +166,12 @@ CMemo::PgroupInsert(CGroup *pgroupTarget, CGroupExpression *pgexpr,
 	GPOS_ASSERT(NULL != pgroupTarget);
 	GPOS_ASSERT(NULL != pgexpr);
 
-	ShtAcc shta(m_sht, *pgexpr);
-
 	// we do a lookup since group expression may have been already inserted
-	CGroupExpression *pgexprFound = shta.Find();
+	CGroupExpression *pgexprFound = m_sht.Find(*pgexpr);
 	if (NULL == pgexprFound)
 	{
-		shta.Insert(pgexpr);
+		m_sht.Insert(pgexpr);
+		m_listGExprs.Append(pgexpr);
 
 		// group proxy scope
 		{
@@ -240,12 +238,7 @@ CMemo::PgroupInsert(CGroup *pgroupTarget, CExpression *pexprOrigin,
 	GPOS_ASSERT(pgexpr->Arity() == pexprOrigin->Arity());
 
 	CGroup *pgroupContainer = NULL;
-	CGroupExpression *pgexprFound = NULL;
-	// hash table accessor's scope
-	{
-		ShtAcc shta(m_sht, *pgexpr);
-		pgexprFound = shta.Find();
-	}
+	CGroupExpression *pgexprFound = m_sht.Find(*pgexpr);
 
 	// check if we may need to create a new group
 	BOOL fNewGroup =
@@ -476,25 +469,18 @@ CMemo::FRehash()
 	GPOS_ASSERT(m_pgroupRoot->FExplored());
 	GPOS_ASSERT(!m_pgroupRoot->FImplemented());
 
-	// dump memo hash table into a local list
+	// move the group expressions of the memo hash table into a local list;
+	// they are re-inserted in the order they were first inserted, so that
+	// the earliest of duplicate group expressions is kept, whatever the
+	// layout of the hash table
 	CList<CGroupExpression> listGExprs;
 	listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkMemo));
 
-	ShtIter shtit(m_sht);
-	CGroupExpression *pgexpr = NULL;
-	while (NULL != pgexpr || shtit.Advance())
+	while (!m_listGExprs.IsEmpty())
 	{
-		{
-			ShtAccIter shtitacc(shtit);
-			pgexpr = shtitacc.Value();
-			if (NULL != pgexpr)
-			{
-				shtitacc.Remove(pgexpr);
-				listGExprs.Append(pgexpr);
-			}
-		}
-		GPOS_CHECK_ABORT;
+		listGExprs.Append(m_listGExprs.RemoveHead());
 	}
+	m_sht.Clear();
 
 	// iterate on list and insert non-duplicate group expressions
 	// back to memo hash table
@@ -502,19 +488,13 @@ CMemo::FRehash()
 	while (!listGExprs.IsEmpty())
 	{
 		CGroupExpression *pgexpr = listGExprs.RemoveHead();
-		CGroupExpression *pgexprFound = NULL;
-
+		CGroupExpression *pgexprFound = m_sht.Find(*pgexpr);
+		if (NULL == pgexprFound)
 		{
-			// hash table accessor scope
-			ShtAcc shta(m_sht, *pgexpr);
-			pgexprFound = shta.Find();
-
-			if (NULL == pgexprFound)
-			{
-				// group expression has no duplicates, insert back to memo hash table
-				shta.Insert(pgexpr);
-				continue;
-			}
+			// group expression has no duplicates, insert back to memo hash table
+			m_sht.Insert(pgexpr);
+			m_listGExprs.Append(pgexpr);
+			continue;
 		}
 
 		GPOS_ASSERT(pgexprFound != pgexpr);
@@ -10,8 +10,18 @@
 //---------------------------------------------------------------------------
 
 #include "gpopt/search/CSearchStage.h"
+
+#include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CExpression.h"
 #include "gpopt/xforms/CXformFactory.h"
 
+// largest number of inputs of a join for which the memo estimate grows
+// exponentially; larger joins are complex anyway
+#define GPOPT_ADAPTIVE_SEARCH_MAX_JOIN_INPUTS 20
+
+// estimated number of memo groups above which a query is complex
+#define GPOPT_ADAPTIVE_SEARCH_MAX_MEMO_GROUPS 4096
+
 using namespace gpopt;
 using namespace gpos;
 
@@ -125,4 +135,200 @@ CSearchStage::PdrgpssDefault(CMemoryPool *mp)
 	return search_stage_array;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStage::CollectShape
+//
+//	@doc:
+//		Collect the joins, subqueries and partitioned tables of the given
+//		expression; every join of k inputs may explore up to 2^k groups
+//
+//---------------------------------------------------------------------------
+void
+CSearchStage::CollectShape(CExpression *pexpr, ULONG ulSubqueryDepth,
+						   SQueryShape *pqs)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+	GPOS_ASSERT(NULL != pqs);
+
+	COperator *pop = pexpr->Pop();
+	if (CUtils::FSubquery(pop))
+	{
+		ulSubqueryDepth++;
+		pqs->m_ulSubqueryDepth =
+			std::max(pqs->m_ulSubqueryDepth, ulSubqueryDepth);
+	}
+
+	if (pop->FLogical())
+	{
+		pqs->m_ullMemoGroups++;
+	}
+
+	if (COperator::EopLogicalDynamicGet == pop->Eopid())
+	{
+		pqs->m_ulPartitionedTables++;
+	}
+
+	if (CUtils::FLogicalJoin(pop) || CUtils::FApply(pop))
+	{
+		ULONG ulInputs = 0;
+		for (ULONG ul = 0; ul < pexpr->Arity(); ul++)
+		{
+			if ((*pexpr)[ul]->Pop()->FLogical())
+			{
+				ulInputs++;
+			}
+		}
+
+		if (1 < ulInputs)
+		{
+			pqs->m_ulJoins += ulInputs - 1;
+			pqs->m_ullMemoGroups +=
+				1ULL << std::min(ulInputs,
+								 (ULONG) GPOPT_ADAPTIVE_SEARCH_MAX_JOIN_INPUTS);
+		}
+	}
+
+	for (ULONG ul = 0; ul < pexpr->Arity(); ul++)
+	{
+		CollectShape((*pexpr)[ul], ulSubqueryDepth, pqs);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStage::PxfsExplorationWithout
+//
+//	@doc:
+//		Exploration xforms without the given ones
+//
+//---------------------------------------------------------------------------
+CXformSet *
+CSearchStage::PxfsExplorationWithout(CMemoryPool *mp,
+									 const CXform::EXformId *rgexfid,
+									 ULONG ulXforms)
+{
+	CXformSet *xform_set = GPOS_NEW(mp) CXformSet(mp);
+	xform_set->Union(CXformFactory::Pxff()->PxfsExploration());
+	for (ULONG ul = 0; ul < ulXforms; ul++)
+	{
+		(void) xform_set->ExchangeClear(rgexfid[ul]);
+	}
+
+	return xform_set;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStage::Eqc
+//
+//	@doc:
+//		Complexity class of the given preprocessed query; a query is simple
+//		if it has at most one join and neither subqueries nor partitioned
+//		tables, and complex if its memo may grow large or it nests
+//		subqueries or partitioned tables deeply
+//
+//---------------------------------------------------------------------------
+CSearchStage::EQueryComplexity
+CSearchStage::Eqc(CExpression *pexpr)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	SQueryShape qs;
+	CollectShape(pexpr, 0 /*ulSubqueryDepth*/, &qs);
+
+	if (GPOPT_ADAPTIVE_SEARCH_MAX_MEMO_GROUPS < qs.m_ullMemoGroups ||
+		2 < qs.m_ulSubqueryDepth || 2 < qs.m_ulPartitionedTables)
+	{
+		return EqcComplex;
+	}
+
+	if (1 >= qs.m_ulJoins && 0 == qs.m_ulSubqueryDepth &&
+		0 == qs.m_ulPartitionedTables)
+	{
+		return EqcSimple;
+	}
+
+	return EqcModerate;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStage::PdrgpssAdaptive
+//
+//	@doc:
+//		Generate a search strategy for the complexity of the given
+//		preprocessed query:
+//		- simple queries run in one stage without the xforms that reorder
+//		  two adjacent joins, which cannot apply to a single join
+//		- moderate queries first try the cheap join orders, and only run
+//		  the exhaustive ones if the best plan found costs more than
+//		  GPOPT_ADAPTIVE_SEARCH_COST_THRESHOLD
+//		- complex queries use the default strategy
+//
+//---------------------------------------------------------------------------
+CSearchStageArray *
+CSearchStage::PdrgpssAdaptive(CMemoryPool *mp, CExpression *pexpr)
+{
+	// reorderings of two adjacent joins; the n-ary join expansions stay,
+	// preprocessing turns a single inner join into an n-ary one as well
+	const CXform::EXformId rgexfidJoinOrder[] = {
+		CXform::ExfJoinAssociativity,
+		CXform::ExfSemiJoinSemiJoinSwap,
+		CXform::ExfSemiJoinAntiSemiJoinSwap,
+		CXform::ExfSemiJoinAntiSemiJoinNotInSwap,
+		CXform::ExfSemiJoinInnerJoinSwap,
+		CXform::ExfAntiSemiJoinAntiSemiJoinSwap,
+		CXform::ExfAntiSemiJoinAntiSemiJoinNotInSwap,
+		CXform::ExfAntiSemiJoinSemiJoinSwap,
+		CXform::ExfAntiSemiJoinInnerJoinSwap,
+		CXform::ExfAntiSemiJoinNotInAntiSemiJoinSwap,
+		CXform::ExfAntiSemiJoinNotInAntiSemiJoinNotInSwap,
+		CXform::ExfAntiSemiJoinNotInSemiJoinSwap,
+		CXform::ExfAntiSemiJoinNotInInnerJoinSwap,
+		CXform::ExfInnerJoinSemiJoinSwap,
+		CXform::ExfInnerJoinAntiSemiJoinSwap,
+		CXform::ExfInnerJoinAntiSemiJoinNotInSwap,
+	};
+
+	const CXform::EXformId rgexfidExhaustive[] = {
+		CXform::ExfExpandNAryJoinDP,
+		CXform::ExfExpandNAryJoinDPv2,
+		CXform::ExfJoinAssociativity,
+	};
+
+	CSearchStageArray *search_stage_array = NULL;
+	switch (Eqc(pexpr))
+	{
+		case EqcSimple:
+			search_stage_array = GPOS_NEW(mp) CSearchStageArray(mp);
+			search_stage_array->Append(GPOS_NEW(mp) CSearchStage(
+				PxfsExplorationWithout(mp, rgexfidJoinOrder,
+									   GPOS_ARRAY_SIZE(rgexfidJoinOrder))));
+			break;
+
+		case EqcModerate:
+			search_stage_array = GPOS_NEW(mp) CSearchStageArray(mp);
+			search_stage_array->Append(GPOS_NEW(mp) CSearchStage(
+				PxfsExplorationWithout(mp, rgexfidExhaustive,
+									   GPOS_ARRAY_SIZE(rgexfidExhaustive)),
+				gpos::ulong_max,
+				CCost(GPOPT_ADAPTIVE_SEARCH_COST_THRESHOLD)));
+			search_stage_array->Append(GPOS_NEW(mp) CSearchStage(
+				PxfsExplorationWithout(mp, NULL /*rgexfid*/, 0 /*ulXforms*/)));
+			break;
+
+		default:
+			search_stage_array = PdrgpssDefault(mp);
+			break;
+	}
+
+	return search_stage_array;
+}
+
 // EOF
@@ -0,0 +1,950 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CJoinOrderDPccp.cpp
+//
+//	@doc:
+//		Implementation of dynamic programming-based join order generation
+//		enumerating connected subgraph complement pairs
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "gpos/common/CBitSetIter.h"
+#include "gpos/error/CAutoTrace.h"
+
+#include "gpopt/base/CColRefSetIter.h"
+#include "gpopt/base/CConstraint.h"
+#include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CLogicalInnerJoin.h"
+#include "gpopt/operators/CPredicateUtils.h"
+#include "gpopt/xforms/CJoinOrderDPccp.h"
+#include "naucrates/statistics/CJoinStatsProcessor.h"
+#include "naucrates/statistics/CStatistics.h"
+
+using namespace gpopt;
+
+#define GPOPT_DP_JOIN_ORDERING_TOPK 10
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::CJoinOrderDPccp
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CJoinOrderDPccp::CJoinOrderDPccp(CMemoryPool *mp,
+								 CExpressionArray *pdrgpexprComponents,
+								 CExpressionArray *pdrgpexprConjuncts)
+	: CJoinOrder(mp, pdrgpexprComponents, pdrgpexprConjuncts,
+				 false /* m_include_loj_childs */),
+	  m_setAll(0),
+	  m_rgsetNeighbors(NULL),
+	  m_rgsetEdgeCover(NULL),
+	  m_rgsetBestLeft(NULL),
+	  m_rgdCost(NULL),
+	  m_rgpexpr(NULL),
+	  m_rgpstats(NULL),
+	  m_rgpdrgpcrs(NULL),
+	  m_rgpdrgpcrsEdge(NULL),
+	  m_ulEdgeCols(0),
+	  m_rgpcrEdgeCol(NULL),
+	  m_rgsetEdgeColComp(NULL),
+	  m_rgsetEdgeColUsers(NULL),
+	  m_rgfEdgeOuterRefs(NULL),
+	  m_popJoin(NULL),
+	  m_rgsetTopKLeft(NULL),
+	  m_rgdTopKCost(NULL),
+	  m_ulTopK(0),
+	  m_pdrgpexprTopKOrders(NULL)
+{
+	GPOS_ASSERT(0 < m_ulComps);
+	GPOS_ASSERT(m_ulComps <= GPOPT_DPCCP_MAX_COMPONENTS);
+
+	m_setAll = (SET(1) << m_ulComps) - 1;
+
+	m_rgsetNeighbors = GPOS_NEW_ARRAY(mp, SET, m_ulComps);
+	for (ULONG ul = 0; ul < m_ulComps; ul++)
+	{
+		m_rgsetNeighbors[ul] = 0;
+	}
+
+	// an edge connects each pair of the components it covers
+	m_rgsetEdgeCover = GPOS_NEW_ARRAY(mp, SET, m_ulEdges);
+	m_rgpdrgpcrsEdge = GPOS_NEW_ARRAY(mp, CColRefSetArray *, m_ulEdges);
+	m_rgfEdgeOuterRefs = GPOS_NEW_ARRAY(mp, BOOL, m_ulEdges);
+	CColRefSet *pcrsEdges = GPOS_NEW(mp) CColRefSet(mp);
+	for (ULONG ulEdge = 0; ulEdge < m_ulEdges; ulEdge++)
+	{
+		CExpression *pexprEdge = m_rgpedge[ulEdge]->m_pexpr;
+		pcrsEdges->Include(pexprEdge->DeriveUsedColumns());
+
+		CColRefSetArray *pdrgpcrsEdge = NULL;
+		CConstraint *pcnstr =
+			CConstraint::PcnstrFromScalarExpr(mp, pexprEdge, &pdrgpcrsEdge);
+		CRefCount::SafeRelease(pcnstr);
+		m_rgpdrgpcrsEdge[ulEdge] = pdrgpcrsEdge;
+		m_rgfEdgeOuterRefs[ulEdge] = false;
+
+		SET setCover = 0;
+		CBitSetIter bsi(*m_rgpedge[ulEdge]->m_pbs);
+		while (bsi.Advance())
+		{
+			setCover |= SET(1) << bsi.Bit();
+		}
+		m_rgsetEdgeCover[ulEdge] = setCover;
+
+		for (ULONG ul = 0; ul < m_ulComps; ul++)
+		{
+			SET setComp = SET(1) << ul;
+			if (0 != (setCover & setComp))
+			{
+				m_rgsetNeighbors[ul] |= setCover & ~setComp;
+			}
+		}
+	}
+
+	const ULONG ulSets = ULONG(m_setAll) + 1;
+	m_rgsetBestLeft = GPOS_NEW_ARRAY(mp, SET, ulSets);
+	m_rgdCost = GPOS_NEW_ARRAY(mp, DOUBLE, ulSets);
+	m_rgpexpr = GPOS_NEW_ARRAY(mp, CExpression *, ulSets);
+	m_rgpstats = GPOS_NEW_ARRAY(mp, IStatistics *, ulSets);
+	m_rgpdrgpcrs = GPOS_NEW_ARRAY(mp, CColRefSetArray *, ulSets);
+	for (ULONG ul = 0; ul < ulSets; ul++)
+	{
+		m_rgsetBestLeft[ul] = 0;
+		m_rgdCost[ul] = 0.0;
+		m_rgpexpr[ul] = NULL;
+		m_rgpstats[ul] = NULL;
+		m_rgpdrgpcrs[ul] = NULL;
+	}
+
+	// columns used by the edges, with the component producing each of them
+	// and the components covered by the edges using it; the edges using a
+	// column that no component produces reference outer columns
+	m_ulEdgeCols = pcrsEdges->Size();
+	m_rgpcrEdgeCol = GPOS_NEW_ARRAY(mp, CColRef *, m_ulEdgeCols);
+	m_rgsetEdgeColComp = GPOS_NEW_ARRAY(mp, SET, m_ulEdgeCols);
+	m_rgsetEdgeColUsers = GPOS_NEW_ARRAY(mp, SET, m_ulEdgeCols);
+	ULONG ulCol = 0;
+	CColRefSetIter crsi(*pcrsEdges);
+	while (crsi.Advance())
+	{
+		CColRef *colref = crsi.Pcr();
+		m_rgpcrEdgeCol[ulCol] = colref;
+		m_rgsetEdgeColComp[ulCol] = 0;
+		m_rgsetEdgeColUsers[ulCol] = 0;
+		for (ULONG ul = 0; ul < m_ulComps; ul++)
+		{
+			if (m_rgpcomp[ul]->m_pexpr->DeriveOutputColumns()->FMember(colref))
+			{
+				m_rgsetEdgeColComp[ulCol] |= SET(1) << ul;
+			}
+		}
+		for (ULONG ul = 0; ul < m_ulEdges; ul++)
+		{
+			if (m_rgpedge[ul]->m_pexpr->DeriveUsedColumns()->FMember(colref))
+			{
+				m_rgsetEdgeColUsers[ulCol] |= m_rgsetEdgeCover[ul];
+				m_rgfEdgeOuterRefs[ul] = m_rgfEdgeOuterRefs[ul] ||
+										 0 == m_rgsetEdgeColComp[ulCol];
+			}
+		}
+		ulCol++;
+	}
+	pcrsEdges->Release();
+
+	for (ULONG ul = 0; ul < m_ulComps; ul++)
+	{
+		CExpression *pexprComp = m_rgpcomp[ul]->m_pexpr;
+		GPOS_ASSERT(NULL != pexprComp->Pstats() &&
+					"stats were not derived on input component");
+
+		SET setComp = SET(1) << ul;
+		m_rgdCost[setComp] = DCostComponent(pexprComp);
+		m_rgpstats[setComp] = PstatsEdgeCols(pexprComp->Pstats(), setComp);
+
+		m_rgpdrgpcrs[setComp] = PdrgpcrsEdgeCols(
+			pexprComp->DerivePropertyConstraint()->PdrgpcrsEquivClasses(),
+			setComp);
+	}
+
+	m_popJoin = GPOS_NEW(mp) CLogicalInnerJoin(mp);
+
+	m_rgsetTopKLeft = GPOS_NEW_ARRAY(mp, SET, GPOPT_DP_JOIN_ORDERING_TOPK);
+	m_rgdTopKCost = GPOS_NEW_ARRAY(mp, DOUBLE, GPOPT_DP_JOIN_ORDERING_TOPK);
+	m_pdrgpexprTopKOrders = GPOS_NEW(mp) CExpressionArray(mp);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::~CJoinOrderDPccp
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CJoinOrderDPccp::~CJoinOrderDPccp()
+{
+	const ULONG ulSets = ULONG(m_setAll) + 1;
+	for (ULONG ul = 0; ul < ulSets; ul++)
+	{
+		CRefCount::SafeRelease(m_rgpexpr[ul]);
+		CRefCount::SafeRelease(m_rgpstats[ul]);
+		CRefCount::SafeRelease(m_rgpdrgpcrs[ul]);
+	}
+
+	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	{
+		CRefCount::SafeRelease(m_rgpdrgpcrsEdge[ul]);
+	}
+
+	GPOS_DELETE_ARRAY(m_rgsetNeighbors);
+	GPOS_DELETE_ARRAY(m_rgsetEdgeCover);
+	GPOS_DELETE_ARRAY(m_rgsetBestLeft);
+	GPOS_DELETE_ARRAY(m_rgdCost);
+	GPOS_DELETE_ARRAY(m_rgpexpr);
+	GPOS_DELETE_ARRAY(m_rgpstats);
+	GPOS_DELETE_ARRAY(m_rgpdrgpcrs);
+	GPOS_DELETE_ARRAY(m_rgpdrgpcrsEdge);
+	GPOS_DELETE_ARRAY(m_rgfEdgeOuterRefs);
+	GPOS_DELETE_ARRAY(m_rgpcrEdgeCol);
+	GPOS_DELETE_ARRAY(m_rgsetEdgeColComp);
+	GPOS_DELETE_ARRAY(m_rgsetEdgeColUsers);
+	GPOS_DELETE_ARRAY(m_rgsetTopKLeft);
+	GPOS_DELETE_ARRAY(m_rgdTopKCost);
+	m_pdrgpexprTopKOrders->Release();
+	m_popJoin->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::DCostComponent
+//
+//	@doc:
+//		Primitive costing of a component, as for the joins built on top of
+//		it: the cost of a leaf is its number of rows, and the cost of other
+//		operators is the cost of their relational children plus the
+//		children's rows
+//
+//---------------------------------------------------------------------------
+DOUBLE
+CJoinOrderDPccp::DCostComponent(CExpression *pexpr)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+
+	const ULONG arity = pexpr->Arity();
+	if (0 == arity)
+	{
+		DeriveStats(pexpr);
+		return pexpr->Pstats()->Rows().Get();
+	}
+
+	// the last child is the scalar one
+	DOUBLE dCost = 0.0;
+	for (ULONG ul = 0; ul < arity - 1; ul++)
+	{
+		CExpression *pexprChild = (*pexpr)[ul];
+		dCost += DCostComponent(pexprChild);
+
+		DeriveStats(pexprChild);
+		dCost += pexprChild->Pstats()->Rows().Get();
+	}
+
+	return dCost;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::FEdgeColLeaving
+//
+//	@doc:
+//		Is the given column of the edges produced by the given set and used
+//		by an edge leaving it
+//
+//---------------------------------------------------------------------------
+BOOL
+CJoinOrderDPccp::FEdgeColLeaving(ULONG ulCol, SET set) const
+{
+	return 0 != (m_rgsetEdgeColComp[ulCol] & set) &&
+		   0 != (m_rgsetEdgeColUsers[ulCol] & ~set);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PdrgpcrsEdgeCols
+//
+//	@doc:
+//		Equivalence classes of the given set for joining it with others:
+//		they only tell which conjuncts of a join predicate are implied, so
+//		they are restricted to the columns used by edges leaving the set,
+//		and the classes left with less than two columns are dropped
+//
+//---------------------------------------------------------------------------
+CColRefSetArray *
+CJoinOrderDPccp::PdrgpcrsEdgeCols(CColRefSetArray *pdrgpcrs, SET set) const
+{
+	CColRefSetArray *pdrgpcrsResult = GPOS_NEW(m_mp) CColRefSetArray(m_mp);
+	const ULONG size = pdrgpcrs->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		CColRefSet *pcrsClass = (*pdrgpcrs)[ul];
+		CColRefSet *pcrs = GPOS_NEW(m_mp) CColRefSet(m_mp);
+		for (ULONG ulCol = 0; ulCol < m_ulEdgeCols; ulCol++)
+		{
+			if (FEdgeColLeaving(ulCol, set) &&
+				pcrsClass->FMember(m_rgpcrEdgeCol[ulCol]))
+			{
+				pcrs->Include(m_rgpcrEdgeCol[ulCol]);
+			}
+		}
+
+		if (2 <= pcrs->Size())
+		{
+			pdrgpcrsResult->Append(pcrs);
+		}
+		else
+		{
+			pcrs->Release();
+		}
+	}
+
+	return pdrgpcrsResult;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PstatsEdgeCols
+//
+//	@doc:
+//		Statistics of the given set for joining it with others: the number
+//		of rows of a join only depends on the rows of its inputs and on
+//		the histograms of the columns of its predicate, so only the
+//		histograms of the set's columns used by edges leaving the set are
+//		kept, and no widths, saving their copies in every join built on
+//		top of the set
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CJoinOrderDPccp::PstatsEdgeCols(const IStatistics *stats, SET set) const
+{
+	const CStatistics *pstats = dynamic_cast<const CStatistics *>(stats);
+	GPOS_ASSERT(NULL != pstats);
+
+	UlongToHistogramMap *col_histogram_mapping =
+		GPOS_NEW(m_mp) UlongToHistogramMap(m_mp);
+	for (ULONG ul = 0; ul < m_ulEdgeCols; ul++)
+	{
+		if (!FEdgeColLeaving(ul, set))
+		{
+			continue;
+		}
+
+		ULONG colid = m_rgpcrEdgeCol[ul]->Id();
+		const CHistogram *histogram = pstats->GetHistogram(colid);
+		if (NULL != histogram)
+		{
+			col_histogram_mapping->Insert(GPOS_NEW(m_mp) ULONG(colid),
+										  histogram->CopyHistogram());
+		}
+	}
+
+	return GPOS_NEW(m_mp) CStatistics(
+		m_mp, col_histogram_mapping, GPOS_NEW(m_mp) UlongToDoubleMap(m_mp),
+		pstats->Rows(), pstats->IsEmpty(), pstats->GetNumberOfPredicates());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::UlLowest
+//
+//	@doc:
+//		Lowest component in the given set
+//
+//---------------------------------------------------------------------------
+ULONG
+CJoinOrderDPccp::UlLowest(SET set)
+{
+	GPOS_ASSERT(0 != set);
+
+	ULONG ul = 0;
+	while (0 == (set & (SET(1) << ul)))
+	{
+		ul++;
+	}
+
+	return ul;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::SetNeighbors
+//
+//	@doc:
+//		Components connected to the given set by an edge, excluding the
+//		set itself and the given excluded set
+//
+//---------------------------------------------------------------------------
+CJoinOrderDPccp::SET
+CJoinOrderDPccp::SetNeighbors(SET set, SET setExcluded) const
+{
+	SET setNeighbors = 0;
+	for (ULONG ul = 0; ul < m_ulComps; ul++)
+	{
+		if (0 != (set & (SET(1) << ul)))
+		{
+			setNeighbors |= m_rgsetNeighbors[ul];
+		}
+	}
+
+	return setNeighbors & ~set & ~setExcluded;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::EnumerateCsgRec
+//
+//	@doc:
+//		Emit the connected sets that extend the given connected set with
+//		its neighbors, then recurse on each of them with the neighbors
+//		excluded; non-empty subsets of a set are visited in increasing
+//		order with (sub - set) & set
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPccp::EnumerateCsgRec(SET set, SET setExcluded)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	SET setNeighbors = SetNeighbors(set, setExcluded);
+	if (0 == setNeighbors)
+	{
+		return;
+	}
+
+	SET setSub = 0;
+	while (0 != (setSub = (setSub - setNeighbors) & setNeighbors))
+	{
+		EmitCsg(set | setSub);
+	}
+
+	setSub = 0;
+	while (0 != (setSub = (setSub - setNeighbors) & setNeighbors))
+	{
+		EnumerateCsgRec(set | setSub, setExcluded | setNeighbors);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::EmitCsg
+//
+//	@doc:
+//		Enumerate the connected complements of the given connected set,
+//		made of components above its lowest one; each complement is
+//		grown from one neighbor, visited in descending order
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPccp::EmitCsg(SET set)
+{
+	GPOS_CHECK_ABORT;
+
+	SET setExcluded = set | ((SET(2) << UlLowest(set)) - 1);
+	SET setNeighbors = SetNeighbors(set, setExcluded);
+
+	for (ULONG ul = m_ulComps; ul > 0; ul--)
+	{
+		SET setComp = SET(1) << (ul - 1);
+		if (0 == (setNeighbors & setComp))
+		{
+			continue;
+		}
+
+		EmitCsgCmp(set, setComp);
+		EnumerateCmpRec(set, setComp,
+						setExcluded | (setNeighbors & ((setComp << 1) - 1)));
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::EnumerateCmpRec
+//
+//	@doc:
+//		Emit the complements of the first set that extend the second one
+//		with its neighbors, then recurse on each of them with the
+//		neighbors excluded
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPccp::EnumerateCmpRec(SET setFst, SET setSnd, SET setExcluded)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	SET setNeighbors = SetNeighbors(setSnd, setExcluded);
+	if (0 == setNeighbors)
+	{
+		return;
+	}
+
+	SET setSub = 0;
+	while (0 != (setSub = (setSub - setNeighbors) & setNeighbors))
+	{
+		EmitCsgCmp(setFst, setSnd | setSub);
+	}
+
+	setSub = 0;
+	while (0 != (setSub = (setSub - setNeighbors) & setNeighbors))
+	{
+		EnumerateCmpRec(setFst, setSnd | setSub, setExcluded | setNeighbors);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::EmitCsgCmp
+//
+//	@doc:
+//		Cost the join of the given sets, and keep it if it is the best
+//		plan of their union; the plans of both sets are final
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPccp::EmitCsgCmp(SET setFst, SET setSnd)
+{
+	GPOS_ASSERT(0 == (setFst & setSnd));
+
+	DOUBLE dRowsFst = PstatsBest(setFst)->Rows().Get();
+	DOUBLE dRowsSnd = PstatsBest(setSnd)->Rows().Get();
+	DOUBLE dCost =
+		m_rgdCost[setFst] + m_rgdCost[setSnd] + dRowsFst + dRowsSnd;
+
+	SET set = setFst | setSnd;
+	if (0 == m_rgsetBestLeft[set] || dCost < m_rgdCost[set])
+	{
+		m_rgsetBestLeft[set] = setFst;
+		m_rgdCost[set] = dCost;
+
+		// an expression or statistics created for a previous best plan
+		// are stale
+		CRefCount::SafeRelease(m_rgpexpr[set]);
+		m_rgpexpr[set] = NULL;
+		CRefCount::SafeRelease(m_rgpstats[set]);
+		m_rgpstats[set] = NULL;
+		CRefCount::SafeRelease(m_rgpdrgpcrs[set]);
+		m_rgpdrgpcrs[set] = NULL;
+	}
+
+	if (m_setAll == set)
+	{
+		AddJoinOrder(setFst, dCost);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::AddJoinOrder
+//
+//	@doc:
+//		Add given join of all components to top k join orders
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPccp::AddJoinOrder(SET setLeft, DOUBLE dCost)
+{
+	if (m_ulTopK < GPOPT_DP_JOIN_ORDERING_TOPK)
+	{
+		m_rgsetTopKLeft[m_ulTopK] = setLeft;
+		m_rgdTopKCost[m_ulTopK] = dCost;
+		m_ulTopK++;
+
+		return;
+	}
+
+	// we have stored K join orders, evict the worst one
+	ULONG ulWorst = 0;
+	for (ULONG ul = 1; ul < m_ulTopK; ul++)
+	{
+		if (m_rgdTopKCost[ulWorst] < m_rgdTopKCost[ul])
+		{
+			ulWorst = ul;
+		}
+	}
+
+	if (dCost < m_rgdTopKCost[ulWorst])
+	{
+		m_rgsetTopKLeft[ulWorst] = setLeft;
+		m_rgdTopKCost[ulWorst] = dCost;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PexprBest
+//
+//	@doc:
+//		Expression of the best plan of the given set, created when first
+//		asked for
+//
+//---------------------------------------------------------------------------
+CExpression *
+CJoinOrderDPccp::PexprBest(SET set)
+{
+	GPOS_ASSERT(0 != set);
+
+	if (0 == (set & (set - 1)))
+	{
+		return m_rgpcomp[UlLowest(set)]->m_pexpr;
+	}
+
+	if (NULL == m_rgpexpr[set])
+	{
+		SET setLeft = m_rgsetBestLeft[set];
+		GPOS_ASSERT(0 != setLeft && "set has no plan");
+
+		m_rgpexpr[set] = PexprJoin(setLeft, set & ~setLeft);
+	}
+
+	return m_rgpexpr[set];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PstatsBest
+//
+//	@doc:
+//		Statistics of the best plan of the given set, derived when first
+//		asked for. As in the stats derivation of the join expression, the
+//		conjuncts implied by the equivalence classes of the inputs are
+//		removed from the join predicate, and the ones referencing outer
+//		columns are left out
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CJoinOrderDPccp::PstatsBest(SET set)
+{
+	GPOS_ASSERT(0 != set);
+
+	if (NULL != m_rgpstats[set])
+	{
+		return m_rgpstats[set];
+	}
+
+	SET setLeft = m_rgsetBestLeft[set];
+	SET setRight = set & ~setLeft;
+	GPOS_ASSERT(0 != setLeft && "set has no plan");
+
+	IStatisticsArray *pdrgpstat = GPOS_NEW(m_mp) IStatisticsArray(m_mp);
+	IStatistics *pstatsLeft = PstatsBest(setLeft);
+	IStatistics *pstatsRight = PstatsBest(setRight);
+	pstatsLeft->AddRef();
+	pdrgpstat->Append(pstatsLeft);
+	pstatsRight->AddRef();
+	pdrgpstat->Append(pstatsRight);
+
+	// equivalence classes of the inputs, extended with the conjuncts of the
+	// join predicate that they do not imply
+	CColRefSetArray *pdrgpcrs = CUtils::PdrgpcrsMergeEquivClasses(
+		m_mp, m_rgpdrgpcrs[setLeft], m_rgpdrgpcrs[setRight]);
+	CExpressionArray *pdrgpexpr = GPOS_NEW(m_mp) CExpressionArray(m_mp);
+	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	{
+		SET setCover = m_rgsetEdgeCover[ul];
+		if (0 != (setCover & ~set) || 0 == (setCover & setLeft) ||
+			0 == (setCover & setRight))
+		{
+			continue;
+		}
+
+		CExpression *pexprEdge = m_rgpedge[ul]->m_pexpr;
+		if (CPredicateUtils::FCheckPredicateImplication(pexprEdge) &&
+			CPredicateUtils::FImpliedPredicate(pexprEdge, pdrgpcrs))
+		{
+			continue;
+		}
+
+		if (NULL != m_rgpdrgpcrsEdge[ul])
+		{
+			CColRefSetArray *pdrgpcrsMerged = CUtils::PdrgpcrsMergeEquivClasses(
+				m_mp, pdrgpcrs, m_rgpdrgpcrsEdge[ul]);
+			pdrgpcrs->Release();
+			pdrgpcrs = pdrgpcrsMerged;
+		}
+
+		if (!m_rgfEdgeOuterRefs[ul])
+		{
+			pexprEdge->AddRef();
+			pdrgpexpr->Append(pexprEdge);
+		}
+	}
+	CExpression *pexprPred = CPredicateUtils::PexprConjunction(m_mp, pdrgpexpr);
+
+	IStatistics *stats = CJoinStatsProcessor::CalcAllJoinStats(
+		m_mp, pdrgpstat, pexprPred, m_popJoin);
+	m_rgpstats[set] = PstatsEdgeCols(stats, set);
+	m_rgpdrgpcrs[set] = PdrgpcrsEdgeCols(pdrgpcrs, set);
+
+	stats->Release();
+	pdrgpcrs->Release();
+	pexprPred->Release();
+	pdrgpstat->Release();
+
+	return m_rgpstats[set];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PexprPred
+//
+//	@doc:
+//		Predicate joining the two given sets, made of the edges covered by
+//		their union and by neither of them; edges covering fewer than two
+//		components go to the join of all components
+//
+//---------------------------------------------------------------------------
+CExpression *
+CJoinOrderDPccp::PexprPred(SET setFst, SET setSnd) const
+{
+	SET set = setFst | setSnd;
+
+	CExpressionArray *pdrgpexpr = GPOS_NEW(m_mp) CExpressionArray(m_mp);
+	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	{
+		SET setCover = m_rgsetEdgeCover[ul];
+		BOOL fJoining = 0 == (setCover & ~set) && 0 != (setCover & setFst) &&
+						0 != (setCover & setSnd);
+		BOOL fTopLevel = m_setAll == set && 0 == (setCover & (setCover - 1));
+
+		if (fJoining || fTopLevel)
+		{
+			CExpression *pexprEdge = m_rgpedge[ul]->m_pexpr;
+			pexprEdge->AddRef();
+			pdrgpexpr->Append(pexprEdge);
+		}
+	}
+
+	return CPredicateUtils::PexprConjunction(m_mp, pdrgpexpr);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PexprJoin
+//
+//	@doc:
+//		Join the best plans of the two given sets
+//
+//---------------------------------------------------------------------------
+CExpression *
+CJoinOrderDPccp::PexprJoin(SET setFst, SET setSnd)
+{
+	CExpression *pexprFst = PexprBest(setFst);
+	CExpression *pexprSnd = PexprBest(setSnd);
+	pexprFst->AddRef();
+	pexprSnd->AddRef();
+
+	return CUtils::PexprLogicalJoin<CLogicalInnerJoin>(
+		m_mp, pexprFst, pexprSnd, PexprPred(setFst, setSnd));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PexprCross
+//
+//	@doc:
+//		Cross product of the best plans of the connected parts of all
+//		components, for join graphs that are not connected
+//
+//---------------------------------------------------------------------------
+CExpression *
+CJoinOrderDPccp::PexprCross()
+{
+	CExpression *pexprResult = NULL;
+	SET setDone = 0;
+	SET setRemaining = m_setAll;
+	while (0 != setRemaining)
+	{
+		// grow the connected part of the lowest remaining component
+		SET setPart = SET(1) << UlLowest(setRemaining);
+		SET setNeighbors = SetNeighbors(setPart, 0 /*setExcluded*/);
+		while (0 != setNeighbors)
+		{
+			setPart |= setNeighbors;
+			setNeighbors = SetNeighbors(setPart, 0 /*setExcluded*/);
+		}
+
+		CExpression *pexprPart = PexprBest(setPart);
+		pexprPart->AddRef();
+		if (NULL == pexprResult)
+		{
+			pexprResult = pexprPart;
+		}
+		else
+		{
+			pexprResult = CUtils::PexprLogicalJoin<CLogicalInnerJoin>(
+				m_mp, pexprResult, pexprPart, PexprPred(setDone, setPart));
+		}
+
+		setDone |= setPart;
+		setRemaining &= ~setPart;
+	}
+
+	return pexprResult;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::DeriveStats
+//
+//	@doc:
+//		Derive stats on given expression
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPccp::DeriveStats(CExpression *pexpr)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	if (NULL == pexpr->Pstats())
+	{
+		CExpressionHandle exprhdl(m_mp);
+		exprhdl.Attach(pexpr);
+		exprhdl.DeriveStats(m_mp, m_mp, NULL /*prprel*/, NULL /*stats_ctxt*/);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::PexprExpand
+//
+//	@doc:
+//		Create join order; connected sets are enumerated from the highest
+//		component down, each extended with neighbors above its lowest one
+//
+//---------------------------------------------------------------------------
+CExpression *
+CJoinOrderDPccp::PexprExpand()
+{
+	for (ULONG ul = m_ulComps; ul > 0; ul--)
+	{
+		SET setComp = SET(1) << (ul - 1);
+		EmitCsg(setComp);
+		EnumerateCsgRec(setComp, (setComp << 1) - 1);
+	}
+
+	if (0 == m_rgsetBestLeft[m_setAll])
+	{
+		// join graph is not connected
+		return PexprCross();
+	}
+
+	CExpression *pexprResult = PexprBest(m_setAll);
+	pexprResult->AddRef();
+
+	for (ULONG ul = 0; ul < m_ulTopK; ul++)
+	{
+		SET setLeft = m_rgsetTopKLeft[ul];
+		if (setLeft == m_rgsetBestLeft[m_setAll])
+		{
+			pexprResult->AddRef();
+			m_pdrgpexprTopKOrders->Append(pexprResult);
+		}
+		else
+		{
+			m_pdrgpexprTopKOrders->Append(
+				PexprJoin(setLeft, m_setAll & ~setLeft));
+		}
+	}
+
+	return pexprResult;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPccp::OsPrint
+//
+//	@doc:
+//		Print created join order
+//
+//---------------------------------------------------------------------------
+IOstream &
+CJoinOrderDPccp::OsPrint(IOstream &os) const
+{
+	// increase GPOS_LOG_MESSAGE_BUFFER_SIZE in file ILogger.h if the output of this method gets truncated
+	CPrintPrefix pref(NULL, "      ");
+
+	const ULONG ulSets = ULONG(m_setAll) + 1;
+	for (ULONG ulSet = 1; ulSet < ulSets; ulSet++)
+	{
+		if (0 == m_rgsetBestLeft[ulSet])
+		{
+			continue;
+		}
+
+		os << "Set: {";
+		BOOL fFirst = true;
+		for (ULONG ul = 0; ul < m_ulComps; ul++)
+		{
+			if (0 != (ulSet & (ULONG(1) << ul)))
+			{
+				os << (fFirst ? "" : ", ") << ul;
+				fFirst = false;
+			}
+		}
+		os << "}" << std::endl;
+		os << "Cost: " << m_rgdCost[ulSet] << std::endl;
+
+		if (NULL != m_rgpexpr[ulSet])
+		{
+			os << "Best expression: " << std::endl;
+			m_rgpexpr[ulSet]->OsPrintExpression(os, &pref);
+		}
+	}
+
+	for (ULONG k = 0; k < m_pdrgpexprTopKOrders->Size(); k++)
+	{
+		os << "Best top-level expression [" << k << "]: " << std::endl;
+		os << "Cost: " << m_rgdTopKCost[k] << std::endl;
+		(*m_pdrgpexprTopKOrders)[k]->OsPrintExpression(os, &pref);
+	}
+	os << std::endl;
+
+	return os;
+}
+
+
+#ifdef GPOS_DEBUG
+void
+CJoinOrderDPccp::DbgPrint()
+{
+	CAutoTrace at(m_mp);
+
+	OsPrint(at.Os());
+}
+#endif
+
+// EOF
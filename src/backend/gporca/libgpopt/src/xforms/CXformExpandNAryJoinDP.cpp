@@ -21,7 +21,7 @@
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/xforms/CXformExpandNAryJoinDP.h"
 #include "gpopt/xforms/CXformUtils.h"
-#include "gpopt/xforms/CJoinOrderDP.h"
+#include "gpopt/xforms/CJoinOrderDPccp.h"
 
 
 
@@ -68,7 +68,8 @@ CXformExpandNAryJoinDP::Exfp(CExpressionHandle &exprhdl) const
 	// defining the join predicate, ignore it.
 	const ULONG ulRelChild = arity - 1;
 
-	if (ulRelChild > phint->UlJoinOrderDPLimit())
+	if (ulRelChild > phint->UlJoinOrderDPLimit() ||
+		ulRelChild > GPOPT_DPCCP_MAX_COMPONENTS)
 	{
 		return CXform::ExfpNone;
 	}
@@ -113,7 +114,7 @@ CXformExpandNAryJoinDP::Transform(CXformContext *pxfctxt, CXformResult *pxfres,
 		CPredicateUtils::PdrgpexprConjuncts(mp, pexprScalar);
 
 	// create join order using dynamic programming
-	CJoinOrderDP jodp(mp, pdrgpexpr, pdrgpexprPreds);
+	CJoinOrderDPccp jodp(mp, pdrgpexpr, pdrgpexprPreds);
 	CExpression *pexprResult = jodp.PexprExpand();
 
 	if (NULL != pexprResult)
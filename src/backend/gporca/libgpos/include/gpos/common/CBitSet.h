@@ -6,16 +6,19 @@
 //		CBitSet.h
 //
 //	@doc:
-//		Implementation of bitset as linked list of bitvectors
+//		Implementation of bitset as a contiguous array of words
 //---------------------------------------------------------------------------
 #ifndef GPOS_CBitSet_H
 #define GPOS_CBitSet_H
 
 #include "gpos/base.h"
 #include "gpos/common/CDynamicPtrArray.h"
-#include "gpos/common/CBitVector.h"
-#include "gpos/common/CList.h"
 
+// number of bits per word of a set
+#define GPOS_BITSET_WORD_BITS (64)
+
+// number of words stored inline in the set, before allocating any
+#define GPOS_BITSET_INLINE_WORDS (4)
 
 namespace gpos
 {
@@ -24,7 +27,11 @@ namespace gpos
 //		CBitSet
 //
 //	@doc:
-//		Linked list of CBitSetLink's
+//		Set of non-negative integers, kept as a window of 64-bit words over
+//		the bit positions; all words outside the window are zero. The first
+//		few words are stored inside the object, larger windows are allocated
+//		from the memory pool and grow by doubling. The window starts at the
+//		lowest word needed, so that sets of only large elements stay small.
 //
 //---------------------------------------------------------------------------
 class CBitSet : public CRefCount
@@ -33,77 +40,55 @@ class CBitSet : public CRefCount
 	friend class CBitSetIter;
 
 protected:
-	//---------------------------------------------------------------------------
-	//	@class:
-	//		CBitSetLink
-	//
-	//	@doc:
-	//		bit vector + offset + link
-	//
-	//---------------------------------------------------------------------------
-	class CBitSetLink
-	{
-	private:
-		// offset
-		ULONG m_offset;
+	// pool to allocate words from
+	CMemoryPool *m_mp;
 
-		// bitvector
-		CBitVector *m_vec;
+	// size of the blocks of bits that hash values are computed from;
+	// kept so that hash values do not depend on the representation
+	ULONG m_vector_size;
 
-	public:
-		CBitSetLink(const CBitSetLink &) = delete;
+	// number of elements
+	ULONG m_size;
 
-		// ctor
-		explicit CBitSetLink(CMemoryPool *, ULONG offset, ULONG vector_size);
+	// index of the first word in the window
+	ULONG m_first_word;
 
-		explicit CBitSetLink(CMemoryPool *, const CBitSetLink &);
+	// number of words in the window
+	ULONG m_num_words;
 
-		// dtor
-		~CBitSetLink();
+	// words of the window, either the inline words or an allocated array
+	ULLONG *m_words;
 
-		// accessor
-		ULONG
-		GetOffset() const
-		{
-			return m_offset;
-		}
+	// inline words
+	ULLONG m_inline_words[GPOS_BITSET_INLINE_WORDS];
+
+	// private copy ctor
+	CBitSet(const CBitSet &);
 
-		// accessor
-		CBitVector *
-		GetVec() const
+	// word at the given index, zero if outside the window
+	ULLONG
+	Word(ULONG idx) const
+	{
+		if (idx < m_first_word || idx - m_first_word >= m_num_words)
 		{
-			return m_vec;
+			return 0;
 		}
 
-		// list link
-		SLink m_link;
-
-	};	// class CBitSetLink
+		return m_words[idx - m_first_word];
+	}
 
-	// list of bit set links
-	CList<CBitSetLink> m_bsllist;
+	// extend the window to cover the given range of words
+	void EnsureWords(ULONG first_word, ULONG end_word);
 
-	// pool to allocate links from
-	CMemoryPool *m_mp;
+	// find first set bit at or after the given position
+	BOOL FindNextSetBit(ULONG start_pos, ULONG &next_pos) const;
 
-	// size of individual bitvectors
-	ULONG m_vector_size;
-
-	// number of elements
-	ULONG m_size;
-
-	// private copy ctor
-	CBitSet(const CBitSet &);
-
-	// find link with offset less or equal to given value
-	CBitSetLink *FindLinkByOffset(ULONG, CBitSetLink * = NULL) const;
+	// hash value of the block of bits starting at the given position
+	ULONG HashBlock(ULONG start_pos) const;
 
 	// reset set
 	void Clear();
 
-	// compute target offset
-	ULONG ComputeOffset(ULONG) const;
-
 	// re-compute size of set
 	void RecomputeSize();
 
@@ -116,7 +101,12 @@ public:
 	~CBitSet() override;
 
 	// determine if bit is set
-	BOOL Get(ULONG pos) const;
+	BOOL
+	Get(ULONG pos) const
+	{
+		return 0 != (Word(pos / GPOS_BITSET_WORD_BITS) &
+					 ((ULLONG) 1 << (pos % GPOS_BITSET_WORD_BITS)));
+	}
 
 	// set given bit; return previous value
 	BOOL ExchangeSet(ULONG pos);
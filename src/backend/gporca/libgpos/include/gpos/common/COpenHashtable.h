@@ -0,0 +1,272 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		COpenHashtable.h
+//
+//	@doc:
+//		Open addressing hash table
+//		* stores pointers to objects that are their own keys
+//		* hashing and equality use template function arguments
+//		* does not own the objects, and does not allow removing single ones
+//---------------------------------------------------------------------------
+#ifndef GPOS_COpenHashtable_H
+#define GPOS_COpenHashtable_H
+
+#include "gpos/base.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/common/CStackObject.h"
+
+// initial number of slots
+#define GPOS_OPEN_HT_MIN_SLOTS (8)
+
+namespace gpos
+{
+// fwd declaration
+template <class T, ULONG (*HashFn)(const T &),
+		  BOOL (*EqFn)(const T &, const T &)>
+class COpenHashtableIter;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		COpenHashtable
+//
+//	@doc:
+//		Hash table with linear probing over an array of slots, each holding
+//		an object along with its hash value. Probes compare the stored hash
+//		values before calling the equality function, so that lookups mostly
+//		touch the slot array only. The table doubles its size when it gets
+//		half full; as there are no removals of single objects, it needs no
+//		tombstones.
+//
+//		Lookups do not modify the table. The table takes no locks, callers
+//		inserting concurrently must synchronize themselves.
+//
+//---------------------------------------------------------------------------
+template <class T, ULONG (*HashFn)(const T &),
+		  BOOL (*EqFn)(const T &, const T &)>
+class COpenHashtable
+{
+	// fwd declaration
+	friend class COpenHashtableIter<T, HashFn, EqFn>;
+
+private:
+	// slot of the table; empty slots have no object
+	struct SSlot
+	{
+		// hash value of the object
+		ULONG m_hash;
+
+		// object
+		T *m_value;
+	};
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// slots, a power of two of them
+	SSlot *m_slots;
+
+	// number of slots
+	ULONG m_num_slots;
+
+	// number of objects
+	ULONG m_size;
+
+	// first slot to probe for the given hash value; the hash value is
+	// scrambled since slots are picked by its low bits only
+	ULONG
+	UlFirstSlot(ULONG hash) const
+	{
+		return (ULONG)((hash * 0x9E3779B1u) & (m_num_slots - 1));
+	}
+
+	// allocate the given number of empty slots
+	SSlot *
+	PslotNew(ULONG num_slots) const
+	{
+		SSlot *slots = GPOS_NEW_ARRAY(m_mp, SSlot, num_slots);
+		clib::Memset(slots, 0, num_slots * GPOS_SIZEOF(SSlot));
+
+		return slots;
+	}
+
+	// place object with given hash value in the first empty slot of its
+	// probe sequence
+	void
+	Place(T *value, ULONG hash)
+	{
+		ULONG ul = UlFirstSlot(hash);
+		while (NULL != m_slots[ul].m_value)
+		{
+			ul = (ul + 1) & (m_num_slots - 1);
+		}
+
+		m_slots[ul].m_hash = hash;
+		m_slots[ul].m_value = value;
+	}
+
+	// double the number of slots, reusing the stored hash values
+	void
+	Grow()
+	{
+		SSlot *slots = m_slots;
+		ULONG num_slots = m_num_slots;
+
+		m_slots = PslotNew(2 * num_slots);
+		m_num_slots = 2 * num_slots;
+
+		for (ULONG ul = 0; ul < num_slots; ul++)
+		{
+			if (NULL != slots[ul].m_value)
+			{
+				Place(slots[ul].m_value, slots[ul].m_hash);
+			}
+		}
+
+		GPOS_DELETE_ARRAY(slots);
+	}
+
+public:
+	COpenHashtable(const COpenHashtable &) = delete;
+
+	// ctor; the table starts with room for the given number of objects
+	COpenHashtable(CMemoryPool *mp, ULONG size = GPOS_OPEN_HT_MIN_SLOTS / 2)
+		: m_mp(mp),
+		  m_slots(NULL),
+		  m_num_slots(GPOS_OPEN_HT_MIN_SLOTS),
+		  m_size(0)
+	{
+		GPOS_ASSERT(NULL != mp);
+
+		while (m_num_slots < 2 * size)
+		{
+			m_num_slots *= 2;
+		}
+
+		m_slots = PslotNew(m_num_slots);
+	}
+
+	// dtor; does not destroy the objects
+	~COpenHashtable()
+	{
+		GPOS_DELETE_ARRAY(m_slots);
+	}
+
+	// find the object equal to the given one
+	T *
+	Find(const T &key) const
+	{
+		const ULONG hash = HashFn(key);
+
+		for (ULONG ul = UlFirstSlot(hash); NULL != m_slots[ul].m_value;
+			 ul = (ul + 1) & (m_num_slots - 1))
+		{
+			if (hash == m_slots[ul].m_hash && EqFn(*m_slots[ul].m_value, key))
+			{
+				return m_slots[ul].m_value;
+			}
+		}
+
+		return NULL;
+	}
+
+	// insert an object; the table must not contain an equal one
+	void
+	Insert(T *value)
+	{
+		GPOS_ASSERT(NULL != value);
+		GPOS_ASSERT(NULL == Find(*value));
+
+		if (2 * (m_size + 1) > m_num_slots)
+		{
+			Grow();
+		}
+
+		Place(value, HashFn(*value));
+		m_size++;
+	}
+
+	// remove all objects, keeping the slots
+	void
+	Clear()
+	{
+		clib::Memset(m_slots, 0, m_num_slots * GPOS_SIZEOF(SSlot));
+		m_size = 0;
+	}
+
+	// number of objects
+	ULONG
+	Size() const
+	{
+		return m_size;
+	}
+
+};	// class COpenHashtable
+
+
+//---------------------------------------------------------------------------
+//	@class:
+//		COpenHashtableIter
+//
+//	@doc:
+//		Iterator over the objects of an open addressing hash table, in slot
+//		order; the table must not be modified while iterating
+//
+//---------------------------------------------------------------------------
+template <class T, ULONG (*HashFn)(const T &),
+		  BOOL (*EqFn)(const T &, const T &)>
+class COpenHashtableIter : public CStackObject
+{
+	// short hand for hash table type
+	typedef COpenHashtable<T, HashFn, EqFn> TTable;
+
+private:
+	// table to iterate
+	const TTable *m_table;
+
+	// slot after the current one
+	ULONG m_next_slot;
+
+public:
+	COpenHashtableIter(const COpenHashtableIter &) = delete;
+
+	// ctor
+	explicit COpenHashtableIter(const TTable *table)
+		: m_table(table), m_next_slot(0)
+	{
+		GPOS_ASSERT(NULL != table);
+	}
+
+	// advance iterator to the next object
+	BOOL
+	Advance()
+	{
+		while (m_next_slot < m_table->m_num_slots)
+		{
+			if (NULL != m_table->m_slots[m_next_slot++].m_value)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// current object
+	T *
+	Value() const
+	{
+		GPOS_ASSERT(0 < m_next_slot);
+
+		return m_table->m_slots[m_next_slot - 1].m_value;
+	}
+
+};	// class COpenHashtableIter
+
+}  // namespace gpos
+
+#endif	// !GPOS_COpenHashtable_H
+
+// EOF
@@ -80,6 +80,9 @@ public:
 	typedef ULONG (*HashFuncPtr)(const K &);
 	typedef BOOL (*EqualFuncPtr)(const K &, const K &);
 
+	// type definition of predicate selecting the entries to invalidate
+	typedef BOOL (*InvalidateFuncPtr)(const K &, T, void *);
+
 private:
 	typedef CCacheEntry<T, K> CCacheHashTableEntry;
 
@@ -112,6 +115,15 @@ private:
 	// number of times cache entries were evicted
 	ULLONG m_eviction_counter;
 
+	// number of lookups that found a cached object
+	ULLONG m_hit_counter;
+
+	// number of lookups that did not find a cached object
+	ULLONG m_miss_counter;
+
+	// number of cache entries dropped by invalidation
+	ULLONG m_invalidation_counter;
+
 	// if the gclock hand was already advanced and therefore can serve the next entry
 	BOOL m_clock_hand_advanced;
 
@@ -220,11 +232,16 @@ private:
 
 		if (NULL != entry)
 		{
+			++m_hit_counter;
 			entry->SetGClockCounter(m_gclock_init_counter);
 			// increase ref count, since CCacheHashtableAccessor points to the obj
 			// ref count will be decreased when CCacheHashtableAccessor will be destroyed
 			entry->IncRefCount();
 		}
+		else
+		{
+			++m_miss_counter;
+		}
 
 		return entry;
 	}
@@ -255,6 +272,7 @@ private:
 				// remove entry from hash table
 				acc.Remove(entry);
 				deleted = true;
+				m_cache_size -= entry->Pmp()->TotalAllocatedSize();
 			}
 		}
 
@@ -438,6 +456,9 @@ public:
 		  m_gclock_init_counter(g_clock_init_counter),
 		  m_eviction_factor((float) 0.1),
 		  m_eviction_counter(0),
+		  m_hit_counter(0),
+		  m_miss_counter(0),
+		  m_invalidation_counter(0),
 		  m_clock_hand_advanced(false),
 		  m_hash_func(hash_func),
 		  m_equal_func(equal_func)
@@ -498,6 +519,84 @@ public:
 		return m_eviction_counter;
 	}
 
+	// return number of lookups that found a cached object
+	ULLONG
+	GetHitCounter()
+	{
+		return m_hit_counter;
+	}
+
+	// return number of lookups that did not find a cached object
+	ULLONG
+	GetMissCounter()
+	{
+		return m_miss_counter;
+	}
+
+	// return number of cache entries dropped by invalidation
+	ULLONG
+	GetInvalidationCounter()
+	{
+		return m_invalidation_counter;
+	}
+
+	// Drop all entries for which the given predicate holds, and return their
+	// number. Entries that are not referenced are destroyed right away; the
+	// others are marked for deletion, which hides them from lookups, and are
+	// destroyed once their last reference is released
+	ULONG
+	InvalidateEntries(InvalidateFuncPtr invalidate_func, void *arg)
+	{
+		GPOS_ASSERT(NULL != invalidate_func);
+
+		ULONG num_invalidated = 0;
+		CCacheHashtableIter iter(m_hash_table);
+		BOOL iter_advanced = false;
+
+		while (iter_advanced || iter.Advance())
+		{
+			iter_advanced = false;
+			CCacheHashTableEntry *entry = NULL;
+			BOOL deleted = false;
+			// Scope for CCacheHashtableIterAccessor
+			{
+				CCacheHashtableIterAccessor acc(iter);
+
+				if (NULL != (entry = acc.Value()) &&
+					!entry->IsMarkedForDeletion() &&
+					invalidate_func(entry->Key(), entry->Val(), arg))
+				{
+					num_invalidated++;
+
+					// as in EvictEntriesOnePass, the iterator accessor does
+					// not hold a reference to the entry
+					if (EXPECTED_REF_COUNT_FOR_DELETE == entry->RefCount())
+					{
+						// remove advances iterator automatically
+						acc.Remove(entry);
+						deleted = true;
+						iter_advanced = true;
+						m_cache_size -= entry->Pmp()->TotalAllocatedSize();
+					}
+					else
+					{
+						entry->MarkForDeletion();
+					}
+				}
+			}
+
+			if (deleted)
+			{
+				GPOS_ASSERT(NULL != entry);
+				DestroyCacheEntry(entry);
+			}
+		}
+
+		m_invalidation_counter += num_invalidated;
+
+		return num_invalidated;
+	}
+
 	// sets the cache quota
 	void
 	SetCacheQuota(ULLONG new_quota)
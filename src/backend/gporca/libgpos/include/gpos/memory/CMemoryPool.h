@@ -20,6 +20,10 @@
 //			To calculate this, we calculate the length by calling UserSizeOfAlloc(). This
 //			is only done for allocations of type EatArray and thus we do not store the
 //			allocation length for non-array allocations.
+//		3. Allocations of CMemoryPoolArena are recognized by the lowest bit of
+//			the word right in front of them, which is set. All other memory
+//			pools must make sure that this bit is clear in their allocations,
+//			e.g., by ending their headers with a pointer.
 //
 //---------------------------------------------------------------------------
 #ifndef GPOS_CMemoryPool_H
@@ -152,6 +156,14 @@ public:
 		return 0;
 	}
 
+	// return the largest total allocated size so far
+	virtual ULLONG
+	PeakAllocatedSize() const
+	{
+		GPOS_ASSERT(!"not supported");
+		return 0;
+	}
+
 	// requested size of allocation
 	static ULONG UserSizeOfAlloc(const void *ptr);
 
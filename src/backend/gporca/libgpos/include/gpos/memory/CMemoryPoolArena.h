@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMemoryPoolArena.h
+//
+//	@doc:
+//		Memory pool that carves allocations out of large chunks obtained
+//		from an upstream memory pool
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolArena_H
+#define GPOS_CMemoryPoolArena_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/memory/CMemoryPool.h"
+
+// size of the first chunk requested from the upstream pool; each further
+// chunk doubles in size up to the maximum
+#define GPOS_MEM_ARENA_INIT_CHUNK_SIZE (8 * 1024)
+#define GPOS_MEM_ARENA_MAX_CHUNK_SIZE (1024 * 1024)
+
+// largest allocation served from a chunk; larger ones are passed on to the
+// upstream pool individually
+#define GPOS_MEM_ARENA_MAX_CLASS_SIZE (1024)
+
+// number of size classes, one for every multiple of the alignment
+#define GPOS_MEM_ARENA_NUM_CLASSES (GPOS_MEM_ARENA_MAX_CLASS_SIZE / GPOS_MEM_ARCH)
+
+namespace gpos
+{
+//---------------------------------------------------------------------------
+//	@class:
+//		CMemoryPoolArena
+//
+//	@doc:
+//		Region memory pool for short-lived pools, such as the one of a
+//		single optimization. Allocations are bumped off chunks of growing
+//		size that are requested from an upstream pool, so that most of them
+//		never reach the underlying allocator. Freed allocations are kept on
+//		per-size-class free lists and handed out again; nothing is returned
+//		to the upstream pool before the arena is torn down, which releases
+//		all chunks at once along with the upstream pool.
+//
+//		Every allocation is preceded by a header whose last word has its
+//		lowest bit set, which is how CMemoryPool tells arena allocations
+//		from those of other pools; all other pools must precede their
+//		allocations with a word whose lowest bit is clear.
+//
+//		Debug builds count the live allocations, so that leaks are reported
+//		like in the other pools, if without the stack traces.
+//
+//---------------------------------------------------------------------------
+class CMemoryPoolArena : public CMemoryPool
+{
+private:
+	// header of every allocation
+	struct SAllocHeader
+	{
+		// owning pool
+		CMemoryPoolArena *m_mp;
+
+		// user requested size shifted left by one, with the lowest bit set
+		ULONG_PTR m_tagged_size;
+	};
+
+	// pool that chunks and large allocations are requested from
+	CMemoryPool *m_upstream;
+
+	// next free byte of the current chunk
+	BYTE *m_current;
+
+	// end of the current chunk
+	BYTE *m_end;
+
+	// size of the next chunk to request
+	ULONG m_chunk_size;
+
+	// heads of the free lists, linked through the freed allocations
+	void *m_free_lists[GPOS_MEM_ARENA_NUM_CLASSES];
+
+#ifdef GPOS_DEBUG
+	// number of allocations not freed yet, checked for leaks
+	ULONG m_num_live;
+#endif	// GPOS_DEBUG
+
+	// size class of an allocation of the given size
+	static ULONG
+	SizeClass(ULONG bytes)
+	{
+		if (0 == bytes)
+		{
+			return 0;
+		}
+
+		return GPOS_MEM_ALIGNED_SIZE(bytes) / GPOS_MEM_ARCH - 1;
+	}
+
+	// carve an allocation of the given total size off the current chunk,
+	// starting a new chunk if needed
+	void *PvBump(ULONG alloc_size);
+
+	// return the given allocation to its free list or to the upstream pool
+	void Free(SAllocHeader *header);
+
+protected:
+	// dtor
+	~CMemoryPoolArena() override;
+
+public:
+	CMemoryPoolArena(CMemoryPoolArena &) = delete;
+
+	// ctor; the arena takes ownership of the upstream pool
+	explicit CMemoryPoolArena(CMemoryPool *upstream);
+
+	// prepare the memory pool to be deleted
+	void TearDown() override;
+
+	// allocate memory
+	void *NewImpl(const ULONG bytes, const CHAR *file, const ULONG line,
+				  CMemoryPool::EAllocationType eat) override;
+
+	// free memory allocation
+	static void DeleteImpl(void *ptr, EAllocationType eat);
+
+	// get user requested size of allocation
+	static ULONG UserSizeOfAlloc(const void *ptr);
+
+	// return total allocated size, including unused parts of chunks
+	ULLONG TotalAllocatedSize() const override;
+
+	// return the largest total allocated size so far
+	ULLONG PeakAllocatedSize() const override;
+
+#ifdef GPOS_DEBUG
+	// check that all allocations have been freed
+	void AssertEmpty(IOstream &os) override;
+#endif	// GPOS_DEBUG
+
+	// check if the given allocation was made by an arena
+	static BOOL
+	IsArenaAllocation(const void *ptr)
+	{
+		return 0 != (*(static_cast<const ULONG_PTR *>(ptr) - 1) & 1);
+	}
+};
+}  // namespace gpos
+
+#endif	// !GPOS_CMemoryPoolArena_H
+
+// EOF
@@ -65,6 +65,9 @@ private:
 	// create new pool of given type
 	virtual CMemoryPool *NewMemoryPool();
 
+	// add memory pool to the pools maintained by the manager
+	void RegisterMemoryPool(CMemoryPool *mp);
+
 	// clean-up memory pools
 	void Cleanup();
 
@@ -133,6 +136,9 @@ public:
 	// create new memory pool
 	CMemoryPool *CreateMemoryPool();
 
+	// create new arena memory pool, drawing its memory from a new pool
+	CMemoryPool *CreateArenaMemoryPool();
+
 	// release memory pool
 	void Destroy(CMemoryPool *);
 
@@ -38,6 +38,8 @@ private:
 
 	ULLONG m_live_obj_total_size;
 
+	ULLONG m_live_obj_peak_total_size;
+
 public:
 	CMemoryPoolStatistics(CMemoryPoolStatistics &) = delete;
 
@@ -48,7 +50,8 @@ public:
 		  m_num_free(0),
 		  m_num_live_obj(0),
 		  m_live_obj_user_size(0),
-		  m_live_obj_total_size(0)
+		  m_live_obj_total_size(0),
+		  m_live_obj_peak_total_size(0)
 	{
 	}
 
@@ -106,6 +109,10 @@ public:
 		++m_num_live_obj;
 		m_live_obj_user_size += user_data_size;
 		m_live_obj_total_size += total_data_size;
+		if (m_live_obj_total_size > m_live_obj_peak_total_size)
+		{
+			m_live_obj_peak_total_size = m_live_obj_total_size;
+		}
 	}
 
 	// record a successful free call (of a valid, non-NULL pointer)
@@ -132,6 +139,13 @@ public:
 		return m_live_obj_total_size;
 	}
 
+	// return the largest total allocated size so far
+	ULLONG
+	PeakAllocatedSize() const
+	{
+		return m_live_obj_peak_total_size;
+	}
+
 };	// class CMemoryPoolStatistics
 }  // namespace gpos
 
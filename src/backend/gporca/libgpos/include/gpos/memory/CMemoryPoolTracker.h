@@ -108,6 +108,13 @@ public:
 		return m_memory_pool_statistics.TotalAllocatedSize();
 	}
 
+	// return the largest total allocated size so far
+	ULLONG
+	PeakAllocatedSize() const override
+	{
+		return m_memory_pool_statistics.PeakAllocatedSize();
+	}
+
 #ifdef GPOS_DEBUG
 
 	// check if the memory pool keeps track of live objects
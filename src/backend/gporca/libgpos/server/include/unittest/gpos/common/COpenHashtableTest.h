@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		COpenHashtableTest.h
+//
+//	@doc:
+//		Test for COpenHashtable
+//---------------------------------------------------------------------------
+#ifndef GPOS_COpenHashtableTest_H
+#define GPOS_COpenHashtableTest_H
+
+#include "gpos/base.h"
+
+namespace gpos
+{
+//---------------------------------------------------------------------------
+//	@class:
+//		COpenHashtableTest
+//
+//	@doc:
+//		Static unit tests
+//
+//---------------------------------------------------------------------------
+class COpenHashtableTest
+{
+private:
+	// element of the tested tables
+	struct SElem
+	{
+		// key
+		ULONG m_key;
+
+		// payload, not part of the key
+		ULONG m_payload;
+
+		// hash function; folds keys together to force collisions
+		static ULONG
+		HashValue(const SElem &elem)
+		{
+			return elem.m_key % 7;
+		}
+
+		// equality function
+		static BOOL
+		Equals(const SElem &elemFst, const SElem &elemSnd)
+		{
+			return elemFst.m_key == elemSnd.m_key;
+		}
+	};
+
+public:
+	// unittests
+	static GPOS_RESULT EresUnittest();
+	static GPOS_RESULT EresUnittest_Basic();
+	static GPOS_RESULT EresUnittest_Iteration();
+
+};	// class COpenHashtableTest
+}  // namespace gpos
+
+#endif	// !GPOS_COpenHashtableTest_H
+
+// EOF
@@ -68,6 +68,9 @@ private:
 	// remove
 	static GPOS_RESULT EresRemoveDuplicates(CCache<SSimpleObject *, ULONG *> *);
 
+	// invalidation predicate selecting entries with even keys
+	static BOOL FEvenKey(ULONG *const &pvKey, SSimpleObject *pso, void *pvArg);
+
 	// inserts one SSimpleObject with key and value set to ulKey
 	static ULLONG InsertOneElement(CCache<SSimpleObject *, ULONG *> *pCache,
 								   ULONG ulKey);
@@ -159,6 +162,7 @@ public:
 	static GPOS_RESULT EresUnittest_DeepObject();
 	static GPOS_RESULT EresUnittest_Iteration();
 	static GPOS_RESULT EresUnittest_IterativeDeletion();
+	static GPOS_RESULT EresUnittest_Invalidation();
 
 
 };	// class CCacheTest
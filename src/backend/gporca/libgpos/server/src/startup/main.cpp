@@ -32,6 +32,7 @@
 #include "unittest/gpos/common/CHashSetTest.h"
 #include "unittest/gpos/common/CHashSetIterTest.h"
 #include "unittest/gpos/common/CListTest.h"
+#include "unittest/gpos/common/COpenHashtableTest.h"
 #include "unittest/gpos/common/CRefCountTest.h"
 #include "unittest/gpos/common/CStackTest.h"
 #include "unittest/gpos/common/CSyncHashtableTest.h"
@@ -80,6 +81,7 @@ static gpos::CUnittest rgut[] = {
 	GPOS_UNITTEST_STD(CHashSetIterTest),
 	GPOS_UNITTEST_STD(CRefCountTest),
 	GPOS_UNITTEST_STD(CListTest),
+	GPOS_UNITTEST_STD(COpenHashtableTest),
 	GPOS_UNITTEST_STD(CStackTest),
 	GPOS_UNITTEST_STD(CSyncHashtableTest),
 	GPOS_UNITTEST_STD(CSyncListTest),
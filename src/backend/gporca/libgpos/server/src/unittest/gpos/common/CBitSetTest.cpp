@@ -14,6 +14,7 @@
 #include "gpos/string/CWStringDynamic.h"
 
 #include "gpos/common/CBitSet.h"
+#include "gpos/common/CBitSetIter.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
 
@@ -36,6 +37,7 @@ CBitSetTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Basics),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Removal),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_SetOps),
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Window),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Performance)};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -209,6 +211,79 @@ CBitSetTest::EresUnittest_SetOps()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSetTest::EresUnittest_Window
+//
+//	@doc:
+//		Grow sets of large elements in both directions, and check that
+//		equal sets built in different orders have equal hash values
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CBitSetTest::EresUnittest_Window()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	ULONG vector_size = 100;
+	ULONG cInserts = 1000;
+	ULONG ulBase = 100000;
+
+	CBitSet *pbsUp = GPOS_NEW(mp) CBitSet(mp, vector_size);
+	CBitSet *pbsDown = GPOS_NEW(mp) CBitSet(mp, vector_size);
+	for (ULONG i = 0; i < cInserts; i++)
+	{
+		(void) pbsUp->ExchangeSet(ulBase + 3 * i);
+		(void) pbsDown->ExchangeSet(ulBase + 3 * (cInserts - i - 1));
+	}
+
+	if (cInserts != pbsUp->Size() || !pbsUp->Equals(pbsDown) ||
+		pbsUp->HashValue() != pbsDown->HashValue())
+	{
+		pbsUp->Release();
+		pbsDown->Release();
+
+		return GPOS_FAILED;
+	}
+
+	// elements below the window are not contained
+	CBitSet *pbsLow = GPOS_NEW(mp) CBitSet(mp, vector_size);
+	(void) pbsLow->ExchangeSet(ulBase - 1);
+	(void) pbsLow->ExchangeSet(0);
+
+	GPOS_ASSERT(!pbsUp->Get(ulBase - 1));
+	GPOS_ASSERT(pbsUp->IsDisjoint(pbsLow));
+
+	pbsUp->Union(pbsLow);
+	GPOS_ASSERT(pbsUp->ContainsAll(pbsLow));
+	GPOS_ASSERT(cInserts + 2 == pbsUp->Size());
+
+	pbsUp->Difference(pbsLow);
+	GPOS_ASSERT(pbsUp->Equals(pbsDown));
+
+	// elements are iterated in order
+	ULONG ulExpected = ulBase;
+	CBitSetIter bsiter(*pbsUp);
+	while (bsiter.Advance() && ulExpected == bsiter.Bit())
+	{
+		ulExpected += 3;
+	}
+
+	pbsLow->Release();
+	pbsDown->Release();
+	pbsUp->Release();
+
+	if (ulBase + 3 * cInserts != ulExpected)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CBitSetTest::EresUnittest_Performance
@@ -0,0 +1,156 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		COpenHashtableTest.cpp
+//
+//	@doc:
+//		Test for COpenHashtable
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/COpenHashtable.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/test/CUnittest.h"
+
+#include "unittest/gpos/common/COpenHashtableTest.h"
+
+using namespace gpos;
+
+#define GPOS_OPEN_HT_TEST_SIZE (1000)
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COpenHashtableTest::EresUnittest
+//
+//	@doc:
+//		Unittest for open addressing hash table
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COpenHashtableTest::EresUnittest()
+{
+	CUnittest rgut[] = {
+		GPOS_UNITTEST_FUNC(COpenHashtableTest::EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(COpenHashtableTest::EresUnittest_Iteration),
+	};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COpenHashtableTest::EresUnittest_Basic
+//
+//	@doc:
+//		Insertion and lookup test, growing the table from its smallest
+//		size with colliding hash values
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COpenHashtableTest::EresUnittest_Basic()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	typedef COpenHashtable<SElem, SElem::HashValue, SElem::Equals> Table;
+
+	CAutoRg<SElem> rgelem(GPOS_NEW_ARRAY(mp, SElem, GPOS_OPEN_HT_TEST_SIZE));
+	for (ULONG ul = 0; ul < GPOS_OPEN_HT_TEST_SIZE; ul++)
+	{
+		rgelem[ul].m_key = ul;
+		rgelem[ul].m_payload = ul;
+	}
+
+	Table table(mp);
+	for (ULONG ul = 0; ul < GPOS_OPEN_HT_TEST_SIZE; ul++)
+	{
+		// only even keys are inserted
+		if (0 == ul % 2)
+		{
+			table.Insert(&rgelem[ul]);
+		}
+	}
+
+	if (GPOS_OPEN_HT_TEST_SIZE / 2 != table.Size())
+	{
+		return GPOS_FAILED;
+	}
+
+	for (ULONG ul = 0; ul < GPOS_OPEN_HT_TEST_SIZE; ul++)
+	{
+		// look up by an equal element that is not in the table
+		SElem key = {ul, gpos::ulong_max};
+		SElem *found = table.Find(key);
+
+		if ((0 == ul % 2 && found != &rgelem[ul]) ||
+			(0 != ul % 2 && NULL != found))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COpenHashtableTest::EresUnittest_Iteration
+//
+//	@doc:
+//		Iterate over all elements, clear the table and reuse it
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COpenHashtableTest::EresUnittest_Iteration()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	typedef COpenHashtable<SElem, SElem::HashValue, SElem::Equals> Table;
+	typedef COpenHashtableIter<SElem, SElem::HashValue, SElem::Equals> Iter;
+
+	CAutoRg<SElem> rgelem(GPOS_NEW_ARRAY(mp, SElem, GPOS_OPEN_HT_TEST_SIZE));
+	Table table(mp, 16);
+
+	for (ULONG ulRound = 0; ulRound < 2; ulRound++)
+	{
+		for (ULONG ul = 0; ul < GPOS_OPEN_HT_TEST_SIZE; ul++)
+		{
+			rgelem[ul].m_key = ul;
+			rgelem[ul].m_payload = 0;
+			table.Insert(&rgelem[ul]);
+		}
+
+		// every element must be visited exactly once
+		Iter it(&table);
+		while (it.Advance())
+		{
+			it.Value()->m_payload++;
+		}
+
+		for (ULONG ul = 0; ul < GPOS_OPEN_HT_TEST_SIZE; ul++)
+		{
+			if (1 != rgelem[ul].m_payload)
+			{
+				return GPOS_FAILED;
+			}
+		}
+
+		table.Clear();
+
+		SElem key = {0, 0};
+		if (0 != table.Size() || NULL != table.Find(key))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+// EOF
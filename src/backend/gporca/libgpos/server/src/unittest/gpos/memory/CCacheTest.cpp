@@ -50,7 +50,8 @@ CCacheTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Eviction),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Iteration),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_DeepObject),
-		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion)};
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion),
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Invalidation)};
 
 	fUnique = true;
 	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -988,4 +989,110 @@ CCacheTest::EresUnittest_IterativeDeletion()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::FEvenKey
+//
+//	@doc:
+//		Invalidation predicate selecting entries with even keys
+//
+//---------------------------------------------------------------------------
+BOOL
+CCacheTest::FEvenKey(ULONG *const &pvKey, SSimpleObject *pso,
+					 void *  // pvArg
+)
+{
+	GPOS_ASSERT(*pvKey == pso->m_ulKey);
+
+	return 0 == *pvKey % 2;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::EresUnittest_Invalidation
+//
+//	@doc:
+//		Cache invalidation test; drops all entries with even keys while
+//		one of them is still referenced, and checks that lookups no longer
+//		find them
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCacheTest::EresUnittest_Invalidation()
+{
+	CAutoP<CCache<SSimpleObject *, ULONG *> > apcache;
+	apcache = CCacheFactory::CreateCache<SSimpleObject *, ULONG *>(
+		fUnique, UNLIMITED_CACHE_QUOTA, SSimpleObject::UlMyHash,
+		SSimpleObject::FMyEqual);
+
+	CCache<SSimpleObject *, ULONG *> *pcache = apcache.Value();
+
+	CCacheTest::EresInsertDuplicates(pcache);
+
+	ULONG ulDuplicates = 1;
+	if (!pcache->AllowsDuplicateKeys())
+	{
+		ulDuplicates = GPOS_CACHE_DUPLICATES;
+	}
+
+	ULLONG ullSizeBefore = pcache->TotalAllocatedSize();
+	ULLONG ullSizeHeld = 0;
+
+	// scope for accessor holding a reference to an invalidated entry
+	{
+		CSimpleObjectCacheAccessor caHeld(pcache);
+		ULONG ulHeldKey = 0;
+		caHeld.Lookup(&ulHeldKey);
+		SSimpleObject *psoHeld = caHeld.Val();
+		GPOS_RTL_ASSERT(NULL != psoHeld);
+
+		// release object since there is no customer to release it after lookup and before CCache's cleanup
+		psoHeld->Release();
+
+		ULONG ulInvalidated = pcache->InvalidateEntries(FEvenKey, NULL);
+		GPOS_RTL_ASSERT(ulInvalidated ==
+						(GPOS_CACHE_ELEMENTS / 2) * ulDuplicates);
+		GPOS_RTL_ASSERT(ulInvalidated == pcache->GetInvalidationCounter());
+
+		// the held object stays valid, but is not visible to lookups
+		GPOS_RTL_ASSERT(0 == psoHeld->m_ulKey);
+		ullSizeHeld = pcache->TotalAllocatedSize();
+		GPOS_RTL_ASSERT(ullSizeHeld < ullSizeBefore);
+
+		ULLONG ullHits = pcache->GetHitCounter();
+		ULLONG ullMisses = pcache->GetMissCounter();
+		for (ULONG i = 0; i < GPOS_CACHE_ELEMENTS; i++)
+		{
+			GPOS_CHECK_ABORT;
+
+			CSimpleObjectCacheAccessor ca(pcache);
+			ca.Lookup(&i);
+			SSimpleObject *pso = ca.Val();
+			GPOS_RTL_ASSERT((0 == i % 2) == (NULL == pso));
+
+			if (NULL != pso)
+			{
+				// release object since there is no customer to release it after lookup and before CCache's cleanup
+				pso->Release();
+			}
+		}
+
+		GPOS_RTL_ASSERT(ullHits + GPOS_CACHE_ELEMENTS / 2 ==
+						pcache->GetHitCounter());
+		GPOS_RTL_ASSERT(ullMisses + GPOS_CACHE_ELEMENTS / 2 ==
+						pcache->GetMissCounter());
+	}
+
+	// releasing the last reference destroys the invalidated entry
+	GPOS_RTL_ASSERT(pcache->Size() ==
+					(GPOS_CACHE_ELEMENTS / 2) * ulDuplicates);
+	GPOS_RTL_ASSERT(pcache->TotalAllocatedSize() < ullSizeHeld);
+
+	// invalidated entries are not selected again
+	GPOS_RTL_ASSERT(0 == pcache->InvalidateEntries(FEvenKey, NULL));
+
+	return GPOS_OK;
+}
+
 // EOF
@@ -45,7 +45,8 @@ CMemoryPoolBasicTest::EresUnittest()
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_Print),
 #endif	// GPOS_DEBUG
-		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestTracker)};
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestTracker),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestArena)};
 
 	CAutoTraceFlag atf(EtraceTestMemoryPools, true /*value*/);
 
@@ -97,6 +98,88 @@ CMemoryPoolBasicTest::EresUnittest_TestTracker()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestArena
+//
+//	@doc:
+//		Run tests for arena pool; freed allocations are reused for
+//		allocations of the same size class, large allocations are passed on
+//		to the upstream pool
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestArena()
+{
+	CAutoTimer at("Arena test", true /*fPrint*/);
+
+	// scope for pool
+	{
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcExc,
+							CAutoMemoryPool::EptArena);
+		CMemoryPool *mp = amp.Pmp();
+
+		ULONG *rgulFirst = GPOS_NEW_ARRAY(mp, ULONG, 10);
+		BOOL fSizeKept = (10 * GPOS_SIZEOF(ULONG) ==
+						  CMemoryPool::UserSizeOfAlloc(rgulFirst));
+		GPOS_DELETE_ARRAY(rgulFirst);
+
+		ULONG *rgulSecond = GPOS_NEW_ARRAY(mp, ULONG, 9);
+		fSizeKept = fSizeKept && (9 * GPOS_SIZEOF(ULONG) ==
+								  CMemoryPool::UserSizeOfAlloc(rgulSecond));
+		BOOL fReused = (rgulFirst == rgulSecond);
+		GPOS_DELETE_ARRAY(rgulSecond);
+
+		// allocations of all sizes, freeing every other one right away and
+		// the rest at the end
+		const ULONG ulAllocs = 64 * 1024 / 7 + 1;
+		BYTE **rgrgby = GPOS_NEW_ARRAY(mp, BYTE *, ulAllocs);
+		ULONG ulLive = 0;
+		for (ULONG ul = 0; ul < 64 * 1024; ul += 7)
+		{
+			ULONG ulSize = ul % (4 * 1024);
+			BYTE *rgby = GPOS_NEW_ARRAY(mp, BYTE, ulSize);
+			fSizeKept =
+				fSizeKept && (ulSize == CMemoryPool::UserSizeOfAlloc(rgby));
+			if (0 == (ul & 1))
+			{
+				GPOS_DELETE_ARRAY(rgby);
+			}
+			else
+			{
+				rgrgby[ulLive++] = rgby;
+			}
+		}
+
+		BOOL fAllocated = (0 < mp->TotalAllocatedSize());
+
+		for (ULONG ul = 0; ul < ulLive; ul++)
+		{
+			GPOS_DELETE_ARRAY(rgrgby[ul]);
+		}
+		GPOS_DELETE_ARRAY(rgrgby);
+
+		if (!fSizeKept || !fReused || !fAllocated)
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	// allocation failing in the ctor is freed again, and leaks are reported
+	if (GPOS_OK !=
+			EresTestExpectedError(EresArenaThrowingCtor, CException::ExmiOOM)
+#ifdef GPOS_DEBUG
+		|| GPOS_OK != EresTestExpectedError(EresArenaLeak, CException::ExmiAssert)
+#endif	// GPOS_DEBUG
+	)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresTestType
@@ -212,6 +295,36 @@ CMemoryPoolBasicTest::EresNewDelete()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresArenaThrowingCtor
+//
+//	@doc:
+//		Exception in constructor of an object allocated from an arena
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresArenaThrowingCtor()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, CAutoMemoryPool::EptArena);
+	CMemoryPool *mp = amp.Pmp();
+
+	class CMyTestClass
+	{
+	public:
+		CMyTestClass()
+		{
+			GPOS_RAISE(CException::ExmaSystem, CException::ExmiOOM);
+		}
+	};
+
+	GPOS_NEW(mp) CMyTestClass();
+
+	// doesn't reach this line
+	return GPOS_FAILED;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresThrowingCtor
@@ -321,6 +434,39 @@ CMemoryPoolBasicTest::EresLeakByException()
 	return GPOS_FAILED;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresArenaLeak
+//
+//	@doc:
+//		Leak checking of arena pools
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresArenaLeak()
+{
+	// scope for pool
+	{
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict,
+							CAutoMemoryPool::EptArena);
+		CMemoryPool *mp = amp.Pmp();
+
+		for (ULONG i = 0; i < 10; i++)
+		{
+			ULONG *rgul = GPOS_NEW_ARRAY(mp, ULONG, 10);
+			rgul[2] = 1;
+
+			if (i < 8)
+			{
+				GPOS_DELETE_ARRAY(rgul);
+			}
+		}
+	}
+
+	return GPOS_FAILED;
+}
+
 #endif	// GPOS_DEBUG
 
 
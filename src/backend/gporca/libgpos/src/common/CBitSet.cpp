@@ -8,14 +8,16 @@
 //	@doc:
 //		Implementation of bit sets
 //
-//		Underlying assumption: a set contains only a few links of bitvectors
-//		hence, keeping them in a linked list is efficient;
+//		Underlying assumption: the elements of a set are mostly clustered,
+//		as are the ids of the columns of a table, hence keeping a single
+//		window of words over them is compact, and set operations reduce to
+//		tight loops over contiguous words;
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
-#include "gpos/common/CAutoRef.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/common/CBitSetIter.h"
+#include "gpos/common/clibwrapper.h"
 
 #ifdef GPOS_DEBUG
 #include "gpos/error/CAutoTrace.h"
@@ -23,163 +25,209 @@
 
 using namespace gpos;
 
+#define BITS_PER_UNIT GPOS_BITSET_WORD_BITS
+
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSetLink
+//		CountBits
 //
 //	@doc:
-//		ctor
+//		Number of bits set in a word
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink::CBitSetLink(CMemoryPool *mp, ULONG offset,
-								  ULONG vector_size)
-	: m_offset(offset)
+static inline ULONG
+CountBits(ULLONG ull)
 {
-	m_vec = GPOS_NEW(mp) CBitVector(mp, vector_size);
+	return (ULONG) __builtin_popcountll(ull);
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSetLink
+//		CBitSet::EnsureWords
 //
 //	@doc:
-//		copy ctor
+//		Extend the window to cover the given range of words; the window
+//		grows by at least doubling, leaving the extra words on the side it
+//		grows towards
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink::CBitSetLink(CMemoryPool *mp, const CBitSetLink &bsl)
-	: m_offset(bsl.m_offset)
+void
+CBitSet::EnsureWords(ULONG first_word, ULONG end_word)
 {
-	m_vec = GPOS_NEW(mp) CBitVector(mp, *bsl.GetVec());
-}
+	GPOS_ASSERT(first_word < end_word);
 
+	ULONG window_end = m_first_word + m_num_words;
+	if (first_word >= m_first_word && end_word <= window_end)
+	{
+		return;
+	}
 
-//---------------------------------------------------------------------------
-//	@function:
-//		~CBitSetLink
-//
-//	@doc:
-//		ctor
-//
-//---------------------------------------------------------------------------
-CBitSet::CBitSetLink::~CBitSetLink()
-{
-	GPOS_DELETE(m_vec);
+	// the words of an empty set are all zero, so its window can be moved
+	if (0 == m_size && end_word - first_word <= m_num_words)
+	{
+		m_first_word = first_word;
+		return;
+	}
+
+	ULONG lo = first_word;
+	ULONG hi = end_word;
+	if (0 != m_size)
+	{
+		lo = std::min(lo, m_first_word);
+		hi = std::max(hi, window_end);
+	}
+
+	ULONG num_words = std::max(hi - lo, 2 * m_num_words);
+	ULONG new_first_word = lo;
+	if (first_word < m_first_word && 0 != m_size)
+	{
+		// growing downwards
+		new_first_word = (hi > num_words) ? hi - num_words : 0;
+	}
+
+	ULLONG *words = GPOS_NEW_ARRAY(m_mp, ULLONG, num_words);
+	clib::Memset(words, 0, num_words * GPOS_SIZEOF(ULLONG));
+
+	if (0 != m_size)
+	{
+		clib::Memcpy(words + (m_first_word - new_first_word), m_words,
+					 m_num_words * GPOS_SIZEOF(ULLONG));
+	}
+
+	if (m_words != m_inline_words)
+	{
+		GPOS_DELETE_ARRAY(m_words);
+	}
+
+	m_words = words;
+	m_first_word = new_first_word;
+	m_num_words = num_words;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::FindLinkByOffset
+//		CBitSet::FindNextSetBit
 //
 //	@doc:
-//		Find bit set link for a given offset; if non-existent return previous
-//		link (may be NULL);
-//		By providing a starting link we can implement a number of operations
-//		in one sweep, ie O(N)
+//		Find the first set bit at or after the given position
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink *
-CBitSet::FindLinkByOffset(ULONG offset, CBitSetLink *bsl) const
+BOOL
+CBitSet::FindNextSetBit(ULONG start_pos, ULONG &next_pos) const
 {
-	CBitSetLink *found = NULL;
-	CBitSetLink *cursor = bsl;
-
-	if (NULL == bsl)
+	ULONG idx = start_pos / BITS_PER_UNIT;
+	ULLONG mask = ~((ULLONG) 0) << (start_pos % BITS_PER_UNIT);
+	if (idx < m_first_word)
 	{
-		// if no cursor provided start with first element
-		cursor = m_bsllist.First();
+		idx = m_first_word;
+		mask = ~((ULLONG) 0);
 	}
-	else
+
+	ULONG window_end = m_first_word + m_num_words;
+	if (idx >= window_end)
 	{
-		GPOS_ASSERT(bsl->GetOffset() <= offset && "invalid start cursor");
-		found = bsl;
+		return false;
 	}
 
-	GPOS_ASSERT_IMP(NULL != cursor,
-					GPOS_OK == m_bsllist.Find(cursor) && "cursor not in list");
-
-	while (1)
+	ULLONG ull = m_words[idx - m_first_word] & mask;
+	while (0 == ull)
 	{
-		// no more links or we've overshot the target
-		if (NULL == cursor || cursor->GetOffset() > offset)
+		if (++idx == window_end)
 		{
-			break;
+			return false;
 		}
 
-		found = cursor;
-		cursor = m_bsllist.Next(cursor);
+		ull = m_words[idx - m_first_word];
 	}
 
-	GPOS_ASSERT_IMP(found, found->GetOffset() <= offset);
-	return found;
+	next_pos = idx * BITS_PER_UNIT + (ULONG) __builtin_ctzll(ull);
+	return true;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::RecomputeSize
+//		CBitSet::HashBlock
 //
 //	@doc:
-//		Compute size of set by adding up sizes of links
+//		Hash value of the block of m_vector_size bits starting at the given
+//		position; computes gpos::HashByteArray over the words the block
+//		would occupy on its own, so that hash values are the same as when
+//		sets were kept as lists of bit vectors of that size
 //
 //---------------------------------------------------------------------------
-void
-CBitSet::RecomputeSize()
+ULONG
+CBitSet::HashBlock(ULONG start_pos) const
 {
-	m_size = 0;
-	CBitSetLink *bsl = NULL;
+	ULONG num_units = (m_vector_size + BITS_PER_UNIT - 1) / BITS_PER_UNIT;
+	ULONG hash = num_units * GPOS_SIZEOF(ULLONG);
 
-	for (bsl = m_bsllist.First(); bsl != NULL; bsl = m_bsllist.Next(bsl))
+	for (ULONG ul = 0; ul < num_units; ul++)
 	{
-		m_size += bsl->GetVec()->CountSetBits();
+		ULONG pos = start_pos + ul * BITS_PER_UNIT;
+		ULONG shift = pos % BITS_PER_UNIT;
+
+		ULLONG ull = Word(pos / BITS_PER_UNIT) >> shift;
+		if (0 != shift)
+		{
+			ull |= Word(pos / BITS_PER_UNIT + 1) << (BITS_PER_UNIT - shift);
+		}
+
+		ULONG remaining = m_vector_size - ul * BITS_PER_UNIT;
+		if (remaining < BITS_PER_UNIT)
+		{
+			ull &= ((ULLONG) 1 << remaining) - 1;
+		}
+
+		const BYTE *bytes = (const BYTE *) &ull;
+		for (ULONG ulByte = 0; ulByte < GPOS_SIZEOF(ULLONG); ulByte++)
+		{
+			hash = ((hash << 5) ^ (hash >> 27)) ^ bytes[ulByte];
+		}
 	}
+
+	return hash;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::Clear
+//		CBitSet::RecomputeSize
 //
 //	@doc:
-//		release all links
+//		Compute size of set by counting the bits of all words
 //
 //---------------------------------------------------------------------------
 void
-CBitSet::Clear()
+CBitSet::RecomputeSize()
 {
-	CBitSetLink *bsl = NULL;
-
-	while (NULL != (bsl = m_bsllist.First()))
+	m_size = 0;
+	for (ULONG ul = 0; ul < m_num_words; ul++)
 	{
-		CBitSetLink *bsl_to_remove = bsl;
-		bsl = m_bsllist.Next(bsl);
-
-		m_bsllist.Remove(bsl_to_remove);
-		GPOS_DELETE(bsl_to_remove);
+		m_size += CountBits(m_words[ul]);
 	}
-
-	RecomputeSize();
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::GetOffset
+//		CBitSet::Clear
 //
 //	@doc:
-//		Compute offset
+//		Remove all elements
 //
 //---------------------------------------------------------------------------
-ULONG
-CBitSet::ComputeOffset(ULONG ul) const
+void
+CBitSet::Clear()
 {
-	return (ul / m_vector_size) * m_vector_size;
+	clib::Memset(m_words, 0, m_num_words * GPOS_SIZEOF(ULLONG));
+	m_size = 0;
 }
 
 
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CBitSet::CBitSet
@@ -189,9 +237,14 @@ CBitSet::ComputeOffset(ULONG ul) const
 //
 //---------------------------------------------------------------------------
 CBitSet::CBitSet(CMemoryPool *mp, ULONG vector_size)
-	: m_mp(mp), m_vector_size(vector_size), m_size(0)
+	: m_mp(mp),
+	  m_vector_size(vector_size),
+	  m_size(0),
+	  m_first_word(0),
+	  m_num_words(GPOS_BITSET_INLINE_WORDS),
+	  m_words(m_inline_words)
 {
-	m_bsllist.Init(GPOS_OFFSET(CBitSetLink, m_link));
+	Clear();
 }
 
 
@@ -204,9 +257,14 @@ CBitSet::CBitSet(CMemoryPool *mp, ULONG vector_size)
 //
 //---------------------------------------------------------------------------
 CBitSet::CBitSet(CMemoryPool *mp, const CBitSet &bs)
-	: m_mp(mp), m_vector_size(bs.m_vector_size), m_size(0)
+	: m_mp(mp),
+	  m_vector_size(bs.m_vector_size),
+	  m_size(0),
+	  m_first_word(0),
+	  m_num_words(GPOS_BITSET_INLINE_WORDS),
+	  m_words(m_inline_words)
 {
-	m_bsllist.Init(GPOS_OFFSET(CBitSetLink, m_link));
+	Clear();
 	Union(&bs);
 }
 
@@ -221,30 +279,10 @@ CBitSet::CBitSet(CMemoryPool *mp, const CBitSet &bs)
 //---------------------------------------------------------------------------
 CBitSet::~CBitSet()
 {
-	Clear();
-}
-
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CBitSet::Get
-//
-//	@doc:
-//		Check if given bit is set
-//
-//---------------------------------------------------------------------------
-BOOL
-CBitSet::Get(ULONG pos) const
-{
-	ULONG offset = ComputeOffset(pos);
-
-	CBitSetLink *bsl = FindLinkByOffset(offset);
-	if (NULL != bsl && bsl->GetOffset() == offset)
+	if (m_words != m_inline_words)
 	{
-		return bsl->GetVec()->Get(pos - offset);
+		GPOS_DELETE_ARRAY(m_words);
 	}
-
-	return false;
 }
 
 
@@ -253,37 +291,22 @@ CBitSet::Get(ULONG pos) const
 //		CBitSet::ExchangeSet
 //
 //	@doc:
-//		Set given bit; return previous value; allocate new link if necessary
+//		Set given bit; return previous value; extend window if necessary
 //
 //---------------------------------------------------------------------------
 BOOL
 CBitSet::ExchangeSet(ULONG pos)
 {
-	ULONG offset = ComputeOffset(pos);
-
-	CBitSetLink *bsl = FindLinkByOffset(offset);
-	if (NULL == bsl || bsl->GetOffset() != offset)
-	{
-		CBitSetLink *pbsl_new =
-			GPOS_NEW(m_mp) CBitSetLink(m_mp, offset, m_vector_size);
-		if (NULL == bsl)
-		{
-			m_bsllist.Prepend(pbsl_new);
-		}
-		else
-		{
-			// insert after found link
-			m_bsllist.Append(pbsl_new, bsl);
-		}
+	ULONG idx = pos / BITS_PER_UNIT;
+	EnsureWords(idx, idx + 1);
 
-		bsl = pbsl_new;
-	}
+	ULLONG &ull = m_words[idx - m_first_word];
+	ULLONG mask = ((ULLONG) 1) << (pos % BITS_PER_UNIT);
 
-	GPOS_ASSERT(bsl->GetOffset() == offset);
-
-	BOOL bit = bsl->GetVec()->ExchangeSet(pos - offset);
+	BOOL bit = (0 != (ull & mask));
 	if (!bit)
 	{
+		ull |= mask;
 		m_size++;
 	}
 
@@ -302,29 +325,16 @@ CBitSet::ExchangeSet(ULONG pos)
 BOOL
 CBitSet::ExchangeClear(ULONG pos)
 {
-	ULONG offset = ComputeOffset(pos);
-
-	CBitSetLink *bsl = FindLinkByOffset(offset);
-	if (NULL != bsl && bsl->GetOffset() == offset)
+	if (!Get(pos))
 	{
-		BOOL bit = bsl->GetVec()->ExchangeClear(pos - offset);
-
-		// remove empty link
-		if (bsl->GetVec()->IsEmpty())
-		{
-			m_bsllist.Remove(bsl);
-			GPOS_DELETE(bsl);
-		}
-
-		if (bit)
-		{
-			m_size--;
-		}
-
-		return bit;
+		return false;
 	}
 
-	return false;
+	ULONG idx = pos / BITS_PER_UNIT;
+	m_words[idx - m_first_word] &= ~(((ULLONG) 1) << (pos % BITS_PER_UNIT));
+	m_size--;
+
+	return true;
 }
 
 
@@ -333,77 +343,45 @@ CBitSet::ExchangeClear(ULONG pos)
 //		CBitSet::Union
 //
 //	@doc:
-//		Union with given other set;
-//		(1) determine which links need to be allocated before(!) modifying
-//			the set allocate and copy missing links aside
-//		(2) insert the new links into the list
-//		(3) union all links, old and new, on a per-bitvector basis
-//
-//		For clarity step (2) and (3) are separated;
+//		Union with given other set; extends the window to the non-zero
+//		words of the other set, and or's them in
 //
 //---------------------------------------------------------------------------
 void
 CBitSet::Union(const CBitSet *pbsOther)
 {
-	CBitSetLink *bsl = NULL;
-	CBitSetLink *bsl_other = NULL;
-
-	// dynamic array of CBitSetLink
-	typedef CDynamicPtrArray<CBitSetLink, CleanupNULL> CBitSetLinkArray;
-
-	CAutoRef<CBitSetLinkArray> a_drgpbsl;
-	a_drgpbsl = GPOS_NEW(m_mp) CBitSetLinkArray(m_mp);
-
-	// iterate through other's links and copy missing links to array
-	for (bsl_other = pbsOther->m_bsllist.First(); bsl_other != NULL;
-		 bsl_other = pbsOther->m_bsllist.Next(bsl_other))
+	if (0 == pbsOther->Size())
 	{
-		bsl = FindLinkByOffset(bsl_other->GetOffset(), bsl);
-		if (NULL == bsl || bsl->GetOffset() != bsl_other->GetOffset())
-		{
-			// need to copy this link
-			CAutoP<CBitSetLink> a_pbsl;
-			a_pbsl = GPOS_NEW(m_mp) CBitSetLink(m_mp, *bsl_other);
-			a_drgpbsl->Append(a_pbsl.Value());
-
-			a_pbsl.Reset();
-		}
+		return;
 	}
 
-	// insert all new links
-	bsl = NULL;
-	for (ULONG i = 0; i < a_drgpbsl->Size(); i++)
+	// trim zero words off the other's window
+	const ULLONG *other_words = pbsOther->m_words;
+	ULONG lo = 0;
+	ULONG hi = pbsOther->m_num_words;
+	while (0 == other_words[lo])
 	{
-		CBitSetLink *pbslInsert = (*a_drgpbsl)[i];
-		bsl = FindLinkByOffset(pbslInsert->GetOffset(), bsl);
-
-		GPOS_ASSERT_IMP(NULL != bsl,
-						bsl->GetOffset() < pbslInsert->GetOffset());
-		if (NULL == bsl)
-		{
-			m_bsllist.Prepend(pbslInsert);
-		}
-		else
-		{
-			m_bsllist.Append(pbslInsert, bsl);
-		}
+		lo++;
 	}
-
-	// iterate through all links and union them up
-	bsl_other = NULL;
-	bsl = m_bsllist.First();
-	while (NULL != bsl)
+	while (0 == other_words[hi - 1])
 	{
-		bsl_other = pbsOther->FindLinkByOffset(bsl->GetOffset(), bsl_other);
-		if (NULL != bsl_other && bsl_other->GetOffset() == bsl->GetOffset())
-		{
-			bsl->GetVec()->Or(bsl_other->GetVec());
-		}
+		hi--;
+	}
 
-		bsl = m_bsllist.Next(bsl);
+	ULONG first_word = pbsOther->m_first_word + lo;
+	EnsureWords(first_word, pbsOther->m_first_word + hi);
+
+	ULLONG *words = m_words + (first_word - m_first_word);
+	other_words += lo;
+
+	ULONG num_added = 0;
+	for (ULONG ul = 0; ul < hi - lo; ul++)
+	{
+		num_added += CountBits(other_words[ul] & ~words[ul]);
+		words[ul] |= other_words[ul];
 	}
 
-	RecomputeSize();
+	m_size += num_added;
 }
 
 
@@ -412,7 +390,7 @@ CBitSet::Union(const CBitSet *pbsOther)
 //		CBitSet::Intersection
 //
 //	@doc:
-//		Iterate through all links and intersect them; release unused links
+//		And all words of the window with the other's
 //
 //---------------------------------------------------------------------------
 void
@@ -423,27 +401,9 @@ CBitSet::Intersection(const CBitSet *pbsOther)
 		return;
 	}
 
-	CBitSetLink *bsl_other = NULL;
-	CBitSetLink *bsl = m_bsllist.First();
-
-	while (NULL != bsl)
+	for (ULONG ul = 0; ul < m_num_words; ul++)
 	{
-		CBitSetLink *bsl_to_remove = NULL;
-
-		bsl_other = pbsOther->FindLinkByOffset(bsl->GetOffset(), bsl_other);
-		if (NULL != bsl_other && bsl_other->GetOffset() == bsl->GetOffset())
-		{
-			bsl->GetVec()->And(bsl_other->GetVec());
-			bsl = m_bsllist.Next(bsl);
-		}
-		else
-		{
-			bsl_to_remove = bsl;
-			bsl = m_bsllist.Next(bsl);
-
-			m_bsllist.Remove(bsl_to_remove);
-			GPOS_DELETE(bsl_to_remove);
-		}
+		m_words[ul] &= pbsOther->Word(m_first_word + ul);
 	}
 
 	RecomputeSize();
@@ -455,8 +415,8 @@ CBitSet::Intersection(const CBitSet *pbsOther)
 //		CBitSet::Difference
 //
 //	@doc:
-//		Substract other set from this by iterating through other set and
-//		explicit removal of elements;
+//		Substract other set from this by clearing its bits from the words
+//		of the window
 //
 //---------------------------------------------------------------------------
 void
@@ -467,11 +427,12 @@ CBitSet::Difference(const CBitSet *pbs)
 		return;
 	}
 
-	CBitSetIter bsiter(*pbs);
-	while (bsiter.Advance())
+	for (ULONG ul = 0; ul < m_num_words; ul++)
 	{
-		(void) ExchangeClear(bsiter.Bit());
+		m_words[ul] &= ~pbs->Word(m_first_word + ul);
 	}
+
+	RecomputeSize();
 }
 
 
@@ -492,17 +453,9 @@ CBitSet::ContainsAll(const CBitSet *bs) const
 		return false;
 	}
 
-	CBitSetLink *bsl = NULL;
-	CBitSetLink *bsl_other = NULL;
-
-	// iterate through other's links and check for subsets
-	for (bsl_other = bs->m_bsllist.First(); bsl_other != NULL;
-		 bsl_other = bs->m_bsllist.Next(bsl_other))
+	for (ULONG ul = 0; ul < bs->m_num_words; ul++)
 	{
-		bsl = FindLinkByOffset(bsl_other->GetOffset(), bsl);
-
-		if (NULL == bsl || bsl->GetOffset() != bsl_other->GetOffset() ||
-			!bsl->GetVec()->ContainsAll(bsl_other->GetVec()))
+		if (0 != (bs->m_words[ul] & ~Word(bs->m_first_word + ul)))
 		{
 			return false;
 		}
@@ -535,23 +488,16 @@ CBitSet::Equals(const CBitSet *bs) const
 		return false;
 	}
 
-	CBitSetLink *bsl = m_bsllist.First();
-	CBitSetLink *bsl_other = bs->m_bsllist.First();
-
-	while (NULL != bsl)
+	// same size implies there are no bits outside the other's window
+	for (ULONG ul = 0; ul < bs->m_num_words; ul++)
 	{
-		if (NULL == bsl_other || bsl->GetOffset() != bsl_other->GetOffset() ||
-			!bsl->GetVec()->Equals(bsl_other->GetVec()))
+		if (bs->m_words[ul] != Word(bs->m_first_word + ul))
 		{
 			return false;
 		}
-
-		bsl = m_bsllist.Next(bsl);
-		bsl_other = bs->m_bsllist.Next(bsl_other);
 	}
 
-	// same length implies bsl_other must have reached end as well
-	return bsl_other == NULL;
+	return true;
 }
 
 
@@ -567,17 +513,9 @@ CBitSet::Equals(const CBitSet *bs) const
 BOOL
 CBitSet::IsDisjoint(const CBitSet *bs) const
 {
-	CBitSetLink *bsl = NULL;
-	CBitSetLink *bsl_other = NULL;
-
-	// iterate through other's links an check if disjoint
-	for (bsl_other = bs->m_bsllist.First(); bsl_other != NULL;
-		 bsl_other = bs->m_bsllist.Next(bsl_other))
+	for (ULONG ul = 0; ul < bs->m_num_words; ul++)
 	{
-		bsl = FindLinkByOffset(bsl_other->GetOffset(), bsl);
-
-		if (NULL != bsl && bsl->GetOffset() == bsl_other->GetOffset() &&
-			!bsl->GetVec()->IsDisjoint(bsl_other->GetVec()))
+		if (0 != (bs->m_words[ul] & Word(bs->m_first_word + ul)))
 		{
 			return false;
 		}
@@ -592,7 +530,8 @@ CBitSet::IsDisjoint(const CBitSet *bs) const
 //		CBitSet::HashValue
 //
 //	@doc:
-//		Compute hash value for set
+//		Compute hash value for set by combining the hash values of all
+//		non-empty blocks of bits
 //
 //---------------------------------------------------------------------------
 ULONG
@@ -600,11 +539,14 @@ CBitSet::HashValue() const
 {
 	ULONG ulHash = 0;
 
-	CBitSetLink *bsl = m_bsllist.First();
-	while (NULL != bsl)
+	ULONG pos = 0;
+	while (FindNextSetBit(pos, pos))
 	{
-		ulHash = gpos::CombineHashes(ulHash, bsl->GetVec()->HashValue());
-		bsl = m_bsllist.Next(bsl);
+		GPOS_ASSERT(0 < m_vector_size);
+
+		ULONG block_start = (pos / m_vector_size) * m_vector_size;
+		ulHash = gpos::CombineHashes(ulHash, HashBlock(block_start));
+		pos = block_start + m_vector_size;
 	}
 
 	return ulHash;
@@ -11,7 +11,6 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CBitSetIter.h"
-#include "gpos/common/CAutoRef.h"
 
 using namespace gpos;
 
@@ -25,7 +24,7 @@ using namespace gpos;
 //
 //---------------------------------------------------------------------------
 CBitSetIter::CBitSetIter(const CBitSet &bs)
-	: m_bs(bs), m_cursor((ULONG) -1), m_bsl(NULL), m_active(true)
+	: m_bs(bs), m_cursor((ULONG) -1), m_active(true)
 {
 }
 
@@ -43,24 +42,8 @@ CBitSetIter::Advance()
 {
 	GPOS_ASSERT(m_active && "called advance on exhausted iterator");
 
-	if (NULL == m_bsl)
-	{
-		m_bsl = m_bs.m_bsllist.First();
-	}
-
-	while (NULL != m_bsl)
-	{
-		if (m_cursor + 1 <= m_bs.m_vector_size &&
-			m_bsl->GetVec()->GetNextSetBit(m_cursor + 1, m_cursor))
-		{
-			break;
-		}
-
-		m_bsl = m_bs.m_bsllist.Next(m_bsl);
-		m_cursor = (ULONG) -1;
-	}
-
-	m_active = (NULL != m_bsl);
+	// the cursor starts out at -1, so the search starts at bit 0
+	m_active = m_bs.FindNextSetBit(m_cursor + 1, m_cursor);
 	return m_active;
 }
 
@@ -76,10 +59,10 @@ CBitSetIter::Advance()
 ULONG
 CBitSetIter::Bit() const
 {
-	GPOS_ASSERT(m_active && NULL != m_bsl && "iterator uninitialized");
-	GPOS_ASSERT(m_bsl->GetVec()->Get(m_cursor));
+	GPOS_ASSERT(m_active && "iterator exhausted");
+	GPOS_ASSERT(m_bs.Get(m_cursor) && "iterator uninitialized");
 
-	return m_bsl->GetOffset() + m_cursor;
+	return m_cursor;
 }
 
 // EOF
@@ -38,12 +38,20 @@ using namespace gpos;
 //  	the CMemoryPoolManager global instance
 //
 //---------------------------------------------------------------------------
-CAutoMemoryPool::CAutoMemoryPool(ELeakCheck leak_check_type GPOS_ASSERTS_ONLY)
+CAutoMemoryPool::CAutoMemoryPool(ELeakCheck leak_check_type GPOS_ASSERTS_ONLY,
+								 EPoolType pool_type)
 #ifdef GPOS_DEBUG
 	: m_leak_check_type(leak_check_type)
 #endif
 {
-	m_mp = CMemoryPoolManager::GetMemoryPoolMgr()->CreateMemoryPool();
+	if (EptArena == pool_type)
+	{
+		m_mp = CMemoryPoolManager::GetMemoryPoolMgr()->CreateArenaMemoryPool();
+	}
+	else
+	{
+		m_mp = CMemoryPoolManager::GetMemoryPoolMgr()->CreateMemoryPool();
+	}
 }
 
 
@@ -13,6 +13,7 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/memory/CMemoryPool.h"
+#include "gpos/memory/CMemoryPoolArena.h"
 #include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/memory/CMemoryPoolManager.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
@@ -30,6 +31,13 @@ CMemoryPool::UserSizeOfAlloc(const void *ptr)
 {
 	GPOS_ASSERT(NULL != ptr);
 
+	// arenas may be created by any manager, so their allocations are
+	// recognized before handing the pointer to the manager
+	if (CMemoryPoolArena::IsArenaAllocation(ptr))
+	{
+		return CMemoryPoolArena::UserSizeOfAlloc(ptr);
+	}
+
 	return CMemoryPoolManager::GetMemoryPoolMgr()->UserSizeOfAlloc(ptr);
 }
 
@@ -37,6 +45,12 @@ CMemoryPool::UserSizeOfAlloc(const void *ptr)
 void
 CMemoryPool::DeleteImpl(void *ptr, EAllocationType eat)
 {
+	if (CMemoryPoolArena::IsArenaAllocation(ptr))
+	{
+		CMemoryPoolArena::DeleteImpl(ptr, eat);
+		return;
+	}
+
 	CMemoryPoolManager::GetMemoryPoolMgr()->DeleteImpl(ptr, eat);
 }
 
@@ -0,0 +1,226 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMemoryPoolArena.cpp
+//
+//	@doc:
+//		Implementation of the arena memory pool
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/memory/CMemoryPoolArena.h"
+#include "gpos/task/ITask.h"
+#include "gpos/task/traceflags.h"
+
+using namespace gpos;
+
+#define GPOS_MEM_ARENA_HEADER_SIZE GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader)
+
+
+// ctor
+CMemoryPoolArena::CMemoryPoolArena(CMemoryPool *upstream)
+	: CMemoryPool(),
+	  m_upstream(upstream),
+	  m_current(NULL),
+	  m_end(NULL),
+	  m_chunk_size(GPOS_MEM_ARENA_INIT_CHUNK_SIZE)
+#ifdef GPOS_DEBUG
+	  ,
+	  m_num_live(0)
+#endif	// GPOS_DEBUG
+{
+	GPOS_ASSERT(NULL != upstream);
+
+	// the tagged size must be the word right in front of the user data
+	GPOS_ASSERT(GPOS_MEM_ARENA_HEADER_SIZE == GPOS_SIZEOF(SAllocHeader));
+
+	for (ULONG ul = 0; ul < GPOS_MEM_ARENA_NUM_CLASSES; ul++)
+	{
+		m_free_lists[ul] = NULL;
+	}
+}
+
+
+// dtor
+CMemoryPoolArena::~CMemoryPoolArena()
+{
+	GPOS_ASSERT(NULL == m_upstream);
+}
+
+
+// carve an allocation of the given total size off the current chunk
+void *
+CMemoryPoolArena::PvBump(ULONG alloc_size)
+{
+	if (static_cast<ULONG>(m_end - m_current) < alloc_size)
+	{
+		// the rest of the current chunk is abandoned
+		m_current = static_cast<BYTE *>(m_upstream->NewImpl(
+			m_chunk_size, __FILE__, __LINE__, CMemoryPool::EatSingleton));
+		m_end = m_current + m_chunk_size;
+
+		if (GPOS_MEM_ARENA_MAX_CHUNK_SIZE > m_chunk_size)
+		{
+			m_chunk_size *= 2;
+		}
+	}
+
+	void *ptr = m_current;
+	m_current += alloc_size;
+
+	return ptr;
+}
+
+
+void *
+CMemoryPoolArena::NewImpl(const ULONG bytes, const CHAR *file,
+						  const ULONG line, CMemoryPool::EAllocationType)
+{
+	GPOS_ASSERT(bytes <= GPOS_MEM_ALLOC_MAX);
+	GPOS_ASSERT(NULL != m_upstream);
+
+	SAllocHeader *header = NULL;
+	if (GPOS_MEM_ARENA_MAX_CLASS_SIZE < bytes)
+	{
+		header = static_cast<SAllocHeader *>(
+			m_upstream->NewImpl(GPOS_MEM_ARENA_HEADER_SIZE + bytes, file, line,
+								CMemoryPool::EatSingleton));
+	}
+	else
+	{
+		ULONG size_class = SizeClass(bytes);
+		void *user_data = m_free_lists[size_class];
+		if (NULL != user_data)
+		{
+			m_free_lists[size_class] = *static_cast<void **>(user_data);
+			header = static_cast<SAllocHeader *>(user_data) - 1;
+		}
+		else
+		{
+			header = static_cast<SAllocHeader *>(
+				PvBump(GPOS_MEM_ARENA_HEADER_SIZE +
+					   (size_class + 1) * GPOS_MEM_ARCH));
+		}
+	}
+
+	header->m_mp = this;
+	header->m_tagged_size = ((ULONG_PTR) bytes << 1) | 1;
+
+	void *ptr_result = header + 1;
+
+#ifdef GPOS_DEBUG
+	clib::Memset(ptr_result, GPOS_MEM_INIT_PATTERN_CHAR, bytes);
+	m_num_live++;
+#endif	// GPOS_DEBUG
+
+	return ptr_result;
+}
+
+
+// return the given allocation to its free list or to the upstream pool
+void
+CMemoryPoolArena::Free(SAllocHeader *header)
+{
+	GPOS_ASSERT(this == header->m_mp);
+
+	ULONG user_size = (ULONG)(header->m_tagged_size >> 1);
+	void *user_data = header + 1;
+
+#ifdef GPOS_DEBUG
+	// mark user memory as unused in debug mode
+	clib::Memset(user_data, GPOS_MEM_FREED_PATTERN_CHAR, user_size);
+
+	GPOS_ASSERT(0 < m_num_live);
+	m_num_live--;
+#endif	// GPOS_DEBUG
+
+	if (GPOS_MEM_ARENA_MAX_CLASS_SIZE < user_size)
+	{
+		CMemoryPool::DeleteImpl(header, CMemoryPool::EatSingleton);
+		return;
+	}
+
+	// freed allocations keep their header, and link the free list through
+	// their first word
+	ULONG size_class = SizeClass(user_size);
+	*static_cast<void **>(user_data) = m_free_lists[size_class];
+	m_free_lists[size_class] = user_data;
+}
+
+
+// free memory allocation
+void
+CMemoryPoolArena::DeleteImpl(void *ptr, EAllocationType)
+{
+	GPOS_ASSERT(IsArenaAllocation(ptr));
+
+	SAllocHeader *header = static_cast<SAllocHeader *>(ptr) - 1;
+	header->m_mp->Free(header);
+}
+
+
+// get user requested size of allocation
+ULONG
+CMemoryPoolArena::UserSizeOfAlloc(const void *ptr)
+{
+	GPOS_ASSERT(IsArenaAllocation(ptr));
+
+	const SAllocHeader *header = static_cast<const SAllocHeader *>(ptr) - 1;
+	return (ULONG)(header->m_tagged_size >> 1);
+}
+
+
+// total allocated size, as seen by the upstream pool
+ULLONG
+CMemoryPoolArena::TotalAllocatedSize() const
+{
+	return m_upstream->TotalAllocatedSize();
+}
+
+
+// largest total allocated size so far, as seen by the upstream pool
+ULLONG
+CMemoryPoolArena::PeakAllocatedSize() const
+{
+	return m_upstream->PeakAllocatedSize();
+}
+
+
+#ifdef GPOS_DEBUG
+
+// check that all allocations have been freed
+void
+CMemoryPoolArena::AssertEmpty(IOstream &os)
+{
+	if (0 != m_num_live && NULL != ITask::Self() &&
+		!GPOS_FTRACE(EtraceDisablePrintMemoryLeak))
+	{
+		os << "Unfreed memory in memory pool " << (void *) this << ": "
+		   << m_num_live << " objects leaked" << std::endl;
+
+		GPOS_ASSERT(!"leak detected");
+	}
+}
+
+#endif	// GPOS_DEBUG
+
+
+// Prepare the memory pool to be deleted; releases all chunks and large
+// allocations at once by tearing down the upstream pool
+void
+CMemoryPoolArena::TearDown()
+{
+	m_upstream->TearDown();
+	GPOS_DELETE(m_upstream);
+	m_upstream = NULL;
+
+	m_current = NULL;
+	m_end = NULL;
+}
+
+// EOF
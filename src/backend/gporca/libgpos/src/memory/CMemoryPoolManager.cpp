@@ -17,6 +17,7 @@
 #include "gpos/task/CAutoTraceFlag.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/memory/CMemoryPool.h"
+#include "gpos/memory/CMemoryPoolArena.h"
 #include "gpos/memory/CMemoryPoolManager.h"
 #include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
@@ -81,7 +82,43 @@ CMemoryPool *
 CMemoryPoolManager::CreateMemoryPool()
 {
 	CMemoryPool *mp = NewMemoryPool();
+	RegisterMemoryPool(mp);
 
+	return mp;
+}
+
+
+// Create a new arena on top of a new pool of the managed type; only the arena
+// is registered with the manager
+CMemoryPool *
+CMemoryPoolManager::CreateArenaMemoryPool()
+{
+	CMemoryPool *upstream = NewMemoryPool();
+	CMemoryPool *mp = NULL;
+
+	GPOS_TRY
+	{
+		mp = GPOS_NEW(m_internal_memory_pool) CMemoryPoolArena(upstream);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		upstream->TearDown();
+		GPOS_DELETE(upstream);
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	RegisterMemoryPool(mp);
+
+	return mp;
+}
+
+
+// Add given memory pool to the pools maintained by the manager
+void
+CMemoryPoolManager::RegisterMemoryPool(CMemoryPool *mp)
+{
 	// accessor scope
 	{
 		// HERE BE DRAGONS
@@ -90,8 +127,6 @@ CMemoryPoolManager::CreateMemoryPool()
 		MemoryPoolKeyAccessor acc(*m_ht_all_pools, hashKey);
 		acc.Insert(mp);
 	}
-
-	return mp;
 }
 
 
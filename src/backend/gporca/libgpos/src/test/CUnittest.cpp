@@ -14,6 +14,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CAutoTimer.h"
+#include "gpos/common/CBitVector.h"
 #include "gpos/common/clibwrapper.h"
 #include "gpos/error/CErrorHandlerStandard.h"
 #include "gpos/memory/CAutoMemoryPool.h"
@@ -52,7 +52,7 @@ public:
 	~IDatum() override = default;
 
 	// accessor for datum type
-	virtual IMDType::ETypeInfo GetDatumType() = 0;
+	virtual IMDType::ETypeInfo GetDatumType() const = 0;
 
 	// accessor of metadata id
 	virtual IMDId *MDId() const = 0;
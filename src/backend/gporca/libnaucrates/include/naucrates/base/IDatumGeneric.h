@@ -41,7 +41,7 @@ public:
 
 	// accessor for datum type
 	IMDType::ETypeInfo
-	GetDatumType() override
+	GetDatumType() const override
 	{
 		return IMDType::EtiGeneric;
 	}
@@ -38,7 +38,7 @@ public:
 
 	// accessor for datum type
 	IMDType::ETypeInfo
-	GetDatumType() override
+	GetDatumType() const override
 	{
 		return IMDType::EtiInt4;
 	}
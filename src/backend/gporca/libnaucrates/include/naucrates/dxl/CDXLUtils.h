@@ -71,7 +71,16 @@ private:
 		CMemoryPool *, const CWStringBase *dxl_string,
 		const CHAR *xsd_file_path);
 
+	// serialize a plan with the given serializer
+	static void SerializePlan(CMemoryPool *mp, CXMLSerializer *xml_serializer,
+							  const CDXLNode *node, ULLONG plan_id,
+							  ULLONG plan_space_size,
+							  BOOL serialize_document_header_footer);
 
+	// serialize a metadata object with the given serializer
+	static void SerializeMDObj(CMemoryPool *mp, CXMLSerializer *xml_serializer,
+							   const IMDCacheObject *imd_cache_obj,
+							   BOOL serialize_document_header_footer);
 
 public:
 	// helper functions for serializing DXL document header and footer, respectively
@@ -83,10 +92,21 @@ public:
 	static CParseHandlerDXL *GetParseHandlerForDXLString(
 		CMemoryPool *, const CHAR *dxl_string, const CHAR *xsd_file_path);
 
+	// same as above but for a document of the given length, which may be
+	// a binary one
+	static CParseHandlerDXL *GetParseHandlerForDXLString(
+		CMemoryPool *, const CHAR *dxl_string, ULONG length,
+		const CHAR *xsd_file_path);
+
 	// same as above but with DXL file name specified instead of the file contents
 	static CParseHandlerDXL *GetParseHandlerForDXLFile(
 		CMemoryPool *, const CHAR *dxl_filename, const CHAR *xsd_file_path);
 
+	// same as above but for a binary DXL document
+	static CParseHandlerDXL *GetParseHandlerForDXLBinary(CMemoryPool *,
+														 const BYTE *data,
+														 ULONG length);
+
 	// parse a DXL document containing a DXL plan
 	static CDXLNode *GetPlanDXLNode(CMemoryPool *, const CHAR *dxl_string,
 									const CHAR *xsd_file_path, ULLONG *plan_id,
@@ -170,6 +190,12 @@ public:
 							  BOOL serialize_document_header_footer,
 							  BOOL indentation);
 
+	// serialize a plan into a binary DXL document, released by the caller
+	// with GPOS_DELETE_ARRAY
+	static BYTE *SerializePlanToBinary(CMemoryPool *mp, const CDXLNode *node,
+									   ULLONG plan_id, ULLONG plan_space_size,
+									   ULONG *length);
+
 	static CWStringDynamic *SerializeStatistics(
 		CMemoryPool *mp, CMDAccessor *md_accessor,
 		const CStatisticsArray *statistics_array, BOOL serialize_header_footer,
@@ -218,6 +244,21 @@ public:
 		CMemoryPool *, const IMDCacheObject *,
 		BOOL serialize_document_header_footer, BOOL indentation);
 
+	// serialize a metadata object into a binary DXL document, released by
+	// the caller with GPOS_DELETE_ARRAY
+	static BYTE *SerializeMDObjToBinary(CMemoryPool *mp,
+										const IMDCacheObject *imd_cache_obj,
+										ULONG *length);
+
+	// convert an XML DXL document into a binary one
+	static BYTE *ConvertXMLToBinary(CMemoryPool *mp, const CHAR *dxl_string,
+									ULONG *length);
+
+	// convert a binary DXL document into an XML one
+	static CWStringDynamic *ConvertBinaryToXML(CMemoryPool *mp,
+											   const BYTE *data, ULONG length,
+											   BOOL indentation);
+
 	// serialize a scalar expression into DXL
 	static CWStringDynamic *SerializeScalarExpr(
 		CMemoryPool *mp, const CDXLNode *node,
@@ -48,7 +48,8 @@ private:
 	// the memory manager used for parsing the current document
 	CDXLMemoryManager *m_dxl_memory_manager;
 
-	// parser object responsible for parsing the current XML document
+	// parser object responsible for parsing the current XML document; NULL
+	// for binary documents, whose events are replayed to GetContentHandler()
 	SAX2XMLReader *m_xml_reader;
 
 	// current parse handler
@@ -63,6 +64,9 @@ private:
 	// check for aborts at regular intervals
 	void CheckForAborts();
 
+	// direct the events of the XML reader to the given handler
+	void SetReaderHandler(CParseHandlerBase *parse_handler_base);
+
 
 public:
 	CParseHandlerManager(const CParseHandlerManager &) = delete;
@@ -97,6 +101,9 @@ public:
 
 	// Returns the current parse handler if one exists; used for debugging purposes
 	const CParseHandlerBase *GetCurrentParseHandler();
+
+	// returns the handler receiving the parse events
+	CParseHandlerBase *GetContentHandler();
 };
 }  // namespace gpdxl
 #endif	// !GPDXL_CParseHandlerManager_H
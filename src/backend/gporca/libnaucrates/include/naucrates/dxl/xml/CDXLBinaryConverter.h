@@ -0,0 +1,83 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryConverter.h
+//
+//	@doc:
+//		SAX handler converting XML DXL documents to binary ones.
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CDXLBinaryConverter_H
+#define GPDXL_CDXLBinaryConverter_H
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
+
+#include <xercesc/sax2/DefaultHandler.hpp>
+
+namespace gpdxl
+{
+using namespace gpos;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryConverter
+//
+//	@doc:
+//		Receives the elements of an XML DXL document from the XML parser and
+//		writes them to a binary writer. Namespace declarations are kept as
+//		attributes, so that converting the result back gives a document
+//		equivalent to the original one.
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryConverter : public DefaultHandler
+{
+private:
+	// writer of the binary document
+	CDXLBinaryWriter *m_binary_writer;
+
+	// qualified name of the current element or attribute
+	CWStringDynamic m_qname;
+
+	// namespace prefix of the current element
+	CWStringDynamic m_ns;
+
+	// local name of the current element
+	CWStringDynamic m_name;
+
+	// value of the current attribute
+	CWStringDynamic m_value;
+
+	// split the given qualified name into m_ns and m_name; returns false if
+	// it has no namespace prefix
+	BOOL FSplitName(const XMLCh *const qname);
+
+public:
+	CDXLBinaryConverter(const CDXLBinaryConverter &) = delete;
+
+	// ctor
+	CDXLBinaryConverter(CMemoryPool *mp, CDXLBinaryWriter *binary_writer);
+
+	// process the opening tag of an XML element
+	void startElement(const XMLCh *const element_uri,
+					  const XMLCh *const element_local_name,
+					  const XMLCh *const element_qname,
+					  const Attributes &attr) override;
+
+	// process the closing tag of an XML element
+	void endElement(const XMLCh *const element_uri,
+					const XMLCh *const element_local_name,
+					const XMLCh *const element_qname) override;
+};
+
+}  // namespace gpdxl
+
+#endif	//!GPDXL_CDXLBinaryConverter_H
+
+// EOF
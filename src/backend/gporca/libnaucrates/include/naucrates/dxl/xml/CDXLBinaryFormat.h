@@ -0,0 +1,84 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryFormat.h
+//
+//	@doc:
+//		Layout of binary DXL documents.
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CDXLBinaryFormat_H
+#define GPDXL_CDXLBinaryFormat_H
+
+#include "gpos/base.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryFormat
+//
+//	@doc:
+//		Binary DXL documents carry the same elements and attributes as their
+//		XML counterparts, in a form that can be replayed to the DXL parse
+//		handlers without an XML parser.
+//
+//		A document is a sequence of 32-bit words in native byte order. It
+//		starts with a header of EdxlbinHeaderWords words: the magic bytes,
+//		a byte order mark, the format version, the length of the document
+//		in bytes, the number of names and the offset of the name table.
+//		The elements follow, each encoded as
+//
+//		[EdxlbinOpen] [name id] [namespace id] [number of attributes]
+//		[name id] [value] ... for each attribute
+//		... child elements
+//		[EdxlbinClose] [name id] [namespace id]
+//
+//		Element and attribute names are interned. The name table at the end
+//		of the document holds each of them once, as a string; names are
+//		referred to by their position in the table. Strings are stored as
+//		their length in UTF-16 code units, followed by the NUL-terminated
+//		code units, padded to a word boundary. This lets the reader hand
+//		names and values to the parse handlers without copying them.
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryFormat
+{
+public:
+	// record kinds
+	enum ERecord
+	{
+		EdxlbinOpen = 1,
+		EdxlbinClose
+	};
+
+	// layout constants
+	enum EConst
+	{
+		EdxlbinVersion = 1,
+		EdxlbinByteOrderMark = 0x01020304,
+		EdxlbinHeaderWords = 6,
+		EdxlbinNoNamespace = 0xffffffff
+	};
+
+	// magic bytes starting a binary document
+	static const BYTE m_magic[4];
+
+	// does the given buffer start like a binary DXL document?
+	static BOOL
+	IsBinary(const BYTE *data, ULONG length)
+	{
+		return GPOS_ARRAY_SIZE(m_magic) <= length &&
+			   0 == clib::Memcmp(data, m_magic, GPOS_ARRAY_SIZE(m_magic));
+	}
+};
+
+}  // namespace gpdxl
+
+#endif	//!GPDXL_CDXLBinaryFormat_H
+
+// EOF
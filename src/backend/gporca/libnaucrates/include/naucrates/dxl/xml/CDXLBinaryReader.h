@@ -0,0 +1,190 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryReader.h
+//
+//	@doc:
+//		Class for reading binary DXL documents.
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CDXLBinaryReader_H
+#define GPDXL_CDXLBinaryReader_H
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/util/XercesDefs.hpp>
+
+namespace gpdxl
+{
+using namespace gpos;
+
+XERCES_CPP_NAMESPACE_USE
+
+// fwd decl
+class CParseHandlerManager;
+class CXMLSerializer;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryAttributes
+//
+//	@doc:
+//		Attributes of an element of a binary DXL document, pointing into the
+//		document itself
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryAttributes : public Attributes
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// attribute names
+	const XMLCh **m_names;
+
+	// attribute values
+	const XMLCh **m_values;
+
+	// number of attributes
+	ULONG m_length;
+
+	// number of attributes there is room for
+	ULONG m_capacity;
+
+public:
+	CDXLBinaryAttributes(const CDXLBinaryAttributes &) = delete;
+
+	// ctor/dtor
+	explicit CDXLBinaryAttributes(CMemoryPool *mp);
+
+	~CDXLBinaryAttributes() override;
+
+	// remove all attributes
+	void
+	Reset()
+	{
+		m_length = 0;
+	}
+
+	// add an attribute
+	void Append(const XMLCh *name, const XMLCh *value);
+
+	// Attributes interface; attributes carry no namespace and are all of
+	// type CDATA
+	XMLSize_t getLength() const override;
+
+	const XMLCh *getURI(const XMLSize_t index) const override;
+
+	const XMLCh *getLocalName(const XMLSize_t index) const override;
+
+	const XMLCh *getQName(const XMLSize_t index) const override;
+
+	const XMLCh *getType(const XMLSize_t index) const override;
+
+	const XMLCh *getValue(const XMLSize_t index) const override;
+
+	bool getIndex(const XMLCh *const uri, const XMLCh *const local_part,
+				  XMLSize_t &index) const override;
+
+	int getIndex(const XMLCh *const uri,
+				 const XMLCh *const local_part) const override;
+
+	bool getIndex(const XMLCh *const qname, XMLSize_t &index) const override;
+
+	int getIndex(const XMLCh *const qname) const override;
+
+	const XMLCh *getType(const XMLCh *const uri,
+						 const XMLCh *const local_part) const override;
+
+	const XMLCh *getType(const XMLCh *const qname) const override;
+
+	const XMLCh *getValue(const XMLCh *const uri,
+						  const XMLCh *const local_part) const override;
+
+	const XMLCh *getValue(const XMLCh *const qname) const override;
+};
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryReader
+//
+//	@doc:
+//		Reads a binary DXL document (see CDXLBinaryFormat), either replaying
+//		it to the DXL parse handlers the way the XML parser does, or
+//		converting it back to XML. Names and attribute values are handed out
+//		as pointers into the document, which is therefore only copied when
+//		it is not suitably aligned. Malformed documents raise
+//		ExmiDXLBinaryParseError.
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryReader
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// the document
+	const BYTE *m_data;
+
+	// aligned copy of the document, if one had to be made
+	BYTE *m_copy;
+
+	// length of the document in bytes
+	ULONG m_length;
+
+	// names, indexed by their ids
+	const XMLCh **m_names;
+
+	// number of names
+	ULONG m_num_names;
+
+	// offset of the name table, which ends the elements
+	ULONG m_names_offset;
+
+	// attributes of the element being read
+	CDXLBinaryAttributes *m_attrs;
+
+	// read the word at the given offset and advance past it
+	ULONG ReadWord(ULONG *offset) const;
+
+	// read the string at the given offset and advance past it
+	const XMLCh *ReadString(ULONG *offset) const;
+
+	// read the name id at the given offset and advance past it
+	ULONG ReadNameId(ULONG *offset) const;
+
+	// read the namespace id at the given offset and advance past it
+	ULONG ReadNamespaceId(ULONG *offset) const;
+
+	// read the attributes of an element into m_attrs
+	void ReadAttributes(ULONG *offset);
+
+public:
+	CDXLBinaryReader(const CDXLBinaryReader &) = delete;
+
+	// ctor/dtor
+	CDXLBinaryReader(CMemoryPool *mp, const BYTE *data, ULONG length);
+
+	~CDXLBinaryReader();
+
+	// replay the document to the parse handlers of the given manager
+	void Parse(CParseHandlerManager *parse_handler_mgr);
+
+	// write the document as XML
+	void Serialize(CXMLSerializer *xml_serializer);
+
+	// append the given UTF-16 string to the given GPOS string
+	static void AppendXMLCh(CWStringDynamic *str, const XMLCh *xmlch);
+};
+
+}  // namespace gpdxl
+
+#endif	//!GPDXL_CDXLBinaryReader_H
+
+// EOF
@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryWriter.h
+//
+//	@doc:
+//		Class for creating binary DXL documents.
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CDXLBinaryWriter_H
+#define GPDXL_CDXLBinaryWriter_H
+
+#include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/string/CWStringConst.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryWriter
+//
+//	@doc:
+//		Encodes a stream of elements and attributes as a binary DXL document
+//		(see CDXLBinaryFormat). Used by CXMLSerializer to write binary DXL
+//		instead of XML, and to convert XML documents to binary ones.
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryWriter
+{
+private:
+	// hash function for names
+	static ULONG HashName(const CWStringConst *str);
+
+	// equality function for names
+	static BOOL EqualNames(const CWStringConst *str1,
+						   const CWStringConst *str2);
+
+	// map from names to their ids
+	typedef CHashMap<CWStringConst, ULONG, HashName, EqualNames,
+					 CleanupDelete<CWStringConst>, CleanupDelete<ULONG> >
+		NameToIdMap;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CBuffer
+	//
+	//	@doc:
+	//		Growing buffer of words
+	//
+	//---------------------------------------------------------------------------
+	class CBuffer
+	{
+	private:
+		// memory pool
+		CMemoryPool *m_mp;
+
+		// buffer
+		BYTE *m_data;
+
+		// size of the allocated buffer in bytes
+		ULONG m_capacity;
+
+		// length of the content in bytes
+		ULONG m_length;
+
+	public:
+		CBuffer(const CBuffer &) = delete;
+
+		// ctor/dtor
+		CBuffer(CMemoryPool *mp, ULONG capacity);
+
+		~CBuffer();
+
+		// make room for the given number of bytes
+		void Reserve(ULONG length);
+
+		// append a word
+		void AppendWord(ULONG word);
+
+		// append a string
+		void AppendString(const WCHAR *wsz, ULONG length);
+
+		// append the content of another buffer
+		void Append(const CBuffer *buffer);
+
+		// overwrite the word at the given offset
+		void SetWord(ULONG offset, ULONG word);
+
+		// read the word at the given offset
+		ULONG GetWord(ULONG offset) const;
+
+		// length of the content in bytes
+		ULONG
+		Length() const
+		{
+			return m_length;
+		}
+
+		// hand the content over to the caller
+		BYTE *Detach();
+	};
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// header and elements
+	CBuffer *m_elements;
+
+	// name table
+	CBuffer *m_names;
+
+	// ids of the names defined so far
+	NameToIdMap *m_name_ids;
+
+	// number of names defined so far
+	ULONG m_num_names;
+
+	// offset of the attribute count of the open element, if attributes can
+	// still be added to it
+	ULONG m_attr_count_offset;
+
+	// name id of the attribute being written
+	ULONG m_attr_name_id;
+
+	// value of the attribute being written
+	CWStringDynamic *m_attr_value;
+
+	// stream writing into the attribute value
+	COstreamString *m_attr_value_os;
+
+	// id of the given name, defining it if needed
+	ULONG NameId(const CWStringBase *name);
+
+public:
+	CDXLBinaryWriter(const CDXLBinaryWriter &) = delete;
+
+	// ctor/dtor
+	explicit CDXLBinaryWriter(CMemoryPool *mp);
+
+	~CDXLBinaryWriter();
+
+	// start an element; pass NULL for elements without namespace
+	void OpenElement(const CWStringBase *ns, const CWStringBase *name);
+
+	// end the last open element
+	void CloseElement(const CWStringBase *ns, const CWStringBase *name);
+
+	// add an attribute to the element just opened
+	void AddAttribute(const CWStringBase *name, const CWStringBase *value);
+
+	// start an attribute of the element just opened, whose value is written
+	// to AttributeValueStream()
+	void StartAttribute(const CWStringBase *name);
+
+	// finish the attribute started last
+	void EndAttribute();
+
+	// stream receiving the value of the attribute being written
+	IOstream &
+	AttributeValueStream()
+	{
+		return *m_attr_value_os;
+	}
+
+	// finish the document and hand it over to the caller, who releases it
+	// with GPOS_DELETE_ARRAY
+	BYTE *GetDocument(ULONG *length);
+};
+
+}  // namespace gpdxl
+
+#endif	//!GPDXL_CDXLBinaryWriter_H
+
+// EOF
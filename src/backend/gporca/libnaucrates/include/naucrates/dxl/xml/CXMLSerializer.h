@@ -18,6 +18,7 @@
 #include "gpos/io/COstream.h"
 
 #include "gpos/common/CStack.h"
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 
 namespace gpdxl
@@ -29,7 +30,8 @@ using namespace gpos;
 //		CXMLSerializer
 //
 //	@doc:
-//		Class for creating XML documents.
+//		Class for creating XML documents. When given a binary writer, the
+//		elements and attributes are encoded as a binary DXL document instead.
 //
 //---------------------------------------------------------------------------
 class CXMLSerializer
@@ -41,9 +43,13 @@ private:
 	// memory pool
 	CMemoryPool *m_mp;
 
-	// output stream for writing out the xml document
+	// output stream for writing out the xml document; for binary documents,
+	// the stream receiving attribute values
 	IOstream &m_os;
 
+	// writer of the binary document, NULL when writing XML
+	CDXLBinaryWriter *m_binary_writer;
+
 	// should XML document be indented
 	BOOL m_indentation;
 
@@ -65,6 +71,12 @@ private:
 	// escape the given string and write it to the given stream
 	static void WriteEscaped(IOstream &os, const CWStringBase *str);
 
+	// start an attribute, whose value is then written to m_os
+	void StartAttribute(const CWStringBase *pstrAttr);
+
+	// finish the attribute started last
+	void EndAttribute();
+
 public:
 	CXMLSerializer(const CXMLSerializer &) = delete;
 
@@ -72,6 +84,7 @@ public:
 	CXMLSerializer(CMemoryPool *mp, IOstream &os, BOOL indentation = true)
 		: m_mp(mp),
 		  m_os(os),
+		  m_binary_writer(NULL),
 		  m_indentation(indentation),
 		  m_strstackElems(NULL),
 		  m_fOpenTag(false),
@@ -81,6 +94,20 @@ public:
 		m_strstackElems = GPOS_NEW(m_mp) StrStack(m_mp);
 	}
 
+	// ctor for serializers writing binary documents
+	CXMLSerializer(CMemoryPool *mp, CDXLBinaryWriter *binary_writer)
+		: m_mp(mp),
+		  m_os(binary_writer->AttributeValueStream()),
+		  m_binary_writer(binary_writer),
+		  m_indentation(false),
+		  m_strstackElems(NULL),
+		  m_fOpenTag(false),
+		  m_ulLevel(0),
+		  m_iteration_since_last_abortcheck(0)
+	{
+		m_strstackElems = GPOS_NEW(m_mp) StrStack(m_mp);
+	}
+
 	~CXMLSerializer();
 
 	// get underlying memory pool
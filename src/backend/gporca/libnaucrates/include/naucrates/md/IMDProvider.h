@@ -28,6 +28,8 @@ namespace gpmd
 {
 using namespace gpos;
 
+class IMDCacheObject;
+
 //---------------------------------------------------------------------------
 //	@class:
 //		IMDProvider
@@ -51,6 +53,11 @@ public:
 										 CMDAccessor *md_accessor,
 										 IMDId *mdid) const = 0;
 
+	// returns the requested metadata object, allocated in the given memory
+	// pool; by default, the object is parsed from its DXL string
+	virtual IMDCacheObject *GetMDObj(CMemoryPool *mp, CMDAccessor *md_accessor,
+									 IMDId *mdid) const;
+
 	// return the mdid for the specified system id and type
 	virtual IMDId *MDId(CMemoryPool *mp, CSystemId sysid,
 						IMDType::ETypeInfo type_info) const = 0;
@@ -125,6 +125,15 @@ private:
 	CHistogram *MakeJoinHistogramEqualityFilter(
 		const CHistogram *histogram) const;
 
+	// check if the equality join of the given histograms can run on the
+	// columnar form of their buckets
+	static BOOL IsColumnarJoinSupported(const CHistogram *histogram1,
+										const CHistogram *histogram2);
+
+	// equality join on the columnar form of the buckets
+	CHistogram *MakeColumnarJoinHistogramEqualityFilter(
+		const CHistogram *histogram) const;
+
 	// generate histogram based on NDV
 	CHistogram *MakeNDVBasedJoinHistogramEqualityFilter(
 		const CHistogram *histogram) const;
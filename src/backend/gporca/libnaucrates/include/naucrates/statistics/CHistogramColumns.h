@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CHistogramColumns.h
+//
+//	@doc:
+//		Columnar form of histogram buckets, for types whose stats mapping
+//		is a LINT
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CHistogramColumns_H
+#define GPNAUCRATES_CHistogramColumns_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+
+#include "naucrates/statistics/CBucket.h"
+
+namespace gpnaucrates
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CHistogramColumns
+//
+//	@doc:
+//		Buckets of a histogram as parallel arrays of the LINT mappings of
+//		their bounds, their closedness, frequencies and NDVs. Bucket
+//		comparisons on these arrays are plain integer comparisons, instead
+//		of the virtual datum calls CPoint makes, and give the same results
+//		for bounds that are all LINT mappable datums of one type. The
+//		points of the bounds are kept, without a reference, to convert
+//		buckets back to CBucket objects
+//
+//---------------------------------------------------------------------------
+class CHistogramColumns
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// maximum number of buckets
+	ULONG m_capacity;
+
+	// number of buckets
+	ULONG m_size;
+
+	// LINT mappings of the bounds
+	LINT *m_lower_bounds;
+	LINT *m_upper_bounds;
+
+	// closedness of the bounds
+	BOOL *m_is_lower_closed;
+	BOOL *m_is_upper_closed;
+
+	// frequencies and NDVs
+	DOUBLE *m_frequencies;
+	DOUBLE *m_distincts;
+
+	// points of the bounds
+	CPoint **m_lower_points;
+	CPoint **m_upper_points;
+
+	// append a bucket
+	void Append(LINT lower_bound, LINT upper_bound, BOOL is_lower_closed,
+				BOOL is_upper_closed, CDouble frequency, CDouble distinct,
+				CPoint *lower_point, CPoint *upper_point);
+
+	// is the given bucket a singleton?
+	BOOL
+	IsSingleton(ULONG ul) const
+	{
+		return m_lower_bounds[ul] == m_upper_bounds[ul];
+	}
+
+	// width of the given bucket
+	CDouble Width(ULONG ul) const;
+
+	// does the given bucket contain the given value?
+	BOOL Contains(ULONG ul, LINT value) const;
+
+	// does the bucket of the first columns subsume that of the second?
+	static BOOL Subsumes(const CHistogramColumns *columns1, ULONG ul1,
+						 const CHistogramColumns *columns2, ULONG ul2);
+
+	// do the given buckets intersect?
+	static BOOL Intersects(const CHistogramColumns *columns1, ULONG ul1,
+						   const CHistogramColumns *columns2, ULONG ul2);
+
+	// compare lower bounds, as CBucket::CompareLowerBounds
+	static INT CompareLowerBounds(const CHistogramColumns *columns1, ULONG ul1,
+								  const CHistogramColumns *columns2,
+								  ULONG ul2);
+
+	// compare upper bounds, as CBucket::CompareUpperBounds
+	static INT CompareUpperBounds(const CHistogramColumns *columns1, ULONG ul1,
+								  const CHistogramColumns *columns2,
+								  ULONG ul2);
+
+	// compare a lower bound to an upper bound, as
+	// CBucket::CompareLowerBoundToUpperBound
+	static INT CompareLowerBoundToUpperBound(const CHistogramColumns *columns1,
+											 ULONG ul1,
+											 const CHistogramColumns *columns2,
+											 ULONG ul2);
+
+	// append the intersection of the given buckets, as
+	// CBucket::MakeBucketIntersect
+	void AppendIntersect(const CHistogramColumns *columns1, ULONG ul1,
+						 const CHistogramColumns *columns2, ULONG ul2,
+						 CDouble *result_freq_intersect1,
+						 CDouble *result_freq_intersect2);
+
+public:
+	CHistogramColumns(const CHistogramColumns &) = delete;
+
+	// ctor for empty columns with room for the given number of buckets
+	CHistogramColumns(CMemoryPool *mp, ULONG capacity);
+
+	// ctor for the columns of the given buckets
+	CHistogramColumns(CMemoryPool *mp, const CBucketArray *buckets);
+
+	// dtor
+	~CHistogramColumns();
+
+	// number of buckets
+	ULONG
+	Size() const
+	{
+		return m_size;
+	}
+
+	// can the given buckets be put in columns, with bounds of the given type?
+	static BOOL IsSupported(const CBucketArray *buckets, const IMDId *mdid);
+
+	// convert back to an array of buckets sharing the points of the bounds
+	CBucketArray *MakeBuckets(CMemoryPool *mp) const;
+
+	// equi-join the given columns, as in
+	// CHistogram::MakeJoinHistogramEqualityFilter; returns the columns of
+	// the join buckets and the frequencies of the joining input buckets
+	static CHistogramColumns *MakeJoinEqualityFilter(
+		CMemoryPool *mp, const CHistogramColumns *columns1,
+		const CHistogramColumns *columns2, CDouble *result_buckets_freq1,
+		CDouble *result_buckets_freq2);
+
+};	// class CHistogramColumns
+}  // namespace gpnaucrates
+
+#endif	// !GPNAUCRATES_CHistogramColumns_H
+
+// EOF
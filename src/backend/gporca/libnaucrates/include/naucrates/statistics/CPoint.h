@@ -32,6 +32,11 @@ using namespace gpopt;
 //
 //	@doc:
 //		One dimensional point in the datum space
+//
+//		Points are compared in the inner loops of histogram filtering and
+//		bucket intersection. The LINT or double mapping of the datum is
+//		resolved once, on the first comparison, and later comparisons use
+//		the resolved values instead of calls into the datum.
 //---------------------------------------------------------------------------
 class CPoint : public CRefCount
 {
@@ -39,6 +44,42 @@ private:
 	// datum corresponding to the point
 	IDatum *m_datum;
 
+	// is the stats mapping of the datum resolved
+	mutable BOOL m_is_resolved;
+
+	// is the datum null
+	mutable BOOL m_is_null;
+
+	// can the datum be mapped to LINT, resp. double
+	mutable BOOL m_is_lint_mappable;
+	mutable BOOL m_is_double_mappable;
+
+	// is the datum of a time-related type
+	mutable BOOL m_is_time_related;
+
+	// mapping of a non-null datum
+	mutable LINT m_lint_value;
+	mutable CDouble m_double_value;
+
+	// resolve the stats mapping of the datum
+	void ResolveStatsMapping() const;
+
+	// resolve the stats mapping of the datum, unless already done
+	void
+	EnsureStatsMapping() const
+	{
+		if (!m_is_resolved)
+		{
+			ResolveStatsMapping();
+		}
+	}
+
+	// can the two points be compared, same as IDatum::StatsAreComparable
+	BOOL StatsAreComparable(const CPoint *point) const;
+
+	// less-than on the mapped values, same as IDatum::StatsAreLessThan
+	BOOL StatsAreLessThan(const CPoint *point) const;
+
 public:
 	CPoint &operator=(CPoint &) = delete;
 
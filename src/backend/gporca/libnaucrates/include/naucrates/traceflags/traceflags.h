@@ -213,6 +213,15 @@ enum EOptTraceFlag
 	// Use legacy (cdbhash) opfamilies for compatibility
 	EopttraceUseLegacyOpfamilies = 103039,
 
+	// Look up and store plans in the plan cache
+	EopttraceEnablePlanCache = 103040,
+
+	// Pick the search strategy from the complexity of the query
+	EopttraceEnableAdaptiveSearchStrategy = 103041,
+
+	// Write minidumps and serialized plans as binary DXL
+	EopttraceBinaryDXL = 103042,
+
 	///////////////////////////////////////////////////////
 	///////////////////// statistics flags ////////////////
 	//////////////////////////////////////////////////////
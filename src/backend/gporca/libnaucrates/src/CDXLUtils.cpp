@@ -33,6 +33,8 @@
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
 #include "naucrates/dxl/parser/CParseHandlerDummy.h"
+#include "naucrates/dxl/xml/CDXLBinaryConverter.h"
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "gpopt/mdcache/CMDAccessor.h"
@@ -71,8 +73,37 @@ XERCES_CPP_NAMESPACE_USE
 CParseHandlerDXL *
 CDXLUtils::GetParseHandlerForDXLString(CMemoryPool *mp, const CHAR *dxl_string,
 									   const CHAR *xsd_file_path)
+{
+	GPOS_ASSERT(NULL != dxl_string);
+
+	return GetParseHandlerForDXLString(mp, dxl_string,
+									   clib::Strlen(dxl_string), xsd_file_path);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::GetParseHandlerForDXLString
+//
+//	@doc:
+//		Same as above, for a document of the given length. Binary documents
+//		contain NUL bytes, so they can only be parsed through this entry
+//		point; a binary document whose header disagrees with the given
+//		length is rejected.
+//
+//---------------------------------------------------------------------------
+CParseHandlerDXL *
+CDXLUtils::GetParseHandlerForDXLString(CMemoryPool *mp, const CHAR *dxl_string,
+									   ULONG length, const CHAR *xsd_file_path)
 {
 	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != dxl_string);
+
+	// binary documents are replayed without the XML parser
+	if (CDXLBinaryFormat::IsBinary((const BYTE *) dxl_string, length))
+	{
+		return GetParseHandlerForDXLBinary(mp, (const BYTE *) dxl_string,
+										   length);
+	}
 
 	// setup own memory manager
 	CDXLMemoryManager *memory_manager = GPOS_NEW(mp) CDXLMemoryManager(mp);
@@ -106,8 +137,8 @@ CDXLUtils::GetParseHandlerForDXLString(CMemoryPool *mp, const CHAR *dxl_string,
 	parse_handler_mgr->ActivateParseHandler(parse_handler_dxl);
 
 	MemBufInputSource *input_src_memory_buffer = new (memory_manager)
-		MemBufInputSource((const XMLByte *) dxl_string, strlen(dxl_string),
-						  "dxl test", false, memory_manager);
+		MemBufInputSource((const XMLByte *) dxl_string, length, "dxl test",
+						  false, memory_manager);
 
 	try
 	{
@@ -160,6 +191,31 @@ CDXLUtils::GetParseHandlerForDXLFile(CMemoryPool *mp, const CHAR *dxl_filename,
 {
 	GPOS_ASSERT(NULL != mp);
 
+	// binary documents, recognized by their magic bytes, are read whole and
+	// replayed without the XML parser
+	{
+		CFileReader fr;
+		fr.Open(dxl_filename);
+
+		BYTE magic[GPOS_ARRAY_SIZE(CDXLBinaryFormat::m_magic)];
+		ULONG_PTR read_bytes = fr.ReadBytesToBuffer(magic, GPOS_SIZEOF(magic));
+
+		if (CDXLBinaryFormat::IsBinary(magic, (ULONG) read_bytes))
+		{
+			ULONG_PTR file_size = (ULONG_PTR) fr.FileSize();
+			CAutoRg<BYTE> data(GPOS_NEW_ARRAY(mp, BYTE, file_size));
+			clib::Memcpy(data.Rgt(), magic, read_bytes);
+			read_bytes += fr.ReadBytesToBuffer(data.Rgt() + read_bytes,
+											   file_size - read_bytes);
+			fr.Close();
+
+			return GetParseHandlerForDXLBinary(mp, data.Rgt(),
+											   (ULONG) read_bytes);
+		}
+
+		fr.Close();
+	}
+
 	// setup own memory manager
 	CDXLMemoryManager mm(mp);
 	SAX2XMLReader *sax_2_xml_reader = NULL;
@@ -236,6 +292,42 @@ CDXLUtils::GetParseHandlerForDXLFile(CMemoryPool *mp, const CHAR *dxl_filename,
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::GetParseHandlerForDXLBinary
+//
+//	@doc:
+//		Replay the given binary DXL document to the parse handlers and return
+//		the top-level parser. Binary documents are not validated against the
+//		XSD schema.
+//
+//---------------------------------------------------------------------------
+CParseHandlerDXL *
+CDXLUtils::GetParseHandlerForDXLBinary(CMemoryPool *mp, const BYTE *data,
+									   ULONG length)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != data);
+
+	CAutoTimer at("\n[OPT]: Binary DXL Parsing Time",
+				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
+
+	CDXLBinaryReader binary_reader(mp, data, length);
+
+	// there is no XML reader for the handlers to register with
+	CDXLMemoryManager mm(mp);
+	CParseHandlerManager parse_handler_mgr(&mm, NULL);
+	CAutoP<CParseHandlerDXL> parse_handler_dxl(
+		CParseHandlerFactory::GetParseHandlerDXL(mp, &parse_handler_mgr));
+	parse_handler_mgr.ActivateParseHandler(parse_handler_dxl.Value());
+
+	binary_reader.Parse(&parse_handler_mgr);
+
+	GPOS_CHECK_ABORT;
+
+	return parse_handler_dxl.Reset();
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::GetParseHandlerForDXLString
@@ -895,32 +987,75 @@ CDXLUtils::SerializePlan(CMemoryPool *mp, IOstream &os, const CDXLNode *node,
 				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
 	CXMLSerializer xml_serializer(mp, os, indentation);
+	SerializePlan(mp, &xml_serializer, node, plan_id, plan_space_size,
+				  serialize_header_footer);
+}
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializePlanToBinary
+//
+//	@doc:
+//		Serialize a DXL tree into a binary DXL document
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLUtils::SerializePlanToBinary(CMemoryPool *mp, const CDXLNode *node,
+								 ULLONG plan_id, ULLONG plan_space_size,
+								 ULONG *length)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != node);
+
+	CAutoTimer at("\n[OPT]: Binary DXL Plan Serialization Time",
+				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
+
+	CDXLBinaryWriter binary_writer(mp);
+	CXMLSerializer xml_serializer(mp, &binary_writer);
+	SerializePlan(mp, &xml_serializer, node, plan_id, plan_space_size,
+				  true /* serialize_header_footer */);
+
+	return binary_writer.GetDocument(length);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializePlan
+//
+//	@doc:
+//		Serialize a DXL tree with the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializePlan(CMemoryPool *mp, CXMLSerializer *xml_serializer,
+						 const CDXLNode *node, ULLONG plan_id,
+						 ULLONG plan_space_size, BOOL serialize_header_footer)
+{
 	if (serialize_header_footer)
 	{
-		SerializeHeader(mp, &xml_serializer);
+		SerializeHeader(mp, xml_serializer);
 	}
 
-	xml_serializer.OpenElement(
+	xml_serializer->OpenElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenPlan));
 
 	// serialize plan id and space size attributes
 
-	xml_serializer.AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenPlanId),
-								plan_id);
-	xml_serializer.AddAttribute(
+	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenPlanId),
+								 plan_id);
+	xml_serializer->AddAttribute(
 		CDXLTokens::GetDXLTokenStr(EdxltokenPlanSpaceSize), plan_space_size);
 
-	node->SerializeToDXL(&xml_serializer);
+	node->SerializeToDXL(xml_serializer);
 
-	xml_serializer.CloseElement(
+	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenPlan));
 
 	if (serialize_header_footer)
 	{
-		SerializeFooter(&xml_serializer);
+		SerializeFooter(xml_serializer);
 	}
 }
 
@@ -1291,28 +1426,151 @@ CDXLUtils::SerializeMDObj(CMemoryPool *mp, const IMDCacheObject *imd_cache_obj,
 	COstreamString oss(string_var.Value());
 
 	CXMLSerializer xml_serializer(mp, oss, indentation);
+	SerializeMDObj(mp, &xml_serializer, imd_cache_obj,
+				   serialize_header_footer);
 
+	return string_var.Reset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializeMDObjToBinary
+//
+//	@doc:
+//		Serialize an MD object into a binary DXL document
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLUtils::SerializeMDObjToBinary(CMemoryPool *mp,
+								  const IMDCacheObject *imd_cache_obj,
+								  ULONG *length)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != imd_cache_obj);
+
+	CDXLBinaryWriter binary_writer(mp);
+	CXMLSerializer xml_serializer(mp, &binary_writer);
+	SerializeMDObj(mp, &xml_serializer, imd_cache_obj,
+				   true /* serialize_header_footer */);
+
+	return binary_writer.GetDocument(length);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializeMDObj
+//
+//	@doc:
+//		Serialize an MD object with the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializeMDObj(CMemoryPool *mp, CXMLSerializer *xml_serializer,
+						  const IMDCacheObject *imd_cache_obj,
+						  BOOL serialize_header_footer)
+{
 	if (serialize_header_footer)
 	{
-		SerializeHeader(mp, &xml_serializer);
-		xml_serializer.OpenElement(
+		SerializeHeader(mp, xml_serializer);
+		xml_serializer->OpenElement(
 			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 			CDXLTokens::GetDXLTokenStr(EdxltokenMetadata));
 	}
 	GPOS_CHECK_ABORT;
 
-	imd_cache_obj->Serialize(&xml_serializer);
+	imd_cache_obj->Serialize(xml_serializer);
 	GPOS_CHECK_ABORT;
 
 	if (serialize_header_footer)
 	{
-		xml_serializer.CloseElement(
+		xml_serializer->CloseElement(
 			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 			CDXLTokens::GetDXLTokenStr(EdxltokenMetadata));
-		SerializeFooter(&xml_serializer);
+		SerializeFooter(xml_serializer);
 	}
 
 	GPOS_CHECK_ABORT;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::ConvertXMLToBinary
+//
+//	@doc:
+//		Convert an XML DXL document into a binary one, released by the caller
+//		with GPOS_DELETE_ARRAY
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLUtils::ConvertXMLToBinary(CMemoryPool *mp, const CHAR *dxl_string,
+							  ULONG *length)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != dxl_string);
+
+	CDXLMemoryManager mm(mp);
+	SAX2XMLReader *sax_2_xml_reader = XMLReaderFactory::createXMLReader(&mm);
+
+	// report namespace declarations, so that they are kept in the result
+	sax_2_xml_reader->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, true);
+
+	CDXLBinaryWriter binary_writer(mp);
+	CDXLBinaryConverter converter(mp, &binary_writer);
+	sax_2_xml_reader->setContentHandler(&converter);
+	sax_2_xml_reader->setErrorHandler(&converter);
+
+	MemBufInputSource input_src_memory_buffer(
+		(const XMLByte *) dxl_string, clib::Strlen(dxl_string),
+		"dxl binary conversion", false, &mm);
+
+	try
+	{
+		sax_2_xml_reader->parse(input_src_memory_buffer);
+	}
+	catch (const XMLException &)
+	{
+		delete sax_2_xml_reader;
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
+	}
+	catch (const SAXParseException &)
+	{
+		delete sax_2_xml_reader;
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
+	}
+	catch (const SAXException &)
+	{
+		delete sax_2_xml_reader;
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
+	}
+
+	delete sax_2_xml_reader;
+
+	return binary_writer.GetDocument(length);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::ConvertBinaryToXML
+//
+//	@doc:
+//		Convert a binary DXL document into an XML one
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+CDXLUtils::ConvertBinaryToXML(CMemoryPool *mp, const BYTE *data, ULONG length,
+							  BOOL indentation)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != data);
+
+	CDXLBinaryReader binary_reader(mp, data, length);
+
+	CAutoP<CWStringDynamic> string_var(GPOS_NEW(mp) CWStringDynamic(mp));
+	COstreamString oss(string_var.Value());
+	CXMLSerializer xml_serializer(mp, oss, indentation);
+
+	binary_reader.Serialize(&xml_serializer);
+
 	return string_var.Reset();
 }
 
@@ -10,9 +10,14 @@
 //---------------------------------------------------------------------------
 
 #include "naucrates/md/IMDProvider.h"
+
+#include "gpos/common/CAutoP.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/md/CMDIdGPDB.h"
 
 using namespace gpmd;
+using namespace gpdxl;
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -56,4 +61,25 @@ IMDProvider::GetGPDBTypeMdid(CMemoryPool *mp,
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		IMDProvider::GetMDObj
+//
+//	@doc:
+//		Return the requested metadata object, allocated in the given memory
+//		pool, by parsing its DXL string
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+IMDProvider::GetMDObj(CMemoryPool *mp, CMDAccessor *md_accessor,
+					  IMDId *mdid) const
+{
+	CAutoP<CWStringBase> a_pstr;
+	a_pstr = GetMDObjDXLStr(mp, md_accessor, mdid);
+	GPOS_ASSERT(NULL != a_pstr.Value());
+
+	return CDXLUtils::ParseDXLToIMDIdCacheObj(mp, a_pstr.Value(),
+											  NULL /* XSD path */);
+}
+
 // EOF
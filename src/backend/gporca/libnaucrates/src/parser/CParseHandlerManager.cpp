@@ -74,8 +74,7 @@ CParseHandlerManager::ActivateParseHandler(
 	GPOS_ASSERT(NULL != parse_handler_base);
 
 	m_curr_parse_handler = parse_handler_base;
-	m_xml_reader->setContentHandler(parse_handler_base);
-	m_xml_reader->setErrorHandler(parse_handler_base);
+	SetReaderHandler(parse_handler_base);
 }
 
 //---------------------------------------------------------------------------
@@ -102,8 +101,7 @@ CParseHandlerManager::ReplaceHandler(CParseHandlerBase *parse_handler_base,
 	}
 
 	m_curr_parse_handler = parse_handler_base;
-	m_xml_reader->setContentHandler(parse_handler_base);
-	m_xml_reader->setErrorHandler(parse_handler_base);
+	SetReaderHandler(parse_handler_base);
 }
 
 
@@ -132,8 +130,7 @@ CParseHandlerManager::DeactivateHandler()
 		m_curr_parse_handler = NULL;
 	}
 
-	m_xml_reader->setContentHandler(m_curr_parse_handler);
-	m_xml_reader->setErrorHandler(m_curr_parse_handler);
+	SetReaderHandler(m_curr_parse_handler);
 }
 
 //---------------------------------------------------------------------------
@@ -150,6 +147,39 @@ CParseHandlerManager::GetCurrentParseHandler()
 	return m_curr_parse_handler;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::GetContentHandler
+//
+//	@doc:
+//		Returns the handler receiving the parse events; used to replay
+//		documents that are not parsed by an XML reader
+//
+//---------------------------------------------------------------------------
+CParseHandlerBase *
+CParseHandlerManager::GetContentHandler()
+{
+	return m_curr_parse_handler;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::SetReaderHandler
+//
+//	@doc:
+//		Direct the events of the XML reader, if any, to the given handler
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerManager::SetReaderHandler(CParseHandlerBase *parse_handler_base)
+{
+	if (NULL != m_xml_reader)
+	{
+		m_xml_reader->setContentHandler(parse_handler_base);
+		m_xml_reader->setErrorHandler(parse_handler_base);
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CParseHandlerManager::CheckForAborts
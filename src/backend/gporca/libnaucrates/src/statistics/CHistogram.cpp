@@ -12,6 +12,7 @@
 
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/statistics/CHistogram.h"
+#include "naucrates/statistics/CHistogramColumns.h"
 #include "naucrates/dxl/operators/CDXLScalarConstValue.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "gpos/io/COstreamString.h"
@@ -1112,6 +1113,11 @@ CHistogram::MakeJoinHistogramEqualityFilter(const CHistogram *histogram) const
 		return MakeNDVBasedJoinHistogramEqualityFilter(histogram);
 	}
 
+	if (IsColumnarJoinSupported(this, histogram))
+	{
+		return MakeColumnarJoinHistogramEqualityFilter(histogram);
+	}
+
 	CBucketArray *join_buckets = GPOS_NEW(m_mp) CBucketArray(m_mp);
 	while (idx1 < buckets1 && idx2 < buckets2)
 	{
@@ -1168,6 +1174,51 @@ CHistogram::MakeJoinHistogramEqualityFilter(const CHistogram *histogram) const
 				   0.0 /*null_freq*/, distinct_remaining, freq_remaining);
 }
 
+// check if the equality join of the given histograms can run on the
+// columnar form of their buckets
+BOOL
+CHistogram::IsColumnarJoinSupported(const CHistogram *histogram1,
+									const CHistogram *histogram2)
+{
+	GPOS_ASSERT(0 < histogram1->GetNumBuckets());
+
+	const CBucket *bucket = (*histogram1->m_histogram_buckets)[0];
+	const IMDId *mdid = bucket->GetLowerBound()->GetDatum()->MDId();
+
+	return CHistogramColumns::IsSupported(histogram1->m_histogram_buckets,
+										  mdid) &&
+		   CHistogramColumns::IsSupported(histogram2->m_histogram_buckets,
+										  mdid);
+}
+
+// construct a new histogram with equality join, merging the buckets in
+// their columnar form; the result is the same as that of the merge in
+// MakeJoinHistogramEqualityFilter
+CHistogram *
+CHistogram::MakeColumnarJoinHistogramEqualityFilter(
+	const CHistogram *histogram) const
+{
+	CHistogramColumns columns1(m_mp, m_histogram_buckets);
+	CHistogramColumns columns2(m_mp, histogram->m_histogram_buckets);
+
+	CDouble hist1_buckets_freq(0.0);
+	CDouble hist2_buckets_freq(0.0);
+	CHistogramColumns *join_columns = CHistogramColumns::MakeJoinEqualityFilter(
+		m_mp, &columns1, &columns2, &hist1_buckets_freq, &hist2_buckets_freq);
+	CBucketArray *join_buckets = join_columns->MakeBuckets(m_mp);
+	GPOS_DELETE(join_columns);
+
+	CDouble distinct_remaining(0.0);
+	CDouble freq_remaining(0.0);
+	ComputeJoinNDVRemainInfo(this, histogram, join_buckets, hist1_buckets_freq,
+							 hist2_buckets_freq, &distinct_remaining,
+							 &freq_remaining);
+
+	return GPOS_NEW(m_mp)
+		CHistogram(m_mp, join_buckets, true /*is_well_defined*/,
+				   0.0 /*null_freq*/, distinct_remaining, freq_remaining);
+}
+
 // construct a new histogram for NDV based cardinality estimation
 CHistogram *
 CHistogram::MakeNDVBasedJoinHistogramEqualityFilter(
@@ -0,0 +1,572 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CHistogramColumns.cpp
+//
+//	@doc:
+//		Implementation of the columnar form of histogram buckets
+//---------------------------------------------------------------------------
+
+#include "naucrates/statistics/CHistogramColumns.h"
+
+#include "gpos/base.h"
+
+#include "naucrates/base/IDatum.h"
+
+using namespace gpnaucrates;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::CHistogramColumns
+//
+//	@doc:
+//		Ctor for empty columns with room for the given number of buckets
+//
+//---------------------------------------------------------------------------
+CHistogramColumns::CHistogramColumns(CMemoryPool *mp, ULONG capacity)
+	: m_mp(mp),
+	  m_capacity(capacity),
+	  m_size(0),
+	  m_lower_bounds(NULL),
+	  m_upper_bounds(NULL),
+	  m_is_lower_closed(NULL),
+	  m_is_upper_closed(NULL),
+	  m_frequencies(NULL),
+	  m_distincts(NULL),
+	  m_lower_points(NULL),
+	  m_upper_points(NULL)
+{
+	// keep the arrays non-empty
+	const ULONG size = std::max(capacity, (ULONG) 1);
+
+	m_lower_bounds = GPOS_NEW_ARRAY(m_mp, LINT, size);
+	m_upper_bounds = GPOS_NEW_ARRAY(m_mp, LINT, size);
+	m_is_lower_closed = GPOS_NEW_ARRAY(m_mp, BOOL, size);
+	m_is_upper_closed = GPOS_NEW_ARRAY(m_mp, BOOL, size);
+	m_frequencies = GPOS_NEW_ARRAY(m_mp, DOUBLE, size);
+	m_distincts = GPOS_NEW_ARRAY(m_mp, DOUBLE, size);
+	m_lower_points = GPOS_NEW_ARRAY(m_mp, CPoint *, size);
+	m_upper_points = GPOS_NEW_ARRAY(m_mp, CPoint *, size);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::CHistogramColumns
+//
+//	@doc:
+//		Ctor for the columns of the given buckets
+//
+//---------------------------------------------------------------------------
+CHistogramColumns::CHistogramColumns(CMemoryPool *mp,
+									 const CBucketArray *buckets)
+	: CHistogramColumns(mp, buckets->Size())
+{
+	const ULONG num_buckets = buckets->Size();
+	for (ULONG ul = 0; ul < num_buckets; ul++)
+	{
+		const CBucket *bucket = (*buckets)[ul];
+		CPoint *lower_point = bucket->GetLowerBound();
+		CPoint *upper_point = bucket->GetUpperBound();
+
+		Append(lower_point->GetDatum()->GetLINTMapping(),
+			   upper_point->GetDatum()->GetLINTMapping(),
+			   bucket->IsLowerClosed(), bucket->IsUpperClosed(),
+			   bucket->GetFrequency(), bucket->GetNumDistinct(), lower_point,
+			   upper_point);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::~CHistogramColumns
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CHistogramColumns::~CHistogramColumns()
+{
+	GPOS_DELETE_ARRAY(m_lower_bounds);
+	GPOS_DELETE_ARRAY(m_upper_bounds);
+	GPOS_DELETE_ARRAY(m_is_lower_closed);
+	GPOS_DELETE_ARRAY(m_is_upper_closed);
+	GPOS_DELETE_ARRAY(m_frequencies);
+	GPOS_DELETE_ARRAY(m_distincts);
+	GPOS_DELETE_ARRAY(m_lower_points);
+	GPOS_DELETE_ARRAY(m_upper_points);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::IsSupported
+//
+//	@doc:
+//		Can the given buckets be put in columns? All bounds must be non-null
+//		LINT mappable datums of the given type, so that comparing their
+//		mappings is what CPoint comparisons do
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramColumns::IsSupported(const CBucketArray *buckets, const IMDId *mdid)
+{
+	const ULONG num_buckets = buckets->Size();
+	for (ULONG ul = 0; ul < num_buckets; ul++)
+	{
+		const CBucket *bucket = (*buckets)[ul];
+		const IDatum *bounds[] = {bucket->GetLowerBound()->GetDatum(),
+								  bucket->GetUpperBound()->GetDatum()};
+
+		for (ULONG ulBound = 0; ulBound < GPOS_ARRAY_SIZE(bounds); ulBound++)
+		{
+			const IDatum *datum = bounds[ulBound];
+			if (datum->IsNull() || !datum->IsDatumMappableToLINT() ||
+				!datum->MDId()->Equals(mdid))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::Append
+//
+//	@doc:
+//		Append a bucket
+//
+//---------------------------------------------------------------------------
+void
+CHistogramColumns::Append(LINT lower_bound, LINT upper_bound,
+						  BOOL is_lower_closed, BOOL is_upper_closed,
+						  CDouble frequency, CDouble distinct,
+						  CPoint *lower_point, CPoint *upper_point)
+{
+	GPOS_ASSERT(m_size < m_capacity);
+
+	m_lower_bounds[m_size] = lower_bound;
+	m_upper_bounds[m_size] = upper_bound;
+	m_is_lower_closed[m_size] = is_lower_closed;
+	m_is_upper_closed[m_size] = is_upper_closed;
+	m_frequencies[m_size] = frequency.Get();
+	m_distincts[m_size] = distinct.Get();
+	m_lower_points[m_size] = lower_point;
+	m_upper_points[m_size] = upper_point;
+	m_size++;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::MakeBuckets
+//
+//	@doc:
+//		Convert back to an array of buckets sharing the points of the bounds
+//
+//---------------------------------------------------------------------------
+CBucketArray *
+CHistogramColumns::MakeBuckets(CMemoryPool *mp) const
+{
+	CBucketArray *buckets = GPOS_NEW(mp) CBucketArray(mp, m_size);
+	for (ULONG ul = 0; ul < m_size; ul++)
+	{
+		m_lower_points[ul]->AddRef();
+		m_upper_points[ul]->AddRef();
+		buckets->Append(GPOS_NEW(mp) CBucket(
+			m_lower_points[ul], m_upper_points[ul], m_is_lower_closed[ul],
+			m_is_upper_closed[ul], CDouble(m_frequencies[ul]),
+			CDouble(m_distincts[ul])));
+	}
+
+	return buckets;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::Width
+//
+//	@doc:
+//		Width of the given bucket, as CBucket::Width
+//
+//---------------------------------------------------------------------------
+CDouble
+CHistogramColumns::Width(ULONG ul) const
+{
+	if (IsSingleton(ul))
+	{
+		return CDouble(1.0);
+	}
+
+	return CDouble(m_upper_bounds[ul] - m_lower_bounds[ul]);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::Contains
+//
+//	@doc:
+//		Does the given bucket contain the given value? As CBucket::Contains
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramColumns::Contains(ULONG ul, LINT value) const
+{
+	if (IsSingleton(ul))
+	{
+		return m_lower_bounds[ul] == value;
+	}
+
+	if (m_is_lower_closed[ul] && m_lower_bounds[ul] == value)
+	{
+		return true;
+	}
+
+	if (m_is_upper_closed[ul] && m_upper_bounds[ul] == value)
+	{
+		return true;
+	}
+
+	return m_lower_bounds[ul] < value && m_upper_bounds[ul] > value;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::CompareLowerBounds
+//
+//	@doc:
+//		Compare lower bounds of the given buckets, as
+//		CBucket::CompareLowerBounds
+//
+//---------------------------------------------------------------------------
+INT
+CHistogramColumns::CompareLowerBounds(const CHistogramColumns *columns1,
+									  ULONG ul1,
+									  const CHistogramColumns *columns2,
+									  ULONG ul2)
+{
+	LINT lower_bound1 = columns1->m_lower_bounds[ul1];
+	LINT lower_bound2 = columns2->m_lower_bounds[ul2];
+
+	if (lower_bound1 == lower_bound2)
+	{
+		BOOL is_closed1 = columns1->m_is_lower_closed[ul1];
+		if (is_closed1 == columns2->m_is_lower_closed[ul2])
+		{
+			return 0;
+		}
+
+		return is_closed1 ? -1 : 1;
+	}
+
+	return lower_bound1 < lower_bound2 ? -1 : 1;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::CompareUpperBounds
+//
+//	@doc:
+//		Compare upper bounds of the given buckets, as
+//		CBucket::CompareUpperBounds
+//
+//---------------------------------------------------------------------------
+INT
+CHistogramColumns::CompareUpperBounds(const CHistogramColumns *columns1,
+									  ULONG ul1,
+									  const CHistogramColumns *columns2,
+									  ULONG ul2)
+{
+	LINT upper_bound1 = columns1->m_upper_bounds[ul1];
+	LINT upper_bound2 = columns2->m_upper_bounds[ul2];
+
+	if (upper_bound1 == upper_bound2)
+	{
+		BOOL is_closed1 = columns1->m_is_upper_closed[ul1];
+		if (is_closed1 == columns2->m_is_upper_closed[ul2])
+		{
+			return 0;
+		}
+
+		return is_closed1 ? 1 : -1;
+	}
+
+	return upper_bound1 < upper_bound2 ? -1 : 1;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::CompareLowerBoundToUpperBound
+//
+//	@doc:
+//		Compare the lower bound of the first bucket to the upper bound of the
+//		second, as CBucket::CompareLowerBoundToUpperBound
+//
+//---------------------------------------------------------------------------
+INT
+CHistogramColumns::CompareLowerBoundToUpperBound(
+	const CHistogramColumns *columns1, ULONG ul1,
+	const CHistogramColumns *columns2, ULONG ul2)
+{
+	LINT lower_bound1 = columns1->m_lower_bounds[ul1];
+	LINT upper_bound2 = columns2->m_upper_bounds[ul2];
+
+	if (lower_bound1 != upper_bound2)
+	{
+		return lower_bound1 < upper_bound2 ? -1 : 1;
+	}
+
+	if (columns1->m_is_lower_closed[ul1] && columns2->m_is_upper_closed[ul2])
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::Subsumes
+//
+//	@doc:
+//		Does the bucket of the first columns subsume that of the second? As
+//		CBucket::Subsumes
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramColumns::Subsumes(const CHistogramColumns *columns1, ULONG ul1,
+							const CHistogramColumns *columns2, ULONG ul2)
+{
+	if (columns2->IsSingleton(ul2))
+	{
+		// this also covers both being singletons
+		return columns1->Contains(ul1, columns2->m_lower_bounds[ul2]);
+	}
+
+	return 0 >= CompareLowerBounds(columns1, ul1, columns2, ul2) &&
+		   0 <= CompareUpperBounds(columns1, ul1, columns2, ul2);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::Intersects
+//
+//	@doc:
+//		Do the given buckets intersect? As CBucket::Intersects
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramColumns::Intersects(const CHistogramColumns *columns1, ULONG ul1,
+							  const CHistogramColumns *columns2, ULONG ul2)
+{
+	if (columns1->IsSingleton(ul1))
+	{
+		// this also covers both being singletons
+		return columns2->Contains(ul2, columns1->m_lower_bounds[ul1]);
+	}
+
+	if (columns2->IsSingleton(ul2))
+	{
+		return columns1->Contains(ul1, columns2->m_lower_bounds[ul2]);
+	}
+
+	if (Subsumes(columns1, ul1, columns2, ul2) ||
+		Subsumes(columns2, ul2, columns1, ul1))
+	{
+		return true;
+	}
+
+	if (0 >= CompareLowerBounds(columns1, ul1, columns2, ul2))
+	{
+		// first bucket starts before the second one
+		return 0 >=
+			   CompareLowerBoundToUpperBound(columns2, ul2, columns1, ul1);
+	}
+
+	return 0 >= CompareLowerBoundToUpperBound(columns1, ul1, columns2, ul2);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::AppendIntersect
+//
+//	@doc:
+//		Append the intersection of the given buckets and return the
+//		frequency of each of them that intersects; see
+//		CBucket::MakeBucketIntersect for the estimation, which this follows
+//		step by step so that the results are bit-identical
+//
+//---------------------------------------------------------------------------
+void
+CHistogramColumns::AppendIntersect(const CHistogramColumns *columns1,
+								   ULONG ul1,
+								   const CHistogramColumns *columns2,
+								   ULONG ul2, CDouble *result_freq_intersect1,
+								   CDouble *result_freq_intersect2)
+{
+	GPOS_ASSERT(Intersects(columns1, ul1, columns2, ul2));
+
+	// maximum of lower bounds, minimum of upper bounds, preferring the
+	// first bucket on ties as CPoint::MaxPoint and CPoint::MinPoint do
+	const LINT lower_bound1 = columns1->m_lower_bounds[ul1];
+	const LINT lower_bound2 = columns2->m_lower_bounds[ul2];
+	const LINT upper_bound1 = columns1->m_upper_bounds[ul1];
+	const LINT upper_bound2 = columns2->m_upper_bounds[ul2];
+	const BOOL is_lower_first = lower_bound1 >= lower_bound2;
+	const BOOL is_upper_first = upper_bound1 <= upper_bound2;
+
+	LINT lower_new = is_lower_first ? lower_bound1 : lower_bound2;
+	LINT upper_new = is_upper_first ? upper_bound1 : upper_bound2;
+
+	BOOL lower_new_is_closed = true;
+	BOOL upper_new_is_closed = true;
+
+	CDouble ratio1(0.0);
+	CDouble ratio2(0.0);
+	if (columns1->IsSingleton(ul1) && columns2->IsSingleton(ul2))
+	{
+		ratio1 = CDouble(1.0);
+		ratio2 = CDouble(1.0);
+	}
+	else
+	{
+		CDouble distance_new = 1.0;
+		if (lower_new != upper_new)
+		{
+			lower_new_is_closed = columns1->m_is_lower_closed[ul1];
+			upper_new_is_closed = columns1->m_is_upper_closed[ul1];
+
+			if (lower_new == lower_bound2)
+			{
+				lower_new_is_closed = columns2->m_is_lower_closed[ul2];
+				if (lower_new == lower_bound1)
+				{
+					lower_new_is_closed = columns1->m_is_lower_closed[ul1] &&
+										  columns2->m_is_lower_closed[ul2];
+				}
+			}
+
+			if (upper_new == upper_bound2)
+			{
+				upper_new_is_closed = columns2->m_is_upper_closed[ul2];
+				if (upper_new == upper_bound1)
+				{
+					upper_new_is_closed = columns1->m_is_upper_closed[ul1] &&
+										  columns2->m_is_upper_closed[ul2];
+				}
+			}
+
+			distance_new = CDouble(upper_new - lower_new);
+		}
+
+		GPOS_ASSERT(distance_new <= columns1->Width(ul1));
+		GPOS_ASSERT(distance_new <= columns2->Width(ul2));
+
+		ratio1 = distance_new / columns1->Width(ul1);
+		ratio2 = distance_new / columns2->Width(ul2);
+	}
+
+	const CDouble distinct1(columns1->m_distincts[ul1]);
+	const CDouble distinct2(columns2->m_distincts[ul2]);
+
+	CDouble distinct_new(std::min(ratio1.Get() * distinct1.Get(),
+								  ratio2.Get() * distinct2.Get()));
+
+	CDouble freq_intersect1 = ratio1 * CDouble(columns1->m_frequencies[ul1]);
+	CDouble freq_intersect2 = ratio2 * CDouble(columns2->m_frequencies[ul2]);
+
+	CDouble frequency_new(freq_intersect1 * freq_intersect2 * DOUBLE(1.0) /
+						  std::max(ratio1.Get() * distinct1.Get(),
+								   ratio2.Get() * distinct2.Get()));
+
+	*result_freq_intersect1 = freq_intersect1;
+	*result_freq_intersect2 = freq_intersect2;
+
+	Append(lower_new, upper_new, lower_new_is_closed, upper_new_is_closed,
+		   frequency_new, distinct_new,
+		   is_lower_first ? columns1->m_lower_points[ul1]
+						  : columns2->m_lower_points[ul2],
+		   is_upper_first ? columns1->m_upper_points[ul1]
+						  : columns2->m_upper_points[ul2]);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramColumns::MakeJoinEqualityFilter
+//
+//	@doc:
+//		Equi-join the given columns by merging their buckets in one pass, as
+//		CHistogram::MakeJoinHistogramEqualityFilter does on bucket arrays.
+//		Every step of the merge emits at most one join bucket, so the join
+//		has at most as many buckets as both inputs together, and the merge
+//		allocates nothing beyond the result columns
+//
+//---------------------------------------------------------------------------
+CHistogramColumns *
+CHistogramColumns::MakeJoinEqualityFilter(CMemoryPool *mp,
+										  const CHistogramColumns *columns1,
+										  const CHistogramColumns *columns2,
+										  CDouble *result_buckets_freq1,
+										  CDouble *result_buckets_freq2)
+{
+	const ULONG buckets1 = columns1->Size();
+	const ULONG buckets2 = columns2->Size();
+
+	CHistogramColumns *join_columns =
+		GPOS_NEW(mp) CHistogramColumns(mp, buckets1 + buckets2);
+
+	CDouble hist1_buckets_freq(0.0);
+	CDouble hist2_buckets_freq(0.0);
+
+	ULONG idx1 = 0;
+	ULONG idx2 = 0;
+	while (idx1 < buckets1 && idx2 < buckets2)
+	{
+		if (Intersects(columns1, idx1, columns2, idx2))
+		{
+			CDouble freq_intersect1(0.0);
+			CDouble freq_intersect2(0.0);
+
+			join_columns->AppendIntersect(columns1, idx1, columns2, idx2,
+										  &freq_intersect1, &freq_intersect2);
+
+			hist1_buckets_freq = hist1_buckets_freq + freq_intersect1;
+			hist2_buckets_freq = hist2_buckets_freq + freq_intersect2;
+
+			INT res = CompareUpperBounds(columns1, idx1, columns2, idx2);
+			if (0 == res)
+			{
+				idx1++;
+				idx2++;
+			}
+			else if (1 > res)
+			{
+				idx1++;
+			}
+			else
+			{
+				idx2++;
+			}
+		}
+		else if (columns1->m_upper_bounds[idx1] <=
+				 columns2->m_lower_bounds[idx2])
+		{
+			// the buckets do not intersect and the first one comes before
+			// the second one
+			idx1++;
+		}
+		else
+		{
+			idx2++;
+		}
+	}
+
+	*result_buckets_freq1 = hist1_buckets_freq;
+	*result_buckets_freq2 = hist2_buckets_freq;
+
+	return join_columns;
+}
+
+// EOF
@@ -12,6 +12,7 @@
 #include "gpos/base.h"
 #include "naucrates/statistics/CPoint.h"
 #include "gpopt/mdcache/CMDAccessor.h"
+#include "naucrates/md/CMDTypeGenericGPDB.h"
 #include "naucrates/statistics/CStatistics.h"
 
 using namespace gpnaucrates;
@@ -25,11 +26,122 @@ using namespace gpopt;
 //		Ctor
 //
 //---------------------------------------------------------------------------
-CPoint::CPoint(IDatum *datum) : m_datum(datum)
+CPoint::CPoint(IDatum *datum)
+	: m_datum(datum),
+	  m_is_resolved(false),
+	  m_is_null(false),
+	  m_is_lint_mappable(false),
+	  m_is_double_mappable(false),
+	  m_is_time_related(false),
+	  m_lint_value(0),
+	  m_double_value(0.0)
 {
 	GPOS_ASSERT(NULL != m_datum);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CPoint::ResolveStatsMapping
+//
+//	@doc:
+//		Look up how the datum maps to LINT or double, and the mapped value.
+//		Points are immutable, so this is done once per point rather than
+//		for every comparison
+//
+//---------------------------------------------------------------------------
+void
+CPoint::ResolveStatsMapping() const
+{
+	m_is_null = m_datum->IsNull();
+	m_is_lint_mappable = m_datum->IsDatumMappableToLINT();
+	m_is_double_mappable = m_datum->IsDatumMappableToDouble();
+	m_is_time_related = CMDTypeGenericGPDB::IsTimeRelatedType(m_datum->MDId());
+
+	if (!m_is_null)
+	{
+		if (m_is_lint_mappable)
+		{
+			m_lint_value = m_datum->GetLINTMapping();
+		}
+		if (m_is_double_mappable)
+		{
+			m_double_value = m_datum->GetDoubleMapping();
+		}
+	}
+
+	m_is_resolved = true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPoint::StatsAreComparable
+//
+//	@doc:
+//		Check if the two points can be compared for statistics
+//
+//---------------------------------------------------------------------------
+BOOL
+CPoint::StatsAreComparable(const CPoint *point) const
+{
+	GPOS_ASSERT(NULL != point);
+
+	EnsureStatsMapping();
+	point->EnsureStatsMapping();
+
+	// the statistics of different time-related types can't be compared,
+	// the type ids are only looked at for those
+	if (m_is_time_related && point->m_is_time_related)
+	{
+		IMDId *mdid = m_datum->MDId();
+		IMDId *mdid_other = point->m_datum->MDId();
+		if (mdid != mdid_other && !mdid->Equals(mdid_other))
+		{
+			return false;
+		}
+	}
+
+	return (m_is_double_mappable && point->m_is_double_mappable) ||
+		   (m_is_lint_mappable && point->m_is_lint_mappable);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPoint::StatsAreLessThan
+//
+//	@doc:
+//		Less-than based on the mapping to LINT or CDouble
+//
+//---------------------------------------------------------------------------
+BOOL
+CPoint::StatsAreLessThan(const CPoint *point) const
+{
+	GPOS_ASSERT(m_is_resolved && point->m_is_resolved);
+
+	BOOL is_lint_comparison =
+		m_is_lint_mappable && point->m_is_lint_mappable;
+	GPOS_ASSERT(is_lint_comparison ||
+				(m_is_double_mappable && point->m_is_double_mappable));
+
+	if (m_is_null)
+	{
+		// nulls are less than everything else except nulls
+		return !point->m_is_null;
+	}
+
+	if (point->m_is_null)
+	{
+		return false;
+	}
+
+	if (is_lint_comparison)
+	{
+		return m_lint_value < point->m_lint_value;
+	}
+
+	CDouble diff = point->m_double_value - m_double_value;
+	return diff > CStatistics::Epsilon;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CPoint::Equals
@@ -42,7 +154,33 @@ BOOL
 CPoint::Equals(const CPoint *point) const
 {
 	GPOS_ASSERT(NULL != point);
-	return m_datum->StatsAreEqual(point->m_datum);
+
+	EnsureStatsMapping();
+	point->EnsureStatsMapping();
+
+	BOOL is_lint_comparison =
+		m_is_lint_mappable && point->m_is_lint_mappable;
+	GPOS_ASSERT(is_lint_comparison ||
+				(m_is_double_mappable && point->m_is_double_mappable));
+
+	if (m_is_null)
+	{
+		// nulls are equal from stats point of view
+		return point->m_is_null;
+	}
+
+	if (point->m_is_null)
+	{
+		return false;
+	}
+
+	if (is_lint_comparison)
+	{
+		return m_lint_value == point->m_lint_value;
+	}
+
+	CDouble diff = m_double_value - point->m_double_value;
+	return diff.Absolute() <= CStatistics::Epsilon;
 }
 
 //---------------------------------------------------------------------------
@@ -71,8 +209,7 @@ BOOL
 CPoint::IsLessThan(const CPoint *point) const
 {
 	GPOS_ASSERT(NULL != point);
-	return m_datum->StatsAreComparable(point->m_datum) &&
-		   m_datum->StatsAreLessThan(point->m_datum);
+	return StatsAreComparable(point) && StatsAreLessThan(point);
 }
 
 //---------------------------------------------------------------------------
@@ -100,8 +237,8 @@ CPoint::IsLessThanOrEqual(const CPoint *point) const
 BOOL
 CPoint::IsGreaterThan(const CPoint *point) const
 {
-	return m_datum->StatsAreComparable(point->m_datum) &&
-		   m_datum->StatsAreGreaterThan(point->m_datum);
+	GPOS_ASSERT(NULL != point);
+	return StatsAreComparable(point) && point->StatsAreLessThan(this);
 }
 
 //---------------------------------------------------------------------------
@@ -135,11 +272,26 @@ CPoint::Width(const CPoint *point, BOOL include_lower, BOOL include_upper) const
 	CDouble width = CDouble(1.0);
 	CDouble adjust = CDouble(0.0);
 	GPOS_ASSERT(NULL != point);
-	if (m_datum->StatsAreComparable(point->m_datum))
+	if (StatsAreComparable(point))
 	{
 		// default case [this, point) or (this, point]
-		width = CDouble(m_datum->GetStatsDistanceFrom(point->m_datum));
-		if (m_datum->IsDatumMappableToLINT())
+		BOOL is_lint_comparison =
+			m_is_lint_mappable && point->m_is_lint_mappable;
+		if (m_is_null || point->m_is_null)
+		{
+			// as in IDatum::GetStatsDistanceFrom
+			width = CDouble(m_is_null && point->m_is_null);
+		}
+		else if (is_lint_comparison)
+		{
+			width = CDouble(m_lint_value - point->m_lint_value);
+		}
+		else
+		{
+			width = m_double_value - point->m_double_value;
+		}
+
+		if (m_is_lint_mappable)
 		{
 			adjust = CDouble(1.0);
 		}
@@ -148,7 +300,7 @@ CPoint::Width(const CPoint *point, BOOL include_lower, BOOL include_upper) const
 			// for the case of doubles, the distance could be any point along
 			// between the int values, so make a small adjust by a factor of
 			// 10 * Epsilon (as anything smaller than Epsilon is treated as 0)
-			GPOS_ASSERT(m_datum->IsDatumMappableToDouble());
+			GPOS_ASSERT(m_is_double_mappable);
 			adjust = CStatistics::Epsilon * 10;
 		}
 	}
@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryConverter.cpp
+//
+//	@doc:
+//		Implementation of the SAX handler converting XML DXL documents to
+//		binary ones.
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLBinaryConverter.h"
+
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
+
+#include <xercesc/sax2/Attributes.hpp>
+
+using namespace gpdxl;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryConverter::CDXLBinaryConverter
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryConverter::CDXLBinaryConverter(CMemoryPool *mp,
+										 CDXLBinaryWriter *binary_writer)
+	: m_binary_writer(binary_writer),
+	  m_qname(mp),
+	  m_ns(mp),
+	  m_name(mp),
+	  m_value(mp)
+{
+	GPOS_ASSERT(NULL != binary_writer);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryConverter::FSplitName
+//
+//	@doc:
+//		Split the given qualified name of an element into its namespace
+//		prefix and local name
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLBinaryConverter::FSplitName(const XMLCh *const qname)
+{
+	m_qname.Reset();
+	m_ns.Reset();
+	m_name.Reset();
+	CDXLBinaryReader::AppendXMLCh(&m_qname, qname);
+
+	const WCHAR *wsz = m_qname.GetBuffer();
+	ULONG prefix_len = 0;
+	while (prefix_len < m_qname.Length() &&
+		   GPOS_WSZ_LIT(':') != wsz[prefix_len])
+	{
+		prefix_len++;
+	}
+
+	if (prefix_len == m_qname.Length())
+	{
+		m_name.Append(&m_qname);
+		return false;
+	}
+
+	m_ns.AppendFormat(GPOS_WSZ_LIT("%.*ls"), (INT) prefix_len, wsz);
+	m_name.AppendWideCharArray(wsz + prefix_len + 1);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryConverter::startElement
+//
+//	@doc:
+//		Write the opening tag of an element along with its attributes
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryConverter::startElement(const XMLCh *const,  // element_uri,
+								  const XMLCh *const,  // element_local_name,
+								  const XMLCh *const element_qname,
+								  const Attributes &attrs)
+{
+	BOOL has_ns = FSplitName(element_qname);
+	m_binary_writer->OpenElement(has_ns ? &m_ns : NULL, &m_name);
+
+	for (ULONG ul = 0; ul < attrs.getLength(); ul++)
+	{
+		m_qname.Reset();
+		m_value.Reset();
+		CDXLBinaryReader::AppendXMLCh(&m_qname, attrs.getQName(ul));
+		CDXLBinaryReader::AppendXMLCh(&m_value, attrs.getValue(ul));
+		m_binary_writer->AddAttribute(&m_qname, &m_value);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryConverter::endElement
+//
+//	@doc:
+//		Write the closing tag of an element
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryConverter::endElement(const XMLCh *const,	 // element_uri,
+								const XMLCh *const,	 // element_local_name,
+								const XMLCh *const element_qname)
+{
+	BOOL has_ns = FSplitName(element_qname);
+	m_binary_writer->CloseElement(has_ns ? &m_ns : NULL, &m_name);
+}
+
+// EOF
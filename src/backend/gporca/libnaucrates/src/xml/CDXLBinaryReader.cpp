@@ -0,0 +1,626 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryReader.cpp
+//
+//	@doc:
+//		Implementation of the class for reading binary DXL documents.
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CDynamicPtrArray.h"
+
+#include "naucrates/dxl/parser/CParseHandlerBase.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/exception.h"
+
+#include <xercesc/util/XMLString.hpp>
+
+using namespace gpdxl;
+
+// initial number of attributes there is room for
+#define GPDXL_BINARY_INITIAL_ATTRIBUTES 16
+
+// number of characters converted at a time
+#define GPDXL_BINARY_CONVERSION_CHUNK 128
+
+// array of names converted to GPOS strings
+typedef CDynamicPtrArray<CWStringDynamic, CleanupDelete> CWStringDynamicArray;
+
+// namespace URI and type reported for attributes
+static const XMLCh xmlszEmpty[] = {0};
+static const XMLCh xmlszCDATA[] = {'C', 'D', 'A', 'T', 'A', 0};
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryAttributes::CDXLBinaryAttributes
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryAttributes::CDXLBinaryAttributes(CMemoryPool *mp)
+	: m_mp(mp),
+	  m_names(NULL),
+	  m_values(NULL),
+	  m_length(0),
+	  m_capacity(GPDXL_BINARY_INITIAL_ATTRIBUTES)
+{
+	m_names = GPOS_NEW_ARRAY(m_mp, const XMLCh *, m_capacity);
+	m_values = GPOS_NEW_ARRAY(m_mp, const XMLCh *, m_capacity);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryAttributes::~CDXLBinaryAttributes
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryAttributes::~CDXLBinaryAttributes()
+{
+	GPOS_DELETE_ARRAY(m_names);
+	GPOS_DELETE_ARRAY(m_values);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryAttributes::Append
+//
+//	@doc:
+//		Add an attribute, growing the arrays as needed
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryAttributes::Append(const XMLCh *name, const XMLCh *value)
+{
+	if (m_length == m_capacity)
+	{
+		ULONG capacity = m_capacity * 2;
+		const XMLCh **names = GPOS_NEW_ARRAY(m_mp, const XMLCh *, capacity);
+		const XMLCh **values = GPOS_NEW_ARRAY(m_mp, const XMLCh *, capacity);
+		clib::Memcpy(names, m_names, m_length * GPOS_SIZEOF(const XMLCh *));
+		clib::Memcpy(values, m_values, m_length * GPOS_SIZEOF(const XMLCh *));
+		GPOS_DELETE_ARRAY(m_names);
+		GPOS_DELETE_ARRAY(m_values);
+		m_names = names;
+		m_values = values;
+		m_capacity = capacity;
+	}
+
+	m_names[m_length] = name;
+	m_values[m_length] = value;
+	m_length++;
+}
+
+XMLSize_t
+CDXLBinaryAttributes::getLength() const
+{
+	return m_length;
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getURI(const XMLSize_t index) const
+{
+	return index < m_length ? xmlszEmpty : NULL;
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getLocalName(const XMLSize_t index) const
+{
+	return index < m_length ? m_names[index] : NULL;
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getQName(const XMLSize_t index) const
+{
+	return getLocalName(index);
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getType(const XMLSize_t index) const
+{
+	return index < m_length ? xmlszCDATA : NULL;
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getValue(const XMLSize_t index) const
+{
+	return index < m_length ? m_values[index] : NULL;
+}
+
+bool
+CDXLBinaryAttributes::getIndex(const XMLCh *const,	// uri
+							   const XMLCh *const local_part,
+							   XMLSize_t &index) const
+{
+	return getIndex(local_part, index);
+}
+
+int
+CDXLBinaryAttributes::getIndex(const XMLCh *const,	// uri
+							   const XMLCh *const local_part) const
+{
+	return getIndex(local_part);
+}
+
+bool
+CDXLBinaryAttributes::getIndex(const XMLCh *const qname,
+							   XMLSize_t &index) const
+{
+	for (ULONG ul = 0; ul < m_length; ul++)
+	{
+		if (XMLString::equals(qname, m_names[ul]))
+		{
+			index = ul;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int
+CDXLBinaryAttributes::getIndex(const XMLCh *const qname) const
+{
+	XMLSize_t index = 0;
+	if (getIndex(qname, index))
+	{
+		return (int) index;
+	}
+
+	return -1;
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getType(const XMLCh *const,  // uri
+							  const XMLCh *const local_part) const
+{
+	return getType(local_part);
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getType(const XMLCh *const qname) const
+{
+	XMLSize_t index = 0;
+	if (getIndex(qname, index))
+	{
+		return xmlszCDATA;
+	}
+
+	return NULL;
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getValue(const XMLCh *const,	// uri
+							   const XMLCh *const local_part) const
+{
+	return getValue(local_part);
+}
+
+const XMLCh *
+CDXLBinaryAttributes::getValue(const XMLCh *const qname) const
+{
+	XMLSize_t index = 0;
+	if (getIndex(qname, index))
+	{
+		return m_values[index];
+	}
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CDXLBinaryReader
+//
+//	@doc:
+//		Ctor; validates the header and builds the name table
+//
+//---------------------------------------------------------------------------
+CDXLBinaryReader::CDXLBinaryReader(CMemoryPool *mp, const BYTE *data,
+								   ULONG length)
+	: m_mp(mp),
+	  m_data(data),
+	  m_copy(NULL),
+	  m_length(length),
+	  m_names(NULL),
+	  m_num_names(0),
+	  m_names_offset(0),
+	  m_attrs(NULL)
+{
+	GPOS_ASSERT(NULL != data);
+
+	const ULONG header_size =
+		CDXLBinaryFormat::EdxlbinHeaderWords * GPOS_SIZEOF(ULONG);
+	if (header_size > length || !CDXLBinaryFormat::IsBinary(data, length))
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	// words and strings are read in place, which needs them to be aligned
+	CAutoRg<BYTE> copy;
+	if (0 != ((ULONG_PTR) data & (GPOS_SIZEOF(ULONG) - 1)))
+	{
+		copy = GPOS_NEW_ARRAY(mp, BYTE, length);
+		clib::Memcpy(copy.Rgt(), data, length);
+		m_data = copy.Rgt();
+	}
+
+	ULONG offset = GPOS_SIZEOF(ULONG);
+	ULONG byte_order_mark = ReadWord(&offset);
+	ULONG version = ReadWord(&offset);
+	ULONG doc_length = ReadWord(&offset);
+	ULONG num_names = ReadWord(&offset);
+	ULONG names_offset = ReadWord(&offset);
+
+	// a name takes at least two words
+	if (CDXLBinaryFormat::EdxlbinByteOrderMark != byte_order_mark ||
+		CDXLBinaryFormat::EdxlbinVersion != version || length != doc_length ||
+		header_size > names_offset || length < names_offset ||
+		0 != (names_offset & (GPOS_SIZEOF(ULONG) - 1)) ||
+		(length - names_offset) / (2 * GPOS_SIZEOF(ULONG)) < num_names)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	CAutoRg<const XMLCh *> names(
+		GPOS_NEW_ARRAY(mp, const XMLCh *, num_names + 1));
+	offset = names_offset;
+	for (ULONG ul = 0; ul < num_names; ul++)
+	{
+		names[ul] = ReadString(&offset);
+	}
+
+	if (length != offset)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	m_attrs = GPOS_NEW(mp) CDXLBinaryAttributes(mp);
+	m_names = names.RgtReset();
+	m_num_names = num_names;
+	m_names_offset = names_offset;
+	m_copy = copy.RgtReset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::~CDXLBinaryReader
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryReader::~CDXLBinaryReader()
+{
+	GPOS_DELETE(m_attrs);
+	GPOS_DELETE_ARRAY(m_names);
+	GPOS_DELETE_ARRAY(m_copy);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadWord
+//
+//	@doc:
+//		Read the word at the given offset and advance past it
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryReader::ReadWord(ULONG *offset) const
+{
+	if (m_length - *offset < GPOS_SIZEOF(ULONG))
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	ULONG word = *(const ULONG *) (m_data + *offset);
+	*offset += GPOS_SIZEOF(ULONG);
+
+	return word;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadString
+//
+//	@doc:
+//		Read the string at the given offset and advance past it; the string
+//		is returned in place
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::ReadString(ULONG *offset) const
+{
+	ULONG num_units = ReadWord(offset);
+	if (m_length / GPOS_SIZEOF(XMLCh) <= num_units)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	ULONG size = (num_units + 1) * GPOS_SIZEOF(XMLCh);
+	ULONG padded_size = (size + GPOS_SIZEOF(ULONG) - 1) &
+						~(ULONG)(GPOS_SIZEOF(ULONG) - 1);
+	if (m_length - *offset < padded_size)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	// the parse handlers rely on the terminator
+	const XMLCh *xmlsz = (const XMLCh *) (m_data + *offset);
+	if (0 != xmlsz[num_units])
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	*offset += padded_size;
+
+	return xmlsz;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadNameId
+//
+//	@doc:
+//		Read the name id at the given offset and advance past it
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryReader::ReadNameId(ULONG *offset) const
+{
+	ULONG name_id = ReadWord(offset);
+	if (m_num_names <= name_id)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	return name_id;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadNamespaceId
+//
+//	@doc:
+//		Read the namespace id at the given offset and advance past it
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryReader::ReadNamespaceId(ULONG *offset) const
+{
+	ULONG ns_id = ReadWord(offset);
+	if (CDXLBinaryFormat::EdxlbinNoNamespace != ns_id && m_num_names <= ns_id)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	return ns_id;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadAttributes
+//
+//	@doc:
+//		Read the attributes of an element into m_attrs
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::ReadAttributes(ULONG *offset)
+{
+	ULONG num_attrs = ReadWord(offset);
+
+	// an attribute takes at least three words
+	if ((m_names_offset - *offset) / (3 * GPOS_SIZEOF(ULONG)) < num_attrs)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	m_attrs->Reset();
+	for (ULONG ul = 0; ul < num_attrs; ul++)
+	{
+		const XMLCh *name = m_names[ReadNameId(offset)];
+		m_attrs->Append(name, ReadString(offset));
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::Parse
+//
+//	@doc:
+//		Replay the document to the parse handlers of the given manager, in
+//		the same way the XML parser reports the elements of an XML document
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::Parse(CParseHandlerManager *parse_handler_mgr)
+{
+	GPOS_ASSERT(NULL != parse_handler_mgr);
+
+	ULONG offset = CDXLBinaryFormat::EdxlbinHeaderWords * GPOS_SIZEOF(ULONG);
+	ULONG depth = 0;
+
+	while (offset < m_names_offset)
+	{
+		ULONG record = ReadWord(&offset);
+		const XMLCh *name = m_names[ReadNameId(&offset)];
+		(void) ReadNamespaceId(&offset);
+
+		CParseHandlerBase *parse_handler =
+			parse_handler_mgr->GetContentHandler();
+		if (NULL == parse_handler)
+		{
+			GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+		}
+
+		switch (record)
+		{
+			case CDXLBinaryFormat::EdxlbinOpen:
+				ReadAttributes(&offset);
+				depth++;
+				parse_handler->startElement(xmlszEmpty, name, name, *m_attrs);
+				break;
+
+			case CDXLBinaryFormat::EdxlbinClose:
+				if (0 == depth)
+				{
+					GPOS_RAISE(gpdxl::ExmaDXL,
+							   gpdxl::ExmiDXLBinaryParseError);
+				}
+				depth--;
+				parse_handler->endElement(xmlszEmpty, name, name);
+				break;
+
+			default:
+				GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+		}
+	}
+
+	if (0 != depth || m_names_offset != offset)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+
+	// the top-level handler collects what its children parsed at the end of
+	// the document
+	CParseHandlerBase *parse_handler = parse_handler_mgr->GetContentHandler();
+	if (NULL == parse_handler)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+	parse_handler->endDocument();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::Serialize
+//
+//	@doc:
+//		Write the document as XML
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::Serialize(CXMLSerializer *xml_serializer)
+{
+	GPOS_ASSERT(NULL != xml_serializer);
+
+	// the serializer keeps pointers to the names of open elements
+	CAutoRef<CWStringDynamicArray> names(GPOS_NEW(m_mp)
+											 CWStringDynamicArray(m_mp));
+	for (ULONG ul = 0; ul < m_num_names; ul++)
+	{
+		CWStringDynamic *name = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+		AppendXMLCh(name, m_names[ul]);
+		names->Append(name);
+	}
+
+	CWStringDynamic attr_name(m_mp);
+	CWStringDynamic attr_value(m_mp);
+
+	xml_serializer->StartDocument();
+
+	ULONG offset = CDXLBinaryFormat::EdxlbinHeaderWords * GPOS_SIZEOF(ULONG);
+	ULONG depth = 0;
+
+	while (offset < m_names_offset)
+	{
+		ULONG record = ReadWord(&offset);
+		const CWStringDynamic *name = (*names)[ReadNameId(&offset)];
+		ULONG ns_id = ReadNamespaceId(&offset);
+		const CWStringDynamic *ns = NULL;
+		if (CDXLBinaryFormat::EdxlbinNoNamespace != ns_id)
+		{
+			ns = (*names)[ns_id];
+		}
+
+		switch (record)
+		{
+			case CDXLBinaryFormat::EdxlbinOpen:
+				ReadAttributes(&offset);
+				depth++;
+				xml_serializer->OpenElement(ns, name);
+				for (ULONG ul = 0; ul < m_attrs->getLength(); ul++)
+				{
+					attr_name.Reset();
+					attr_value.Reset();
+					AppendXMLCh(&attr_name, m_attrs->getQName(ul));
+					AppendXMLCh(&attr_value, m_attrs->getValue(ul));
+					xml_serializer->AddAttribute(&attr_name, &attr_value);
+				}
+				break;
+
+			case CDXLBinaryFormat::EdxlbinClose:
+				if (0 == depth)
+				{
+					GPOS_RAISE(gpdxl::ExmaDXL,
+							   gpdxl::ExmiDXLBinaryParseError);
+				}
+				depth--;
+				xml_serializer->CloseElement(ns, name);
+				break;
+
+			default:
+				GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+		}
+	}
+
+	if (0 != depth || m_names_offset != offset)
+	{
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::AppendXMLCh
+//
+//	@doc:
+//		Append the given UTF-16 string to the given GPOS string, combining
+//		surrogate pairs into single characters
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::AppendXMLCh(CWStringDynamic *str, const XMLCh *xmlch)
+{
+	GPOS_ASSERT(NULL != str);
+	GPOS_ASSERT(NULL != xmlch);
+
+	WCHAR chunk[GPDXL_BINARY_CONVERSION_CHUNK + 1];
+	ULONG length = 0;
+
+	for (const XMLCh *unit = xmlch; 0 != *unit; unit++)
+	{
+		ULONG code_point = (ULONG) *unit;
+		if (0xd800 <= code_point && 0xdc00 > code_point &&
+			0xdc00 <= (ULONG) unit[1] && 0xe000 > (ULONG) unit[1])
+		{
+			code_point = 0x10000 + ((code_point - 0xd800) << 10) +
+						 ((ULONG) unit[1] - 0xdc00);
+			unit++;
+		}
+
+		chunk[length++] = (WCHAR) code_point;
+		if (GPDXL_BINARY_CONVERSION_CHUNK == length)
+		{
+			chunk[length] = WCHAR_EOS;
+			str->AppendWideCharArray(chunk);
+			length = 0;
+		}
+	}
+
+	chunk[length] = WCHAR_EOS;
+	str->AppendWideCharArray(chunk);
+}
+
+// EOF
@@ -0,0 +1,473 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryWriter.cpp
+//
+//	@doc:
+//		Implementation of the class for creating binary DXL documents.
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
+
+#include "gpos/utils.h"
+
+using namespace gpdxl;
+
+// initial size of the element buffer
+#define GPDXL_BINARY_INITIAL_SIZE 4096
+
+// initial size of the name table
+#define GPDXL_BINARY_INITIAL_NAMES_SIZE 1024
+
+const BYTE CDXLBinaryFormat::m_magic[4] = {0x89, 'D', 'X', 'B'};
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::CBuffer
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryWriter::CBuffer::CBuffer(CMemoryPool *mp, ULONG capacity)
+	: m_mp(mp), m_data(NULL), m_capacity(capacity), m_length(0)
+{
+	GPOS_ASSERT(0 < capacity);
+
+	m_data = GPOS_NEW_ARRAY(m_mp, BYTE, m_capacity);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::~CBuffer
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryWriter::CBuffer::~CBuffer()
+{
+	GPOS_DELETE_ARRAY(m_data);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::Reserve
+//
+//	@doc:
+//		Make room for the given number of bytes, doubling the buffer as
+//		needed
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CBuffer::Reserve(ULONG length)
+{
+	if (m_length + length <= m_capacity)
+	{
+		return;
+	}
+
+	ULONG capacity = m_capacity;
+	while (capacity < m_length + length)
+	{
+		capacity *= 2;
+	}
+
+	BYTE *data = GPOS_NEW_ARRAY(m_mp, BYTE, capacity);
+	clib::Memcpy(data, m_data, m_length);
+	GPOS_DELETE_ARRAY(m_data);
+	m_data = data;
+	m_capacity = capacity;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::AppendWord
+//
+//	@doc:
+//		Append a word
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CBuffer::AppendWord(ULONG word)
+{
+	Reserve(GPOS_SIZEOF(ULONG));
+	SetWord(m_length, word);
+	m_length += GPOS_SIZEOF(ULONG);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::AppendString
+//
+//	@doc:
+//		Append a string: its length in UTF-16 code units, followed by the
+//		NUL-terminated code units, padded to a word boundary
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CBuffer::AppendString(const WCHAR *wsz, ULONG length)
+{
+	// characters outside the basic multilingual plane take two code units
+	ULONG num_units = length;
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		if (0xffff < (ULONG) wsz[ul])
+		{
+			num_units++;
+		}
+	}
+
+	AppendWord(num_units);
+
+	ULONG size = (num_units + 1) * GPOS_SIZEOF(USINT);
+	ULONG padded_size = (size + GPOS_SIZEOF(ULONG) - 1) &
+						~(ULONG)(GPOS_SIZEOF(ULONG) - 1);
+	Reserve(padded_size);
+
+	USINT *units = (USINT *) (m_data + m_length);
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		ULONG code_point = (ULONG) wsz[ul];
+		if (0xffff < code_point)
+		{
+			code_point -= 0x10000;
+			*units++ = (USINT)(0xd800 + (code_point >> 10));
+			*units++ = (USINT)(0xdc00 + (code_point & 0x3ff));
+		}
+		else
+		{
+			*units++ = (USINT) code_point;
+		}
+	}
+
+	// terminate and pad
+	clib::Memset(units, 0, padded_size - num_units * GPOS_SIZEOF(USINT));
+	m_length += padded_size;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::Append
+//
+//	@doc:
+//		Append the content of another buffer
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CBuffer::Append(const CBuffer *buffer)
+{
+	Reserve(buffer->m_length);
+	clib::Memcpy(m_data + m_length, buffer->m_data, buffer->m_length);
+	m_length += buffer->m_length;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::SetWord
+//
+//	@doc:
+//		Overwrite the word at the given offset
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CBuffer::SetWord(ULONG offset, ULONG word)
+{
+	GPOS_ASSERT(offset + GPOS_SIZEOF(ULONG) <= m_capacity);
+
+	clib::Memcpy(m_data + offset, &word, GPOS_SIZEOF(ULONG));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::GetWord
+//
+//	@doc:
+//		Read the word at the given offset
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryWriter::CBuffer::GetWord(ULONG offset) const
+{
+	GPOS_ASSERT(offset + GPOS_SIZEOF(ULONG) <= m_length);
+
+	ULONG word = 0;
+	clib::Memcpy(&word, m_data + offset, GPOS_SIZEOF(ULONG));
+
+	return word;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CBuffer::Detach
+//
+//	@doc:
+//		Hand the content over to the caller
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLBinaryWriter::CBuffer::Detach()
+{
+	BYTE *data = m_data;
+	m_data = NULL;
+	m_capacity = 0;
+	m_length = 0;
+
+	return data;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CDXLBinaryWriter
+//
+//	@doc:
+//		Ctor; reserves room for the header
+//
+//---------------------------------------------------------------------------
+CDXLBinaryWriter::CDXLBinaryWriter(CMemoryPool *mp)
+	: m_mp(mp),
+	  m_elements(NULL),
+	  m_names(NULL),
+	  m_name_ids(NULL),
+	  m_num_names(0),
+	  m_attr_count_offset(0),
+	  m_attr_name_id(0),
+	  m_attr_value(NULL),
+	  m_attr_value_os(NULL)
+{
+	m_elements = GPOS_NEW(mp) CBuffer(mp, GPDXL_BINARY_INITIAL_SIZE);
+	m_names = GPOS_NEW(mp) CBuffer(mp, GPDXL_BINARY_INITIAL_NAMES_SIZE);
+	m_name_ids = GPOS_NEW(mp) NameToIdMap(mp);
+	m_attr_value = GPOS_NEW(mp) CWStringDynamic(mp);
+	m_attr_value_os = GPOS_NEW(mp) COstreamString(m_attr_value);
+
+	for (ULONG ul = 0; ul < CDXLBinaryFormat::EdxlbinHeaderWords; ul++)
+	{
+		m_elements->AppendWord(0);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::~CDXLBinaryWriter
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryWriter::~CDXLBinaryWriter()
+{
+	GPOS_DELETE(m_attr_value_os);
+	GPOS_DELETE(m_attr_value);
+	m_name_ids->Release();
+	GPOS_DELETE(m_names);
+	GPOS_DELETE(m_elements);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::HashName
+//
+//	@doc:
+//		Hash function for names
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryWriter::HashName(const CWStringConst *str)
+{
+	return gpos::HashByteArray((const BYTE *) str->GetBuffer(),
+							   str->Length() * GPOS_SIZEOF(WCHAR));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::EqualNames
+//
+//	@doc:
+//		Equality function for names
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLBinaryWriter::EqualNames(const CWStringConst *str1,
+							 const CWStringConst *str2)
+{
+	return str1->Equals(str2);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::NameId
+//
+//	@doc:
+//		Id of the given name; names seen for the first time are added to
+//		the name table
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryWriter::NameId(const CWStringBase *name)
+{
+	GPOS_ASSERT(NULL != name);
+
+	CWStringConst str(name->GetBuffer());
+	const ULONG *id = m_name_ids->Find(&str);
+	if (NULL != id)
+	{
+		return *id;
+	}
+
+	CWStringConst *key = GPOS_NEW(m_mp) CWStringConst(m_mp, name->GetBuffer());
+	BOOL inserted GPOS_ASSERTS_ONLY =
+		m_name_ids->Insert(key, GPOS_NEW(m_mp) ULONG(m_num_names));
+	GPOS_ASSERT(inserted);
+
+	m_names->AppendString(name->GetBuffer(), name->Length());
+
+	return m_num_names++;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::OpenElement
+//
+//	@doc:
+//		Start an element
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::OpenElement(const CWStringBase *ns,
+							  const CWStringBase *name)
+{
+	ULONG ns_id = CDXLBinaryFormat::EdxlbinNoNamespace;
+	if (NULL != ns)
+	{
+		ns_id = NameId(ns);
+	}
+
+	m_elements->AppendWord(CDXLBinaryFormat::EdxlbinOpen);
+	m_elements->AppendWord(NameId(name));
+	m_elements->AppendWord(ns_id);
+
+	m_attr_count_offset = m_elements->Length();
+	m_elements->AppendWord(0);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CloseElement
+//
+//	@doc:
+//		End the last open element
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CloseElement(const CWStringBase *ns,
+							   const CWStringBase *name)
+{
+	ULONG ns_id = CDXLBinaryFormat::EdxlbinNoNamespace;
+	if (NULL != ns)
+	{
+		ns_id = NameId(ns);
+	}
+
+	m_elements->AppendWord(CDXLBinaryFormat::EdxlbinClose);
+	m_elements->AppendWord(NameId(name));
+	m_elements->AppendWord(ns_id);
+	m_attr_count_offset = 0;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::AddAttribute
+//
+//	@doc:
+//		Add an attribute to the element just opened
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::AddAttribute(const CWStringBase *name,
+							   const CWStringBase *value)
+{
+	GPOS_ASSERT(0 != m_attr_count_offset);
+
+	ULONG name_id = NameId(name);
+	m_elements->AppendWord(name_id);
+	m_elements->AppendString(value->GetBuffer(), value->Length());
+	m_elements->SetWord(m_attr_count_offset,
+						m_elements->GetWord(m_attr_count_offset) + 1);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::StartAttribute
+//
+//	@doc:
+//		Start an attribute of the element just opened, whose value is then
+//		written to the attribute value stream
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::StartAttribute(const CWStringBase *name)
+{
+	GPOS_ASSERT(0 != m_attr_count_offset);
+
+	m_attr_name_id = NameId(name);
+	m_attr_value->Reset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::EndAttribute
+//
+//	@doc:
+//		Finish the attribute started last
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::EndAttribute()
+{
+	GPOS_ASSERT(0 != m_attr_count_offset);
+
+	m_elements->AppendWord(m_attr_name_id);
+	m_elements->AppendString(m_attr_value->GetBuffer(),
+							 m_attr_value->Length());
+	m_elements->SetWord(m_attr_count_offset,
+						m_elements->GetWord(m_attr_count_offset) + 1);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::GetDocument
+//
+//	@doc:
+//		Finish the document by filling in the header and appending the name
+//		table, and hand it over to the caller
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLBinaryWriter::GetDocument(ULONG *length)
+{
+	GPOS_ASSERT(NULL != length);
+
+	ULONG names_offset = m_elements->Length();
+	m_elements->Append(m_names);
+
+	ULONG magic = 0;
+	clib::Memcpy(&magic, CDXLBinaryFormat::m_magic, GPOS_SIZEOF(ULONG));
+
+	m_elements->SetWord(0 * GPOS_SIZEOF(ULONG), magic);
+	m_elements->SetWord(1 * GPOS_SIZEOF(ULONG),
+						CDXLBinaryFormat::EdxlbinByteOrderMark);
+	m_elements->SetWord(2 * GPOS_SIZEOF(ULONG),
+						CDXLBinaryFormat::EdxlbinVersion);
+	m_elements->SetWord(3 * GPOS_SIZEOF(ULONG), m_elements->Length());
+	m_elements->SetWord(4 * GPOS_SIZEOF(ULONG), m_num_names);
+	m_elements->SetWord(5 * GPOS_SIZEOF(ULONG), names_offset);
+
+	*length = m_elements->Length();
+
+	return m_elements->Detach();
+}
+
+// EOF
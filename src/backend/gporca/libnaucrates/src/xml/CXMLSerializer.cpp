@@ -43,6 +43,13 @@ void
 CXMLSerializer::StartDocument()
 {
 	GPOS_ASSERT(m_strstackElems->IsEmpty());
+
+	// binary documents have no XML declaration
+	if (NULL != m_binary_writer)
+	{
+		return;
+	}
+
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenXMLDocHeader)->GetBuffer();
 	if (m_indentation)
 	{
@@ -75,6 +82,14 @@ CXMLSerializer::OpenElement(const CWStringBase *pstrNamespace,
 	// put element on the stack
 	m_strstackElems->Push(elem_str);
 
+	if (NULL != m_binary_writer)
+	{
+		m_binary_writer->OpenElement(pstrNamespace, elem_str);
+		m_fOpenTag = true;
+		m_ulLevel++;
+		return;
+	}
+
 	// write the closing bracket for the previous element if necessary and add indentation
 	if (m_fOpenTag)
 	{
@@ -129,7 +144,12 @@ CXMLSerializer::CloseElement(const CWStringBase *pstrNamespace,
 
 	GPOS_ASSERT(strOpenElem->Equals(elem_str));
 
-	if (m_fOpenTag)
+	if (NULL != m_binary_writer)
+	{
+		m_binary_writer->CloseElement(pstrNamespace, elem_str);
+		m_fOpenTag = false;
+	}
+	else if (m_fOpenTag)
 	{
 		// singleton element with no children - close the element with "/>"
 		m_os << CDXLTokens::GetDXLTokenStr(EdxltokenBracketCloseSingletonTag)
@@ -182,13 +202,17 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr,
 	GPOS_ASSERT(NULL != pstrAttr);
 	GPOS_ASSERT(NULL != str_value);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	  // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // "
+	// binary documents keep attribute values verbatim
+	if (NULL != m_binary_writer)
+	{
+		GPOS_ASSERT(m_fOpenTag);
+		m_binary_writer->AddAttribute(pstrAttr, str_value);
+		return;
+	}
+
+	StartAttribute(pstrAttr);
 	WriteEscaped(m_os, str_value);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // "
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -205,13 +229,9 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, const CHAR *szValue)
 	GPOS_ASSERT(NULL != pstrAttr);
 	GPOS_ASSERT(NULL != szValue);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	 // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer()	 // "
-		 << szValue
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // "
+	StartAttribute(pstrAttr);
+	m_os << szValue;
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -228,13 +248,9 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, ULONG ulValue)
 {
 	GPOS_ASSERT(NULL != pstrAttr);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	 // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer()	 // \"
-		 << ulValue
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // \"
+	StartAttribute(pstrAttr);
+	m_os << ulValue;
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -251,13 +267,9 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, ULLONG ullValue)
 {
 	GPOS_ASSERT(NULL != pstrAttr);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	 // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer()	 // \"
-		 << ullValue
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // \"
+	StartAttribute(pstrAttr);
+	m_os << ullValue;
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -274,13 +286,9 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, INT iValue)
 {
 	GPOS_ASSERT(NULL != pstrAttr);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	 // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer()	 // \"
-		 << iValue
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // \"
+	StartAttribute(pstrAttr);
+	m_os << iValue;
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -297,13 +305,9 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, LINT value)
 {
 	GPOS_ASSERT(NULL != pstrAttr);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	 // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer()	 // \"
-		 << value
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // \"
+	StartAttribute(pstrAttr);
+	m_os << value;
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -320,13 +324,9 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, CDouble value)
 {
 	GPOS_ASSERT(NULL != pstrAttr);
 
-	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
-		 << pstrAttr->GetBuffer()
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	 // =
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer()	 // \"
-		 << value
-		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // \"
+	StartAttribute(pstrAttr);
+	m_os << value;
+	EndAttribute();
 }
 
 //---------------------------------------------------------------------------
@@ -355,6 +355,53 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, BOOL fValue)
 	AddAttribute(pstrAttr, str_value);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::StartAttribute
+//
+//	@doc:
+//		Start an attribute of the currently open XML tag; its value is then
+//		written to the output stream
+//
+//---------------------------------------------------------------------------
+void
+CXMLSerializer::StartAttribute(const CWStringBase *pstrAttr)
+{
+	GPOS_ASSERT(NULL != pstrAttr);
+	GPOS_ASSERT(m_fOpenTag);
+
+	if (NULL != m_binary_writer)
+	{
+		m_binary_writer->StartAttribute(pstrAttr);
+		return;
+	}
+
+	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
+		 << pstrAttr->GetBuffer()
+		 << CDXLTokens::GetDXLTokenStr(EdxltokenEq)->GetBuffer()	  // =
+		 << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // "
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::EndAttribute
+//
+//	@doc:
+//		Finish the attribute started last
+//
+//---------------------------------------------------------------------------
+void
+CXMLSerializer::EndAttribute()
+{
+	if (NULL != m_binary_writer)
+	{
+		m_binary_writer->EndAttribute();
+		return;
+	}
+
+	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenQuote)->GetBuffer();  // "
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CXMLSerializer::Indent
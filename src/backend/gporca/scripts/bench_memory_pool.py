@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+
+# Compares the memory pools used for optimization on a set of minidumps
+#
+# Every minidump is optimized by gporca_test twice, once in a pool of the
+# default type and once in an arena (gporca_test -a). For each run, the
+# elapsed time and the peak resident set size of the process are recorded,
+# the best of several repetitions is reported per minidump, followed by the
+# totals over all minidumps.
+#
+# Run this program with the -h or --help option to see argument syntax
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import time
+
+_help = """
+Run minidumps with gporca_test in the default memory pool and in an arena
+memory pool, and report elapsed time and peak RSS for both.
+"""
+
+POOLS = [("default", []), ("arena", ["-a"])]
+
+
+def run_minidump(gporca_test, mdp, extra_args):
+    """Run one minidump; return elapsed seconds and peak RSS in KB"""
+    start = time.monotonic()
+    proc = subprocess.Popen([gporca_test, "-d", mdp] + extra_args,
+                            stdout=subprocess.DEVNULL,
+                            stderr=subprocess.DEVNULL)
+    _, status, rusage = os.wait4(proc.pid, 0)
+    elapsed = time.monotonic() - start
+
+    if os.WIFEXITED(status) and os.WEXITSTATUS(status) == 0:
+        return elapsed, rusage.ru_maxrss
+    return None, None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=_help)
+    parser.add_argument("gporca_test", help="path to the gporca_test binary")
+    parser.add_argument("minidumps", nargs="+",
+                        help="minidump files, or directories containing them")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="number of runs per minidump and pool, the best "
+                             "of which is reported (default: 3)")
+    args = parser.parse_args()
+
+    files = []
+    for path in args.minidumps:
+        if os.path.isdir(path):
+            files.extend(sorted(glob.glob(os.path.join(path, "*.mdp"))))
+        else:
+            files.append(path)
+
+    totals = {name: [0.0, 0] for name, _ in POOLS}
+    header = "%-60s" % "minidump"
+    for name, _ in POOLS:
+        header += " %12s %12s" % (name + " ms", name + " KB")
+    print(header)
+
+    for mdp in files:
+        results = []
+        for name, extra_args in POOLS:
+            best_time, best_rss = None, None
+            for _ in range(args.repeat):
+                elapsed, rss = run_minidump(args.gporca_test, mdp, extra_args)
+                if elapsed is None:
+                    best_time = None
+                    break
+                if best_time is None or elapsed < best_time:
+                    best_time = elapsed
+                if best_rss is None or rss < best_rss:
+                    best_rss = rss
+            results.append((name, best_time, best_rss))
+
+        # skip minidumps that fail in either pool, so that totals compare
+        # the same work
+        if any(best_time is None for _, best_time, _ in results):
+            print("%-60s failed" % os.path.basename(mdp))
+            continue
+
+        line = "%-60s" % os.path.basename(mdp)
+        for name, best_time, best_rss in results:
+            line += " %12.1f %12d" % (best_time * 1000, best_rss)
+            totals[name][0] += best_time
+            totals[name][1] = max(totals[name][1], best_rss)
+        print(line)
+
+    line = "%-60s" % "total time / max peak RSS"
+    for name, _ in POOLS:
+        line += " %12.1f %12d" % (totals[name][0] * 1000, totals[name][1])
+    print(line)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,476 @@
+#!/usr/bin/env python3
+
+# Optimizer cost model calibration
+#
+# This program runs a suite of micro-queries, each of which adds a single
+# operator (a filter, a hash join, a redistribute motion, ...) to a simpler
+# baseline query. Every query is explained and executed on two tables of
+# different sizes, which gives, per row:
+#
+# - the time the operator adds to its baseline
+# - the cost the optimizer estimates for the operator
+#
+# Both are taken relative to a plain table scan, which anchors the units of
+# the cost model. When the operator takes relatively more time than the
+# optimizer estimates, the cost model parameters that drive the operator are
+# scaled up by the same ratio, and vice versa. Parameters shared by several
+# operators get the geometric mean of their ratios.
+#
+# The fitted parameters are written as a DXL file of cost parameters, which
+# the calibrated cost model reads when the optimizer_cost_model_params_path
+# GUC points to it:
+#
+#   SET optimizer_cost_model = calibrated;
+#   SET optimizer_cost_model_params_path = '/path/to/cost_params.xml';
+#
+# Run this on a cluster with the same hardware as the production one, for
+# example a demo cluster on one of its hosts. Run this program with the -h
+# or --help option to see argument syntax.
+
+import argparse
+import math
+import re
+import sys
+import time
+
+try:
+    from gppylib.db import dbconn
+except ImportError as e:
+    sys.exit('ERROR: Cannot import modules.  Please check that you have sourced greenplum_path.sh.  Detail: ' + str(e))
+
+# constants
+# -----------------------------------------------------------------------------
+
+_help = """
+Calibrate the parameters of the optimizer cost model on this cluster.
+This runs a suite of micro-queries, compares their execution times with the
+estimated costs, and writes the fitted cost model parameters to a file.
+"""
+
+# default values of the parameters of the calibrated cost model, as in
+# CCostModelParamsGPDB.cpp; only those fitted by the queries below
+DEFAULT_PARAMS = {
+    "FilterColCostUnit": 3.29e-05,
+    "GatherSendCostUnit": 4.58e-06,
+    "GatherRecvCostUnit": 2.20e-06,
+    "RedistributeSendCostUnit": 2.33e-06,
+    "RedistributeRecvCostUnit": 8.0e-07,
+    "BroadcastSendCostUnit": 4.965e-05,
+    "BroadcastRecvCostUnit": 1.35e-06,
+    "JoinFeedingTupColumnCostUnit": 8.69e-05,
+    "JoinFeedingTupWidthCostUnit": 6.09e-07,
+    "JoinOutputTupCostUnit": 3.50e-06,
+    "HJHashTableColumnCostUnit": 5.0e-05,
+    "HJHashTableWidthCostUnit": 3.0e-06,
+    "HJHashingTupWidthCostUnit": 1.97e-05,
+    "HashAggInputTupColumnCostUnit": 1.20e-04,
+    "HashAggInputTupWidthCostUnit": 1.12e-07,
+    "HashAggOutputTupWidthCostUnit": 5.61e-07,
+    "SortTupWidthCostUnit": 5.67e-06,
+    "NLJFactor": 1.0,
+}
+
+# a fitted parameter is not moved further than this factor from its default,
+# larger ratios come from noisy measurements rather than from the hardware
+MAX_FACTOR = 100.0
+
+# relative width of the bounds written for every fitted parameter
+BOUNDS_WIDTH = 0.1
+
+TABLE_NAME_PATTERN = "cal_cm_%d"
+DIM_TABLE_NAME = "cal_cm_dim"
+DIM_TABLE_ROWS = 100
+
+FALLBACK_PATTERN = "Postgres query optimizer"
+
+# The micro-queries. Every query has:
+# - name:     identifies the query, and is the baseline of other queries
+# - baseline: the query whose time and cost are subtracted, None for the scan
+# - sql:      the query, {t} is replaced with the table name, {n} with its
+#             number of rows
+# - setup:    GUCs to set to force the plan
+# - pattern:  an operator the plan must contain
+# - params:   the cost model parameters that drive the operator
+#
+# The scan query comes first, it anchors the units of the cost model.
+MICRO_QUERIES = [
+    {"name": "scan",
+     "baseline": None,
+     "sql": "SELECT count(*) FROM {t}",
+     "setup": [],
+     "pattern": r"Seq Scan",
+     "params": []},
+    {"name": "filter",
+     "baseline": "scan",
+     "sql": "SELECT count(*) FROM {t} WHERE a + b > -1 AND a - b < {n} AND g >= 0",
+     "setup": [],
+     "pattern": r"Filter:",
+     "params": ["FilterColCostUnit"]},
+    {"name": "hash_agg",
+     "baseline": "scan",
+     "sql": "SELECT count(*) FROM (SELECT id, count(*) FROM {t} GROUP BY id) s",
+     "setup": ["SET optimizer_enable_groupagg = off"],
+     "pattern": r"HashAggregate",
+     "params": ["HashAggInputTupColumnCostUnit", "HashAggInputTupWidthCostUnit",
+                "HashAggOutputTupWidthCostUnit"]},
+    {"name": "sort",
+     "baseline": "scan",
+     "sql": "SELECT count(*) FROM (SELECT row_number() OVER (PARTITION BY id ORDER BY a) FROM {t}) s",
+     "setup": [],
+     "pattern": r"Sort",
+     "params": ["SortTupWidthCostUnit"]},
+    {"name": "gather",
+     "baseline": "scan",
+     "sql": "SELECT count(*) FROM (SELECT id FROM {t} LIMIT {n}) s",
+     "setup": [],
+     "pattern": r"Gather Motion",
+     "params": ["GatherSendCostUnit", "GatherRecvCostUnit"]},
+    {"name": "hash_join",
+     "baseline": "scan",
+     "sql": "SELECT count(*) FROM {t} t1 JOIN {t} t2 ON t1.id = t2.id",
+     "setup": [],
+     "pattern": r"Hash Join",
+     "params": ["HJHashTableColumnCostUnit", "HJHashTableWidthCostUnit",
+                "HJHashingTupWidthCostUnit", "JoinFeedingTupColumnCostUnit",
+                "JoinFeedingTupWidthCostUnit", "JoinOutputTupCostUnit"]},
+    {"name": "redistribute",
+     "baseline": "hash_join",
+     "sql": "SELECT count(*) FROM {t} t1 JOIN {t} t2 ON t1.id = t2.b",
+     "setup": ["SET optimizer_enable_motion_broadcast = off"],
+     "pattern": r"Redistribute Motion",
+     "params": ["RedistributeSendCostUnit", "RedistributeRecvCostUnit"]},
+    {"name": "broadcast",
+     "baseline": "hash_join",
+     "sql": "SELECT count(*) FROM {t} t1 JOIN {t} t2 ON t1.id = t2.b",
+     "setup": ["SET optimizer_enable_motion_redistribute = off"],
+     "pattern": r"Broadcast Motion",
+     "params": ["BroadcastSendCostUnit", "BroadcastRecvCostUnit"]},
+    {"name": "nl_join",
+     "baseline": "scan",
+     "sql": "SELECT count(*) FROM {t} t JOIN " + DIM_TABLE_NAME + " d ON t.a < d.id",
+     "setup": [],
+     "pattern": r"Nested Loop",
+     "params": ["NLJFactor"]},
+]
+
+# GUCs the calibration runs with
+_session_setup = [
+    "SET optimizer = on",
+    "SET optimizer_cost_model = calibrated",
+    "SET optimizer_cost_model_params_path = ''",
+    "SET optimizer_nestloop_factor = 1.0",
+    "SET optimizer_sort_factor = 1.0",
+]
+
+# GUCs set by the micro-queries
+_query_reset = [
+    "RESET optimizer_enable_groupagg",
+    "RESET optimizer_enable_motion_broadcast",
+    "RESET optimizer_enable_motion_redistribute",
+]
+
+# global variables
+# -----------------------------------------------------------------------------
+
+glob_verbose = False
+glob_log_file = None
+
+# SQL statements, DDL and DML
+# -----------------------------------------------------------------------------
+
+_drop_table = "DROP TABLE IF EXISTS %s"
+
+# the table, id is unique and the distribution key, b is unique and not
+# collocated with id, g has one value per 10 rows
+_create_table = """
+CREATE TABLE %s (id int, a int, b int, g int, txt text)
+%s
+DISTRIBUTED BY (id)
+"""
+
+_with_appendonly = "WITH (appendonly=true)"
+
+_insert_table = """
+INSERT INTO %s
+SELECT i, i %% 1000, ((i::bigint * 7919) %% %d)::int, i / 10, 'cal_cm_' || i
+FROM generate_series(0, %d) i
+"""
+
+_create_dim_table = "CREATE TABLE %s (id int) DISTRIBUTED BY (id)"
+
+_insert_dim_table = "INSERT INTO %s SELECT i FROM generate_series(0, %d) i"
+
+_analyze_table = "ANALYZE %s"
+
+# deal with command line arguments
+# -----------------------------------------------------------------------------
+
+def parseargs():
+    parser = argparse.ArgumentParser(description=_help)
+
+    parser.add_argument("--create", action="store_true",
+                        help="Create the tables to use in the calibration")
+    parser.add_argument("--drop", action="store_true",
+                        help="Drop the tables used in the calibration when finished")
+    parser.add_argument("--execute", type=int, default="3",
+                        help="Number of times to execute every query, the fastest time is used (default is 3)")
+    parser.add_argument("--numRows", type=int, default="1000000",
+                        help="Number of rows of the smaller table, the larger one has 4 times as many (default is 1 million)")
+    parser.add_argument("--appendOnly", action="store_true",
+                        help="Create append-only tables. Default is heap tables")
+    parser.add_argument("--output", default="cost_params.xml",
+                        help="File to write the fitted cost model parameters to (default is cost_params.xml)")
+    parser.add_argument("--verbose", action="store_true",
+                        help="Print more verbose output")
+    parser.add_argument("--logFile", default="",
+                        help="Log diagnostic output to a file")
+    parser.add_argument("--host", default="",
+                        help="Host to connect to (default is localhost or $PGHOST, if set).")
+    parser.add_argument("--port", type=int, default="0",
+                        help="Port on the host to connect to (default is 0 or $PGPORT, if set)")
+    parser.add_argument("--dbName", default="",
+                        help="Database name to connect to")
+
+    args = parser.parse_args()
+    return args, parser
+
+
+def log_output(str):
+    if glob_verbose:
+        print(str)
+    if glob_log_file != None:
+        glob_log_file.write(str + "\n")
+
+
+# SQL related methods
+# -----------------------------------------------------------------------------
+
+def connect(host, port_num, db_name):
+    try:
+        dburl = dbconn.DbURL(hostname=host, port=port_num, dbname=db_name)
+        conn = dbconn.connect(dburl, encoding="UTF8", unsetSearchPath=False)
+
+    except Exception as e:
+        print(("Exception during connect: %s" % e))
+        quit()
+
+    return conn
+
+
+def execute_sql(conn, sqlStr):
+    log_output("Executing query: %s" % sqlStr)
+    dbconn.execSQL(conn, sqlStr)
+
+
+def execute_sql_arr(conn, sqlStrArr):
+    for sqlStr in sqlStrArr:
+        execute_sql(conn, sqlStr)
+
+
+def table_sizes(num_rows):
+    return [num_rows, 4 * num_rows]
+
+
+def create_tables(conn, num_rows, appendonly):
+    with_clause = _with_appendonly if appendonly else ""
+    for size in table_sizes(num_rows):
+        table_name = TABLE_NAME_PATTERN % size
+        execute_sql(conn, _drop_table % table_name)
+        execute_sql(conn, _create_table % (table_name, with_clause))
+        execute_sql(conn, _insert_table % (table_name, size, size - 1))
+        execute_sql(conn, _analyze_table % table_name)
+
+    execute_sql(conn, _drop_table % DIM_TABLE_NAME)
+    execute_sql(conn, _create_dim_table % DIM_TABLE_NAME)
+    execute_sql(conn, _insert_dim_table % (DIM_TABLE_NAME, DIM_TABLE_ROWS - 1))
+    execute_sql(conn, _analyze_table % DIM_TABLE_NAME)
+    execute_sql(conn, "commit")
+
+
+def drop_tables(conn, num_rows):
+    for size in table_sizes(num_rows):
+        execute_sql(conn, _drop_table % (TABLE_NAME_PATTERN % size))
+    execute_sql(conn, _drop_table % DIM_TABLE_NAME)
+    execute_sql(conn, "commit")
+
+
+# the estimated total cost in a line of explain output
+def cost_from_explain_line(line):
+    return float(re.sub(r".*\.\.([0-9.]+) rows.*", r"\1", line))
+
+
+# explain a query, return the estimated cost of the plan and whether the plan
+# contains the given operator; a plan of the Postgres planner does not count
+def explain_query(conn, sqlStr, pattern):
+    curs = dbconn.query(conn, "EXPLAIN " + sqlStr)
+    rows = curs.fetchall()
+    cost = -1.0
+    has_operator = False
+    for row in rows:
+        line = row[0]
+        log_output(line)
+        if cost < 0 and re.search(r"cost=", line):
+            cost = cost_from_explain_line(line)
+        if re.search(pattern, line):
+            has_operator = True
+        if re.search(FALLBACK_PATTERN, line):
+            return cost, False
+
+    return cost, has_operator
+
+
+# run a query n times, return the fastest elapsed time in msec
+def timed_execute_sql(conn, sqlStr, exec_n_times):
+    best = None
+    for e in range(exec_n_times):
+        start = time.time()
+        curs = dbconn.query(conn, sqlStr)
+        curs.fetchall()
+        elapsed_time_in_msec = (time.time() - start) * 1000
+        log_output("Elapsed time (msec): %.3f" % elapsed_time_in_msec)
+        if best is None or elapsed_time_in_msec < best:
+            best = elapsed_time_in_msec
+
+    return best
+
+
+# explain and execute every micro-query on every table, return two
+# dictionaries of per-row slopes indexed by query name: of the estimated
+# cost, and of the execution time
+def measure_queries(conn, num_rows, exec_n_times):
+    execute_sql_arr(conn, _session_setup)
+
+    sizes = table_sizes(num_rows)
+    cost_slopes = {}
+    time_slopes = {}
+    for query in MICRO_QUERIES:
+        costs = []
+        times = []
+        for size in sizes:
+            sqlStr = query["sql"].format(t=TABLE_NAME_PATTERN % size, n=size)
+            execute_sql_arr(conn, query["setup"])
+            cost, has_operator = explain_query(conn, sqlStr, query["pattern"])
+            if not has_operator:
+                print("Skipping query %s, its plan has no %s" % (query["name"], query["pattern"]))
+                break
+            costs.append(cost)
+            times.append(timed_execute_sql(conn, sqlStr, exec_n_times))
+
+        execute_sql_arr(conn, _query_reset)
+        if len(costs) == len(sizes):
+            rows = float(sizes[1] - sizes[0])
+            cost_slopes[query["name"]] = (costs[1] - costs[0]) / rows
+            time_slopes[query["name"]] = (times[1] - times[0]) / rows
+            log_output("Query %s: cost per row %g, msec per row %g" %
+                       (query["name"], cost_slopes[query["name"]], time_slopes[query["name"]]))
+
+    return cost_slopes, time_slopes
+
+
+# fitting
+# -----------------------------------------------------------------------------
+
+# the ratio of the measured and the estimated cost of every operator, both
+# relative to the scan, indexed by query name
+def fit_factors(cost_slopes, time_slopes):
+    factors = {}
+    if "scan" not in cost_slopes or cost_slopes["scan"] <= 0 or time_slopes["scan"] <= 0:
+        print("The scan query has no usable measurement, nothing to calibrate")
+        return factors
+
+    for query in MICRO_QUERIES:
+        name = query["name"]
+        baseline = query["baseline"]
+        if baseline is None or name not in cost_slopes or baseline not in cost_slopes:
+            continue
+
+        op_cost = cost_slopes[name] - cost_slopes[baseline]
+        op_time = time_slopes[name] - time_slopes[baseline]
+        if op_cost <= 0 or op_time <= 0:
+            # the operator is too cheap to be measured at these sizes
+            log_output("Query %s: operator not measurable, skipped" % name)
+            continue
+
+        factor = (op_time / time_slopes["scan"]) / (op_cost / cost_slopes["scan"])
+        factors[name] = min(max(factor, 1.0 / MAX_FACTOR), MAX_FACTOR)
+
+    return factors
+
+
+# the fitted parameters, indexed by name
+def fit_params(factors):
+    log_factors = {}
+    for query in MICRO_QUERIES:
+        if query["name"] not in factors:
+            continue
+        for param in query["params"]:
+            log_factors.setdefault(param, []).append(math.log(factors[query["name"]]))
+
+    params = {}
+    for param, logs in log_factors.items():
+        params[param] = DEFAULT_PARAMS[param] * math.exp(sum(logs) / len(logs))
+
+    return params
+
+
+def write_cost_params(file_name, params):
+    with open(file_name, "wt") as f:
+        f.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+        f.write('<dxl:DXLMessage xmlns:dxl="http://greenplum.com/dxl/2010/12/">\n')
+        f.write('  <dxl:CostParams>\n')
+        for param in sorted(params):
+            value = params[param]
+            f.write('    <dxl:CostParam Name="%s" Value="%.6g" LowerBound="%.6g" UpperBound="%.6g"/>\n' %
+                    (param, value, value * (1 - BOUNDS_WIDTH), value * (1 + BOUNDS_WIDTH)))
+        f.write('  </dxl:CostParams>\n')
+        f.write('</dxl:DXLMessage>\n')
+
+
+def print_results(factors, params):
+    print("")
+    print("Query\tFactor")
+    for query in MICRO_QUERIES:
+        if query["name"] in factors:
+            print("%s\t%.3f" % (query["name"], factors[query["name"]]))
+
+    print("")
+    print("Parameter\tDefault\tCalibrated")
+    for param in sorted(params):
+        print("%s\t%g\t%g" % (param, DEFAULT_PARAMS[param], params[param]))
+
+
+def main():
+    global glob_verbose
+    global glob_log_file
+
+    args, parser = parseargs()
+    if args.logFile != "":
+        glob_log_file = open(args.logFile, "wt", 1)
+    if args.verbose:
+        glob_verbose = True
+    log_output("Connecting to host %s on port %d, database %s" % (args.host, args.port, args.dbName))
+    conn = connect(args.host, args.port, args.dbName)
+
+    if args.create:
+        create_tables(conn, args.numRows, args.appendOnly)
+
+    cost_slopes, time_slopes = measure_queries(conn, args.numRows, max(args.execute, 1))
+    factors = fit_factors(cost_slopes, time_slopes)
+    params = fit_params(factors)
+    print_results(factors, params)
+
+    if params:
+        write_cost_params(args.output, params)
+        print("")
+        print("Wrote %d cost model parameters to %s" % (len(params), args.output))
+
+    if args.drop:
+        drop_tables(conn, args.numRows)
+
+    conn.close()
+    if glob_log_file != None:
+        glob_log_file.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+import unittest
+from unittest.mock import patch
+from unittest.mock import Mock
+
+import cal_cost_model
+from cal_cost_model import explain_query
+from cal_cost_model import fit_factors
+from cal_cost_model import fit_params
+
+class TestCostModelCalibration(unittest.TestCase):
+
+    @patch('gppylib.db.dbconn.query')
+    def test_explain_query(self, mock_query):
+        mock_query.return_value = Mock()
+        mock_query.return_value.fetchall.return_value = [
+            ["Aggregate  (cost=0.00..862.00 rows=1 width=8)"],
+            ["  ->  Gather Motion 3:1  (slice1; segments: 3)  (cost=0.00..862.00 rows=1 width=8)"],
+            ["        ->  Hash Join  (cost=0.00..862.00 rows=1 width=1)"],
+            ["              Hash Cond: (t1.id = t2.id)"],
+            ["Optimizer: Pivotal Optimizer (GPORCA)"]
+        ]
+
+        (cost, has_operator) = explain_query(Mock(), "mock sql query string", r"Hash Join")
+        self.assertEqual(cost, 862.00)
+        self.assertTrue(has_operator)
+
+    @patch('gppylib.db.dbconn.query')
+    def test_explain_query_fallback(self, mock_query):
+        mock_query.return_value = Mock()
+        mock_query.return_value.fetchall.return_value = [
+            ["Aggregate  (cost=10.00..11.00 rows=1 width=8)"],
+            ["  ->  Hash Join  (cost=0.00..10.00 rows=1 width=1)"],
+            ["Optimizer: Postgres query optimizer"]
+        ]
+
+        (cost, has_operator) = explain_query(Mock(), "mock sql query string", r"Hash Join")
+        self.assertFalse(has_operator)
+
+    def test_fit_unchanged(self):
+        # times proportional to the estimated costs leave the parameters alone
+        cost_slopes = {"scan": 1.0e-3, "filter": 1.5e-3, "hash_join": 4.0e-3, "redistribute": 5.0e-3}
+        time_slopes = {name: 2.0 * slope for name, slope in cost_slopes.items()}
+
+        factors = fit_factors(cost_slopes, time_slopes)
+        self.assertAlmostEqual(factors["filter"], 1.0)
+        self.assertAlmostEqual(factors["hash_join"], 1.0)
+        self.assertAlmostEqual(factors["redistribute"], 1.0)
+
+        params = fit_params(factors)
+        self.assertAlmostEqual(params["FilterColCostUnit"], cal_cost_model.DEFAULT_PARAMS["FilterColCostUnit"])
+
+    def test_fit_relative_to_baseline(self):
+        # the redistribute motion takes 4 times as long as estimated, relative
+        # to the scan and on top of the hash join it is added to
+        cost_slopes = {"scan": 1.0e-3, "hash_join": 4.0e-3, "redistribute": 5.0e-3}
+        time_slopes = {"scan": 1.0e-3, "hash_join": 4.0e-3, "redistribute": 8.0e-3}
+
+        factors = fit_factors(cost_slopes, time_slopes)
+        self.assertAlmostEqual(factors["redistribute"], 4.0)
+
+        params = fit_params(factors)
+        self.assertAlmostEqual(params["RedistributeSendCostUnit"],
+                               4.0 * cal_cost_model.DEFAULT_PARAMS["RedistributeSendCostUnit"])
+        self.assertNotIn("FilterColCostUnit", params)
+
+    def test_fit_unmeasurable(self):
+        # no usable scan, and an operator cheaper than its baseline
+        self.assertEqual(fit_factors({"filter": 1.0}, {"filter": 1.0}), {})
+
+        cost_slopes = {"scan": 1.0e-3, "filter": 1.5e-3}
+        time_slopes = {"scan": 1.0e-3, "filter": 0.9e-3}
+        self.assertNotIn("filter", fit_factors(cost_slopes, time_slopes))
+
+    def test_fit_clamped(self):
+        cost_slopes = {"scan": 1.0e-3, "sort": 1.001e-3}
+        time_slopes = {"scan": 1.0e-3, "sort": 2.0e-3}
+
+        factors = fit_factors(cost_slopes, time_slopes)
+        self.assertEqual(factors["sort"], cal_cost_model.MAX_FACTOR)
+
+
+if __name__ == '__main__':
+    unittest.main()
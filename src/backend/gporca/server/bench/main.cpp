@@ -0,0 +1,512 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		main.cpp
+//
+//	@doc:
+//		Minidump replay benchmark for the optimizer.
+//
+//		Every given minidump is optimized, and one line of tab-separated
+//		measurements is written for it to the output file:
+//
+//			minidump  status  time_ms  memory_peak_kb  groups  group_exprs
+//			xform_calls  stats_ms  xforms
+//
+//		The time is the best wall-clock time of the repetitions, memory is
+//		the peak size of the memory pool the optimization runs in, and
+//		xforms lists "name:calls" for every xform that produced
+//		alternatives.
+//
+//		Given a baseline file written by an earlier run, every measurement
+//		that grew by more than the threshold is reported as a regression,
+//		and the program exits with a non-zero status.
+//
+//		gporca_bench -d <minidump or directory> [-d ...] [-o output]
+//			[-r repetitions] [-b baseline] [-t threshold percent]
+//---------------------------------------------------------------------------
+
+#include <dirent.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gpos/_api.h"
+#include "gpos/types.h"
+#include "gpos/common/CMainArgs.h"
+#include "gpos/common/CWallClock.h"
+#include "gpos/io/ioutils.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+
+#include "gpopt/init.h"
+#include "gpopt/engine/COptimizationStats.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/xforms/CXformFactory.h"
+#include "gpopt/cost/ICostModel.h"
+
+#include "naucrates/init.h"
+
+#include "unittest/base.h"
+
+using namespace gpos;
+using namespace gpopt;
+
+// default number of optimizations per minidump, the best is reported
+#define GPOPT_BENCH_REPETITIONS 3
+
+// default threshold for reporting regressions, in percent
+#define GPOPT_BENCH_THRESHOLD 10
+
+// growth below which a measurement is never reported as a regression, so
+// that noise on small values is ignored
+#define GPOPT_BENCH_MIN_TIME_MS 5
+#define GPOPT_BENCH_MIN_MEMORY_KB 256
+#define GPOPT_BENCH_MIN_COUNT 1
+
+// measurements of one minidump
+struct SBenchResult
+{
+	std::string m_status;
+	DOUBLE m_time_ms;
+	DOUBLE m_memory_peak_kb;
+	DOUBLE m_groups;
+	DOUBLE m_group_exprs;
+	DOUBLE m_xform_calls;
+	DOUBLE m_stats_ms;
+	std::string m_xforms;
+};
+
+// names of the measurements compared against a baseline, their noise
+// floors, and their offsets in a result
+static const struct
+{
+	const CHAR *m_name;
+	DOUBLE m_min_growth;
+	DOUBLE SBenchResult::*m_value;
+} rgMeasurements[] = {
+	{"time_ms", GPOPT_BENCH_MIN_TIME_MS, &SBenchResult::m_time_ms},
+	{"memory_peak_kb", GPOPT_BENCH_MIN_MEMORY_KB,
+	 &SBenchResult::m_memory_peak_kb},
+	{"groups", GPOPT_BENCH_MIN_COUNT, &SBenchResult::m_groups},
+	{"group_exprs", GPOPT_BENCH_MIN_COUNT, &SBenchResult::m_group_exprs},
+	{"xform_calls", GPOPT_BENCH_MIN_COUNT, &SBenchResult::m_xform_calls},
+	{"stats_ms", GPOPT_BENCH_MIN_TIME_MS, &SBenchResult::m_stats_ms},
+};
+
+// options of a run
+struct SBenchOptions
+{
+	std::vector<std::string> m_minidumps;
+	const CHAR *m_output;
+	const CHAR *m_baseline;
+	ULONG m_repetitions;
+	ULONG m_threshold;
+};
+
+// number of regressions found by the comparison with the baseline
+static ULONG regressions = 0;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		AddMinidumps
+//
+//	@doc:
+//		Add the given minidump, or the minidumps in the given directory in
+//		name order, to the list of minidumps to run
+//
+//---------------------------------------------------------------------------
+static void
+AddMinidumps(std::vector<std::string> &minidumps, const CHAR *path)
+{
+	if (!ioutils::IsDir(path))
+	{
+		minidumps.push_back(path);
+		return;
+	}
+
+	std::vector<std::string> files;
+	DIR *dir = opendir(path);
+	if (NULL != dir)
+	{
+		struct dirent *entry = NULL;
+		while (NULL != (entry = readdir(dir)))
+		{
+			std::string name(entry->d_name);
+			if (4 < name.size() &&
+				0 == name.compare(name.size() - 4, 4, ".mdp"))
+			{
+				files.push_back(std::string(path) + "/" + name);
+			}
+		}
+		closedir(dir);
+	}
+
+	std::sort(files.begin(), files.end());
+	minidumps.insert(minidumps.end(), files.begin(), files.end());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		RunMinidump
+//
+//	@doc:
+//		Optimize the given minidump the given number of times, each time in
+//		a fresh memory pool, and return its measurements
+//
+//---------------------------------------------------------------------------
+static SBenchResult
+RunMinidump(const CHAR *file_name, ULONG repetitions)
+{
+	SBenchResult result = {"ok", 0, 0, 0, 0, 0, 0, ""};
+
+	// a minidump that fails to optimize leaves the objects loaded from it
+	// behind, they are released with the pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	CMemoryPool *mp = amp.Pmp();
+
+	GPOS_TRY
+	{
+		CDXLMinidump *pdxlmd = CMinidumperUtils::PdxlmdLoad(mp, file_name);
+
+		COptimizerConfig *optimizer_config = pdxlmd->GetOptimizerConfig();
+		if (NULL == optimizer_config)
+		{
+			optimizer_config = COptimizerConfig::PoconfDefault(mp);
+		}
+		else
+		{
+			optimizer_config->AddRef();
+		}
+
+		COptimizationStats *optimization_stats =
+			GPOS_NEW(mp) COptimizationStats(mp);
+		optimization_stats->AddRef();
+		optimizer_config->SetOptimizationStats(optimization_stats);
+
+		ULONG ulSegments = GPOPT_TEST_SEGMENTS;
+		if (ulSegments < optimizer_config->GetCostModel()->UlHosts())
+		{
+			ulSegments = optimizer_config->GetCostModel()->UlHosts();
+		}
+
+		for (ULONG ul = 0; ul < repetitions; ul++)
+		{
+			// optimize in a pool of its own, whose peak size is the memory
+			// used by the optimization
+			CAutoMemoryPool ampRun;
+			CMemoryPool *pmpRun = ampRun.Pmp();
+
+			optimization_stats->Reset();
+
+			CWallClock clock;
+			CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump(
+				pmpRun, pdxlmd, file_name, ulSegments, 1 /*ulSessionId*/,
+				1 /*ulCmdId*/, optimizer_config, NULL /*pceeval*/);
+			DOUBLE time_ms = (DOUBLE) clock.ElapsedUS() / GPOS_USEC_IN_MSEC;
+			pdxlnPlan->Release();
+
+			if (0 == ul || time_ms < result.m_time_ms)
+			{
+				result.m_time_ms = time_ms;
+			}
+
+			DOUBLE memory_peak_kb = (DOUBLE) pmpRun->PeakAllocatedSize() / 1024;
+			if (0 == ul || memory_peak_kb < result.m_memory_peak_kb)
+			{
+				result.m_memory_peak_kb = memory_peak_kb;
+			}
+		}
+
+		// the counters are the same in every repetition, and those of the
+		// last one are kept
+		result.m_groups = optimization_stats->UlGroups();
+		result.m_group_exprs = optimization_stats->UlGroupExprs();
+		result.m_xform_calls = optimization_stats->UlXformCallsTotal();
+		result.m_stats_ms =
+			(DOUBLE) optimization_stats->UllPhaseTime(
+				COptimizationStats::EphStatsDerivation) /
+			GPOS_USEC_IN_MSEC;
+
+		std::ostringstream xforms;
+		for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+		{
+			ULONG ulCalls = optimization_stats->UlXformCalls(ul);
+			if (0 < ulCalls)
+			{
+				xforms << (xforms.tellp() > 0 ? "," : "")
+					   << CXformFactory::Pxff()
+							  ->Pxf((CXform::EXformId) ul)
+							  ->SzId()
+					   << ":" << ulCalls;
+			}
+		}
+		result.m_xforms = xforms.str();
+
+		optimization_stats->Release();
+		optimizer_config->Release();
+		GPOS_DELETE(pdxlmd);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// minidumps that fail to optimize are reported, and not measured
+		result.m_status = "error";
+		GPOS_RESET_EX;
+	}
+	GPOS_CATCH_END;
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		WriteResult
+//
+//	@doc:
+//		Write the measurements of a minidump as a line of the output
+//
+//---------------------------------------------------------------------------
+static void
+WriteResult(std::ostream &os, const std::string &minidump,
+			const SBenchResult &result)
+{
+	os << minidump << "\t" << result.m_status;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgMeasurements); ul++)
+	{
+		os << "\t" << result.*rgMeasurements[ul].m_value;
+	}
+	os << "\t" << result.m_xforms << std::endl;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		ReadBaseline
+//
+//	@doc:
+//		Read the measurements of a baseline run, indexed by minidump
+//
+//---------------------------------------------------------------------------
+static std::map<std::string, SBenchResult>
+ReadBaseline(const CHAR *file_name)
+{
+	std::map<std::string, SBenchResult> baseline;
+	std::ifstream is(file_name);
+	std::string line;
+
+	// skip the header
+	std::getline(is, line);
+	while (std::getline(is, line))
+	{
+		std::istringstream fields(line);
+		std::string minidump;
+		SBenchResult result = {"", 0, 0, 0, 0, 0, 0, ""};
+		std::getline(fields, minidump, '\t');
+		std::getline(fields, result.m_status, '\t');
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgMeasurements); ul++)
+		{
+			std::string value;
+			std::getline(fields, value, '\t');
+			result.*rgMeasurements[ul].m_value = std::atof(value.c_str());
+		}
+		std::getline(fields, result.m_xforms, '\t');
+		baseline[minidump] = result;
+	}
+
+	return baseline;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		UlCompare
+//
+//	@doc:
+//		Report the measurements of a minidump that grew by more than the
+//		threshold since the baseline; return their number
+//
+//---------------------------------------------------------------------------
+static ULONG
+UlCompare(const std::string &minidump, const SBenchResult &result,
+		  const SBenchResult &baseline, ULONG threshold)
+{
+	if ("ok" != result.m_status || "ok" != baseline.m_status)
+	{
+		if (result.m_status != baseline.m_status)
+		{
+			std::cout << "[BENCH]: " << minidump << ": status "
+					  << baseline.m_status << " -> " << result.m_status
+					  << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	ULONG ulRegressions = 0;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgMeasurements); ul++)
+	{
+		DOUBLE before = baseline.*rgMeasurements[ul].m_value;
+		DOUBLE after = result.*rgMeasurements[ul].m_value;
+		if (after - before >= rgMeasurements[ul].m_min_growth &&
+			after > before * (100 + threshold) / 100)
+		{
+			std::cout << "[BENCH]: " << minidump << ": "
+					  << rgMeasurements[ul].m_name << " " << before << " -> "
+					  << after << std::endl;
+			ulRegressions++;
+		}
+	}
+
+	return ulRegressions;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PvExec
+//
+//	@doc:
+//		Function driving execution
+//
+//---------------------------------------------------------------------------
+static void *
+PvExec(void *pv)
+{
+	SBenchOptions *options = (SBenchOptions *) pv;
+
+	InitDXL();
+	CMDCache::Init();
+
+	std::map<std::string, SBenchResult> baseline;
+	if (NULL != options->m_baseline)
+	{
+		baseline = ReadBaseline(options->m_baseline);
+	}
+
+	std::ofstream os(options->m_output);
+	os << "minidump\tstatus";
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgMeasurements); ul++)
+	{
+		os << "\t" << rgMeasurements[ul].m_name;
+	}
+	os << "\txforms" << std::endl;
+
+	for (ULONG ul = 0; ul < options->m_minidumps.size(); ul++)
+	{
+		const std::string &minidump = options->m_minidumps[ul];
+		SBenchResult result =
+			RunMinidump(minidump.c_str(), options->m_repetitions);
+		WriteResult(os, minidump, result);
+
+		std::map<std::string, SBenchResult>::const_iterator it =
+			baseline.find(minidump);
+		if (it != baseline.end())
+		{
+			regressions +=
+				UlCompare(minidump, result, it->second, options->m_threshold);
+		}
+	}
+
+	if (NULL != options->m_baseline)
+	{
+		std::cout << "[BENCH]: " << regressions << " regressions above "
+				  << options->m_threshold << "% in "
+				  << options->m_minidumps.size() << " minidumps"
+				  << std::endl;
+	}
+
+	CMDCache::Shutdown();
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		main
+//
+//	@doc:
+//		Entry point for the benchmark binary
+//
+//---------------------------------------------------------------------------
+INT
+main(INT iArgs, const CHAR **rgszArgs)
+{
+	// Use default allocator
+	struct gpos_init_params gpos_params = {NULL};
+
+	gpos_init(&gpos_params);
+	gpdxl_init();
+	gpopt_init();
+
+	GPOS_ASSERT(iArgs >= 0);
+
+	SBenchOptions options;
+	options.m_output = "gporca_bench.tsv";
+	options.m_baseline = NULL;
+	options.m_repetitions = GPOPT_BENCH_REPETITIONS;
+	options.m_threshold = GPOPT_BENCH_THRESHOLD;
+
+	{
+		CMainArgs ma(iArgs, rgszArgs, "d:o:r:b:t:");
+		CHAR ch = '\0';
+		while (ma.Getopt(&ch))
+		{
+			switch (ch)
+			{
+				case 'd':
+					AddMinidumps(options.m_minidumps, optarg);
+					break;
+
+				case 'o':
+					options.m_output = optarg;
+					break;
+
+				case 'r':
+					options.m_repetitions =
+						std::max(1, std::atoi(optarg));
+					break;
+
+				case 'b':
+					options.m_baseline = optarg;
+					break;
+
+				case 't':
+					options.m_threshold = std::max(0, std::atoi(optarg));
+					break;
+
+				default:
+					// ignore other parameters
+					break;
+			}
+		}
+	}
+
+	if (options.m_minidumps.empty())
+	{
+		std::cerr << "usage: " << rgszArgs[0]
+				  << " -d <minidump or directory> [-d ...] [-o output]"
+					 " [-r repetitions] [-b baseline] [-t threshold percent]"
+				  << std::endl;
+		return 1;
+	}
+
+	gpos_exec_params params;
+	params.func = PvExec;
+	params.arg = &options;
+	params.stack_start = &params;
+	params.error_buffer = NULL;
+	params.error_buffer_size = -1;
+	params.abort_requested = NULL;
+
+	if (gpos_exec(&params) || (regressions != 0))
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+// EOF
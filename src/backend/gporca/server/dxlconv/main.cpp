@@ -0,0 +1,188 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		main.cpp
+//
+//	@doc:
+//		Converter between XML and binary DXL documents.
+//
+//		A binary document, or a hex-encoded one as printed by EXPLAIN with
+//		optimizer_dxl_binary on, is converted to indented XML; an XML
+//		document is converted to binary.
+//
+//		gporca_dxlconv -i <input file> -o <output file>
+//---------------------------------------------------------------------------
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gpos/_api.h"
+#include "gpos/types.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CMainArgs.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+
+#include "naucrates/init.h"
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+
+using namespace gpos;
+using namespace gpdxl;
+
+// options of a run
+struct SConvOptions
+{
+	const CHAR *m_input;
+	const CHAR *m_output;
+};
+
+//---------------------------------------------------------------------------
+//	@function:
+//		DecodeHex
+//
+//	@doc:
+//		Decode the given document if it is hex-encoded with a "\x" prefix
+//
+//---------------------------------------------------------------------------
+static void
+DecodeHex(std::string &doc)
+{
+	// ignore the line break after the document
+	while (!doc.empty() && ('\n' == doc[doc.size() - 1] ||
+							'\r' == doc[doc.size() - 1]))
+	{
+		doc.erase(doc.size() - 1);
+	}
+
+	if (2 > doc.size() || '\\' != doc[0] || 'x' != doc[1] ||
+		0 != doc.size() % 2)
+	{
+		return;
+	}
+
+	std::string decoded;
+	for (ULONG ul = 2; ul < doc.size(); ul += 2)
+	{
+		decoded.push_back(
+			(CHAR) std::stoi(doc.substr(ul, 2), NULL /*idx*/, 16 /*base*/));
+	}
+	doc.swap(decoded);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PvExec
+//
+//	@doc:
+//		Function driving execution
+//
+//---------------------------------------------------------------------------
+static void *
+PvExec(void *pv)
+{
+	SConvOptions *options = (SConvOptions *) pv;
+
+	InitDXL();
+
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	std::ifstream is(options->m_input, std::ios::binary);
+	std::string doc((std::istreambuf_iterator<char>(is)),
+					std::istreambuf_iterator<char>());
+	DecodeHex(doc);
+
+	std::ofstream os(options->m_output, std::ios::binary);
+
+	if (CDXLBinaryFormat::IsBinary((const BYTE *) doc.data(),
+								   (ULONG) doc.size()))
+	{
+		CAutoP<CWStringDynamic> xml(CDXLUtils::ConvertBinaryToXML(
+			mp, (const BYTE *) doc.data(), (ULONG) doc.size(),
+			true /*indentation*/));
+		CAutoRg<CHAR> str(CDXLUtils::CreateMultiByteCharStringFromWCString(
+			mp, xml->GetBuffer()));
+		os << str.Rgt();
+	}
+	else
+	{
+		ULONG length = 0;
+		CAutoRg<BYTE> binary(
+			CDXLUtils::ConvertXMLToBinary(mp, doc.c_str(), &length));
+		os.write((const char *) binary.Rgt(), length);
+	}
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		main
+//
+//	@doc:
+//		Entry point for the converter binary
+//
+//---------------------------------------------------------------------------
+INT
+main(INT iArgs, const CHAR **rgszArgs)
+{
+	// Use default allocator
+	struct gpos_init_params gpos_params = {NULL};
+
+	gpos_init(&gpos_params);
+	gpdxl_init();
+
+	GPOS_ASSERT(iArgs >= 0);
+
+	SConvOptions options = {NULL, NULL};
+
+	{
+		CMainArgs ma(iArgs, rgszArgs, "i:o:");
+		CHAR ch = '\0';
+		while (ma.Getopt(&ch))
+		{
+			switch (ch)
+			{
+				case 'i':
+					options.m_input = optarg;
+					break;
+
+				case 'o':
+					options.m_output = optarg;
+					break;
+
+				default:
+					// ignore other parameters
+					break;
+			}
+		}
+	}
+
+	if (NULL == options.m_input || NULL == options.m_output)
+	{
+		std::cerr << "usage: " << rgszArgs[0]
+				  << " -i <input file> -o <output file>" << std::endl;
+		return 1;
+	}
+
+	gpos_exec_params params;
+	params.func = PvExec;
+	params.arg = &options;
+	params.stack_start = &params;
+	params.error_buffer = NULL;
+	params.error_buffer_size = -1;
+	params.abort_requested = NULL;
+
+	if (gpos_exec(&params))
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+// EOF
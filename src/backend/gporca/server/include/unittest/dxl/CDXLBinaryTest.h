@@ -0,0 +1,53 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryTest.h
+//
+//	@doc:
+//		Tests the binary DXL format
+//---------------------------------------------------------------------------
+
+#ifndef GPOPT_CDXLBinaryTest_H
+#define GPOPT_CDXLBinaryTest_H
+
+#include "gpos/base.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryTest
+//
+//	@doc:
+//		Static unit tests
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryTest
+{
+private:
+	// files with plans
+	static const CHAR *m_rgszPlanFileNames[];
+
+	// files with metadata objects
+	static const CHAR *m_rgszMetadataFileNames[];
+
+	// convert the given XML document to binary and back
+	static BOOL FConvertRoundTrip(CMemoryPool *mp, const CHAR *dxl_string);
+
+public:
+	// unittests
+	static GPOS_RESULT EresUnittest();
+	static GPOS_RESULT EresUnittest_Plan();
+	static GPOS_RESULT EresUnittest_Metadata();
+	static GPOS_RESULT EresUnittest_Malformed();
+
+};	// class CDXLBinaryTest
+}  // namespace gpdxl
+
+#endif	// !GPOPT_CDXLBinaryTest_H
+
+// EOF
@@ -27,10 +27,26 @@ namespace gpnaucrates
 class CHistogramTest
 {
 private:
+	// shape of a bucket
+	struct SBucketSpec
+	{
+		INT m_lower;
+		INT m_upper;
+		BOOL m_is_lower_closed;
+		BOOL m_is_upper_closed;
+		DOUBLE m_frequency;
+		DOUBLE m_distinct;
+	};
+
 	// generate int histogram having tuples not covered by buckets,
 	// including null fraction and nDistinctRemain
 	static CHistogram *PhistExampleInt4Remain(CMemoryPool *mp);
 
+	// generate an int4 or a float8 histogram with the given buckets
+	static CHistogram *PhistFromSpecs(CMemoryPool *mp,
+									  const SBucketSpec *bucket_specs,
+									  ULONG num_buckets, BOOL is_float8);
+
 public:
 	// unittests
 	static GPOS_RESULT EresUnittest();
@@ -50,6 +66,9 @@ public:
 
 	// merge union test with double values differing by less than epsilon
 	static GPOS_RESULT EresUnittest_MergeUnionDoubleLessThanEpsilon();
+
+	// equality join on the columnar form of int4 buckets
+	static GPOS_RESULT EresUnittest_JoinColumnar();
 };	// class CHistogramTest
 }  // namespace gpnaucrates
 
@@ -36,6 +36,8 @@ public:
 
 	static GPOS_RESULT EresUnittest_CPointBool();
 
+	static GPOS_RESULT EresUnittest_CPointStatsMapping();
+
 };	// class CPointTest
 }  // namespace gpnaucrates
 
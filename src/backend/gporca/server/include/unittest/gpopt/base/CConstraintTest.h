@@ -118,6 +118,8 @@ public:
 	static GPOS_RESULT EresUnittest_CConstraintIntervalConvertsTo();
 	static GPOS_RESULT EresUnittest_CConstraintIntervalPexpr();
 	static GPOS_RESULT EresUnittest_CConstraintIntervalFromArrayExpr();
+	static GPOS_RESULT EresUnittest_CConstraintFromLargeArrayExpr();
+	static GPOS_RESULT EresUnittest_CConstraintFromLargeInAndOrList();
 
 #ifdef GPOS_DEBUG
 	// tests for unconstrainable types
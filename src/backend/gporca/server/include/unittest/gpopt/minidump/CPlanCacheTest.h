@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CPlanCacheTest.h
+//
+//	@doc:
+//		Test for looking up plans in the plan cache
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CPlanCacheTest_H
+#define GPOPT_CPlanCacheTest_H
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/operators/CDXLNode.h"
+
+namespace gpopt
+{
+using namespace gpos;
+using namespace gpdxl;
+
+// fwd declarations
+class CMDAccessor;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CPlanCacheTest
+//
+//	@doc:
+//		Unittests
+//
+//---------------------------------------------------------------------------
+class CPlanCacheTest
+{
+private:
+	// copy of the given tree with all int4 constants set to the given value
+	static CDXLNode *PdxlnSetInt4Consts(CMemoryPool *mp,
+										const CDXLNode *dxlnode, INT value);
+
+	// optimize the given query and serialize the plan
+	static CWStringDynamic *PstrOptimize(CMemoryPool *mp,
+										 CMDAccessor *md_accessor,
+										 const CDXLNode *query,
+										 const CDXLNodeArray *query_output,
+										 const CDXLNodeArray *cte_producers,
+										 BOOL fPlanCache = true);
+
+public:
+	// unittests
+	static GPOS_RESULT EresUnittest();
+	static GPOS_RESULT EresUnittest_Hit();
+	static GPOS_RESULT EresUnittest_Rebind();
+	static GPOS_RESULT EresUnittest_Reset();
+
+};	// class CPlanCacheTest
+}  // namespace gpopt
+
+#endif	// !GPOPT_CPlanCacheTest_H
+
+// EOF
@@ -46,6 +46,9 @@ private:
 	static void BuildMemo(CMemoryPool *mp, CExpression *pexprInput,
 						  CSearchStageArray *search_stage_array);
 
+	// generate an n-ary cross product of the given number of tables
+	static CExpression *PexprCrossProduct(CMemoryPool *mp, ULONG ulRels);
+
 public:
 	// unittests driver
 	static GPOS_RESULT EresUnittest();
@@ -67,6 +70,9 @@ public:
 	// test exception handling when parsing search strategy
 	static GPOS_RESULT EresUnittest_ParsingWithException();
 
+	// test picking the search strategy from the complexity of the query
+	static GPOS_RESULT EresUnittest_Adaptive();
+
 };	// CSearchStrategyTest
 
 }  // namespace gpopt
@@ -31,10 +31,28 @@ private:
 	// counter used to mark last successful test
 	static ULONG m_ulTestCounter;
 
+	// count the predicates and cross products of a DPccp join order
+	static void CheckDPccpJoins(CMemoryPool *mp, CExpression *pexpr,
+								ULONG *pulPreds, ULONG *pulCross,
+								BOOL *pfValid);
+
+	// check the DPccp join order of the given join graph
+	static GPOS_RESULT EresCheckDPccp(const CHAR *szGraph, ULONG ulRels,
+									  const ULONG (*rgulEdges)[2],
+									  ULONG ulEdges, BOOL fHyperedge,
+									  ULONG ulCrossExpected, BOOL fPrint,
+									  ULONG ulMaxElapsedMS = gpos::ulong_max);
+
 public:
 	// unittests
 	static GPOS_RESULT EresUnittest();
 	static GPOS_RESULT EresUnittest_ExpandMinCard();
+	static GPOS_RESULT EresUnittest_DPccpChain();
+	static GPOS_RESULT EresUnittest_DPccpStar();
+	static GPOS_RESULT EresUnittest_DPccpClique();
+	static GPOS_RESULT EresUnittest_DPccpDisconnected();
+	static GPOS_RESULT EresUnittest_DPccpHyperedge();
+	static GPOS_RESULT EresUnittest_DPccpTimings();
 	static GPOS_RESULT EresUnittest_RunTests();
 
 };	// class CJoinOrderTest
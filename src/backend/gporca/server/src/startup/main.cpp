@@ -15,6 +15,7 @@
 
 #include "naucrates/init.h"
 
+#include "gpos/common/CBitVector.h"
 #include "gpos/common/CMainArgs.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
@@ -34,6 +35,7 @@
 #include "unittest/base.h"
 #include "unittest/gpopt/search/CTreeMapTest.h"
 
+#include "unittest/dxl/CDXLBinaryTest.h"
 #include "unittest/dxl/CDXLMemoryManagerTest.h"
 #include "unittest/dxl/CDXLUtilsTest.h"
 #include "unittest/dxl/CParseHandlerManagerTest.h"
@@ -87,6 +89,7 @@
 #include "unittest/gpopt/minidump/CPhysicalParallelUnionAllTest.h"
 #include "unittest/gpopt/minidump/CPruneColumnsTest.h"
 #include "unittest/gpopt/minidump/CMissingStatsTest.h"
+#include "unittest/gpopt/minidump/CPlanCacheTest.h"
 #include "unittest/gpopt/minidump/CBitmapTest.h"
 #include "unittest/gpopt/minidump/CCTETest.h"
 #include "unittest/gpopt/minidump/CExternalTableTest.h"
@@ -150,11 +153,13 @@ static gpos::CUnittest rgut[] = {
 	GPOS_UNITTEST_STD(CCollapseProjectTest),
 	GPOS_UNITTEST_STD(CPruneColumnsTest),
 	GPOS_UNITTEST_STD(CPhysicalParallelUnionAllTest),
-	GPOS_UNITTEST_STD(CMissingStatsTest), GPOS_UNITTEST_STD(CBitmapTest),
+	GPOS_UNITTEST_STD(CMissingStatsTest), GPOS_UNITTEST_STD(CPlanCacheTest),
+	GPOS_UNITTEST_STD(CBitmapTest),
 	GPOS_UNITTEST_STD(CCTETest), GPOS_UNITTEST_STD(CExternalTableTest),
 	GPOS_UNITTEST_STD(CEscapeMechanismTest),
 
 	GPOS_UNITTEST_STD(CMinidumpWithConstExprEvaluatorTest),
+	GPOS_UNITTEST_STD(CDXLBinaryTest),
 	GPOS_UNITTEST_STD(CParseHandlerManagerTest),
 	GPOS_UNITTEST_STD(CParseHandlerTest),
 	GPOS_UNITTEST_STD(CParseHandlerCostModelTest),
@@ -274,6 +279,7 @@ PvExec(void *pv)
 	CHAR *file_name = NULL;
 	BOOL fMinidump = false;
 	BOOL fUnittest = false;
+	BOOL fArena = false;
 	ULLONG ullPlanId = 0;
 
 	while (pma->Getopt(&ch))
@@ -310,6 +316,10 @@ PvExec(void *pv)
 				file_name = optarg;
 				break;
 
+			case 'a':
+				fArena = true;
+				break;
+
 			default:
 				// ignore other parameters
 				break;
@@ -330,7 +340,10 @@ PvExec(void *pv)
 
 		CMDCache::Init();
 
-		CAutoMemoryPool amp;
+		// optimize in an arena, as the server does, if requested
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcExc,
+							fArena ? CAutoMemoryPool::EptArena
+								   : CAutoMemoryPool::EptDefault);
 		CMemoryPool *mp = amp.Pmp();
 
 		// load dump file
@@ -397,7 +410,7 @@ main(INT iArgs, const CHAR **rgszArgs)
 	GPOS_ASSERT(iArgs >= 0);
 
 	// setup args for unittest params
-	CMainArgs ma(iArgs, rgszArgs, "uU:d:xT:i:");
+	CMainArgs ma(iArgs, rgszArgs, "uU:d:axT:i:");
 
 	// initialize unittest framework
 	CUnittest::Init(rgut, GPOS_ARRAY_SIZE(rgut), ConfigureTests, Cleanup);
@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CDXLBinaryTest.cpp
+//
+//	@doc:
+//		Tests writing, reading and converting binary DXL documents.
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/error/CAutoTrace.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/test/CUnittest.h"
+
+#include "naucrates/exception.h"
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+
+#include "unittest/dxl/CDXLBinaryTest.h"
+
+using namespace gpos;
+using namespace gpdxl;
+
+// files with plans
+const CHAR *CDXLBinaryTest::m_rgszPlanFileNames[] = {
+	"../data/dxl/parse_tests/q1-TS.xml",
+	"../data/dxl/parse_tests/q9-constval.xml",
+	"../data/dxl/parse_tests/q25-AppendPartTable.xml",
+	"../data/dxl/parse_tests/q44-Window.xml",
+	"../data/dxl/parse_tests/q61-PlanWithStats.xml",
+	"../data/dxl/parse_tests/q62-CTEPlan.xml",
+};
+
+// files with metadata objects
+const CHAR *CDXLBinaryTest::m_rgszMetadataFileNames[] = {
+	"../data/dxl/parse_tests/q26-Metadata.xml",
+};
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryTest::EresUnittest
+//
+//	@doc:
+//		Unittest for binary DXL
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLBinaryTest::EresUnittest()
+{
+	CUnittest rgut[] = {
+		GPOS_UNITTEST_FUNC(CDXLBinaryTest::EresUnittest_Plan),
+		GPOS_UNITTEST_FUNC(CDXLBinaryTest::EresUnittest_Metadata),
+		GPOS_UNITTEST_FUNC(CDXLBinaryTest::EresUnittest_Malformed)};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryTest::FConvertRoundTrip
+//
+//	@doc:
+//		Convert the given XML document to binary and back, and check that
+//		the result is the original document
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLBinaryTest::FConvertRoundTrip(CMemoryPool *mp, const CHAR *dxl_string)
+{
+	ULONG length = 0;
+	CAutoRg<BYTE> binary(
+		CDXLUtils::ConvertXMLToBinary(mp, dxl_string, &length));
+	GPOS_ASSERT(CDXLBinaryFormat::IsBinary(binary.Rgt(), length));
+
+	CAutoP<CWStringDynamic> xml(CDXLUtils::ConvertBinaryToXML(
+		mp, binary.Rgt(), length, true /*indentation*/));
+
+	CWStringDynamic expected(mp);
+	expected.AppendFormat(GPOS_WSZ_LIT("%s"), dxl_string);
+
+	if (!expected.Equals(xml.Value()))
+	{
+		CAutoTrace at(mp);
+		at.Os() << "Expected:" << std::endl
+				<< expected.GetBuffer() << std::endl
+				<< "Converted:" << std::endl
+				<< xml->GetBuffer();
+
+		return false;
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryTest::EresUnittest_Plan
+//
+//	@doc:
+//		Write plans as binary DXL, parse them back and check that they
+//		serialize to the original XML documents
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLBinaryTest::EresUnittest_Plan()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(m_rgszPlanFileNames); ul++)
+	{
+		CAutoRg<CHAR> dxl_string(CDXLUtils::Read(mp, m_rgszPlanFileNames[ul]));
+
+		ULLONG plan_id = 0;
+		ULLONG plan_space_size = 0;
+		CDXLNode *dxlnode = CDXLUtils::GetPlanDXLNode(
+			mp, dxl_string.Rgt(), NULL /*xsd_file_path*/, &plan_id,
+			&plan_space_size);
+
+		ULONG length = 0;
+		CAutoRg<BYTE> binary(CDXLUtils::SerializePlanToBinary(
+			mp, dxlnode, plan_id, plan_space_size, &length));
+		dxlnode->Release();
+
+		// binary documents are recognized by the string entry point taking
+		// their length
+		CAutoP<CParseHandlerDXL> parse_handler_dxl(
+			CDXLUtils::GetParseHandlerForDXLString(
+				mp, (const CHAR *) binary.Rgt(), length,
+				NULL /*xsd_file_path*/));
+
+		CWStringDynamic str(mp);
+		COstreamString oss(&str);
+		CDXLUtils::SerializePlan(mp, oss, parse_handler_dxl->PdxlnPlan(),
+								 parse_handler_dxl->GetPlanId(),
+								 parse_handler_dxl->GetPlanSpaceSize(),
+								 true /*serialize_header_footer*/,
+								 true /*indentation*/);
+
+		CWStringDynamic expected(mp);
+		expected.AppendFormat(GPOS_WSZ_LIT("%s"), dxl_string.Rgt());
+
+		if (!expected.Equals(&str) || !FConvertRoundTrip(mp, dxl_string.Rgt()))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryTest::EresUnittest_Metadata
+//
+//	@doc:
+//		Parse metadata objects from binary DXL and check that they
+//		serialize to the original XML documents
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLBinaryTest::EresUnittest_Metadata()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(m_rgszMetadataFileNames); ul++)
+	{
+		CAutoRg<CHAR> dxl_string(
+			CDXLUtils::Read(mp, m_rgszMetadataFileNames[ul]));
+
+		ULONG length = 0;
+		CAutoRg<BYTE> binary(
+			CDXLUtils::ConvertXMLToBinary(mp, dxl_string.Rgt(), &length));
+
+		CAutoP<CParseHandlerDXL> parse_handler_dxl(
+			CDXLUtils::GetParseHandlerForDXLString(
+				mp, (const CHAR *) binary.Rgt(), length,
+				NULL /*xsd_file_path*/));
+		IMDCacheObjectArray *mdcache_obj_array =
+			parse_handler_dxl->GetMdIdCachedObjArray();
+		mdcache_obj_array->AddRef();
+
+		CAutoP<CWStringDynamic> metadata_str(CDXLUtils::SerializeMetadata(
+			mp, mdcache_obj_array, true /*serialize_header_footer*/,
+			true /*indentation*/));
+
+		// single objects serialize to the same binary document either way
+		IMDCacheObject *md_obj = (*mdcache_obj_array)[0];
+		CAutoP<CWStringDynamic> md_obj_str(CDXLUtils::SerializeMDObj(
+			mp, md_obj, true /*serialize_header_footer*/,
+			false /*indentation*/));
+		CAutoRg<CHAR> md_obj_sz(
+			CDXLUtils::CreateMultiByteCharStringFromWCString(
+				mp, md_obj_str->GetBuffer()));
+
+		ULONG md_obj_length = 0;
+		CAutoRg<BYTE> md_obj_binary(
+			CDXLUtils::SerializeMDObjToBinary(mp, md_obj, &md_obj_length));
+		ULONG md_obj_converted_length = 0;
+		CAutoRg<BYTE> md_obj_converted(CDXLUtils::ConvertXMLToBinary(
+			mp, md_obj_sz.Rgt(), &md_obj_converted_length));
+
+		mdcache_obj_array->Release();
+
+		CWStringDynamic expected(mp);
+		expected.AppendFormat(GPOS_WSZ_LIT("%s"), dxl_string.Rgt());
+
+		if (!expected.Equals(metadata_str.Value()) ||
+			md_obj_length != md_obj_converted_length ||
+			0 != clib::Memcmp(md_obj_binary.Rgt(), md_obj_converted.Rgt(),
+							  md_obj_length) ||
+			!FConvertRoundTrip(mp, dxl_string.Rgt()))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryTest::EresUnittest_Malformed
+//
+//	@doc:
+//		Truncated and corrupted binary documents are rejected
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLBinaryTest::EresUnittest_Malformed()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	CMemoryPool *mp = amp.Pmp();
+
+	CAutoRg<CHAR> dxl_string(CDXLUtils::Read(mp, m_rgszPlanFileNames[0]));
+
+	ULONG length = 0;
+	CAutoRg<BYTE> binary(
+		CDXLUtils::ConvertXMLToBinary(mp, dxl_string.Rgt(), &length));
+
+	// corrupt every word of the document in turn, and finally truncate it
+	for (ULONG offset = 0; offset <= length; offset += GPOS_SIZEOF(ULONG))
+	{
+		CAutoRg<BYTE> corrupted(GPOS_NEW_ARRAY(mp, BYTE, length));
+		clib::Memcpy(corrupted.Rgt(), binary.Rgt(), length);
+
+		ULONG corrupted_length = length;
+		if (offset < length)
+		{
+			ULONG word = gpos::ulong_max;
+			clib::Memcpy(corrupted.Rgt() + offset, &word, GPOS_SIZEOF(word));
+		}
+		else
+		{
+			corrupted_length -= GPOS_SIZEOF(ULONG);
+		}
+
+		// corrupted strings may still be well-formed, but anything else
+		// must be rejected with the binary parse error
+		BOOL rejected = false;
+		GPOS_TRY
+		{
+			CAutoP<CWStringDynamic> xml(CDXLUtils::ConvertBinaryToXML(
+				mp, corrupted.Rgt(), corrupted_length, false /*indentation*/));
+		}
+		GPOS_CATCH_EX(ex)
+		{
+			if (!GPOS_MATCH_EX(ex, gpdxl::ExmaDXL,
+							   gpdxl::ExmiDXLBinaryParseError))
+			{
+				GPOS_RETHROW(ex);
+			}
+
+			rejected = true;
+			GPOS_RESET_EX;
+		}
+		GPOS_CATCH_END;
+
+		if (!rejected && (offset == length || offset < GPOS_SIZEOF(ULONG)))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	// the string entry point checks the given length against the header
+	// rather than trusting the header
+	BOOL rejected = false;
+	GPOS_TRY
+	{
+		CAutoP<CParseHandlerDXL> parse_handler_dxl(
+			CDXLUtils::GetParseHandlerForDXLString(
+				mp, (const CHAR *) binary.Rgt(), length - GPOS_SIZEOF(ULONG),
+				NULL /*xsd_file_path*/));
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (!GPOS_MATCH_EX(ex, gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError))
+		{
+			GPOS_RETHROW(ex);
+		}
+
+		rejected = true;
+		GPOS_RESET_EX;
+	}
+	GPOS_CATCH_END;
+
+	if (!rejected)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+// EOF
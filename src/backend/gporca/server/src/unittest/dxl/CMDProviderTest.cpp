@@ -133,6 +133,11 @@ CMDProviderTest::TestMDLookup(CMemoryPool *mp, IMDProvider *pmdp)
 	GPOS_ASSERT(NULL != pimdobj1 && pmdid1->Equals(pimdobj1->MDId()));
 	GPOS_ASSERT(NULL != pimdobj2 && pmdid2->Equals(pimdobj2->MDId()));
 
+	// objects fetched directly are the same as those parsed from DXL
+	IMDCacheObject *pimdobj3 = pmdp->GetMDObj(mp, amda.Pmda(), pmdid1);
+	GPOS_ASSERT(NULL != pimdobj3 && pmdid1->Equals(pimdobj3->MDId()));
+	GPOS_ASSERT(pimdobj1->MDType() == pimdobj3->MDType());
+
 	// cleanup
 	pmdid1->Release();
 	pmdid2->Release();
@@ -140,6 +145,7 @@ CMDProviderTest::TestMDLookup(CMemoryPool *mp, IMDProvider *pmdp)
 	GPOS_DELETE(pstrMDObject2);
 	pimdobj1->Release();
 	pimdobj2->Release();
+	pimdobj3->Release();
 }
 
 //---------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
+#include "naucrates/dxl/gpdb_types.h"
 #include "naucrates/statistics/CPoint.h"
 #include "naucrates/statistics/CHistogram.h"
 
@@ -41,7 +42,8 @@ CHistogramTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramValid),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_MergeUnion),
 		GPOS_UNITTEST_FUNC(
-			CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon)};
+			CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon),
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_JoinColumnar)};
 
 
 	CAutoMemoryPool amp;
@@ -430,4 +432,109 @@ CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon()
 
 	return GPOS_OK;
 }
+
+// generate an int4 or a float8 histogram with the given buckets
+CHistogram *
+CHistogramTest::PhistFromSpecs(CMemoryPool *mp,
+							   const SBucketSpec *bucket_specs,
+							   ULONG num_buckets, BOOL is_float8)
+{
+	CBucketArray *buckets = GPOS_NEW(mp) CBucketArray(mp);
+	for (ULONG ul = 0; ul < num_buckets; ul++)
+	{
+		const SBucketSpec &spec = bucket_specs[ul];
+		if (is_float8)
+		{
+			CPoint *lower = CCardinalityTestUtils::PpointDouble(
+				mp, GPDB_FLOAT8, CDouble(spec.m_lower));
+			CPoint *upper = CCardinalityTestUtils::PpointDouble(
+				mp, GPDB_FLOAT8, CDouble(spec.m_upper));
+			buckets->Append(GPOS_NEW(mp) CBucket(
+				lower, upper, spec.m_is_lower_closed, spec.m_is_upper_closed,
+				CDouble(spec.m_frequency), CDouble(spec.m_distinct)));
+		}
+		else
+		{
+			buckets->Append(CCardinalityTestUtils::PbucketInteger(
+				mp, spec.m_lower, spec.m_upper, spec.m_is_lower_closed,
+				spec.m_is_upper_closed, CDouble(spec.m_frequency),
+				CDouble(spec.m_distinct)));
+		}
+	}
+
+	return GPOS_NEW(mp) CHistogram(mp, buckets);
+}
+
+// equality join on the columnar form of int4 buckets gives the same
+// histogram as the join of float8 buckets with the same bounds, which
+// compares datums
+GPOS_RESULT
+CHistogramTest::EresUnittest_JoinColumnar()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	const SBucketSpec rgspec1[] = {
+		{0, 10, true, false, 0.2, 10},	{10, 10, true, true, 0.1, 1},
+		{10, 25, false, true, 0.3, 15}, {30, 40, true, false, 0.2, 10},
+		{40, 50, true, true, 0.1, 10},
+	};
+	const SBucketSpec rgspec2[] = {
+		{5, 15, true, false, 0.3, 10},	{15, 20, true, true, 0.2, 6},
+		{22, 22, true, true, 0.1, 1},	{22, 40, false, false, 0.3, 18},
+		{45, 60, true, false, 0.1, 15},
+	};
+
+	CHistogram *histogram_int1 = PhistFromSpecs(
+		mp, rgspec1, GPOS_ARRAY_SIZE(rgspec1), false /*is_float8*/);
+	CHistogram *histogram_int2 = PhistFromSpecs(
+		mp, rgspec2, GPOS_ARRAY_SIZE(rgspec2), false /*is_float8*/);
+	CHistogram *histogram_float1 = PhistFromSpecs(
+		mp, rgspec1, GPOS_ARRAY_SIZE(rgspec1), true /*is_float8*/);
+	CHistogram *histogram_float2 = PhistFromSpecs(
+		mp, rgspec2, GPOS_ARRAY_SIZE(rgspec2), true /*is_float8*/);
+
+	CHistogram *join_int = histogram_int1->MakeJoinHistogram(
+		CStatsPred::EstatscmptEq, histogram_int2);
+	CHistogram *join_float = histogram_float1->MakeJoinHistogram(
+		CStatsPred::EstatscmptEq, histogram_float2);
+	CCardinalityTestUtils::PrintHist(mp, "join_int", join_int);
+
+	GPOS_RTL_ASSERT(0 < join_int->GetNumBuckets());
+	GPOS_RTL_ASSERT(join_int->GetNumBuckets() == join_float->GetNumBuckets());
+	for (ULONG ul = 0; ul < join_int->GetNumBuckets(); ul++)
+	{
+		const CBucket *bucket_int = (*join_int->GetBuckets())[ul];
+		const CBucket *bucket_float = (*join_float->GetBuckets())[ul];
+
+		GPOS_RTL_ASSERT(
+			bucket_int->GetLowerBound()->GetDatum()->GetValAsDouble().Get() ==
+			bucket_float->GetLowerBound()->GetDatum()->GetValAsDouble().Get());
+		GPOS_RTL_ASSERT(
+			bucket_int->GetUpperBound()->GetDatum()->GetValAsDouble().Get() ==
+			bucket_float->GetUpperBound()->GetDatum()->GetValAsDouble().Get());
+		GPOS_RTL_ASSERT(bucket_int->IsLowerClosed() ==
+						bucket_float->IsLowerClosed());
+		GPOS_RTL_ASSERT(bucket_int->IsUpperClosed() ==
+						bucket_float->IsUpperClosed());
+		GPOS_RTL_ASSERT(bucket_int->GetFrequency().Get() ==
+						bucket_float->GetFrequency().Get());
+		GPOS_RTL_ASSERT(bucket_int->GetNumDistinct().Get() ==
+						bucket_float->GetNumDistinct().Get());
+	}
+	GPOS_RTL_ASSERT(join_int->GetFrequency().Get() ==
+					join_float->GetFrequency().Get());
+	GPOS_RTL_ASSERT(join_int->GetNumDistinct().Get() ==
+					join_float->GetNumDistinct().Get());
+
+	GPOS_DELETE(histogram_int1);
+	GPOS_DELETE(histogram_int2);
+	GPOS_DELETE(histogram_float1);
+	GPOS_DELETE(histogram_float2);
+	GPOS_DELETE(join_int);
+	GPOS_DELETE(join_float);
+
+	return GPOS_OK;
+}
+
 // EOF
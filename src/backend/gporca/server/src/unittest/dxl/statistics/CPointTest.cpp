@@ -18,6 +18,8 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
+#include "naucrates/dxl/gpdb_types.h"
+#include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/statistics/CPoint.h"
 
 #include "unittest/base.h"
@@ -34,6 +36,7 @@ CPointTest::EresUnittest()
 	CUnittest rgutSharedOptCtxt[] = {
 		GPOS_UNITTEST_FUNC(CPointTest::EresUnittest_CPointInt4),
 		GPOS_UNITTEST_FUNC(CPointTest::EresUnittest_CPointBool),
+		GPOS_UNITTEST_FUNC(CPointTest::EresUnittest_CPointStatsMapping),
 	};
 
 	CAutoMemoryPool amp;
@@ -107,4 +110,70 @@ CPointTest::EresUnittest_CPointBool()
 	return GPOS_OK;
 }
 
+// point comparisons on the resolved mapping agree with the datum comparisons
+GPOS_RESULT
+CPointTest::EresUnittest_CPointStatsMapping()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	// int4 points, including null, and float8 points closer than epsilon
+	CPointArray *pdrgppoint = GPOS_NEW(mp) CPointArray(mp);
+	pdrgppoint->Append(CTestUtils::PpointInt4NullVal(mp));
+	pdrgppoint->Append(CTestUtils::PpointInt4(mp, -5));
+	pdrgppoint->Append(CTestUtils::PpointInt4(mp, 7));
+	pdrgppoint->Append(CTestUtils::PpointInt8(mp, 7));
+
+	CPointArray *pdrgppointDouble = GPOS_NEW(mp) CPointArray(mp);
+	const DOUBLE rgdValues[] = {631.821405, 631.821407, 100.9214};
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgdValues); ul++)
+	{
+		IDatum *datum = CTestUtils::CreateDoubleDatum(
+			mp, md_accessor, GPOS_NEW(mp) CMDIdGPDB(GPDB_FLOAT8),
+			CDouble(rgdValues[ul]));
+		pdrgppointDouble->Append(GPOS_NEW(mp) CPoint(datum));
+	}
+
+	CPointArray *rgpdrgppoint[] = {pdrgppoint, pdrgppointDouble};
+	for (ULONG ulArray = 0; ulArray < GPOS_ARRAY_SIZE(rgpdrgppoint); ulArray++)
+	{
+		CPointArray *pdrgppointCur = rgpdrgppoint[ulArray];
+		const ULONG size = pdrgppointCur->Size();
+		for (ULONG ul1 = 0; ul1 < size; ul1++)
+		{
+			for (ULONG ul2 = 0; ul2 < size; ul2++)
+			{
+				CPoint *point1 = (*pdrgppointCur)[ul1];
+				CPoint *point2 = (*pdrgppointCur)[ul2];
+				IDatum *datum1 = point1->GetDatum();
+				IDatum *datum2 = point2->GetDatum();
+
+				GPOS_RTL_ASSERT_MSG(
+					point1->Equals(point2) == datum1->StatsAreEqual(datum2),
+					"point equality differs from datum equality");
+				GPOS_RTL_ASSERT_MSG(
+					point1->IsLessThan(point2) ==
+						datum1->StatsAreLessThan(datum2),
+					"point less-than differs from datum less-than");
+				GPOS_RTL_ASSERT_MSG(
+					point1->IsGreaterThan(point2) ==
+						datum1->StatsAreGreaterThan(datum2),
+					"point greater-than differs from datum greater-than");
+			}
+		}
+	}
+
+	// values closer than epsilon are equal
+	GPOS_RTL_ASSERT_MSG((*pdrgppointDouble)[0]->Equals((*pdrgppointDouble)[1]),
+						"631.821405 == 631.821407");
+
+	pdrgppoint->Release();
+	pdrgppointDouble->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
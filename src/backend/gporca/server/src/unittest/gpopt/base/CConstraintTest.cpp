@@ -25,8 +25,10 @@
 
 #include "gpopt/base/CDefaultComparator.h"
 #include "gpopt/base/CUtils.h"
+#include "gpopt/engine/CHint.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/operators/CPredicateUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 
 #include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/md/IMDScalarOp.h"
@@ -97,6 +99,10 @@ CConstraintTest::EresUnittest()
 			CConstraintTest::EresUnittest_CConstraintIntervalPexpr),
 		GPOS_UNITTEST_FUNC(
 			CConstraintTest::EresUnittest_CConstraintIntervalFromArrayExpr),
+		GPOS_UNITTEST_FUNC(
+			CConstraintTest::EresUnittest_CConstraintFromLargeArrayExpr),
+		GPOS_UNITTEST_FUNC(
+			CConstraintTest::EresUnittest_CConstraintFromLargeInAndOrList),
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC_THROW(CConstraintTest::EresUnittest_NegativeTests,
 								 gpos::CException::ExmaSystem,
@@ -928,6 +934,224 @@ CConstraintTest::EresUnittest_CConstraintIntervalFromArrayExpr()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintTest::EresUnittest_CConstraintFromLargeArrayExpr
+//
+//	@doc:
+//		Tests constraints of IN and NOT IN lists longer than the array
+//		expansion threshold
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstraintTest::EresUnittest_CConstraintFromLargeArrayExpr()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// an array expansion threshold below the sizes of the lists
+	COptimizerConfig *optimizer_config = GPOS_NEW(mp) COptimizerConfig(
+		GPOS_NEW(mp) CEnumeratorConfig(mp, 0 /*plan_id*/, 0 /*ullSamples*/),
+		CStatisticsConfig::PstatsconfDefault(mp),
+		CCTEConfig::PcteconfDefault(mp), CTestUtils::GetCostModel(mp),
+		GPOS_NEW(mp) CHint(gpos::int_max, gpos::int_max,
+						   4 /*array_expansion_threshold*/,
+						   JOIN_ORDER_DP_THRESHOLD, BROADCAST_THRESHOLD,
+						   true /*enforce_constraint_on_dml*/,
+						   PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD),
+		CWindowOids::GetWindowOids(mp));
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(mp, &mda, NULL /*pceeval*/, optimizer_config);
+
+	// IN list with 7 distinct values, and IN list with 5 of them
+	INT rgiValsAll[] = {5, 1, 2, 5, 3, 4, 6, 7};
+	INT rgiValsSome[] = {4, 2, 3, 1, 5};
+	IntPtrArray *pdrgpiAll = GPOS_NEW(mp) IntPtrArray(mp);
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgiValsAll); ul++)
+	{
+		pdrgpiAll->Append(GPOS_NEW(mp) INT(rgiValsAll[ul]));
+	}
+	IntPtrArray *pdrgpiSome = GPOS_NEW(mp) IntPtrArray(mp);
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgiValsSome); ul++)
+	{
+		pdrgpiSome->Append(GPOS_NEW(mp) INT(rgiValsSome[ul]));
+	}
+
+	CExpression *pexprInAll = CTestUtils::PexprLogicalSelectArrayCmp(
+		mp, CScalarArrayCmp::EarrcmpAny, IMDType::EcmptEq, pdrgpiAll);
+	CColRef *colref = pexprInAll->DeriveOutputColumns()->PcrAny();
+	CColRefSetArray *pdrgpcrs = NULL;
+	CConstraint *pcnstrAll =
+		CConstraint::PcnstrFromScalarExpr(mp, (*pexprInAll)[1], &pdrgpcrs);
+	GPOS_RTL_ASSERT(NULL != pcnstrAll);
+	GPOS_RTL_ASSERT(CConstraint::EctInterval == pcnstrAll->Ect());
+	CConstraintInterval *pciAll =
+		dynamic_cast<CConstraintInterval *>(pcnstrAll);
+	GPOS_RTL_ASSERT(7 == pciAll->Pdrgprng()->Size());
+	pdrgpcrs->Release();
+	pdrgpcrs = NULL;
+
+	// the scalar expression of the interval is an array comparison, not
+	// a disjunction of comparisons
+	CExpression *pexprScalar =
+		pciAll->PexprScalar(mp);  // owned by the constraint
+	GPOS_RTL_ASSERT(CUtils::FScalarArrayCmp(pexprScalar));
+
+	// IN list on the same column, taken from the first select
+	CExpression *pexprInSome = CTestUtils::PexprLogicalSelectArrayCmp(
+		mp, CScalarArrayCmp::EarrcmpAny, IMDType::EcmptEq, pdrgpiSome);
+	CConstraintInterval *pciSomeOther =
+		dynamic_cast<CConstraintInterval *>(CConstraint::PcnstrFromScalarExpr(
+			mp, (*pexprInSome)[1], &pdrgpcrs));
+	GPOS_RTL_ASSERT(NULL != pciSomeOther);
+	pdrgpcrs->Release();
+	pdrgpcrs = NULL;
+	CConstraintInterval *pciSome =
+		dynamic_cast<CConstraintInterval *>(pciSomeOther->PcnstrRemapForColumn(
+			mp, colref));
+	pciSomeOther->Release();
+
+	GPOS_RTL_ASSERT(pciAll->FContainsInterval(mp, pciSome));
+	GPOS_RTL_ASSERT(!pciSome->FContainsInterval(mp, pciAll));
+
+	CConstraintInterval *pciIntersect = pciAll->PciIntersect(mp, pciSome);
+	GPOS_RTL_ASSERT(5 == pciIntersect->Pdrgprng()->Size());
+	CConstraintInterval *pciUnion = pciSome->PciUnion(mp, pciAll);
+	GPOS_RTL_ASSERT(7 == pciUnion->Pdrgprng()->Size());
+
+	// NOT IN list with 7 distinct values
+	CExpression *pexprNotIn = CTestUtils::PexprLogicalSelectArrayCmp(
+		mp, CScalarArrayCmp::EarrcmpAll, IMDType::EcmptNEq, pdrgpiAll);
+	CConstraint *pcnstrNotIn =
+		CConstraint::PcnstrFromScalarExpr(mp, (*pexprNotIn)[1], &pdrgpcrs);
+	GPOS_RTL_ASSERT(NULL != pcnstrNotIn);
+	GPOS_RTL_ASSERT(CConstraint::EctInterval == pcnstrNotIn->Ect());
+	GPOS_RTL_ASSERT(
+		8 ==
+		dynamic_cast<CConstraintInterval *>(pcnstrNotIn)->Pdrgprng()->Size());
+	pdrgpcrs->Release();
+	pdrgpcrs = NULL;
+
+	pcnstrNotIn->Release();
+	pexprNotIn->Release();
+	pciUnion->Release();
+	pciIntersect->Release();
+	pciSome->Release();
+	pexprInSome->Release();
+	pcnstrAll->Release();
+	pexprInAll->Release();
+	pdrgpiSome->Release();
+	pdrgpiAll->Release();
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintTest::EresUnittest_CConstraintFromLargeInAndOrList
+//
+//	@doc:
+//		Tests the scalar expressions of the constraints of an IN list and of
+//		an OR list of equalities with the same values, both much longer than
+//		the array expansion threshold: only the IN list becomes an array
+//		comparison
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstraintTest::EresUnittest_CConstraintFromLargeInAndOrList()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	COptimizerConfig *optimizer_config = GPOS_NEW(mp) COptimizerConfig(
+		GPOS_NEW(mp) CEnumeratorConfig(mp, 0 /*plan_id*/, 0 /*ullSamples*/),
+		CStatisticsConfig::PstatsconfDefault(mp),
+		CCTEConfig::PcteconfDefault(mp), CTestUtils::GetCostModel(mp),
+		GPOS_NEW(mp) CHint(gpos::int_max, gpos::int_max,
+						   100 /*array_expansion_threshold*/,
+						   JOIN_ORDER_DP_THRESHOLD, BROADCAST_THRESHOLD,
+						   true /*enforce_constraint_on_dml*/,
+						   PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD),
+		CWindowOids::GetWindowOids(mp));
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(mp, &mda, NULL /*pceeval*/, optimizer_config);
+
+	// IN list of 1000 distinct values, in descending order
+	const ULONG ulVals = 1000;
+	IntPtrArray *pdrgpi = GPOS_NEW(mp) IntPtrArray(mp);
+	for (ULONG ul = 0; ul < ulVals; ul++)
+	{
+		pdrgpi->Append(GPOS_NEW(mp) INT(2 * (ulVals - ul)));
+	}
+
+	CExpression *pexprIn = CTestUtils::PexprLogicalSelectArrayCmp(
+		mp, CScalarArrayCmp::EarrcmpAny, IMDType::EcmptEq, pdrgpi);
+	CColRef *colref = pexprIn->DeriveOutputColumns()->PcrAny();
+	CColRefSetArray *pdrgpcrs = NULL;
+	CConstraint *pcnstrIn =
+		CConstraint::PcnstrFromScalarExpr(mp, (*pexprIn)[1], &pdrgpcrs);
+	GPOS_RTL_ASSERT(NULL != pcnstrIn);
+	GPOS_RTL_ASSERT(CConstraint::EctInterval == pcnstrIn->Ect());
+	CConstraintInterval *pciIn = dynamic_cast<CConstraintInterval *>(pcnstrIn);
+	GPOS_RTL_ASSERT(ulVals == pciIn->Pdrgprng()->Size());
+	GPOS_RTL_ASSERT(pciIn->FFromArray());
+	GPOS_RTL_ASSERT(CUtils::FScalarArrayCmp(pciIn->PexprScalar(mp)));
+	pdrgpcrs->Release();
+	pdrgpcrs = NULL;
+
+	// OR list of equalities with the same values on the same column
+	CExpressionArray *pdrgpexpr = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < ulVals; ul++)
+	{
+		pdrgpexpr->Append(CUtils::PexprScalarEqCmp(
+			mp, colref, CUtils::PexprScalarConstInt4(mp, *(*pdrgpi)[ul])));
+	}
+	CExpression *pexprOr = CPredicateUtils::PexprDisjunction(mp, pdrgpexpr);
+	CConstraint *pcnstrOr =
+		CConstraint::PcnstrFromScalarExpr(mp, pexprOr, &pdrgpcrs);
+	GPOS_RTL_ASSERT(NULL != pcnstrOr);
+	GPOS_RTL_ASSERT(CConstraint::EctInterval == pcnstrOr->Ect());
+	CConstraintInterval *pciOr = dynamic_cast<CConstraintInterval *>(pcnstrOr);
+	GPOS_RTL_ASSERT(ulVals == pciOr->Pdrgprng()->Size());
+	GPOS_RTL_ASSERT(!pciOr->FFromArray());
+	GPOS_RTL_ASSERT(pciIn->Equals(pciOr));
+	pdrgpcrs->Release();
+	pdrgpcrs = NULL;
+
+	// the OR list keeps its disjunction
+	CExpression *pexprScalarOr = pciOr->PexprScalar(mp);
+	GPOS_RTL_ASSERT(CPredicateUtils::FOr(pexprScalarOr));
+	GPOS_RTL_ASSERT(ulVals == pexprScalarOr->Arity());
+
+	// a subset of the IN list is still an array comparison
+	CConstraintInterval *pciIntersect = pciOr->PciIntersect(mp, pciIn);
+	GPOS_RTL_ASSERT(pciIntersect->FFromArray());
+	GPOS_RTL_ASSERT(CUtils::FScalarArrayCmp(pciIntersect->PexprScalar(mp)));
+
+	pciIntersect->Release();
+	pcnstrOr->Release();
+	pexprOr->Release();
+	pcnstrIn->Release();
+	pexprIn->Release();
+	pdrgpi->Release();
+
+	return GPOS_OK;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CConstraintTest::EresUnittest_CConstraintIntervalFromArrayExprIncludesNull
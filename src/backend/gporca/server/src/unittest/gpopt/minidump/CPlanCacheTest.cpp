@@ -0,0 +1,310 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CPlanCacheTest.cpp
+//
+//	@doc:
+//		Test for looking up plans in the plan cache
+//---------------------------------------------------------------------------
+
+#include "unittest/gpopt/minidump/CPlanCacheTest.h"
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/task/CAutoTraceFlag.h"
+#include "gpos/test/CUnittest.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLDatumInt4.h"
+#include "naucrates/dxl/operators/CDXLScalarConstValue.h"
+
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMetadataAccessorFactory.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizer.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/CPlanCache.h"
+
+#include "unittest/gpopt/CTestUtils.h"
+
+using namespace gpopt;
+
+// select a, c from r where c = 5, answered by an index scan
+static const CHAR *szQueryFile =
+	"../data/dxl/minidump/IndexScan-DroppedColumns.mdp";
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest
+//
+//	@doc:
+//		Unittest for the plan cache
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest()
+{
+	CUnittest rgut[] = {
+		GPOS_UNITTEST_FUNC(EresUnittest_Hit),
+		GPOS_UNITTEST_FUNC(EresUnittest_Rebind),
+		GPOS_UNITTEST_FUNC(EresUnittest_Reset),
+	};
+
+	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+
+	if (CPlanCache::FInitialized())
+	{
+		CPlanCache::Shutdown();
+	}
+
+	// reset metadata cache
+	CMDCache::Reset();
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::PdxlnSetInt4Consts
+//
+//	@doc:
+//		Copy of the given tree, sharing its operators, with all int4
+//		constants set to the given value
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CPlanCacheTest::PdxlnSetInt4Consts(CMemoryPool *mp, const CDXLNode *dxlnode,
+								   INT value)
+{
+	CDXLOperator *dxl_op = dxlnode->GetOperator();
+
+	if (EdxlopScalarConstValue == dxl_op->GetDXLOperator())
+	{
+		const CDXLDatum *datum =
+			CDXLScalarConstValue::Cast(dxl_op)->GetDatumVal();
+		if (CDXLDatum::EdxldatumInt4 == datum->GetDatumType())
+		{
+			IMDId *mdid = datum->MDId();
+			mdid->AddRef();
+
+			return GPOS_NEW(mp) CDXLNode(
+				mp, GPOS_NEW(mp) CDXLScalarConstValue(
+						mp, GPOS_NEW(mp) CDXLDatumInt4(
+								mp, mdid, false /*is_null*/, value)));
+		}
+	}
+
+	dxl_op->AddRef();
+	CDXLNode *result = GPOS_NEW(mp) CDXLNode(mp, dxl_op);
+
+	const ULONG arity = dxlnode->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		result->AddChild(PdxlnSetInt4Consts(mp, (*dxlnode)[ul], value));
+	}
+
+	return result;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::PstrOptimize
+//
+//	@doc:
+//		Optimize the given query, with the plan cache enabled unless
+//		requested otherwise, and serialize the plan
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+CPlanCacheTest::PstrOptimize(CMemoryPool *mp, CMDAccessor *md_accessor,
+							 const CDXLNode *query,
+							 const CDXLNodeArray *query_output,
+							 const CDXLNodeArray *cte_producers,
+							 BOOL fPlanCache)
+{
+	CAutoTraceFlag atf1(EopttraceEnablePlanCache, fPlanCache);
+	CAutoTraceFlag atf2(EopttraceMinidump, false /*value*/);
+	CAutoTraceFlag atf3(EopttraceEnableConstantExpressionEvaluation,
+						false /*value*/);
+
+	COptimizerConfig *optimizer_config =
+		COptimizerConfig::PoconfDefault(mp, CTestUtils::GetCostModel(mp));
+
+	CDXLNode *plan = COptimizer::PdxlnOptimize(
+		mp, md_accessor, query, query_output, cte_producers,
+		NULL /*pceeval*/, GPOPT_TEST_SEGMENTS, 1 /*ulSessionId*/,
+		1 /*ulCmdId*/, NULL /*search_stage_array*/, optimizer_config);
+
+	CWStringDynamic *str = GPOS_NEW(mp) CWStringDynamic(mp);
+	COstreamString oss(str);
+	CDXLUtils::SerializePlan(mp, oss, plan, 0 /*plan_id*/,
+							 0 /*plan_space_size*/,
+							 false /*serialize_document_header_footer*/,
+							 true /*indentation*/);
+
+	plan->Release();
+	optimizer_config->Release();
+
+	return str;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest_Hit
+//
+//	@doc:
+//		Optimizing the same query twice returns the cached plan the second
+//		time
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest_Hit()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CAutoP<CDXLMinidump> apdxlmd(CMinidumperUtils::PdxlmdLoad(mp, szQueryFile));
+	CMetadataAccessorFactory factory(mp, apdxlmd.Value(), szQueryFile);
+
+	if (CPlanCache::FInitialized())
+	{
+		CPlanCache::Reset();
+	}
+	else
+	{
+		CPlanCache::Init();
+	}
+
+	CAutoP<CWStringDynamic> apstrFirst(PstrOptimize(
+		mp, factory.Pmda(), apdxlmd->GetQueryDXLRoot(),
+		apdxlmd->PdrgpdxlnQueryOutput(), apdxlmd->GetCTEProducerDXLArray()));
+	GPOS_RTL_ASSERT(0 == CPlanCache::ULLGetCacheHitCounter());
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheMissCounter());
+
+	CAutoP<CWStringDynamic> apstrSecond(PstrOptimize(
+		mp, factory.Pmda(), apdxlmd->GetQueryDXLRoot(),
+		apdxlmd->PdrgpdxlnQueryOutput(), apdxlmd->GetCTEProducerDXLArray()));
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheHitCounter());
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheMissCounter());
+
+	GPOS_RTL_ASSERT(apstrFirst->Equals(apstrSecond.Value()));
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest_Rebind
+//
+//	@doc:
+//		Queries differing from a cached one in their constants only get the
+//		cached plan bound to their constants, which is the plan a fresh
+//		optimization of the query produces
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest_Rebind()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CAutoP<CDXLMinidump> apdxlmd(CMinidumperUtils::PdxlmdLoad(mp, szQueryFile));
+	CMetadataAccessorFactory factory(mp, apdxlmd.Value(), szQueryFile);
+
+	if (CPlanCache::FInitialized())
+	{
+		CPlanCache::Reset();
+	}
+	else
+	{
+		CPlanCache::Init();
+	}
+
+	// the same query, with c = 7 instead of c = 5
+	CDXLNode *query =
+		PdxlnSetInt4Consts(mp, apdxlmd->GetQueryDXLRoot(), 7 /*value*/);
+
+	CAutoP<CWStringDynamic> apstrCached(PstrOptimize(
+		mp, factory.Pmda(), apdxlmd->GetQueryDXLRoot(),
+		apdxlmd->PdrgpdxlnQueryOutput(), apdxlmd->GetCTEProducerDXLArray()));
+	CAutoP<CWStringDynamic> apstrRebound(
+		PstrOptimize(mp, factory.Pmda(), query, apdxlmd->PdrgpdxlnQueryOutput(),
+					 apdxlmd->GetCTEProducerDXLArray()));
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheHitCounter());
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheMissCounter());
+	GPOS_RTL_ASSERT(!apstrCached->Equals(apstrRebound.Value()));
+
+	// the column has no histogram, so the estimates do not depend on the
+	// constant, and the fresh plan only differs from the cached one in it
+	CAutoP<CWStringDynamic> apstrFresh(PstrOptimize(
+		mp, factory.Pmda(), query, apdxlmd->PdrgpdxlnQueryOutput(),
+		apdxlmd->GetCTEProducerDXLArray(), false /*fPlanCache*/));
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheHitCounter());
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheMissCounter());
+	GPOS_RTL_ASSERT(apstrFresh->Equals(apstrRebound.Value()));
+
+	// binding the plan back to the original constant restores it
+	CDXLNode *original_query =
+		PdxlnSetInt4Consts(mp, apdxlmd->GetQueryDXLRoot(), 5 /*value*/);
+	CAutoP<CWStringDynamic> apstrRestored(PstrOptimize(
+		mp, factory.Pmda(), original_query, apdxlmd->PdrgpdxlnQueryOutput(),
+		apdxlmd->GetCTEProducerDXLArray()));
+	GPOS_RTL_ASSERT(2 == CPlanCache::ULLGetCacheHitCounter());
+	GPOS_RTL_ASSERT(apstrCached->Equals(apstrRestored.Value()));
+
+	original_query->Release();
+	query->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest_Reset
+//
+//	@doc:
+//		Resetting the cache drops the cached plans
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest_Reset()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CAutoP<CDXLMinidump> apdxlmd(CMinidumperUtils::PdxlmdLoad(mp, szQueryFile));
+	CMetadataAccessorFactory factory(mp, apdxlmd.Value(), szQueryFile);
+
+	if (!CPlanCache::FInitialized())
+	{
+		CPlanCache::Init();
+	}
+
+	CAutoP<CWStringDynamic> apstrFirst(PstrOptimize(
+		mp, factory.Pmda(), apdxlmd->GetQueryDXLRoot(),
+		apdxlmd->PdrgpdxlnQueryOutput(), apdxlmd->GetCTEProducerDXLArray()));
+
+	CPlanCache::Reset();
+
+	CAutoP<CWStringDynamic> apstrSecond(PstrOptimize(
+		mp, factory.Pmda(), apdxlmd->GetQueryDXLRoot(),
+		apdxlmd->PdrgpdxlnQueryOutput(), apdxlmd->GetCTEProducerDXLArray()));
+	GPOS_RTL_ASSERT(0 == CPlanCache::ULLGetCacheHitCounter());
+	GPOS_RTL_ASSERT(1 == CPlanCache::ULLGetCacheMissCounter());
+
+	GPOS_RTL_ASSERT(apstrFirst->Equals(apstrSecond.Value()));
+
+	return GPOS_OK;
+}
+
+// EOF
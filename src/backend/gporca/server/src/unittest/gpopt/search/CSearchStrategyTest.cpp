@@ -48,6 +48,7 @@ CSearchStrategyTest::EresUnittest()
 		GPOS_UNITTEST_FUNC_THROW(
 			CSearchStrategyTest::EresUnittest_ParsingWithException,
 			gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError),
+		GPOS_UNITTEST_FUNC(CSearchStrategyTest::EresUnittest_Adaptive),
 	};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -207,6 +208,103 @@ CSearchStrategyTest::EresUnittest_ParsingWithException()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStrategyTest::EresUnittest_Adaptive
+//
+//	@doc:
+//		Test picking the search strategy from the complexity of the
+//		preprocessed query, and optimizing with it
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSearchStrategyTest::EresUnittest_Adaptive()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(mp, &mda, NULL /*pceeval*/,
+					 CTestUtils::GetCostModel(mp));
+
+	CExpression *rgpexpr[] = {
+		CTestUtils::PexprLogicalGet(mp),
+		CTestUtils::PexprLogicalNAryJoin(mp),
+		PexprCrossProduct(mp, 16 /*ulRels*/),
+	};
+	const CSearchStage::EQueryComplexity rgeqc[] = {
+		CSearchStage::EqcSimple,
+		CSearchStage::EqcModerate,
+		CSearchStage::EqcComplex,
+	};
+	const ULONG rgulStages[] = {1, 2, 1};
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpexpr); ul++)
+	{
+		CExpression *pexpr = rgpexpr[ul];
+		CQueryContext *pqc = CTestUtils::PqcGenerate(mp, pexpr);
+		CSearchStageArray *search_stage_array =
+			CSearchStage::PdrgpssAdaptive(mp, pqc->Pexpr());
+
+		if (rgeqc[ul] != CSearchStage::Eqc(pqc->Pexpr()) ||
+			rgulStages[ul] != search_stage_array->Size())
+		{
+			eres = GPOS_FAILED;
+		}
+
+		// the cross product is too large to be optimized here
+		if (GPOS_OK == eres && CSearchStage::EqcComplex != rgeqc[ul])
+		{
+			CEngine eng(mp);
+			eng.Init(pqc, search_stage_array);
+			eng.Optimize();
+
+			CExpression *pexprPlan = eng.PexprExtractPlan();
+			GPOS_ASSERT(NULL != pexprPlan);
+			pexprPlan->Release();
+		}
+		else
+		{
+			search_stage_array->Release();
+		}
+
+		pexpr->Release();
+		GPOS_DELETE(pqc);
+	}
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStrategyTest::PexprCrossProduct
+//
+//	@doc:
+//		Generate an n-ary cross product of the given number of tables
+//
+//---------------------------------------------------------------------------
+CExpression *
+CSearchStrategyTest::PexprCrossProduct(CMemoryPool *mp, ULONG ulRels)
+{
+	CExpressionArray *pdrgpexpr = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < ulRels; ul++)
+	{
+		pdrgpexpr->Append(CTestUtils::PexprLogicalGet(mp));
+	}
+	pdrgpexpr->Append(CUtils::PexprScalarConstBool(mp, true /*value*/));
+
+	return CTestUtils::PexprLogicalNAryJoin(mp, pdrgpexpr);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CSearchStrategyTest::PdrgpssRandom
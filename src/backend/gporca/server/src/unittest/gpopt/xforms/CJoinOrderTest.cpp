@@ -8,6 +8,7 @@
 //	@doc:
 //		Test for join ordering
 //---------------------------------------------------------------------------
+#include "gpos/common/CTimerUser.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/test/CUnittest.h"
@@ -19,6 +20,7 @@
 #include "gpopt/operators/ops.h"
 
 #include "gpopt/xforms/CJoinOrder.h"
+#include "gpopt/xforms/CJoinOrderDPccp.h"
 #include "gpopt/xforms/CJoinOrderMinCard.h"
 
 #include "unittest/base.h"
@@ -32,6 +34,27 @@ const CHAR *rgszJoinOrderFileNames[] = {
 	"../data/dxl/minidump/JoinOptimizationLevelGreedyNonPartTblInnerJoin.mdp",
 	"../data/dxl/minidump/JoinOptimizationLevelQueryNonPartTblInnerJoin.mdp"};
 
+// minidump files of joins of many relations, timed
+const CHAR *rgszJoinOrderDPccpFileNames[] = {
+	"../data/dxl/minidump/CJoinOrderDPTest/JoinOrderDPccpChain14.mdp"};
+
+// relations joined by the DPccp tests, reused past the last one
+static const WCHAR *rgwszDPccpRel[] = {
+	GPOS_WSZ_LIT("Rel1"),  GPOS_WSZ_LIT("Rel2"),  GPOS_WSZ_LIT("Rel3"),
+	GPOS_WSZ_LIT("Rel4"),  GPOS_WSZ_LIT("Rel5"),  GPOS_WSZ_LIT("Rel6"),
+	GPOS_WSZ_LIT("Rel7"),  GPOS_WSZ_LIT("Rel8"),  GPOS_WSZ_LIT("Rel9"),
+	GPOS_WSZ_LIT("Rel10"), GPOS_WSZ_LIT("Rel11"), GPOS_WSZ_LIT("Rel12"),
+	GPOS_WSZ_LIT("Rel13"), GPOS_WSZ_LIT("Rel14"), GPOS_WSZ_LIT("Rel15"),
+};
+
+static const ULONG rgulDPccpRel[] = {
+	GPOPT_TEST_REL_OID1,  GPOPT_TEST_REL_OID2,	GPOPT_TEST_REL_OID3,
+	GPOPT_TEST_REL_OID4,  GPOPT_TEST_REL_OID5,	GPOPT_TEST_REL_OID6,
+	GPOPT_TEST_REL_OID7,  GPOPT_TEST_REL_OID8,	GPOPT_TEST_REL_OID9,
+	GPOPT_TEST_REL_OID10, GPOPT_TEST_REL_OID11, GPOPT_TEST_REL_OID12,
+	GPOPT_TEST_REL_OID13, GPOPT_TEST_REL_OID14, GPOPT_TEST_REL_OID15,
+};
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJoinOrderTest::EresUnittest
@@ -43,8 +66,15 @@ const CHAR *rgszJoinOrderFileNames[] = {
 GPOS_RESULT
 CJoinOrderTest::EresUnittest()
 {
-	CUnittest rgut[] = {GPOS_UNITTEST_FUNC(EresUnittest_ExpandMinCard),
-						GPOS_UNITTEST_FUNC(EresUnittest_RunTests)};
+	CUnittest rgut[] = {
+		GPOS_UNITTEST_FUNC(EresUnittest_ExpandMinCard),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPccpChain),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPccpStar),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPccpClique),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPccpDisconnected),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPccpHyperedge),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPccpTimings),
+		GPOS_UNITTEST_FUNC(EresUnittest_RunTests)};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
 }
@@ -135,6 +165,394 @@ CJoinOrderTest::EresUnittest_ExpandMinCard()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::CheckDPccpJoins
+//
+//	@doc:
+//		Count the predicates and the cross products of the joins created
+//		by the DPccp enumerator, and check that each predicate is applied
+//		at a join that covers it, with columns from both sides
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderTest::CheckDPccpJoins(CMemoryPool *mp, CExpression *pexpr,
+								ULONG *pulPreds, ULONG *pulCross,
+								BOOL *pfValid)
+{
+	if (COperator::EopLogicalInnerJoin != pexpr->Pop()->Eopid())
+	{
+		// a component
+		return;
+	}
+
+	CExpression *pexprPred = (*pexpr)[2];
+	if (CUtils::FScalarConstTrue(pexprPred))
+	{
+		(*pulCross)++;
+	}
+	else
+	{
+		CExpressionArray *pdrgpexprConjuncts =
+			CPredicateUtils::PdrgpexprConjuncts(mp, pexprPred);
+		for (ULONG ul = 0; ul < pdrgpexprConjuncts->Size(); ul++)
+		{
+			CColRefSet *pcrsUsed = (*pdrgpexprConjuncts)[ul]->DeriveUsedColumns();
+			*pfValid =
+				*pfValid &&
+				(*pexpr)[0]->DeriveOutputColumns()->FIntersects(pcrsUsed) &&
+				(*pexpr)[1]->DeriveOutputColumns()->FIntersects(pcrsUsed) &&
+				pexpr->DeriveOutputColumns()->ContainsAll(pcrsUsed);
+			(*pulPreds)++;
+		}
+		pdrgpexprConjuncts->Release();
+	}
+
+	CheckDPccpJoins(mp, (*pexpr)[0], pulPreds, pulCross, pfValid);
+	CheckDPccpJoins(mp, (*pexpr)[1], pulPreds, pulCross, pfValid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresCheckDPccp
+//
+//	@doc:
+//		Join the given number of relations with the DPccp enumerator, given
+//		pairs of relations joined by an equality, and optionally a
+//		predicate over the first three relations. Checks that every
+//		predicate is applied once, at a join covering it, that the plan
+//		has the expected number of cross products, if given, and that the
+//		enumeration takes at most the given time
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresCheckDPccp(const CHAR *szGraph, ULONG ulRels,
+							   const ULONG (*rgulEdges)[2], ULONG ulEdges,
+							   BOOL fHyperedge, ULONG ulCrossExpected,
+							   BOOL fPrint, ULONG ulMaxElapsedMS)
+{
+	GPOS_ASSERT(ulRels <= GPOPT_DPCCP_MAX_COMPONENTS);
+
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(mp, &mda, NULL, /* pceeval */
+					 CTestUtils::GetCostModel(mp));
+
+	const ULONG ulRelNames = GPOS_ARRAY_SIZE(rgulDPccpRel);
+	CExpressionArray *pdrgpexprComps = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < ulRels; ul++)
+	{
+		CWStringConst strRel(rgwszDPccpRel[ul % ulRelNames]);
+		pdrgpexprComps->Append(CTestUtils::PexprLogicalGet(
+			mp, &strRel, &strRel, rgulDPccpRel[ul % ulRelNames]));
+	}
+
+	CExpressionArray *pdrgpexprPreds = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < ulEdges; ul++)
+	{
+		CColRef *pcrFst =
+			(*pdrgpexprComps)[rgulEdges[ul][0]]->DeriveOutputColumns()->PcrAny();
+		CColRef *pcrSnd =
+			(*pdrgpexprComps)[rgulEdges[ul][1]]->DeriveOutputColumns()->PcrAny();
+		pdrgpexprPreds->Append(CUtils::PexprScalarEqCmp(mp, pcrFst, pcrSnd));
+	}
+
+	if (fHyperedge)
+	{
+		GPOS_ASSERT(3 <= ulRels);
+
+		CColRef *rgpcr[3];
+		for (ULONG ul = 0; ul < 3; ul++)
+		{
+			rgpcr[ul] = (*pdrgpexprComps)[ul]->DeriveOutputColumns()->PcrAny();
+		}
+
+		CExpression *pexprFst = CUtils::PexprScalarEqCmp(mp, rgpcr[0], rgpcr[1]);
+		CExpression *pexprSnd = CUtils::PexprScalarEqCmp(mp, rgpcr[1], rgpcr[2]);
+		pdrgpexprPreds->Append(
+			CPredicateUtils::PexprDisjunction(mp, pexprFst, pexprSnd));
+		pexprFst->Release();
+		pexprSnd->Release();
+	}
+	const ULONG ulPredsExpected = pdrgpexprPreds->Size();
+
+	pdrgpexprComps->AddRef();
+	pdrgpexprComps->Append(CPredicateUtils::PexprConjunction(mp, pdrgpexprPreds));
+	CExpression *pexprNAryJoin =
+		CTestUtils::PexprLogicalNAryJoin(mp, pdrgpexprComps);
+
+	// derive stats on input expression
+	CExpressionHandle exprhdl(mp);
+	exprhdl.Attach(pexprNAryJoin);
+	exprhdl.DeriveStats(mp, mp, NULL /*prprel*/, NULL /*stats_ctxt*/);
+
+	CExpressionArray *pdrgpexpr = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < ulRels; ul++)
+	{
+		CExpression *pexprChild = (*pexprNAryJoin)[ul];
+		pexprChild->AddRef();
+		pdrgpexpr->Append(pexprChild);
+	}
+	pdrgpexprComps->Release();
+
+	CExpressionArray *pdrgpexprConjuncts =
+		CPredicateUtils::PdrgpexprConjuncts(mp, (*pexprNAryJoin)[ulRels]);
+
+	GPOS_RESULT eres = GPOS_OK;
+	{
+		pdrgpexpr->AddRef();
+		pdrgpexprConjuncts->AddRef();
+		CJoinOrderDPccp jodp(mp, pdrgpexpr, pdrgpexprConjuncts);
+
+		CTimerUser timer;
+		timer.Restart();
+		CExpression *pexprResult = jodp.PexprExpand();
+		ULONG ulElapsedMS = timer.ElapsedMS();
+
+		ULONG ulPreds = 0;
+		ULONG ulCross = 0;
+		BOOL fValid = true;
+		CheckDPccpJoins(mp, pexprResult, &ulPreds, &ulCross, &fValid);
+
+		CExpressionArray *pdrgpexprTopK = jodp.PdrgpexprTopK();
+		for (ULONG ul = 0; ul < pdrgpexprTopK->Size(); ul++)
+		{
+			ULONG ulPredsTopK = 0;
+			ULONG ulCrossTopK = 0;
+			CheckDPccpJoins(mp, (*pdrgpexprTopK)[ul], &ulPredsTopK,
+							&ulCrossTopK, &fValid);
+			fValid = fValid && ulPredsExpected == ulPredsTopK &&
+					 (0 != ulCrossExpected || 0 == ulCrossTopK);
+		}
+
+		{
+			CAutoTrace at(mp);
+			at.Os() << std::endl
+					<< "DPccp " << szGraph << " of " << ulRels
+					<< " relations: " << ulElapsedMS << " ms" << std::endl;
+			if (fPrint)
+			{
+				at.Os() << *pexprResult << std::endl;
+			}
+		}
+
+		if (!fValid || ulPredsExpected != ulPreds ||
+			(gpos::ulong_max != ulCrossExpected && ulCrossExpected != ulCross) ||
+			!pexprResult->DeriveOutputColumns()->Equals(
+				pexprNAryJoin->DeriveOutputColumns()) ||
+			(0 == ulCrossExpected && 0 == pdrgpexprTopK->Size()))
+		{
+			eres = GPOS_FAILED;
+		}
+
+		if (ulMaxElapsedMS < ulElapsedMS)
+		{
+			CAutoTrace at(mp);
+			at.Os() << "DPccp " << szGraph << " of " << ulRels
+					<< " relations exceeded " << ulMaxElapsedMS << " ms"
+					<< std::endl;
+			eres = GPOS_FAILED;
+		}
+
+		pexprResult->Release();
+	}
+
+	pexprNAryJoin->Release();
+	pdrgpexpr->Release();
+	pdrgpexprConjuncts->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPccpChain
+//
+//	@doc:
+//		DPccp join order of a chain of relations
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPccpChain()
+{
+	const ULONG rgulEdges[][2] = {{0, 1}, {1, 2}, {2, 3},
+								  {3, 4}, {4, 5}, {5, 6}};
+
+	return EresCheckDPccp("chain", 7, rgulEdges, GPOS_ARRAY_SIZE(rgulEdges),
+						  false /*fHyperedge*/, 0 /*ulCrossExpected*/,
+						  true /*fPrint*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPccpStar
+//
+//	@doc:
+//		DPccp join order of a star of relations around the first one
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPccpStar()
+{
+	const ULONG rgulEdges[][2] = {{0, 1}, {0, 2}, {0, 3},
+								  {0, 4}, {0, 5}, {0, 6}};
+
+	return EresCheckDPccp("star", 7, rgulEdges, GPOS_ARRAY_SIZE(rgulEdges),
+						  false /*fHyperedge*/, 0 /*ulCrossExpected*/,
+						  true /*fPrint*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPccpClique
+//
+//	@doc:
+//		DPccp join order of relations all joined with each other
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPccpClique()
+{
+	const ULONG ulRels = 6;
+	ULONG rgulEdges[ulRels * (ulRels - 1) / 2][2];
+	ULONG ulEdges = 0;
+	for (ULONG ulFst = 0; ulFst < ulRels; ulFst++)
+	{
+		for (ULONG ulSnd = ulFst + 1; ulSnd < ulRels; ulSnd++)
+		{
+			rgulEdges[ulEdges][0] = ulFst;
+			rgulEdges[ulEdges][1] = ulSnd;
+			ulEdges++;
+		}
+	}
+
+	return EresCheckDPccp("clique", ulRels, rgulEdges, ulEdges,
+						  false /*fHyperedge*/, 0 /*ulCrossExpected*/,
+						  true /*fPrint*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPccpDisconnected
+//
+//	@doc:
+//		DPccp join order of a join graph with three connected parts, two
+//		chains and a single relation, joined by cross products
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPccpDisconnected()
+{
+	const ULONG rgulEdges[][2] = {{0, 1}, {1, 2}, {3, 4}, {4, 5}};
+
+	return EresCheckDPccp("disconnected graph", 7, rgulEdges,
+						  GPOS_ARRAY_SIZE(rgulEdges), false /*fHyperedge*/,
+						  2 /*ulCrossExpected*/, true /*fPrint*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPccpHyperedge
+//
+//	@doc:
+//		DPccp join order with a predicate over three relations, connecting
+//		the first one to the join of the other two; the predicate goes to
+//		the lowest join covering the three. The enumerator connects each
+//		pair of the three, so cross products among them are allowed
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPccpHyperedge()
+{
+	const ULONG rgulEdges[][2] = {{1, 2}, {0, 3}, {3, 4}, {4, 5}};
+
+	return EresCheckDPccp("hyperedge", 6, rgulEdges,
+						  GPOS_ARRAY_SIZE(rgulEdges), true /*fHyperedge*/,
+						  gpos::ulong_max /*ulCrossExpected*/, true /*fPrint*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPccpTimings
+//
+//	@doc:
+//		DPccp join orders of chains and stars of 13 to 16 relations, past
+//		the default join order threshold, reporting the enumeration time;
+//		then the minidumps of such joins, reporting the optimization time.
+//		Each enumeration must finish within the time the DP enumerator it
+//		replaced took for 10 relations of the same shape
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPccpTimings()
+{
+	// time taken by CJoinOrderDP, in a debug build, for a chain and a star
+	// of 10 relations
+	const ULONG ulDPChain10MS = 1673;
+	const ULONG ulDPStar10MS = 3396;
+
+	for (ULONG ulRels = 13; ulRels <= GPOPT_DPCCP_MAX_COMPONENTS; ulRels++)
+	{
+		ULONG rgulChain[GPOPT_DPCCP_MAX_COMPONENTS][2];
+		ULONG rgulStar[GPOPT_DPCCP_MAX_COMPONENTS][2];
+		for (ULONG ul = 0; ul < ulRels - 1; ul++)
+		{
+			rgulChain[ul][0] = ul;
+			rgulChain[ul][1] = ul + 1;
+			rgulStar[ul][0] = 0;
+			rgulStar[ul][1] = ul + 1;
+		}
+
+		if (GPOS_OK != EresCheckDPccp("chain", ulRels, rgulChain, ulRels - 1,
+									  false /*fHyperedge*/,
+									  0 /*ulCrossExpected*/, false /*fPrint*/,
+									  ulDPChain10MS) ||
+			GPOS_OK != EresCheckDPccp("star", ulRels, rgulStar, ulRels - 1,
+									  false /*fHyperedge*/,
+									  0 /*ulCrossExpected*/, false /*fPrint*/,
+									  ulDPStar10MS))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	ULONG ulTestCounter = 0;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgszJoinOrderDPccpFileNames); ul++)
+	{
+		CTimerUser timer;
+		timer.Restart();
+		GPOS_RESULT eres =
+			CTestUtils::EresUnittest_RunTestsWithoutAdditionalTraceFlags(
+				&rgszJoinOrderDPccpFileNames[ul], &ulTestCounter, 1,
+				true /*fMatchPlans*/, false /*fTestSpacePruning*/);
+		ulTestCounter = 0;
+
+		{
+			CAutoMemoryPool amp;
+			CAutoTrace at(amp.Pmp());
+			at.Os() << std::endl
+					<< rgszJoinOrderDPccpFileNames[ul] << ": "
+					<< timer.ElapsedMS() << " ms"
+					<< std::endl;
+		}
+
+		if (GPOS_OK != eres)
+		{
+			return eres;
+		}
+	}
+
+	return GPOS_OK;
+}
+
 //	run all Minidump-based tests with plan matching
 GPOS_RESULT
 CJoinOrderTest::EresUnittest_RunTests()
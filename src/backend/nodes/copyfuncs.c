@@ -148,6 +148,7 @@ _copyPlannedStmt(const PlannedStmt *from)
 	COPY_NODE_FIELD(copyIntoClause);
 	COPY_NODE_FIELD(refreshClause);
 	COPY_SCALAR_FIELD(metricsQueryType);
+	COPY_NODE_FIELD(optimizerProfile);
 
 	return newnode;
 }
@@ -1577,6 +1578,38 @@ _copyPlanInvalItem(const PlanInvalItem *from)
 	return newnode;
 }
 
+/*
+ * _copyOptimizerProfile
+ */
+static OptimizerProfile *
+_copyOptimizerProfile(const OptimizerProfile *from)
+{
+	OptimizerProfile *newnode = makeNode(OptimizerProfile);
+
+	COPY_SCALAR_FIELD(translateTime);
+	COPY_SCALAR_FIELD(preprocessTime);
+	COPY_SCALAR_FIELD(exploreTime);
+	COPY_SCALAR_FIELD(statsTime);
+	COPY_SCALAR_FIELD(implementTime);
+	COPY_SCALAR_FIELD(optimizeTime);
+	COPY_SCALAR_FIELD(planTime);
+	COPY_SCALAR_FIELD(mdFetchTime);
+	COPY_SCALAR_FIELD(mdCacheHits);
+	COPY_SCALAR_FIELD(mdCacheMisses);
+	COPY_SCALAR_FIELD(memoGroups);
+	COPY_SCALAR_FIELD(memoGroupExprs);
+	COPY_SCALAR_FIELD(searchStages);
+	COPY_SCALAR_FIELD(numXforms);
+	for (int i = 0; i < from->numXforms; i++)
+	{
+		COPY_STRING_FIELD(xformNames[i]);
+		COPY_SCALAR_FIELD(xformTimes[i]);
+		COPY_SCALAR_FIELD(xformCalls[i]);
+	}
+
+	return newnode;
+}
+
 /*
  * _copyMotion
  */
@@ -5994,6 +6027,9 @@ copyObjectImpl(const void *from)
 		case T_PlanInvalItem:
 			retval = _copyPlanInvalItem(from);
 			break;
+		case T_OptimizerProfile:
+			retval = _copyOptimizerProfile(from);
+			break;
 		case T_Motion:
 			retval = _copyMotion(from);
 			break;
@@ -393,6 +393,10 @@ _outPlannedStmt(StringInfo str, const PlannedStmt *node)
 	WRITE_NODE_FIELD(copyIntoClause);
 	WRITE_NODE_FIELD(refreshClause);
 	WRITE_INT_FIELD(metricsQueryType);
+	/* the profile is only shown on the QD, don't dispatch it */
+#ifndef COMPILING_BINARY_FUNCS
+	WRITE_NODE_FIELD(optimizerProfile);
+#endif /* COMPILING_BINARY_FUNCS */
 }
 
 
@@ -1304,6 +1308,33 @@ _outPlanInvalItem(StringInfo str, const PlanInvalItem *node)
 	WRITE_INT_FIELD(cacheId);
 	WRITE_UINT_FIELD(hashValue);
 }
+
+static void
+_outOptimizerProfile(StringInfo str, const OptimizerProfile *node)
+{
+	WRITE_NODE_TYPE("OPTIMIZERPROFILE");
+
+	WRITE_FLOAT_FIELD(translateTime, "%.3f");
+	WRITE_FLOAT_FIELD(preprocessTime, "%.3f");
+	WRITE_FLOAT_FIELD(exploreTime, "%.3f");
+	WRITE_FLOAT_FIELD(statsTime, "%.3f");
+	WRITE_FLOAT_FIELD(implementTime, "%.3f");
+	WRITE_FLOAT_FIELD(optimizeTime, "%.3f");
+	WRITE_FLOAT_FIELD(planTime, "%.3f");
+	WRITE_FLOAT_FIELD(mdFetchTime, "%.3f");
+	WRITE_INT_FIELD(mdCacheHits);
+	WRITE_INT_FIELD(mdCacheMisses);
+	WRITE_INT_FIELD(memoGroups);
+	WRITE_INT_FIELD(memoGroupExprs);
+	WRITE_INT_FIELD(searchStages);
+	WRITE_INT_FIELD(numXforms);
+	for (int i = 0; i < node->numXforms; i++)
+	{
+		WRITE_STRING_FIELD(xformNames[i]);
+		WRITE_FLOAT_FIELD(xformTimes[i], "%.3f");
+		WRITE_INT_FIELD(xformCalls[i]);
+	}
+}
 #endif /* COMPILING_BINARY_FUNCS */
 
 static void
@@ -5660,6 +5691,9 @@ outNode(StringInfo str, const void *obj)
 			case T_PlanInvalItem:
 				_outPlanInvalItem(str, obj);
 				break;
+			case T_OptimizerProfile:
+				_outOptimizerProfile(str, obj);
+				break;
 			case T_Motion:
 				_outMotion(str, obj);
 				break;
@@ -2452,6 +2452,10 @@ _readPlannedStmt(void)
 	READ_NODE_FIELD(copyIntoClause);
 	READ_NODE_FIELD(refreshClause);
 	READ_INT_FIELD(metricsQueryType);
+	/* optimizerProfile not serialized in binary mode */
+#ifndef COMPILING_BINARY_FUNCS
+	READ_NODE_FIELD(optimizerProfile);
+#endif /* COMPILING_BINARY_FUNCS */
 
 	READ_DONE();
 }
@@ -3522,6 +3526,40 @@ _readPlanInvalItem(void)
 	READ_DONE();
 }
 
+#ifndef COMPILING_BINARY_FUNCS
+/*
+ * _readOptimizerProfile
+ */
+static OptimizerProfile *
+_readOptimizerProfile(void)
+{
+	READ_LOCALS(OptimizerProfile);
+
+	READ_FLOAT_FIELD(translateTime);
+	READ_FLOAT_FIELD(preprocessTime);
+	READ_FLOAT_FIELD(exploreTime);
+	READ_FLOAT_FIELD(statsTime);
+	READ_FLOAT_FIELD(implementTime);
+	READ_FLOAT_FIELD(optimizeTime);
+	READ_FLOAT_FIELD(planTime);
+	READ_FLOAT_FIELD(mdFetchTime);
+	READ_INT_FIELD(mdCacheHits);
+	READ_INT_FIELD(mdCacheMisses);
+	READ_INT_FIELD(memoGroups);
+	READ_INT_FIELD(memoGroupExprs);
+	READ_INT_FIELD(searchStages);
+	READ_INT_FIELD(numXforms);
+	for (int i = 0; i < local_node->numXforms; i++)
+	{
+		READ_STRING_FIELD(xformNames[i]);
+		READ_FLOAT_FIELD(xformTimes[i]);
+		READ_INT_FIELD(xformCalls[i]);
+	}
+
+	READ_DONE();
+}
+#endif /* COMPILING_BINARY_FUNCS */
+
 /*
  * _readSubPlan
  */
@@ -4675,6 +4713,8 @@ parseNodeString(void)
 		return_value = _readPartitionPruneStepCombine();
 	else if (MATCH("PLANINVALITEM", 13))
 		return_value = _readPlanInvalItem();
+	else if (MATCH("OPTIMIZERPROFILE", 16))
+		return_value = _readOptimizerProfile();
 	else if (MATCH("SUBPLAN", 7))
 		return_value = _readSubPlan();
 	else if (MATCH("ALTERNATIVESUBPLAN", 18))
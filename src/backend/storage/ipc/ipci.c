@@ -68,6 +68,7 @@
 #include "executor/spi.h"
 #include "utils/workfile_mgr.h"
 #include "utils/session_state.h"
+#include "utils/mdcacheshared.h"
 #include "replication/gp_replication.h"
 
 /* GUCs */
@@ -195,6 +196,7 @@ CreateSharedMemoryAndSemaphores(int port)
 		size = add_size(size, CancelBackendMsgShmemSize());
 		size = add_size(size, WorkFileShmemSize());
 		size = add_size(size, ShareInputShmemSize());
+		size = add_size(size, MDCacheSharedShmemSize());
 
 #ifdef FAULT_INJECTOR
 		size = add_size(size, FaultInjector_ShmemSize());
@@ -358,6 +360,7 @@ CreateSharedMemoryAndSemaphores(int port)
 	BackendCancelShmemInit();
 	WorkFileShmemInit();
 	ShareInputShmemInit();
+	MDCacheSharedShmemInit();
 
 	/*
 	 * Set up Instrumentation free list
@@ -0,0 +1,525 @@
+/*-------------------------------------------------------------------------
+ *
+ * mdcacheshared.c
+ *	  Metadata cache of the GPORCA optimizer shared by all backends.
+ *
+ * Every backend that runs GPORCA keeps its own metadata cache (CMDCache)
+ * of the catalog information the optimizer has looked up.  With many
+ * sessions, each of them pays for fetching the same metadata from the
+ * catalogs on its first queries, and keeps its own copy of it.  This module
+ * adds a second tier behind the backend-local caches: a hash table in shared
+ * memory, keyed by the metadata id, holding the serialized (DXL) metadata
+ * objects.  The objects themselves live in a DSA area carved out of the main
+ * shared memory segment, of size optimizer_mdcache_shared_size.  When the
+ * area is full, stale entries are evicted first, then entries in hash table
+ * order.
+ *
+ * Invalidation
+ * ------------
+ *
+ * Each entry records up to MDCACHE_SHARED_MAX_DEPS catalog dependencies:
+ * the relcache entries and syscache tuples (identified by cache id and hash
+ * value, like in syscache invalidation callbacks) the object was built from.
+ * A dependency maps to one of a fixed number of change slots.  Every backend
+ * registers invalidation callbacks (see gpdbwrappers.cpp), which stamp the
+ * slot of each changed relation or syscache tuple with the next value of a
+ * global change sequence.  An entry is stamped with a change sequence value
+ * taken before its object was read from the catalogs, and is only valid as
+ * long as none of its dependency slots has been stamped since.  Slots are
+ * shared by unrelated dependencies, which merely causes some extra misses.
+ *
+ * Other backends run the callbacks when they read the invalidation message
+ * after commit, in particular before they plan their next query.  The
+ * originating backend runs them at command end, before its changes are
+ * visible to anyone else: another backend may still read the old catalogs
+ * and publish an entry stamped after that.  So a transaction that wrote
+ * something also remembers the slots it stamped, and stamps them again in
+ * AtEOXact_MDCacheShared(), once the commit is visible and its invalidation
+ * messages have been sent.  Backends starting after the commit never read
+ * those messages, and rely on this second stamp.
+ *
+ * A backend reading catalogs for a new entry first accepts pending
+ * invalidation messages, so that its catalog snapshot is not older than the
+ * entry's stamp.  Objects read by a transaction that already wrote something
+ * may reflect its uncommitted catalog changes, and are not published.
+ *
+ * Portions Copyright (c) 2020 VMware, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/cache/mdcacheshared.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/xact.h"
+#include "port/atomics.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/dsa.h"
+#include "utils/guc.h"
+#include "utils/hashutils.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/mdcacheshared.h"
+#include "utils/memutils.h"
+
+/* number of change slots the catalog dependencies are mapped to */
+#define MDCACHE_SHARED_CHANGE_SLOTS		8192
+
+/* expected average size of a serialized metadata object */
+#define MDCACHE_SHARED_AVG_OBJECT_SIZE	2048
+
+/* number of slots a transaction remembers before it stamps them all */
+#define MDCACHE_SHARED_MAX_PENDING		256
+
+typedef struct MDCacheSharedEntry
+{
+	char		key[MDCACHE_SHARED_KEY_LEN];	/* metadata id; hash key */
+	uint64		stamp;			/* change sequence when the object was read */
+	int			ndeps;			/* number of catalog dependencies */
+	uint32		deps[MDCACHE_SHARED_MAX_DEPS];	/* their change slots */
+	dsa_pointer data;			/* serialized object */
+	Size		len;			/* its length */
+} MDCacheSharedEntry;
+
+typedef struct MDCacheSharedControl
+{
+	/* last value handed out from the change sequence */
+	pg_atomic_uint64 change_seq;
+
+	/* last change that invalidated all entries */
+	pg_atomic_uint64 reset_slot;
+
+	/* last change of the dependencies mapped to each slot */
+	pg_atomic_uint64 change_slots[MDCACHE_SHARED_CHANGE_SLOTS];
+} MDCacheSharedControl;
+
+static MDCacheSharedControl *mdcache_shared_ctl = NULL;
+static HTAB *mdcache_shared_hash = NULL;
+static void *mdcache_shared_area_place = NULL;
+
+/* this backend's attachment to the DSA area */
+static dsa_area *mdcache_shared_area = NULL;
+
+/* slots stamped by the current transaction, to stamp again at commit */
+static uint32 mdcache_shared_pending[MDCACHE_SHARED_MAX_PENDING];
+static int	mdcache_shared_npending = 0;
+static bool mdcache_shared_pending_reset = false;
+
+static Size
+mdcache_shared_area_size(void)
+{
+	Size		size = (Size) optimizer_mdcache_shared_size * 1024;
+
+	return Max(size, dsa_minimum_size());
+}
+
+static long
+mdcache_shared_max_entries(void)
+{
+	return (long) (mdcache_shared_area_size() / MDCACHE_SHARED_AVG_OBJECT_SIZE);
+}
+
+/*
+ * Report the amount of shared memory needed.
+ */
+Size
+MDCacheSharedShmemSize(void)
+{
+	Size		size;
+
+	if (optimizer_mdcache_shared_size <= 0)
+		return 0;
+
+	size = MAXALIGN(sizeof(MDCacheSharedControl));
+	size = add_size(size, hash_estimate_size(mdcache_shared_max_entries(),
+											 sizeof(MDCacheSharedEntry)));
+	size = add_size(size, MAXALIGN(mdcache_shared_area_size()));
+
+	return size;
+}
+
+/*
+ * Allocate and initialize the shared memory structures.
+ */
+void
+MDCacheSharedShmemInit(void)
+{
+	bool		found;
+	HASHCTL		info;
+
+	if (optimizer_mdcache_shared_size <= 0)
+		return;
+
+	mdcache_shared_ctl = (MDCacheSharedControl *)
+		ShmemInitStruct("Shared MDCache Control",
+						sizeof(MDCacheSharedControl), &found);
+	mdcache_shared_area_place =
+		ShmemInitStruct("Shared MDCache Area",
+						mdcache_shared_area_size(), &found);
+
+	if (!found)
+	{
+		dsa_area   *area;
+		int			i;
+
+		pg_atomic_init_u64(&mdcache_shared_ctl->change_seq, 0);
+		pg_atomic_init_u64(&mdcache_shared_ctl->reset_slot, 0);
+		for (i = 0; i < MDCACHE_SHARED_CHANGE_SLOTS; i++)
+			pg_atomic_init_u64(&mdcache_shared_ctl->change_slots[i], 0);
+
+		/*
+		 * The area must not grow beyond its place in the main shared memory
+		 * segment. Backends attach to it on first use.
+		 */
+		area = dsa_create_in_place(mdcache_shared_area_place,
+								   mdcache_shared_area_size(),
+								   LWTRANCHE_MDCACHE_SHARED_DSA, NULL);
+		dsa_set_size_limit(area, mdcache_shared_area_size());
+		dsa_detach(area);
+	}
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = MDCACHE_SHARED_KEY_LEN;
+	info.entrysize = sizeof(MDCacheSharedEntry);
+	mdcache_shared_hash = ShmemInitHash("Shared MDCache",
+										mdcache_shared_max_entries(),
+										mdcache_shared_max_entries(),
+										&info,
+										HASH_ELEM);
+}
+
+/*
+ * Is the shared metadata cache configured?
+ */
+bool
+MDCacheSharedEnabled(void)
+{
+	return mdcache_shared_ctl != NULL;
+}
+
+static dsa_area *
+mdcache_shared_get_area(void)
+{
+	if (mdcache_shared_area == NULL)
+	{
+		MemoryContext oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+
+		mdcache_shared_area = dsa_attach_in_place(mdcache_shared_area_place,
+												  NULL);
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	return mdcache_shared_area;
+}
+
+/*
+ * Raise the change slot to the given value of the change sequence. Slots
+ * only move forward, even if concurrent changes stamp them out of order.
+ */
+static void
+mdcache_shared_stamp_slot(pg_atomic_uint64 *slot, uint64 seq)
+{
+	uint64		old = pg_atomic_read_u64(slot);
+
+	while (old < seq && !pg_atomic_compare_exchange_u64(slot, &old, seq))
+		;
+}
+
+static bool
+mdcache_shared_entry_is_valid(MDCacheSharedEntry *entry)
+{
+	int			i;
+
+	if (pg_atomic_read_u64(&mdcache_shared_ctl->reset_slot) >= entry->stamp)
+		return false;
+
+	for (i = 0; i < entry->ndeps; i++)
+	{
+		uint32		dep = entry->deps[i];
+
+		if (pg_atomic_read_u64(&mdcache_shared_ctl->change_slots[dep]) >=
+			entry->stamp)
+			return false;
+	}
+
+	return true;
+}
+
+static void
+mdcache_shared_remove_entry(dsa_area *area, MDCacheSharedEntry *entry)
+{
+	if (DsaPointerIsValid(entry->data))
+		dsa_free(area, entry->data);
+	hash_search(mdcache_shared_hash, entry->key, HASH_REMOVE, NULL);
+}
+
+/*
+ * Allocate space for a serialized object, evicting entries other than the
+ * one being filled until the allocation succeeds. Stale entries go first.
+ * Caller holds MDCacheSharedLock exclusively.
+ */
+static dsa_pointer
+mdcache_shared_allocate(dsa_area *area, Size len, MDCacheSharedEntry *keep)
+{
+	dsa_pointer dp;
+	HASH_SEQ_STATUS status;
+	MDCacheSharedEntry *entry;
+	bool		stale_only;
+
+	dp = dsa_allocate_extended(area, len, DSA_ALLOC_NO_OOM);
+
+	for (stale_only = true; !DsaPointerIsValid(dp); stale_only = false)
+	{
+		hash_seq_init(&status, mdcache_shared_hash);
+		while ((entry = hash_seq_search(&status)) != NULL)
+		{
+			if (entry == keep ||
+				(stale_only && mdcache_shared_entry_is_valid(entry)))
+				continue;
+
+			mdcache_shared_remove_entry(area, entry);
+
+			dp = dsa_allocate_extended(area, len, DSA_ALLOC_NO_OOM);
+			if (DsaPointerIsValid(dp))
+			{
+				hash_seq_term(&status);
+				break;
+			}
+		}
+
+		/* nothing left to evict */
+		if (!stale_only)
+			break;
+	}
+
+	return dp;
+}
+
+/*
+ * Look up a serialized metadata object. Returns a palloc'd copy, or NULL if
+ * there is no valid entry for the key.
+ */
+char *
+MDCacheSharedLookup(const char *key, Size *len)
+{
+	char		keybuf[MDCACHE_SHARED_KEY_LEN];
+	MDCacheSharedEntry *entry;
+	char	   *result = NULL;
+
+	if (!MDCacheSharedEnabled() || strlen(key) >= MDCACHE_SHARED_KEY_LEN)
+		return NULL;
+
+	MemSet(keybuf, 0, sizeof(keybuf));
+	strlcpy(keybuf, key, sizeof(keybuf));
+
+	LWLockAcquire(MDCacheSharedLock, LW_SHARED);
+
+	entry = (MDCacheSharedEntry *) hash_search(mdcache_shared_hash, keybuf,
+											   HASH_FIND, NULL);
+	if (entry != NULL && mdcache_shared_entry_is_valid(entry))
+	{
+		result = palloc(entry->len);
+		memcpy(result,
+			   dsa_get_address(mdcache_shared_get_area(), entry->data),
+			   entry->len);
+		*len = entry->len;
+	}
+
+	LWLockRelease(MDCacheSharedLock);
+
+	return result;
+}
+
+/*
+ * Prepare to read a metadata object from the catalogs for publishing in the
+ * shared cache. Returns the stamp to pass to MDCacheSharedInsert(), or 0 if
+ * the object must not be published.
+ */
+uint64
+MDCacheSharedBeginFetch(void)
+{
+	uint64		stamp;
+
+	if (!MDCacheSharedEnabled())
+		return 0;
+
+	/* the catalogs may show our own uncommitted changes */
+	if (TransactionIdIsValid(GetTopTransactionIdIfAny()))
+		return 0;
+
+	stamp = pg_atomic_add_fetch_u64(&mdcache_shared_ctl->change_seq, 1);
+
+	/*
+	 * Catalog changes committed before the stamp was taken may not be
+	 * visible to our catalog snapshot yet; catch up with them.
+	 */
+	AcceptInvalidationMessages();
+
+	return stamp;
+}
+
+/*
+ * Map a catalog dependency to its change slot. For relcache dependencies,
+ * the cache id is MDCACHE_SHARED_RELCACHE and the hash value is the
+ * relation OID.
+ */
+uint32
+MDCacheSharedDependency(int cacheid, uint32 hashvalue)
+{
+	uint32		hash;
+
+	hash = hash_combine(DatumGetUInt32(hash_uint32((uint32) cacheid)),
+						hashvalue);
+
+	return hash % MDCACHE_SHARED_CHANGE_SLOTS;
+}
+
+/*
+ * Publish a serialized metadata object read from the catalogs since
+ * MDCacheSharedBeginFetch() returned the given stamp. The object is
+ * silently dropped if the cache has no room for it.
+ */
+void
+MDCacheSharedInsert(const char *key, uint64 stamp,
+					const uint32 *deps, int ndeps,
+					const char *data, Size len)
+{
+	char		keybuf[MDCACHE_SHARED_KEY_LEN];
+	MDCacheSharedEntry *entry;
+	dsa_area   *area;
+	bool		found;
+
+	Assert(ndeps <= MDCACHE_SHARED_MAX_DEPS);
+
+	if (!MDCacheSharedEnabled() || stamp == 0 ||
+		strlen(key) >= MDCACHE_SHARED_KEY_LEN)
+		return;
+
+	MemSet(keybuf, 0, sizeof(keybuf));
+	strlcpy(keybuf, key, sizeof(keybuf));
+	area = mdcache_shared_get_area();
+
+	LWLockAcquire(MDCacheSharedLock, LW_EXCLUSIVE);
+
+	entry = (MDCacheSharedEntry *) hash_search(mdcache_shared_hash, keybuf,
+											   HASH_ENTER_NULL, &found);
+	if (entry == NULL)
+	{
+		LWLockRelease(MDCacheSharedLock);
+		return;
+	}
+
+	if (found)
+	{
+		/* keep an entry published by a backend with a newer view */
+		if (entry->stamp >= stamp && mdcache_shared_entry_is_valid(entry))
+		{
+			LWLockRelease(MDCacheSharedLock);
+			return;
+		}
+
+		if (DsaPointerIsValid(entry->data))
+			dsa_free(area, entry->data);
+	}
+
+	entry->data = InvalidDsaPointer;
+	entry->data = mdcache_shared_allocate(area, len, entry);
+	if (!DsaPointerIsValid(entry->data))
+	{
+		hash_search(mdcache_shared_hash, keybuf, HASH_REMOVE, NULL);
+		LWLockRelease(MDCacheSharedLock);
+		return;
+	}
+
+	memcpy(dsa_get_address(area, entry->data), data, len);
+	entry->len = len;
+	entry->stamp = stamp;
+	entry->ndeps = ndeps;
+	memcpy(entry->deps, deps, ndeps * sizeof(uint32));
+
+	LWLockRelease(MDCacheSharedLock);
+}
+
+/*
+ * Invalidate the entries depending on the given relation or syscache tuple.
+ */
+void
+MDCacheSharedInvalidate(int cacheid, uint32 hashvalue)
+{
+	uint32		dep;
+	uint64		seq;
+
+	if (!MDCacheSharedEnabled())
+		return;
+
+	dep = MDCacheSharedDependency(cacheid, hashvalue);
+	seq = pg_atomic_add_fetch_u64(&mdcache_shared_ctl->change_seq, 1);
+	mdcache_shared_stamp_slot(&mdcache_shared_ctl->change_slots[dep], seq);
+
+	/* the change may be our own, and not visible to others yet */
+	if (TransactionIdIsValid(GetTopTransactionIdIfAny()))
+	{
+		if (mdcache_shared_npending < MDCACHE_SHARED_MAX_PENDING)
+			mdcache_shared_pending[mdcache_shared_npending++] = dep;
+		else
+			mdcache_shared_pending_reset = true;
+	}
+}
+
+/*
+ * Invalidate all entries.
+ */
+void
+MDCacheSharedInvalidateAll(void)
+{
+	uint64		seq;
+
+	if (!MDCacheSharedEnabled())
+		return;
+
+	seq = pg_atomic_add_fetch_u64(&mdcache_shared_ctl->change_seq, 1);
+	mdcache_shared_stamp_slot(&mdcache_shared_ctl->reset_slot, seq);
+
+	if (TransactionIdIsValid(GetTopTransactionIdIfAny()))
+		mdcache_shared_pending_reset = true;
+}
+
+/*
+ * Stamp again the slots stamped by the transaction, at commit.
+ *
+ * Called after the commit has become visible and the transaction's
+ * invalidation messages have been sent, so that an entry built from the
+ * catalogs as they were before the commit has an older stamp, and one
+ * stamped later reads the new catalogs. On abort, or when the transaction
+ * is prepared, the remembered slots are simply forgotten.
+ */
+void
+AtEOXact_MDCacheShared(bool isCommit)
+{
+	int			i;
+
+	if (isCommit && MDCacheSharedEnabled())
+	{
+		uint64		seq;
+
+		seq = pg_atomic_add_fetch_u64(&mdcache_shared_ctl->change_seq, 1);
+
+		if (mdcache_shared_pending_reset)
+			mdcache_shared_stamp_slot(&mdcache_shared_ctl->reset_slot, seq);
+		else
+		{
+			for (i = 0; i < mdcache_shared_npending; i++)
+			{
+				uint32		dep = mdcache_shared_pending[i];
+
+				mdcache_shared_stamp_slot(&mdcache_shared_ctl->change_slots[dep],
+										  seq);
+			}
+		}
+	}
+
+	mdcache_shared_npending = 0;
+	mdcache_shared_pending_reset = false;
+}
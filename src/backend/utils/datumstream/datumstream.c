@@ -1286,10 +1286,12 @@ datumstreamread_block_content(DatumStreamRead * acc)
 }
 
 
-int
-datumstreamread_block(DatumStreamRead * acc,
-					  AppendOnlyBlockDirectory *blockDirectory,
-					  int colGroupNo)
+/*
+ * Read the header of the next block, and advance the row position of the
+ * stream to it.
+ */
+static bool
+datumstreamread_next_block_info(DatumStreamRead * acc)
 {
 	bool		readOK = false;
 
@@ -1305,7 +1307,7 @@ datumstreamread_block(DatumStreamRead * acc,
 												&acc->getBlockInfo.isLarge,
 											&acc->getBlockInfo.isCompressed);
 	if (!readOK)
-		return -1;
+		return false;
 
 	if (Debug_appendonly_print_datumstream)
 		elog(LOG,
@@ -1347,6 +1349,17 @@ datumstreamread_block(DatumStreamRead * acc,
 			 acc->blockFileOffset,
 			 acc->blockRowCount);
 
+	return true;
+}
+
+int
+datumstreamread_block(DatumStreamRead * acc,
+					  AppendOnlyBlockDirectory *blockDirectory,
+					  int colGroupNo)
+{
+	if (!datumstreamread_next_block_info(acc))
+		return -1;
+
 	datumstreamread_block_content(acc);
 
 	if (blockDirectory)
@@ -1362,6 +1375,47 @@ datumstreamread_block(DatumStreamRead * acc,
 	return 0;
 }
 
+/*
+ * Move the stream forward, so that the next datumstreamread_advance() lands
+ * on the given row. The blocks in between are passed over without reading
+ * their content.
+ *
+ * Returns -1 if the row is past the end of the segment file.
+ */
+int
+datumstreamread_skip_to_row(DatumStreamRead * acc, int64 rowNum)
+{
+	Assert(acc);
+
+	while (rowNum >= acc->blockFirstRowNum + acc->blockRowCount)
+	{
+		if (!datumstreamread_next_block_info(acc))
+			return -1;
+
+		/*
+		 * The row count of a pre-4.0 block is only known once its content
+		 * has been read.
+		 */
+		if (acc->getBlockInfo.firstRow >= 0 &&
+			rowNum >= acc->blockFirstRowNum + acc->blockRowCount)
+		{
+			AppendOnlyStorageRead_SkipCurrentBlock(&acc->ao_read);
+			continue;
+		}
+
+		datumstreamread_block_content(acc);
+	}
+
+	/*
+	 * Either the row is further in the current block, or the block has just
+	 * been read and the row is its first.
+	 */
+	if (rowNum > acc->blockFirstRowNum)
+		datumstreamread_find(acc, rowNum - acc->blockFirstRowNum - 1);
+
+	return 0;
+}
+
 void
 datumstreamread_rewind_block(DatumStreamRead * datumStream)
 {
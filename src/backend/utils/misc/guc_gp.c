@@ -140,6 +140,7 @@ int			gp_max_local_distributed_cache = 1024;
 bool		gp_appendonly_verify_block_checksums = true;
 bool		gp_appendonly_verify_write_block = false;
 bool		gp_appendonly_compaction = true;
+bool		gp_appendonly_zone_maps = false;
 int			gp_appendonly_compaction_threshold = 0;
 bool		gp_heap_require_relhasoids_match = true;
 bool		gp_local_distributed_cache_stats = false;
@@ -250,6 +251,7 @@ bool		gp_enable_hashjoin_size_heuristic = false;
 bool		gp_enable_predicate_propagation = false;
 bool		gp_enable_minmax_optimization = true;
 bool		gp_enable_multiphase_agg = true;
+bool		gp_enable_runtime_filter = false;
 bool		gp_enable_preunique = true;
 bool		gp_enable_agg_distinct = true;
 bool		gp_enable_dqa_pruning = true;
@@ -267,10 +269,17 @@ bool		optimizer_control = true;
 bool		optimizer_trace_fallback;
 bool		optimizer_partition_selection_log;
 int			optimizer_minidump;
+bool		optimizer_dxl_binary;
 int			optimizer_cost_model;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
+bool		optimizer_plan_caching;
+int			optimizer_plan_cache_size;
+bool		optimizer_adaptive_search_strategy;
+bool		optimizer_prefetch_metadata;
+int			optimizer_mdcache_shared_size;
 bool		optimizer_use_gpdb_allocators;
+bool		optimizer_use_arena_memory_pool;
 
 /* Optimizer debugging GUCs */
 bool		optimizer_print_query;
@@ -285,10 +294,12 @@ bool		optimizer_print_group_properties;
 bool		optimizer_print_optimization_context;
 bool		optimizer_print_optimization_stats;
 bool		optimizer_print_xform_results;
+bool		optimizer_explain_profile;
 
 /* array of xforms disable flags */
 bool		optimizer_xforms[OPTIMIZER_XFORMS_COUNT] = {[0 ... OPTIMIZER_XFORMS_COUNT - 1] = false};
 char	   *optimizer_search_strategy_path = NULL;
+char	   *optimizer_cost_model_params_path = NULL;
 
 /* GUCs to tell Optimizer to enable a physical operator */
 bool		optimizer_enable_indexjoin;
@@ -677,6 +688,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_runtime_filter", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables hash joins to filter the rows of the scan on their outer side."),
+			gettext_noop("The hash join builds a Bloom filter, and the range of the first join key, "
+						 "from its inner rows. The Seq Scan on its outer side drops the rows that "
+						 "cannot join before passing them on.")
+		},
+		&gp_enable_runtime_filter,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_enable_preunique", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enable 2-phase duplicate removal."),
@@ -871,6 +894,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_appendonly_zone_maps", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Keep min/max summaries of append-only tables in their block directory, and skip the blocks they rule out."),
+			gettext_noop("Summaries are only added by inserts made with this setting on. "
+						 "Blocks without one are always read."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_appendonly_zone_maps,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_heap_require_relhasoids_match", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Issue an error on discovery of a mismatch between relhasoids and a tuple header."),
@@ -1834,6 +1869,49 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_plan_caching", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("This guc enables the optimizer to cache plans and reuse them for queries differing in constants only."),
+			NULL
+		},
+		&optimizer_plan_caching,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_adaptive_search_strategy", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Pick the optimizer search strategy from the complexity of the query."),
+			gettext_noop("Queries with few joins first search the cheap join orders only, "
+						 "and only run the exhaustive join orders if the plan found is expensive.")
+		},
+		&optimizer_adaptive_search_strategy,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_prefetch_metadata", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Fetch the statistics of the relations referenced by a query, and of the columns it filters, joins or groups on, before optimizing it."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_prefetch_metadata,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_dxl_binary", PGC_USERSET, LOGGING_WHAT,
+			gettext_noop("Write optimizer minidumps and DXL plans in the binary DXL format instead of XML."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_dxl_binary,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_print_missing_stats", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Print columns with missing statistics."),
@@ -1944,6 +2022,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_explain_profile", PGC_USERSET, LOGGING_WHAT,
+			gettext_noop("Collect the planning profile shown by EXPLAIN (VERBOSE, SUMMARY)."),
+			gettext_noop("Timing every transformation adds to the planning time, so the "
+						 "profile is only collected when asked for."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_explain_profile,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_extract_dxl_stats", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Extract plan stats in dxl."),
@@ -2623,6 +2713,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_use_arena_memory_pool", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Enable ORCA to allocate the memory of each optimization from an arena."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_use_arena_memory_pool,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"vmem_process_interrupt", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Checks for interrupts before reserving VMEM"),
@@ -3823,7 +3924,7 @@ struct config_int ConfigureNamesInt_gp[] =
 			NULL
 		},
 		&optimizer_join_order_threshold,
-		10, 0, 12,
+		10, 0, 16,
 		NULL, NULL, NULL
 	},
 
@@ -3860,6 +3961,28 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_plan_cache_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the size of the optimizer plan cache."),
+			NULL,
+			GUC_UNIT_KB
+		},
+		&optimizer_plan_cache_size,
+		16384, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_mdcache_shared_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the size of the MDCache shared by all backends."),
+			gettext_noop("0 disables the shared MDCache."),
+			GUC_UNIT_KB
+		},
+		&optimizer_mdcache_shared_size,
+		0, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -4230,6 +4353,18 @@ struct config_string ConfigureNamesString_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_cost_model_params_path", PGC_USERSET, QUERY_TUNING_COST,
+			gettext_noop("Sets the file of cost model parameters used by gp optimizer."),
+			gettext_noop("Written by the cost model calibration script, and only used "
+						 "by the calibrated cost model. Empty means the default parameters."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_cost_model_params_path,
+		"",
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_default_storage_options", PGC_USERSET, APPENDONLY_TABLES,
 			gettext_noop("default options for appendonly storage."),
@@ -179,6 +179,12 @@ typedef struct AOCSScanDescData
 	 */
 	AppendOnlyBlockDirectory *blockDirectory;
 	AppendOnlyVisimap visibilityMap;
+
+	/*
+	 * Zone maps of the block directory, used to skip the rows that the
+	 * quals rule out. NULL if there are none to use.
+	 */
+	AppendOnlyZoneMap *zoneMap;
 } AOCSScanDescData;
 
 typedef AOCSScanDescData *AOCSScanDesc;
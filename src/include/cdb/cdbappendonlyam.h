@@ -226,6 +226,12 @@ typedef struct AppendOnlyScanDescData
 	 */ 
 	AppendOnlyVisimap visibilityMap;
 
+	/*
+	 * Zone maps of the block directory, used to skip the blocks that the
+	 * quals rule out. NULL if there are none to use.
+	 */
+	AppendOnlyZoneMap *zoneMap;
+
 	/*
 	 * Only used by `analyze`
 	 */
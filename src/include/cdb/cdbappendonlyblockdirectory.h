@@ -17,6 +17,7 @@
 #include "access/aosegfiles.h"
 #include "access/aocssegfiles.h"
 #include "access/appendonlytid.h"
+#include "access/memtup.h"
 #include "access/skey.h"
 #include "catalog/indexing.h"
 
@@ -63,6 +64,38 @@ typedef struct Minipage
 	MinipageEntry entry[1];
 } Minipage;
 
+/*
+ * Zone map of a minipage: for each entry, and for each summarized column of
+ * the column group, the smallest and largest value and the number of NULLs
+ * in the rows the entry covers. Only integer and date/time columns are
+ * summarized, with their values mapped to int64.
+ *
+ * The zone map is stored after the entries of the minipage, within the same
+ * varlena. A minipage without one ends after entry[nEntry - 1].
+ */
+#define MAX_ZONEMAP_COLUMNS 8
+
+/* ZoneMapSummary flags */
+#define ZONEMAP_SUMMARIZED	0x01	/* every row of the entry was added */
+#define ZONEMAP_HAS_VALUES	0x02	/* minValue and maxValue are set */
+
+typedef struct ZoneMapSummary
+{
+	int64 minValue;
+	int64 maxValue;
+	int32 nullCount;
+	int32 flags;
+} ZoneMapSummary;
+
+typedef struct MinipageZoneMap
+{
+	int32 nColumns;
+	AttrNumber attnums[MAX_ZONEMAP_COLUMNS];
+
+	/* nEntry * nColumns summaries, entry-major */
+	ZoneMapSummary summaries[FLEXIBLE_ARRAY_MEMBER];
+} MinipageZoneMap;
+
 /*
  * Define the relevant info for a minipage for each
  * column group.
@@ -72,6 +105,16 @@ typedef struct MinipagePerColumnGroup
 	Minipage *minipage;
 	uint32 numMinipageEntries;
 	ItemPointerData tupleTid;
+
+	/*
+	 * Zone map of the minipage, maintained only when inserting. pendingZoneMap
+	 * summarizes the rows added since the last entry was inserted.
+	 */
+	int numZoneMapColumns;
+	AttrNumber zoneMapAttnums[MAX_ZONEMAP_COLUMNS];
+	Oid zoneMapTypes[MAX_ZONEMAP_COLUMNS];
+	ZoneMapSummary *zoneMap;
+	ZoneMapSummary *pendingZoneMap;
 } MinipagePerColumnGroup;
 
 /*
@@ -124,6 +167,48 @@ typedef struct AppendOnlyBlockDirectory
 }	AppendOnlyBlockDirectory;
 
 
+/*
+ * A zone map loaded for scanning one segment file, for one column group:
+ * the row ranges of its block directory entries, and whether the scan keys
+ * exclude every row of each.
+ */
+typedef struct ZoneMapRange
+{
+	int64 firstRowNum;
+	int64 fileOffset;
+	bool excluded;
+} ZoneMapRange;
+
+typedef struct ZoneMapColumnGroup
+{
+	int columnGroupNo;
+	int numRanges;
+	int maxRanges;
+	ZoneMapRange *ranges;
+
+	/* Scans are forward only, so lookups resume from the last range found */
+	int currentRange;
+} ZoneMapColumnGroup;
+
+typedef struct AppendOnlyZoneMap
+{
+	Relation aoRel;
+	Snapshot appendOnlyMetaDataSnapshot;
+	bool isAOCol;
+	Relation blkdirRel;
+	Relation blkdirIdx;
+
+	/* Scan keys of the quals, and their values mapped to int64 */
+	int nkeys;
+	ScanKey keys;
+	int64 *keyValues;
+
+	int numGroups;
+	ZoneMapColumnGroup *groups;
+
+	MemoryContext memoryContext;
+} AppendOnlyZoneMap;
+
 typedef struct CurrentBlock
 {
 	AppendOnlyBlockDirectoryEntry blockDirectoryEntry;
@@ -225,4 +310,31 @@ extern void AppendOnlyBlockDirectory_DeleteSegmentFile(
 		Snapshot snapshot,
 		int segno,
 		int columnGroupNo);
+extern void AppendOnlyBlockDirectory_SummarizeDatum(
+	AppendOnlyBlockDirectory *blockDirectory,
+	int columnGroupNo,
+	Datum value,
+	bool isnull);
+extern void AppendOnlyBlockDirectory_SummarizeMemTuple(
+	AppendOnlyBlockDirectory *blockDirectory,
+	MemTuple tuple,
+	MemTupleBinding *mt_bind);
+
+extern AppendOnlyZoneMap *AppendOnlyZoneMap_Init(
+	Relation aoRel,
+	Snapshot appendOnlyMetaDataSnapshot,
+	bool isAOCol,
+	List *qual);
+extern void AppendOnlyZoneMap_LoadSegmentFile(
+	AppendOnlyZoneMap *zoneMap,
+	FileSegInfo *segmentFileInfo);
+extern bool AppendOnlyZoneMap_ExcludesBlock(
+	AppendOnlyZoneMap *zoneMap,
+	int64 fileOffset);
+extern bool AppendOnlyZoneMap_ExcludesRow(
+	AppendOnlyZoneMap *zoneMap,
+	int64 rowNum,
+	int64 *nextRowNum);
+extern void AppendOnlyZoneMap_Finish(
+	AppendOnlyZoneMap *zoneMap);
 #endif
@@ -73,6 +73,12 @@ typedef struct BufferedRead
 	/* current read position */
 	off_t				 fileOff;
 
+	/*
+	 * End of the range already handed to the kernel for read-ahead. The
+	 * next large read is prefetched while the current one is consumed.
+	 */
+	int64				 prefetchPosition;
+
 	/*
 	 * Temporary limit support for random reading.
 	 */
@@ -486,6 +486,14 @@ extern bool gp_enable_minmax_optimization;
  */
 extern bool gp_enable_multiphase_agg;
 
+/*
+ * "gp_enable_runtime_filter"
+ *
+ * Let a hash join build a filter from its inner rows, for the Seq Scan on
+ * its outer side, in the same slice, to drop the rows that cannot join.
+ */
+extern bool gp_enable_runtime_filter;
+
 /*
  * Perform a post-planning scan of the final plan looking for motion deadlocks:
  * emit verbose messages about any found.
@@ -48,6 +48,9 @@ extern void ExecParallelHashTableInsert(HashJoinTable hashtable,
 extern void ExecParallelHashTableInsertCurrentBatch(HashJoinTable hashtable,
 													TupleTableSlot *slot,
 													uint32 hashvalue);
+extern bool ExecRuntimeFilterRejects(RuntimeFilterState *filter,
+									 TupleTableSlot *slot,
+									 ExprContext *econtext);
 extern bool ExecHashGetHashValue(HashState *hashState, HashJoinTable hashtable,
 								 ExprContext *econtext,
 								 List *hashkeys,
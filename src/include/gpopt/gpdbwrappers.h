@@ -555,6 +555,9 @@ bool RelPartIsNone(Oid relid);
 // check whether a relation is inherited
 bool HasSubclassSlow(Oid rel_oid);
 
+// partitioned tables the given relation is a partition of, innermost first
+List *GetPartitionAncestors(Oid rel_oid);
+
 // check whether table with given oid is an external table
 bool RelIsExternalTable(Oid relid);
 
@@ -724,10 +727,51 @@ FaultInjectorType_e InjectFaultInOptTasks(const char *fault_name);
 	gpos::ULONG CountLeafPartTables(Oid oidRelation);
 #endif
 
+// a catalog change that only affects individual metadata cache entries
+struct MDCacheInvalidation
+{
+	// invalidated relation, or InvalidOid for a syscache invalidation
+	Oid relid;
+
+	// syscache id and hash value of the invalidated catalog tuple; the
+	// cache id is -1 for a relcache invalidation
+	int cacheid;
+	uint32 hashvalue;
+};
+
 // Does the metadata cache need to be reset (because of a catalog
-// table has been changed?)
+// table has been changed in a way that cannot be pinned down to
+// individual cache entries?)
 bool MDCacheNeedsReset(void);
 
+// catalog changes collected by the last call to MDCacheNeedsReset() that
+// did not require a reset; returns the number of changes
+int MDCacheGetInvalidations(const MDCacheInvalidation **invalidations);
+
+// hash value of the syscache tuple with the given keys
+uint32 GetSysCacheHashValue(int cacheid, Datum key1, Datum key2 = 0,
+							Datum key3 = 0);
+
+// start tracking the catalog changes that affect the metadata caches
+void InitMDCacheInvalidation(void);
+
+// is the metadata cache shared by all backends enabled?
+bool MDCacheSharedEnabled(void);
+
+// serialized object for the given key in the shared metadata cache, or NULL
+char *MDCacheSharedLookup(const char *key, Size *len);
+
+// start reading an object to publish in the shared metadata cache; returns
+// the stamp to publish it with, or 0 if it must not be published
+uint64 MDCacheSharedBeginFetch(void);
+
+// change slot of a catalog dependency of a shared metadata cache entry
+uint32 MDCacheSharedDependency(int cacheid, uint32 hashvalue);
+
+// publish a serialized object in the shared metadata cache
+void MDCacheSharedInsert(const char *key, uint64 stamp, const uint32 *deps,
+						 int ndeps, const char *data, Size len);
+
 // returns true if a query cancel is requested in GPDB
 bool IsAbortRequested(void);
 
@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMDCacheInvalidator.h
+//
+//	@doc:
+//		Targeted invalidation of metadata cache entries on catalog changes.
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CMDCacheInvalidator_H
+#define GPMD_CMDCacheInvalidator_H
+
+#include "gpos/base.h"
+
+#include "naucrates/md/IMDId.h"
+
+#include "gpopt/gpdbwrappers.h"
+
+// fwd decl
+namespace gpopt
+{
+class CMDKey;
+}
+
+namespace gpmd
+{
+using namespace gpos;
+
+class IMDCacheObject;
+class IMDCast;
+class IMDRelation;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CMDCacheInvalidator
+//
+//	@doc:
+//		Drops the metadata cache entries built from catalog tuples that were
+//		changed since the last optimized query. The changes are the relcache
+//		and syscache invalidations recorded by gpdb::MDCacheNeedsReset().
+//
+//		Relation, index, trigger and statistics objects are matched against
+//		invalidated relation OIDs; statistics of partitioned tables are also
+//		dropped when one of their partitions is invalidated, since they are
+//		estimated from the partitions. Types, operators, functions,
+//		aggregates, constraints and casts are matched by hashing their
+//		catalog keys the way the syscache does. Column statistics are matched
+//		by hashing the pg_statistic keys of the columns of cached relations.
+//
+//---------------------------------------------------------------------------
+class CMDCacheInvalidator
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// catalog changes to process
+	const gpdb::MDCacheInvalidation *m_invalidations;
+
+	// number of catalog changes
+	ULONG m_num_invalidations;
+
+	// OIDs of invalidated relations
+	ULongPtrArray *m_rel_oids;
+
+	// OIDs of relations whose statistics are affected by the invalidated
+	// relations, i.e. the invalidated relations and their partition ancestors
+	ULongPtrArray *m_stats_rel_oids;
+
+	// column statistics whose pg_statistic tuples changed
+	MdidHashSet *m_col_stats;
+
+	// relations found in the cache
+	MdidHashSet *m_cached_rels;
+
+	// number of pg_statistic changes
+	ULONG m_num_stats_invalidations;
+
+	// per catalog change, was it traced to a column of a cached relation?
+	BOOL *m_stats_traced;
+
+	// is there a pg_statistic change that cannot be traced back to a
+	// column of a cached relation?
+	BOOL m_has_untraced_stats;
+
+	// does the list contain the OID of the given mdid?
+	static BOOL FContainsOid(const ULongPtrArray *oids, const IMDId *mdid);
+
+	// was the syscache tuple with the given OID key invalidated?
+	BOOL FSyscacheInvalidated(int cacheid, const IMDId *mdid) const;
+
+	// was the pg_cast tuple of the given cast invalidated?
+	BOOL FCastInvalidated(const IMDCast *md_cast) const;
+
+	// trace pg_statistic changes to the columns of the given relation
+	void TraceColStats(const IMDRelation *md_rel);
+
+	// is the given cached object affected by the catalog changes?
+	BOOL FInvalidated(const IMDCacheObject *md_obj) const;
+
+	// cache visitor recording cached relations; selects no entries
+	static BOOL FTraceColStats(gpopt::CMDKey *const &key,
+							   IMDCacheObject *md_obj, void *arg);
+
+	// cache predicate selecting the affected entries
+	static BOOL FInvalidate(gpopt::CMDKey *const &key, IMDCacheObject *md_obj,
+							void *arg);
+
+public:
+	CMDCacheInvalidator(const CMDCacheInvalidator &) = delete;
+
+	// ctor
+	CMDCacheInvalidator(CMemoryPool *mp,
+						const gpdb::MDCacheInvalidation *invalidations,
+						ULONG num_invalidations);
+
+	// dtor
+	~CMDCacheInvalidator();
+
+	// drop the affected entries from the metadata cache, and return
+	// their number
+	ULONG UlInvalidate();
+};
+}  // namespace gpmd
+
+#endif	// !GPMD_CMDCacheInvalidator_H
+
+// EOF
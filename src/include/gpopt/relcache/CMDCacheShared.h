@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMDCacheShared.h
+//
+//	@doc:
+//		Access to the metadata cache shared by all backends.
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CMDCacheShared_H
+#define GPMD_CMDCacheShared_H
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/md/IMDId.h"
+
+#include "gpopt/gpdbwrappers.h"
+
+extern "C" {
+#include "utils/mdcacheshared.h"
+}
+
+// fwd decl
+namespace gpopt
+{
+class CMDAccessor;
+}
+
+namespace gpmd
+{
+using namespace gpos;
+
+class IMDCacheObject;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CMDCacheShared
+//
+//	@doc:
+//		Looks up and publishes the metadata object with a given mdid, as a
+//		binary DXL document, in the metadata cache shared by all backends (see
+//		utils/cache/mdcacheshared.c). The shared cache sits behind the
+//		backend-local metadata cache: it is consulted before translating an
+//		object from the catalogs, and filled with the objects translated.
+//
+//		Published objects record the catalog tuples they were built from,
+//		the same ones the local cache is invalidated on (see
+//		CMDCacheInvalidator). Objects whose catalog dependencies cannot be
+//		pinned down, like the statistics of partitioned tables, are not
+//		published.
+//
+//---------------------------------------------------------------------------
+class CMDCacheShared
+{
+private:
+	// key of the object in the shared cache
+	CHAR m_key[MDCACHE_SHARED_KEY_LEN];
+
+	// can the object be kept in the shared cache?
+	BOOL m_has_key;
+
+	// stamp of the object being read from the catalogs
+	uint64 m_stamp;
+
+	// catalog dependencies of the object being published
+	uint32 m_deps[MDCACHE_SHARED_MAX_DEPS];
+
+	// number of catalog dependencies
+	int m_num_deps;
+
+	// add a catalog dependency
+	void AddDependency(int cacheid, uint32 hashvalue);
+
+	// add a dependency on the relcache entry of the given relation
+	void AddRelDependency(const IMDId *mdid);
+
+	// add a dependency on the tuple of the given OID-keyed syscache
+	void AddSyscacheDependency(int cacheid, const IMDId *mdid);
+
+	// add the dependencies of the given statistics object; returns false if
+	// they cannot be determined
+	BOOL FAddStatsDependencies(gpopt::CMDAccessor *md_accessor,
+							   const IMDCacheObject *md_obj);
+
+	// add the dependencies of the given object; returns false if they
+	// cannot be determined
+	BOOL FAddDependencies(gpopt::CMDAccessor *md_accessor,
+						  const IMDCacheObject *md_obj);
+
+	// binary DXL document of the object if it is in the shared cache
+	BYTE *Lookup(ULONG *length) const;
+
+public:
+	CMDCacheShared(const CMDCacheShared &) = delete;
+
+	// ctor
+	explicit CMDCacheShared(const IMDId *mdid);
+
+	// the object if it is in the shared cache, NULL otherwise
+	IMDCacheObject *GetMDObj(CMemoryPool *mp) const;
+
+	// DXL string of the object if it is in the shared cache, NULL otherwise
+	CWStringDynamic *GetDXLStr(CMemoryPool *mp) const;
+
+	// start reading the object from the catalogs
+	void BeginFetch();
+
+	// publish the object read from the catalogs
+	void Insert(CMemoryPool *mp, gpopt::CMDAccessor *md_accessor,
+				const IMDCacheObject *md_obj);
+};
+}  // namespace gpmd
+
+#endif	// !GPMD_CMDCacheShared_H
+
+// EOF
@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CMDPrefetcher.h
+//
+//	@doc:
+//		Prefetching of the metadata of the relations referenced by a query.
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CMDPrefetcher_H
+#define GPMD_CMDPrefetcher_H
+
+#include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashMapIter.h"
+
+#include "naucrates/dxl/gpdb_types.h"
+
+#include "gpopt/gpdbwrappers.h"
+
+// fwd decl
+namespace gpopt
+{
+class CMDAccessor;
+}
+
+struct List;
+struct Node;
+struct Query;
+struct TargetEntry;
+struct Var;
+
+namespace gpmd
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CMDPrefetcher
+//
+//	@doc:
+//		Fetches the statistics the optimizer will need for the relations
+//		referenced anywhere in a query, in one pass before optimization
+//		instead of one object at a time during statistics derivation: the
+//		relation statistics and the column statistics of the columns the
+//		query filters, joins or groups on. The whole query is walked before
+//		anything is fetched, so a relation referenced several times is
+//		fetched once. The column statistics of a relation reuse the row
+//		count of its relation statistics, so the partitions of a partitioned
+//		table are scanned once for all its columns.
+//
+//		The prefetch runs on a query that has been translated to DXL, so the
+//		relations themselves are already in the metadata accessor.
+//
+//---------------------------------------------------------------------------
+class CMDPrefetcher
+{
+private:
+	// map of relation oids to the attribute numbers of their columns
+	typedef CHashMap<ULONG, CBitSet, gpos::HashValue<ULONG>,
+					 gpos::Equals<ULONG>, CleanupDelete<ULONG>,
+					 CleanupRelease<CBitSet> >
+		OidToAttnoSetMap;
+
+	// iterator over the relations of the map above
+	typedef CHashMapIter<ULONG, CBitSet, gpos::HashValue<ULONG>,
+						 gpos::Equals<ULONG>, CleanupDelete<ULONG>,
+						 CleanupRelease<CBitSet> >
+		OidToAttnoSetMapIter;
+
+	// context of the walker collecting the columns of a query
+	struct SCollectContext
+	{
+		// prefetcher to record the columns in
+		CMDPrefetcher *m_prefetcher;
+
+		// query the expressions walked belong to
+		Query *m_query;
+	};
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// metadata accessor to fetch the objects into
+	gpopt::CMDAccessor *m_md_accessor;
+
+	// relations referenced by the query, and the columns to prefetch
+	OidToAttnoSetMap *m_rel_attnos;
+
+	// record a relation and return the set of its columns to prefetch
+	CBitSet *AddRelation(OID oid);
+
+	// record the column referenced by the given variable of the given query
+	void AddVar(Query *query, const Var *var);
+
+	// record the columns a query filters, joins or groups on
+	void CollectQuery(Query *query);
+
+	// does one of the given sort/group clauses refer to the target entry?
+	static BOOL FSortGroupRef(List *clauses, const TargetEntry *target_entry);
+
+	// walker recording the columns referenced by an expression of a query
+	static BOOL CollectWalker(Node *node, SCollectContext *ctxt);
+
+	// fetch the statistics of the given relation and columns
+	void PrefetchRelation(OID oid, const CBitSet *attnos);
+
+	// walker visiting the range table entries of a query and its subqueries
+	static BOOL PrefetchWalker(Node *node, CMDPrefetcher *prefetcher);
+
+public:
+	CMDPrefetcher(const CMDPrefetcher &) = delete;
+
+	// ctor
+	CMDPrefetcher(CMemoryPool *mp, gpopt::CMDAccessor *md_accessor);
+
+	// dtor
+	~CMDPrefetcher();
+
+	// fetch the statistics of the relations referenced by the given query
+	void Prefetch(Query *query);
+};
+}  // namespace gpmd
+
+#endif	// !GPMD_CMDPrefetcher_H
+
+// EOF
@@ -49,6 +49,9 @@ private:
 	// memory pool
 	CMemoryPool *m_mp;
 
+	// copy of the given mdid, in the given pool
+	static IMDId *CopyMDId(CMemoryPool *mp, IMDId *md_id);
+
 public:
 	CMDProviderRelcache(const CMDProviderRelcache &) = delete;
 
@@ -61,6 +64,11 @@ public:
 	CWStringBase *GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 								 IMDId *md_id) const override;
 
+	// returns the requested metadata object, allocated in the given memory
+	// pool
+	IMDCacheObject *GetMDObj(CMemoryPool *mp, CMDAccessor *md_accessor,
+							 IMDId *md_id) const override;
+
 	// return the mdid for the requested type
 	IMDId *
 	MDId(CMemoryPool *mp, CSystemId sysid,
@@ -30,9 +30,11 @@ private:
 	// To do this, we need the size of the allocation, which we then divide by the
 	// the size of the element to get number of elements to iterate through.
 	// This struct is only used for array allocations (GPOS_NEW_ARRAY())
+	// The size is stored shifted left by one, as the lowest bit of the word
+	// in front of an allocation must be clear (see CMemoryPool)
 	struct SArrayAllocHeader
 	{
-		ULONG m_user_size;
+		ULONG_PTR m_shifted_user_size;
 	};
 
 public:
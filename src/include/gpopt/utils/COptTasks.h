@@ -42,9 +42,12 @@ class CExpression;
 class CMDAccessor;
 class CQueryContext;
 class COptimizerConfig;
+class COptimizationStats;
 class ICostModel;
+class CCostModelParamsGPDB;
 }  // namespace gpopt
 
+struct OptimizerProfile;
 struct PlannedStmt;
 struct Query;
 struct List;
@@ -137,12 +140,23 @@ private:
 		const CDXLNode *dxlnode, bool can_set_tag,
 		DistributionHashOpsKind distribution_hashops);
 
+	// summarize the counters of an optimization for EXPLAIN
+	static OptimizerProfile *CreateOptimizerProfile(
+		COptimizationStats *optimization_stats);
+
 	// load search strategy from given path
 	static CSearchStageArray *LoadSearchStrategy(CMemoryPool *mp, char *path);
 
+	// load cost model parameters from given path
+	static CCostModelParamsGPDB *LoadCostModelParams(CMemoryPool *mp,
+													 char *path);
+
 	// helper for converting wide character string to regular string
 	static CHAR *CreateMultiByteCharStringFromWCString(const WCHAR *wcstr);
 
+	// helper for converting a binary document to a hex string
+	static CHAR *CreateHexStringFromBinary(const BYTE *data, ULONG length);
+
 	// set cost model parameters
 	static void SetCostModelParams(ICostModel *cost_model);
 
@@ -1485,10 +1485,50 @@ typedef struct ScanState
  *	 SeqScanState information
  * ----------------
  */
+/* ----------------
+ *	 RuntimeFilterState information
+ *
+ *		GPDB: A filter built from the inner rows of a hash join, and applied
+ *		by the Seq Scan that produces its outer rows, in the same slice, to
+ *		drop the rows that cannot find a match before they are qualified and
+ *		projected.  The Bloom filter holds the hash value of every inner row,
+ *		computed as ExecHashGetHashValue() does, and the range holds the
+ *		minimum and maximum of the first hash key when it is an integer.
+ *
+ *		nkeys			number of hash keys
+ *		scan_attnos		scan attribute holding every outer hash key
+ *		hashfunctions	outer hash function of every hash key
+ *		collations		collation of every hash key
+ *		hashStrict		is the join operator of every hash key strict?
+ *		range_types		integer types of the first inner and outer keys, or
+ *						InvalidOid if the range is not tracked
+ *		bloom			Bloom filter on the hash values of the inner rows,
+ *						or NULL
+ *		min, max		range of the first inner key
+ *		has_range		have min and max been set?
+ *		built			is the filter ready to be applied?
+ * ----------------
+ */
+typedef struct RuntimeFilterState
+{
+	int			nkeys;
+	AttrNumber *scan_attnos;
+	FmgrInfo   *hashfunctions;
+	Oid		   *collations;
+	bool	   *hashStrict;
+	Oid			range_types[2];
+	struct bloom_filter *bloom;
+	int64		min;
+	int64		max;
+	bool		has_range;
+	bool		built;
+} RuntimeFilterState;
+
 typedef struct SeqScanState
 {
 	ScanState	ss;				/* its first field is NodeTag */
 	Size		pscan_len;		/* size of parallel heap scan descriptor */
+	RuntimeFilterState *runtime_filter; /* GPDB: filter from a hash join */
 } SeqScanState;
 
 /* ----------------
@@ -2753,6 +2793,9 @@ typedef struct HashState
 	bool		hs_hashkeys_null;	/* found an instance wherein hashkeys are all null */
 	/* hashkeys is same as parent's hj_InnerHashKeys */
 
+	/* GPDB: filter to build for the outer Seq Scan, or NULL */
+	RuntimeFilterState *runtime_filter;
+
 	SharedHashInfo *shared_info;	/* one entry per worker */
 	HashInstrumentation *hinstrument;	/* this worker's entry */
 
@@ -118,6 +118,7 @@ typedef enum NodeTag
 	T_PartitionPruneStepOp,
 	T_PartitionPruneStepCombine,
 	T_PlanInvalItem,
+	T_OptimizerProfile,
 
 	/*
 	 * TAGS FOR PLAN STATE NODES (execnodes.h)
@@ -156,6 +156,13 @@ typedef struct PlannedStmt
  	 * GPDB: whether a query is a SPI inner query for extension usage 
  	 */
 	int8		metricsQueryType;
+
+	/*
+	 * GPDB: where GPORCA spent its time producing the plan, shown by EXPLAIN
+	 * (VERBOSE, SUMMARY). NULL for plans of the Postgres planner. Not
+	 * dispatched to the segments.
+	 */
+	struct OptimizerProfile *optimizerProfile;
 } PlannedStmt;
 
 /*
@@ -1739,6 +1746,47 @@ typedef struct PlanInvalItem
 	uint32		hashValue;		/* hash value of object's cache lookup key */
 } PlanInvalItem;
 
+/*
+ * OptimizerProfile - where GPORCA spent its time optimizing a statement
+ *
+ * Times are in milliseconds. The phases follow each other: the query is
+ * translated into GPORCA's representation and preprocessed, the
+ * alternatives are explored, statistics derived, implemented and costed
+ * ("optimization"), and the best plan is translated into a PlannedStmt.
+ * Only the xforms that took the most time are listed.
+ */
+#define OPTIMIZER_PROFILE_XFORMS 5
+
+typedef struct OptimizerProfile
+{
+	NodeTag		type;
+
+	/* time spent in each phase */
+	double		translateTime;	/* Query to DXL to GPORCA expression */
+	double		preprocessTime;
+	double		exploreTime;
+	double		statsTime;		/* statistics derivation */
+	double		implementTime;
+	double		optimizeTime;
+	double		planTime;		/* GPORCA expression to DXL to PlannedStmt */
+
+	/* metadata lookups */
+	double		mdFetchTime;	/* fetching objects missing from the cache */
+	int			mdCacheHits;
+	int			mdCacheMisses;
+
+	/* size of the search space */
+	int			memoGroups;
+	int			memoGroupExprs;
+	int			searchStages;
+
+	/* xforms that took the most time, slowest first */
+	int			numXforms;
+	char	   *xformNames[OPTIMIZER_PROFILE_XFORMS];
+	double		xformTimes[OPTIMIZER_PROFILE_XFORMS];
+	int			xformCalls[OPTIMIZER_PROFILE_XFORMS];
+} OptimizerProfile;
+
 /* ----------------
  * PartitionSelector node
  *
@@ -221,6 +221,7 @@ typedef enum BuiltinTrancheIds
 	LWTRANCHE_PARALLEL_APPEND,
 	LWTRANCHE_SXACT,
 	LWTRANCHE_DISTRIBUTEDLOG_BUFFERS,
+	LWTRANCHE_MDCACHE_SHARED_DSA,
 	LWTRANCHE_FIRST_USER_DEFINED
 }			BuiltinTrancheIds;
 
@@ -312,6 +312,7 @@ extern int	datumstreamread_block(DatumStreamRead * ds,
 extern void datumstreamread_find(DatumStreamRead * datumStream,
 					 int32 rowNumInBlock);
 extern void datumstreamread_rewind_block(DatumStreamRead * datumStream);
+extern int	datumstreamread_skip_to_row(DatumStreamRead * acc, int64 rowNum);
 extern bool datumstreamread_find_block(DatumStreamRead * datumStream,
 						   DatumStreamFetchDesc datumStreamFetchDesc,
 						   int64 rowNum);
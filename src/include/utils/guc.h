@@ -296,6 +296,7 @@ extern bool gp_local_distributed_cache_stats;
 extern bool gp_appendonly_verify_block_checksums;
 extern bool gp_appendonly_verify_write_block;
 extern bool gp_appendonly_compaction;
+extern bool gp_appendonly_zone_maps;
 
 /*
  * Threshold of the ratio of dirty data in a segment file
@@ -454,9 +455,15 @@ extern bool	optimizer_log;
 extern int  optimizer_log_failure;
 extern bool	optimizer_trace_fallback;
 extern int optimizer_minidump;
+extern bool optimizer_dxl_binary;
 extern int  optimizer_cost_model;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
+extern int	optimizer_mdcache_shared_size;
+extern bool optimizer_plan_caching;
+extern int	optimizer_plan_cache_size;
+extern bool optimizer_adaptive_search_strategy;
+extern bool optimizer_prefetch_metadata;
 
 /* Optimizer debugging GUCs */
 extern bool optimizer_print_query;
@@ -471,10 +478,12 @@ extern bool	optimizer_print_group_properties;
 extern bool	optimizer_print_optimization_context;
 extern bool optimizer_print_optimization_stats;
 extern bool optimizer_print_xform_results;
+extern bool optimizer_explain_profile;
 
 /* array of xforms disable flags */
 extern bool optimizer_xforms[OPTIMIZER_XFORMS_COUNT];
 extern char *optimizer_search_strategy_path;
+extern char *optimizer_cost_model_params_path;
 
 /* GUCs to tell Optimizer to enable a physical operator */
 extern bool optimizer_enable_indexjoin;
@@ -570,6 +579,7 @@ extern bool optimizer_analyze_midlevel_partition;
 extern bool optimizer_analyze_enable_merge_of_leaf_stats;
 
 extern bool optimizer_use_gpdb_allocators;
+extern bool optimizer_use_arena_memory_pool;
 
 /* optimizer GUCs for replicated table */
 extern bool optimizer_replicated_table_insert;
@@ -0,0 +1,40 @@
+/*-------------------------------------------------------------------------
+ *
+ * mdcacheshared.h
+ *	  Metadata cache of the GPORCA optimizer shared by all backends.
+ *
+ * Portions Copyright (c) 2020 VMware, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/include/utils/mdcacheshared.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef MDCACHESHARED_H
+#define MDCACHESHARED_H
+
+/* maximum length of the key of a shared metadata cache entry */
+#define MDCACHE_SHARED_KEY_LEN		64
+
+/* maximum number of catalog dependencies of a shared metadata cache entry */
+#define MDCACHE_SHARED_MAX_DEPS		4
+
+/* cache id of relcache dependencies; the hash value is the relation OID */
+#define MDCACHE_SHARED_RELCACHE		(-1)
+
+extern Size MDCacheSharedShmemSize(void);
+extern void MDCacheSharedShmemInit(void);
+extern bool MDCacheSharedEnabled(void);
+
+extern char *MDCacheSharedLookup(const char *key, Size *len);
+extern uint64 MDCacheSharedBeginFetch(void);
+extern uint32 MDCacheSharedDependency(int cacheid, uint32 hashvalue);
+extern void MDCacheSharedInsert(const char *key, uint64 stamp,
+								const uint32 *deps, int ndeps,
+								const char *data, Size len);
+
+extern void MDCacheSharedInvalidate(int cacheid, uint32 hashvalue);
+extern void MDCacheSharedInvalidateAll(void);
+extern void AtEOXact_MDCacheShared(bool isCommit);
+
+#endif							/* MDCACHESHARED_H */
@@ -11,11 +11,13 @@
 		"force_parallel_mode",
 		"gin_fuzzy_search_limit",
 		"gin_pending_list_limit",
+		"gp_appendonly_zone_maps",
 		"gp_blockdirectory_entry_min_range",
 		"gp_blockdirectory_minipage_size",
 		"gp_debug_linger",
 		"gp_default_storage_options",
 		"gp_disable_tuple_hints",
+		"gp_enable_runtime_filter",
 		"gp_enable_segment_copy_checking",
 		"gp_external_enable_filter_pushdown",
 		"gp_hashagg_default_nbatches",
@@ -340,6 +340,7 @@
 		"old_snapshot_threshold",
 		"operator_precedence_warning",
 		"optimizer",
+		"optimizer_adaptive_search_strategy",
 		"optimizer_analyze_enable_merge_of_leaf_stats",
 		"optimizer_analyze_midlevel_partition",
 		"optimizer_analyze_root_partition",
@@ -348,12 +349,14 @@
 		"optimizer_array_expansion_threshold",
 		"optimizer_control",
 		"optimizer_cost_model",
+		"optimizer_cost_model_params_path",
 		"optimizer_cost_threshold",
 		"optimizer_cte_inlining",
 		"optimizer_damping_factor_filter",
 		"optimizer_damping_factor_groupby",
 		"optimizer_damping_factor_join",
 		"optimizer_dpe_stats",
+		"optimizer_dxl_binary",
 		"optimizer_enable_assert_maxonerow",
 		"optimizer_enable_associativity",
 		"optimizer_enable_bitmapscan",
@@ -396,6 +399,7 @@
 		"optimizer_enforce_subplans",
 		"optimizer_enumerate_plans",
 		"optimizer_expand_fulljoin",
+		"optimizer_explain_profile",
 		"optimizer_extract_dxl_stats",
 		"optimizer_extract_dxl_stats_all_nodes",
 		"optimizer_force_agg_skew_avoidance",
@@ -407,6 +411,7 @@
 		"optimizer_join_order_threshold",
 		"optimizer_log",
 		"optimizer_log_failure",
+		"optimizer_mdcache_shared_size",
 		"optimizer_metadata_caching",
 		"optimizer_minidump",
 		"optimizer_multilevel_partitioning",
@@ -414,6 +419,9 @@
 		"optimizer_parallel_union",
 		"optimizer_penalize_broadcast_threshold",
 		"optimizer_penalize_skew",
+		"optimizer_plan_cache_size",
+		"optimizer_plan_caching",
+		"optimizer_prefetch_metadata",
 		"optimizer_print_expression_properties",
 		"optimizer_print_group_properties",
 		"optimizer_print_job_scheduler",
@@ -437,6 +445,7 @@
 		"optimizer_segments",
 		"optimizer_sort_factor",
 		"optimizer_trace_fallback",
+		"optimizer_use_arena_memory_pool",
 		"optimizer_use_external_constant_expression_evaluation_for_ints",
 		"optimizer_use_gpdb_allocators",
 		"parallel_leader_participation",
@@ -0,0 +1,37 @@
+-- Test that a catalog change committed by a transaction invalidates the
+-- shared MDCache entries published while it was in progress, also for
+-- sessions that start after the commit and never see its invalidation
+-- messages.
+!\retcode gpconfig -c optimizer_mdcache_shared_size -v 4096 --skipvalidation;
+!\retcode gpstop -ari;
+
+create or replace function mdcache_shared_rows(q text) returns text as $$ declare l text; /* in func */ begin for l in execute 'explain ' || q loop return substring(l from 'rows=([0-9]+)'); /* in func */ end loop; /* in func */ end; /* in func */ $$ language plpgsql;
+
+1: set gp_autostats_mode = none;
+1: create table mdcache_shared_t (a int) distributed by (a);
+1: insert into mdcache_shared_t select generate_series(1, 10);
+1: analyze mdcache_shared_t;
+1: insert into mdcache_shared_t select generate_series(11, 10000);
+
+-- The statistics gathered by ANALYZE are invalidated at command end, but
+-- only become visible at commit. Another session planning in between still
+-- reads the old statistics, and publishes them.
+1: begin;
+1: analyze mdcache_shared_t;
+2: set optimizer = on;
+2: select mdcache_shared_rows('select * from mdcache_shared_t');
+1: commit;
+
+-- A new session must not get the statistics published before the commit.
+3: set optimizer = on;
+3: select mdcache_shared_rows('select * from mdcache_shared_t');
+
+1q:
+2q:
+3q:
+
+drop table mdcache_shared_t;
+drop function mdcache_shared_rows(text);
+
+!\retcode gpconfig -r optimizer_mdcache_shared_size --skipvalidation;
+!\retcode gpstop -ari;
@@ -0,0 +1,127 @@
+--
+-- Test the zone maps of append-only tables: min/max summaries of their
+-- integer and date/time columns, kept in the block directory when
+-- gp_appendonly_zone_maps is on, that let scans skip the blocks whose
+-- rows cannot satisfy the quals. Every query runs with the setting off,
+-- then on, and must return the same result. The faults count the blocks
+-- and rows that are skipped.
+--
+create function zm_arm(fault text) returns void as $$
+declare
+  seg record;
+begin
+  for seg in select dbid from gp_segment_configuration
+              where role = 'p' and content > -1
+  loop
+    perform gp_inject_fault(fault, 'reset', seg.dbid);
+    perform gp_inject_fault_infinite(fault, 'skip', seg.dbid);
+  end loop;
+end;
+$$ language plpgsql;
+create function zm_hits(fault text) returns bigint as $$
+  select sum((regexp_match(gp_inject_fault(fault, 'status', dbid),
+                           'num times hit:''(\d+)'''))[1]::bigint)
+    from gp_segment_configuration
+   where role = 'p' and content > -1;
+$$ language sql;
+
+-- The block directory, and so the zone maps, only exist with an index.
+create table zm_row (a int, b int, c text)
+  with (appendonly=true, blocksize=8192) distributed by (a);
+create index zm_row_a on zm_row (a);
+set gp_appendonly_zone_maps = on;
+insert into zm_row select i, i, repeat('x', 20) from generate_series(1, 100000) i;
+insert into zm_row select i, null, 'n' from generate_series(100001, 100010) i;
+
+-- blocks of an append-only row table skipped
+set gp_appendonly_zone_maps = off;
+select zm_arm('appendonly_zonemap_skip_block');
+select count(*), sum(b) from zm_row where b between 5001 and 5100;
+select count(*) from zm_row where b is null;
+select zm_hits('appendonly_zonemap_skip_block') = 0;
+set gp_appendonly_zone_maps = on;
+select zm_arm('appendonly_zonemap_skip_block');
+select count(*), sum(b) from zm_row where b between 5001 and 5100;
+select zm_hits('appendonly_zonemap_skip_block') > 0;
+select zm_arm('appendonly_zonemap_skip_block');
+select count(*) from zm_row where b is null;
+select zm_hits('appendonly_zonemap_skip_block') > 0;
+select count(*) from zm_row where b > 100000;
+select count(*) from zm_row where b is not null and a <= 10;
+
+-- Minipages written with the setting off have no zone map: their blocks are
+-- always read, also once later inserts add summarized blocks to them.
+create table zm_old (a int, b int, c text)
+  with (appendonly=true, blocksize=8192) distributed by (a);
+create index zm_old_a on zm_old (a);
+set gp_appendonly_zone_maps = off;
+insert into zm_old select i, i, repeat('x', 20) from generate_series(1, 50000) i;
+set gp_appendonly_zone_maps = on;
+select zm_arm('appendonly_zonemap_skip_block');
+select count(*), sum(b) from zm_old where b between 5001 and 5100;
+select zm_hits('appendonly_zonemap_skip_block') = 0;
+insert into zm_old select i, i, repeat('x', 20) from generate_series(50001, 100000) i;
+select zm_arm('appendonly_zonemap_skip_block');
+select count(*), sum(b) from zm_old where b between 5001 and 5100;
+select count(*), sum(b) from zm_old where b between 60001 and 60100;
+select zm_hits('appendonly_zonemap_skip_block') > 0;
+set gp_appendonly_zone_maps = off;
+select count(*), sum(b) from zm_old where b between 60001 and 60100;
+
+-- ADD COLUMN of a row table
+set gp_appendonly_zone_maps = on;
+alter table zm_old add column d int default 7;
+select count(*), sum(d) from zm_old where d = 7;
+select count(*), sum(b) from zm_old where b between 60001 and 60100;
+
+-- rows of an append-only column table skipped, in every column read
+create table zm_col (a int, b int, c text)
+  with (appendonly=true, orientation=column, blocksize=8192) distributed by (a);
+create index zm_col_a on zm_col (a);
+insert into zm_col select i, i, repeat('y', i % 200) from generate_series(1, 100000) i;
+set gp_appendonly_zone_maps = off;
+select count(*), sum(b), sum(length(c)) from zm_col where b between 5001 and 5100;
+set gp_appendonly_zone_maps = on;
+select zm_arm('aocs_zonemap_skip_rows');
+select count(*), sum(b), sum(length(c)) from zm_col where b between 5001 and 5100;
+select zm_hits('aocs_zonemap_skip_rows') > 0;
+select count(*) from zm_col where b >= 99991;
+
+-- ADD COLUMN of a column table: the new column has no zone map until rows
+-- are inserted
+alter table zm_col add column d int default 7;
+select zm_arm('aocs_zonemap_skip_rows');
+select count(*), sum(b) from zm_col where d = 7;
+select zm_hits('aocs_zonemap_skip_rows') = 0;
+insert into zm_col select i, i, 'z', i from generate_series(100001, 130000) i;
+select zm_arm('aocs_zonemap_skip_rows');
+select count(*), sum(b), sum(length(c)) from zm_col where d between 120001 and 120100;
+select zm_hits('aocs_zonemap_skip_rows') > 0;
+select count(*), sum(b) from zm_col where d = 7;
+set gp_appendonly_zone_maps = off;
+select count(*), sum(b), sum(length(c)) from zm_col where d between 120001 and 120100;
+
+-- large content of a column table, which spans several blocks
+create table zm_large (a int, b int, arr float8[])
+  with (appendonly=true, orientation=column, blocksize=8192) distributed by (a);
+create index zm_large_a on zm_large (a);
+set gp_appendonly_zone_maps = on;
+insert into zm_large
+  select i, i, case when i % 500 = 0 then array_fill(i::float8, array[1100])
+                    else array[i::float8] end
+    from generate_series(1, 30000) i;
+set gp_appendonly_zone_maps = off;
+select count(*), sum(b), sum(array_length(arr, 1)), sum(arr[1])
+  from zm_large where b between 11901 and 12100;
+select b, array_length(arr, 1), arr[1100] from zm_large where b = 12000;
+set gp_appendonly_zone_maps = on;
+select zm_arm('aocs_zonemap_skip_rows');
+select count(*), sum(b), sum(array_length(arr, 1)), sum(arr[1])
+  from zm_large where b between 11901 and 12100;
+select b, array_length(arr, 1), arr[1100] from zm_large where b = 12000;
+select zm_hits('aocs_zonemap_skip_rows') > 0;
+
+reset gp_appendonly_zone_maps;
+drop table zm_row, zm_old, zm_col, zm_large;
+drop function zm_arm(text);
+drop function zm_hits(text);
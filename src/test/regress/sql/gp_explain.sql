@@ -183,3 +183,46 @@ explain (slicetable, costs off) SELECT * FROM explaintest;
 
 -- same in JSON format
 explain (slicetable, costs off, format json) SELECT * FROM explaintest;
+
+--
+-- Test the optimizer profile shown by EXPLAIN (VERBOSE, SUMMARY). Only plans
+-- produced by GPORCA have one.
+--
+-- It is collected only with optimizer_explain_profile on
+SELECT COUNT(*) as profile_lines FROM get_explain_output($$
+  (VERBOSE, SUMMARY) SELECT * FROM explaintest;
+$$) AS et WHERE et like 'Optimizer Profile:%';
+SET optimizer_explain_profile = on;
+WITH query_plan (et) AS
+(
+  select get_explain_output($$
+    (VERBOSE, SUMMARY) SELECT * FROM explaintest;
+  $$)
+)
+SELECT
+  (SELECT COUNT(*) FROM query_plan WHERE et like 'Optimizer Profile:%') as profile_lines,
+  (SELECT COUNT(*) FROM query_plan WHERE et like '  Phases: Query Translation % ms, %') as phases_lines,
+  (SELECT COUNT(*) FROM query_plan WHERE et like '  Memo: Groups %') as memo_lines;
+
+-- ANALYZE turns the summary on, but not the profile
+WITH query_plan (et) AS
+(
+  select get_explain_output($$
+    (ANALYZE, VERBOSE) SELECT * FROM explaintest;
+  $$)
+)
+SELECT
+  (SELECT COUNT(*) FROM query_plan WHERE et like 'Optimizer Profile:%') as profile_lines;
+
+-- A plan reused from the plan cache has no profile
+SET plan_cache_mode = force_generic_plan;
+PREPARE explaintest_profile AS SELECT * FROM explaintest;
+SELECT COUNT(*) as profile_lines FROM get_explain_output($$
+  (VERBOSE, SUMMARY) EXECUTE explaintest_profile;
+$$) AS et WHERE et like 'Optimizer Profile:%';
+SELECT COUNT(*) as profile_lines FROM get_explain_output($$
+  (VERBOSE, SUMMARY) EXECUTE explaintest_profile;
+$$) AS et WHERE et like 'Optimizer Profile:%';
+DEALLOCATE explaintest_profile;
+RESET plan_cache_mode;
+RESET optimizer_explain_profile;
@@ -0,0 +1,26 @@
+-- 
+-- @description Interconnect test case: the rx thread keeps a batch of
+-- receive buffers across queries, teardown must leave them alone
+-- @tags executor
+
+-- Create a table
+CREATE TEMP TABLE mmsg_table(dkey INT, jkey INT, tval TEXT default repeat('x', 100)) DISTRIBUTED BY (dkey);
+
+-- Generate some data
+INSERT INTO mmsg_table SELECT i, i % 1000 FROM generate_series(1, 20000) i;
+
+-- Run several queries with redistribute motions in a row, every one of
+-- them tears down the interconnect after the rx thread got its buffers
+SET gp_interconnect_queue_depth = 1;
+SELECT count(*), sum(length(a.tval)) FROM mmsg_table a JOIN mmsg_table b ON a.jkey = b.dkey;
+SELECT count(*), sum(length(a.tval)) FROM mmsg_table a JOIN mmsg_table b ON a.jkey = b.dkey;
+SELECT count(*), sum(length(a.tval)) FROM mmsg_table a JOIN mmsg_table b ON a.jkey = b.dkey;
+SELECT count(*) FROM (SELECT jkey, count(*) FROM mmsg_table GROUP BY jkey) foo;
+SELECT count(*) FROM (SELECT jkey, count(*) FROM mmsg_table GROUP BY jkey) foo;
+SELECT count(*) FROM (SELECT jkey, count(*) FROM mmsg_table GROUP BY jkey) foo;
+
+RESET gp_interconnect_queue_depth;
+SELECT count(*), sum(length(a.tval)) FROM mmsg_table a JOIN mmsg_table b ON a.jkey = b.dkey;
+SELECT count(*), sum(length(a.tval)) FROM mmsg_table a JOIN mmsg_table b ON a.jkey = b.dkey;
+SELECT count(*), sum(length(a.tval)) FROM mmsg_table a JOIN mmsg_table b ON a.jkey = b.dkey;
+SELECT count(*) FROM (SELECT jkey, count(*) FROM mmsg_table GROUP BY jkey) foo;
@@ -0,0 +1,156 @@
+--
+-- Test the runtime filters that hash joins build from their inner rows for
+-- the Seq Scan on their outer side (gp_enable_runtime_filter). Every query
+-- runs with the filter off, then on, and must return the same result.
+--
+create table rf_outer (a int4, b int8, c int2, d text) distributed by (a);
+create table rf_inner (a int4, b int8, c int2, d text) distributed by (a);
+insert into rf_outer select i, i % 100, i % 50, 'v' || (i % 7) from generate_series(1, 10000) i;
+insert into rf_outer values (null, null, null, null), (null, 1, 1, 'v1');
+insert into rf_inner select i * 10, i % 20, i % 5, 'v' || (i % 3) from generate_series(1, 500) i;
+insert into rf_inner values (null, null, null, null), (null, 2, 2, 'v2');
+create table rf_inner_rep (a int4, b int8, c int2, d text) distributed replicated;
+insert into rf_inner_rep select * from rf_inner;
+analyze rf_outer;
+analyze rf_inner;
+analyze rf_inner_rep;
+set enable_nestloop = off;
+set enable_mergejoin = off;
+
+-- The outer Seq Scans of a query and the rows their runtime filter removed,
+-- with the numbers masked, as EXPLAIN ANALYZE shows them
+create function rf_explain(query text) returns setof text language plpgsql as
+$$
+declare
+  ln text;
+begin
+  for ln in execute 'explain (analyze, costs off, timing off, summary off) ' || query
+  loop
+    if ln like '%Seq Scan on rf_outer%' then
+      return next regexp_replace(ln, '^ *(->  )?(.*) \(actual.*$', '\2');
+    elsif ln like '%Rows Removed by Runtime Filter%' then
+      return next regexp_replace(trim(ln), '[0-9]+', 'N');
+    end if;
+  end loop;
+end;
+$$;
+
+-- inner join
+set gp_enable_runtime_filter = off;
+select count(*), sum(o.b), sum(i.c)
+  from rf_outer o join rf_inner i on o.a = i.a;
+set gp_enable_runtime_filter = on;
+select count(*), sum(o.b), sum(i.c)
+  from rf_outer o join rf_inner i on o.a = i.a;
+select * from rf_explain($$
+select count(*), sum(o.b), sum(i.c)
+  from rf_outer o join rf_inner i on o.a = i.a
+$$);
+
+-- semi join, on two keys
+set gp_enable_runtime_filter = off;
+select count(*), sum(o.b)
+  from rf_outer o
+ where exists (select 1 from rf_inner i where i.a = o.a and i.d = o.d);
+set gp_enable_runtime_filter = on;
+select count(*), sum(o.b)
+  from rf_outer o
+ where exists (select 1 from rf_inner i where i.a = o.a and i.d = o.d);
+
+-- right join, on two keys
+set gp_enable_runtime_filter = off;
+select count(*), count(o.a), count(i.a)
+  from rf_outer o right join rf_inner i on o.a = i.a and o.b = i.b;
+set gp_enable_runtime_filter = on;
+select count(*), count(o.a), count(i.a)
+  from rf_outer o right join rf_inner i on o.a = i.a and o.b = i.b;
+
+-- keys of different integer types; the inner table is replicated, for the
+-- outer Seq Scan to be right below the join, not behind a Motion
+set gp_enable_runtime_filter = off;
+select count(*), sum(o.a)
+  from rf_outer o join rf_inner_rep i on o.c = i.b;
+set gp_enable_runtime_filter = on;
+select count(*), sum(o.a)
+  from rf_outer o join rf_inner_rep i on o.c = i.b;
+select * from rf_explain($$
+select count(*), sum(o.a)
+  from rf_outer o join rf_inner_rep i on o.c = i.b
+$$);
+set gp_enable_runtime_filter = off;
+select count(*), sum(i.a)
+  from rf_outer o join rf_inner_rep i on o.b = i.a;
+set gp_enable_runtime_filter = on;
+select count(*), sum(i.a)
+  from rf_outer o join rf_inner_rep i on o.b = i.a;
+select * from rf_explain($$
+select count(*), sum(i.a)
+  from rf_outer o join rf_inner_rep i on o.b = i.a
+$$);
+set gp_enable_runtime_filter = off;
+select count(*), sum(o.a)
+  from rf_outer o join rf_inner_rep i on o.a = i.c;
+set gp_enable_runtime_filter = on;
+select count(*), sum(o.a)
+  from rf_outer o join rf_inner_rep i on o.a = i.c;
+select * from rf_explain($$
+select count(*), sum(o.a)
+  from rf_outer o join rf_inner_rep i on o.a = i.c
+$$);
+
+-- NULL keys
+set gp_enable_runtime_filter = off;
+select count(*), count(o.a)
+  from rf_outer o join rf_inner i on o.a is not distinct from i.a;
+set gp_enable_runtime_filter = on;
+select count(*), count(o.a)
+  from rf_outer o join rf_inner i on o.a is not distinct from i.a;
+set gp_enable_runtime_filter = off;
+select count(*)
+  from rf_outer o
+ where o.c in (select c from rf_inner);
+set gp_enable_runtime_filter = on;
+select count(*)
+  from rf_outer o
+ where o.c in (select c from rf_inner);
+
+-- rescan of the hash join for every row of the outer query
+set gp_enable_runtime_filter = off;
+select o2.a, o2.c,
+       (select count(*)
+          from rf_outer o join rf_inner i on o.a = i.a
+         where i.c = o2.c)
+  from rf_outer o2
+ where o2.a <= 5
+ order by o2.a;
+set gp_enable_runtime_filter = on;
+select o2.a, o2.c,
+       (select count(*)
+          from rf_outer o join rf_inner i on o.a = i.a
+         where i.c = o2.c)
+  from rf_outer o2
+ where o2.a <= 5
+ order by o2.a;
+
+-- inner rows spilled to several batches
+create table rf_big (a int4, b int8) distributed by (a);
+insert into rf_big select i, i % 1000 from generate_series(1, 300000) i;
+analyze rf_big;
+set statement_mem = '1000kB';
+set gp_enable_runtime_filter = off;
+select count(*), sum(g1.b)
+  from rf_big g1 join rf_big g2 on g1.a = g2.a
+ where g2.b < 500;
+set gp_enable_runtime_filter = on;
+select count(*), sum(g1.b)
+  from rf_big g1 join rf_big g2 on g1.a = g2.a
+ where g2.b < 500;
+reset statement_mem;
+reset gp_enable_runtime_filter;
+reset enable_nestloop;
+reset enable_mergejoin;
+drop table rf_outer;
+drop table rf_inner;
+drop table rf_inner_rep;
+drop table rf_big;
+drop function rf_explain(text);